@@ -45,10 +45,12 @@
 // Core Functionality
 #include "CoreApplication.h"
 #include "WindowManager.h"
+#include "Events/EventHandler.h"
 
 // Logging and Memory
 #include "Logging/Logger.h"
 #include "Memory/MemoryManager.h"
+#include "Memory/AllocationTracker.h"
 
 // Resource Management
 #include "ResourceManager/ResourceManager.h"
@@ -59,6 +61,7 @@
 
 // Time Management
 #include "Time/TimeManager.h"
+#include "Time/Profiler.h"
 
 // Physics and Collision
 #include "Physics/RigidBody.h"
@@ -126,6 +129,14 @@
 // Testing
 Logger engine_logger = Logger("ENGINE");
 
+#ifndef GAMERELEASE
+namespace
+{
+    // Gives the resources of a headless application handles, and outlives them as it is created before main
+    PE::Graphics::NullRenderBackend headlessBackend{};
+}
+#endif // !GAMERELEASE
+
 #define TO_STR(x) #x
 
 
@@ -526,12 +537,25 @@ PE::CoreApplication::CoreApplication()
 
 
     // Initialize Window
+#ifndef GAMERELEASE
+    if (m_headless)
+    {
+        // Nothing is presented, so resources are created through the null backend instead of a context
+        m_window = nullptr;
+        Graphics::RenderBackend::SetResourceBackend(headlessBackend);
+    }
+    else
+    {
+        m_window = m_windowManager.InitWindow(width, height, "Purring_Engine");
+    }
+#else
     m_window = m_windowManager.InitWindow(width, height, "Purring_Engine");
+#endif // !GAMERELEASE
     TimeManager::GetInstance().m_frameRateController.SetTargetFPS(60);
     
     InitializeLogger();
     InitializeMemoryManager();
-    InitializeSystems();
+    InitializeSystems(width, height);
     InitializeAudio();
 
     //create background from file
@@ -554,6 +578,7 @@ void PE::CoreApplication::Run()
 {
     // Start engine run time
     TimeManager::GetInstance().EngineStart();
+    Profiler::GetInstance().SetThreadName("Main");
 
     SerializationManager serializationManager;
 
@@ -585,9 +610,14 @@ void PE::CoreApplication::Run()
     while (!glfwWindowShouldClose(m_window))
     {
         // Time start
+        Profiler::GetInstance().BeginFrame();
+        PE_PROFILE_SCOPE("Frame");
         TimeManager::GetInstance().StartFrame();
         engine_logger.SetTime();
         MemoryManager::GetInstance().CheckMemoryOver();
+
+        // Send the events posted from other threads since the last frame, before any system updates
+        EventHandler::GetInstance().DispatchQueuedEvents();
         
         // ----- UPDATE ----- //
         
@@ -623,9 +653,7 @@ void PE::CoreApplication::Run()
             {
                 for (SystemID systemID{}; systemID < SystemID::GRAPHICS; ++systemID)
                 {
-                    TimeManager::GetInstance().SystemStartFrame(systemID);
-                    m_systemList[systemID]->UpdateSystem(TimeManager::GetInstance().GetFixedTimeStep());
-                    TimeManager::GetInstance().SystemEndFrame(systemID);
+                    UpdateFixedSystem(systemID);
                 }
             }
             TimeManager::GetInstance().EndAccumulator();
@@ -639,9 +667,13 @@ void PE::CoreApplication::Run()
 
         // Update Graphics with variable timestep
 
-        TimeManager::GetInstance().SystemStartFrame(SystemID::GRAPHICS);
-        m_systemList[SystemID::GRAPHICS]->UpdateSystem(TimeManager::GetInstance().GetDeltaTime());
-        TimeManager::GetInstance().SystemEndFrame(SystemID::GRAPHICS);
+        {
+            PE_PROFILE_SCOPE(SystemNames[SystemID::GRAPHICS]);
+            AllocationTracker::SystemScope allocationScope{ SystemID::GRAPHICS };
+            TimeManager::GetInstance().SystemStartFrame(SystemID::GRAPHICS);
+            m_systemList[SystemID::GRAPHICS]->UpdateSystem(TimeManager::GetInstance().GetDeltaTime());
+            TimeManager::GetInstance().SystemEndFrame(SystemID::GRAPHICS);
+        }
 
         skipFrame = false;
 
@@ -669,15 +701,47 @@ void PE::CoreApplication::Run()
         engine_logger.FlushLog();
 
         TimeManager::GetInstance().EndFrame();
+        AllocationTracker::EndFrame();
+        MemoryManager::GetInstance().EndFrame();
         // Finalize FPS calculations for the current frame
         TimeManager::GetInstance().m_frameRateController.EndFrame();
     }
 
-    // Cleanup for ImGui
+    Shutdown();
+}
+
 #ifndef GAMERELEASE
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
+void PE::CoreApplication::RunRenderBenchmark(unsigned frameCount, std::string const& r_tracePath)
+{
+    // Nothing is presented, so hide the window if the application was not created headless
+    if (m_window)
+    {
+        glfwHideWindow(m_window);
+    }
+    Profiler::GetInstance().SetThreadName("Main");
+
+    // Load default assets
+    ResourceManager::GetInstance().LoadDefaultAssets();
+
+    const_cast<Graphics::RendererManager*>(GETRENDERERMANAGER())->BenchmarkScenes("../Assets/Scenes/", frameCount, r_tracePath);
+
+    // Flush log entries
+    engine_logger.FlushLog();
+
+    Shutdown();
+}
+#endif // !GAMERELEASE
+
+void PE::CoreApplication::Shutdown()
+{
+    // Cleanup for ImGui, which is only set up along with the window
+#ifndef GAMERELEASE
+    if (m_window)
+    {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext();
+    }
 #endif // !GAMERELEASE
 
     // Additional Cleanup (if required)
@@ -685,6 +749,36 @@ void PE::CoreApplication::Run()
     ResourceManager::GetInstance().UnloadResources();
 }
 
+void PE::CoreApplication::UpdateFixedSystem(SystemID systemID)
+{
+    System* p_system{ m_systemList[systemID] };
+    float const fixedTimeStep{ TimeManager::GetInstance().GetFixedTimeStep() };
+    m_systemTimeSinceUpdate[systemID] += fixedTimeStep;
+
+    // Wait until the period of the system has passed, with half a step of leeway for rounding
+    if (p_system->GetUpdateFrequency() > 0.f && m_systemTimeSinceUpdate[systemID] < 1.f / p_system->GetUpdateFrequency() - fixedTimeStep * 0.5f)
+    {
+        return;
+    }
+
+    // Let the system catch up in the next frame if it has used up its budget for this one
+    if (p_system->GetFrameBudget() > 0.f && TimeManager::GetInstance().GetSystemCurrentFrameTime(systemID) >= p_system->GetFrameBudget())
+    {
+        TimeManager::GetInstance().SystemDeferred(systemID);
+        return;
+    }
+
+    float const deltaTime{ m_systemTimeSinceUpdate[systemID] };
+    m_systemTimeSinceUpdate[systemID] = 0.f;
+
+    PE_PROFILE_SCOPE(SystemNames[systemID]);
+    AllocationTracker::SystemScope allocationScope{ systemID };
+
+    TimeManager::GetInstance().SystemStartFrame(systemID);
+    p_system->UpdateSystem(deltaTime);
+    TimeManager::GetInstance().SystemEndFrame(systemID, p_system->GetFrameBudget());
+}
+
 void PE::CoreApplication::Initialize()
 {
     // Init all systems and iterate through each system in m_systemList and initialize it
@@ -745,11 +839,13 @@ void PE::CoreApplication::InitializeMemoryManager()
     MemoryManager::GetInstance();
 }
 
-void PE::CoreApplication::InitializeSystems()
+void PE::CoreApplication::InitializeSystems(int width, int height)
 {
-    // Get the window width and height to initialize the camera manager with
-    int width, height;
-    glfwGetWindowSize(WindowManager::GetInstance().GetWindow(), &width, &height);
+    // Get the window width and height to initialize the camera manager with, keeping the configured size without a window
+    if (m_window)
+    {
+        glfwGetWindowSize(WindowManager::GetInstance().GetWindow(), &width, &height);
+    }
 
     // Add system to list & assigning memory to them
 
@@ -54,6 +54,29 @@ namespace PE
 		*************************************************************************************/
 		void Run();
 
+#ifndef GAMERELEASE
+		/*!***********************************************************************************
+		 \brief Draws every scene in the scene directory through the null render backend
+				instead of running the main loop, and writes the CPU time per frame and the
+				draw stats of each scene to the log. Nothing is submitted to the GPU. If the
+				application was created headless, there is no window or OpenGL context at
+				all, and the resources are only given handles by a null backend.
+
+		 \param[in] frameCount Number of frames to draw each scene for.
+		 \param[in] r_tracePath File to write every render command to, empty to not write them.
+		*************************************************************************************/
+		void RunRenderBenchmark(unsigned frameCount, std::string const& r_tracePath);
+
+		/*!***********************************************************************************
+		 \brief Sets whether applications created from now on skip GLFW, the window and
+				the OpenGL context, and create their resources through a null render backend.
+				Only the render benchmark can be run by a headless application.
+
+		 \param[in] headless Whether to create applications without a window.
+		*************************************************************************************/
+		static void SetHeadless(bool headless) { m_headless = headless; }
+#endif // !GAMERELEASE
+
 		/*!***********************************************************************************
 		 \brief     Initializes all the systems in the CoreApplication class.
 
@@ -100,9 +123,29 @@ namespace PE
 		void InitializeMemoryManager();
 
 		/*!***********************************************************************************
-		 \brief Initializes systems.
+		 \brief Initializes systems with the size of the window, or with the size passed in
+				if there is no window.
+
+		 \param[in] width Width of the window in the configuration.
+		 \param[in] height Height of the window in the configuration.
+		*************************************************************************************/
+		void InitializeSystems(int width, int height);
+
+		/*!***********************************************************************************
+		 \brief Shuts down ImGui, closes the window and unloads the resources once the
+				application is done running.
+		*************************************************************************************/
+		void Shutdown();
+
+		/*!***********************************************************************************
+		 \brief Updates a fixed time system for the current fixed step if it is due. Systems
+				with an update frequency skip steps until their period has passed and are
+				passed the time since their last update. Systems that have used up their
+				frame budget are deferred to the next frame.
+
+		 \param[in] systemID ID of the system to update.
 		*************************************************************************************/
-		void InitializeSystems();
+		void UpdateFixedSystem(SystemID systemID);
 
 		// Uncomment if window is managed as a unique_ptr
 		//std::unique_ptr<Window> m_Window;
@@ -114,10 +157,14 @@ namespace PE
 
 		// Container for all the systems in the engine
 		std::vector<System*> m_systemList;
+		std::array<float, SYSTEMCOUNT> m_systemTimeSinceUpdate{};	// Time since each fixed time system was last updated
 
 		// Temporary (or additional) components
 		WindowManager m_windowManager;						// Manages the application window
-		GLFWwindow* m_window;								// Pointer to the GLFW window object
+		GLFWwindow* m_window;								// Pointer to the GLFW window object, nullptr if headless
+#ifndef GAMERELEASE
+		inline static bool m_headless{ false };				// Whether the application is created without a window
+#endif // !GAMERELEASE
 		float m_time;										// Placeholder for time value
 
 		bool skipFrame{ false };										// Flag to skip a frame
@@ -242,6 +242,8 @@ void SerializationManager::DeserializeAllEntities(const nlohmann::json& r_j)
         {
             DeserializeEntity(entityJson);
         }
+        // the parent and children links were loaded as is, not through AttachChild
+        PE::Hierarchy::GetInstance().MarkStructureDirty();
     }
 }
 
@@ -127,6 +127,7 @@ namespace PE
 		// it will call the constructor at this position instead  of allocating more memory
 		++(m_componentPools[r_componentID]->size);
 		LayerManager::GetInstance().AddEntity(r_id);
+		Hierarchy::GetInstance().OnComponentsChanged(r_id);
 	}
 
 	const ComponentPool* EntityManager::GetComponentPoolPointer(const ComponentID& r_component) const
@@ -182,6 +183,7 @@ namespace PE
 			}
 			m_entities.erase(id);
 			m_removed.emplace(id);
+			Hierarchy::GetInstance().OnComponentsChanged(id);
 			
 			UpdateVectors(id, false);
 		}
@@ -210,11 +212,13 @@ namespace PE
 	void EntityManager::AddHelper(const EntityID& r_id)
 	{
 		LayerManager::GetInstance().AddEntity(r_id);
+		Hierarchy::GetInstance().OnComponentsChanged(r_id);
 	}
 
 	void EntityManager::RemoveHelper(const EntityID& r_id)
 	{
 		LayerManager::GetInstance().RemoveEntity(r_id);
+		Hierarchy::GetInstance().OnComponentsChanged(r_id);
 	}
 
 	nlohmann::json EntityDescriptor::ToJson(size_t id) const
@@ -268,7 +272,7 @@ namespace PE
 
 		if (j.contains("isActive"))
 		{
-			desc.isActive = j["isActive"];
+			desc.SetActive(j["isActive"].get<bool>());
 		}
 
 		if (j.contains("Prefab Type"))
@@ -641,12 +641,12 @@ namespace PE
 		EntityID oldID{ ULLONG_MAX }; // technically also kinda stores the order of the entity in the scene
 
 
-		float renderOrder { FLT_MAX };
-
 		bool isActive{ true };  // defaults to true
 		bool isAlive{ true };   // defaults to true, mainly used in undo/redo for editor functionality
 		bool toSave{ true };    // used for whether the entity should be saved or not
 
+		inline static unsigned long long activeFlagsVersion{}; // incremented whenever SetActive changes the active flag of any entity
+
 		int layer = 0;
 		int interactionLayer = 0;
 
@@ -675,9 +675,24 @@ namespace PE
 		*************************************************************************************/
 		void UnHandicapEntity() { isAlive = toSave = true; }
 
+		/*!***********************************************************************************
+		 \brief Sets whether the entity is active. Use this instead of writing isActive
+		 		directly so that the Hierarchy knows to update the states inherited by the
+		 		descendants of the entity.
+		 
+		 \param[in] active 	Whether the entity should be active
+		*************************************************************************************/
+		void SetActive(bool active)
+		{
+			if (isActive == active)
+				return;
+			isActive = active;
+			++activeFlagsVersion;
+		}
+
 		void DisableEntity()
 		{
-			isActive = false;
+			SetActive(false);
 			if (childrenState.empty())
 			{
 				for (const auto& id : children)
@@ -690,7 +705,7 @@ namespace PE
 
 		void EnableEntity()
 		{
-			isActive = true;
+			SetActive(true);
 			for (const auto& id : children)
 			{
 				if (childrenState.size())
@@ -35,12 +35,15 @@
 #include "AudioManager/AudioComponent.h"
 #include "Time/FrameRateTargetControl.h"
 #include "Time/TimeManager.h"
+#include "Time/Profiler.h"
+#include "Memory/AllocationTracker.h"
 #include "ResourceManager/ResourceManager.h"
 #include <Windows.h>
 #include <Commdlg.h>
 #include "Data/SerializationManager.h"
 #include "Physics/PhysicsManager.h"
 #include "Physics/CollisionManager.h"
+#include "Threading/ThreadPool.h"
 #include "Logging/Logger.h"
 #include "Logic/LogicSystem.h"
 #include "Graphics/RendererManager.h"
@@ -885,6 +888,7 @@ namespace PE {
 									if (ImGui::IsKeyDown(ImGuiKey_LeftCtrl))
 									{
 										std::swap(EntityManager::GetInstance().Get<EntityDescriptor>(dragID.value()).sceneID, EntityManager::GetInstance().Get<EntityDescriptor>(hoveredObject.value()).sceneID);
+										Hierarchy::GetInstance().MarkStructureDirty();
 									}
 									else
 									{
@@ -904,6 +908,7 @@ namespace PE {
 										EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID = order++;
 									}
 									EntityManager::GetInstance().Get<EntityDescriptor>(dragID.value()).sceneID = order;
+									Hierarchy::GetInstance().MarkStructureDirty();
 								}
 							}
 							dragID.reset();
@@ -949,6 +954,7 @@ namespace PE {
 							if (EntityManager::GetInstance().Get<EntityDescriptor>(m_currentSelectedObject).parent)
 							{
 								EntityManager::GetInstance().Get<EntityDescriptor>(EntityManager::GetInstance().Get<EntityDescriptor>(m_currentSelectedObject).parent.value()).children.erase(m_currentSelectedObject);
+								Hierarchy::GetInstance().MarkStructureDirty();
 							}
 
 							UndoStack::GetInstance().AddChange(new DeleteObjectUndo(m_currentSelectedObject));
@@ -1152,6 +1158,7 @@ namespace PE {
 													ImGui::EndDisabled();
 												prop.set_value(EntityManager::GetInstance().Get<EntityDescriptor>(entityID), tmp);
 												EntityManager::GetInstance().Get<EntityDescriptor>(entityID).SetLayer(tmp);
+												Hierarchy::GetInstance().QueueRenderOrderUpdate(entityID);
 											}
 											else if (prop.get_name().to_string() == "Interaction Layer")
 											{
@@ -1167,6 +1174,7 @@ namespace PE {
 												prop.set_value(EntityManager::GetInstance().Get<EntityDescriptor>(entityID), tmp);
 												EntityManager::GetInstance().Get<EntityDescriptor>(entityID).interactionLayer = tmp;
 												LayerManager::GetInstance().UpdateEntity(entityID);
+												Hierarchy::GetInstance().QueueRenderOrderUpdate(entityID);
 											}
 										}
 										else if (vp.get_type().get_name() == "unsigned__int64")
@@ -1578,6 +1586,12 @@ namespace PE {
 											ImGui::Text("Linear Drag: "); ImGui::SameLine(); ImGui::InputFloat("##Linear Drag", &linearDrag, 1.0f, 100.f, "%.3f");
 											EntityManager::GetInstance().Get<RigidBody>(entityID).SetLinearDrag(linearDrag);
 											ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
+
+											//continuous collision for fast moving bodies
+											bool continuousCollision = EntityManager::GetInstance().Get<RigidBody>(entityID).GetContinuousCollision();
+											ImGui::Text("Continuous Collision: "); ImGui::SameLine(); ImGui::Checkbox("##Continuous Collision", &continuousCollision);
+											EntityManager::GetInstance().Get<RigidBody>(entityID).SetContinuousCollision(continuousCollision);
+											ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
 										}
 									}
 								}
@@ -5043,6 +5057,186 @@ namespace PE {
 			ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
 			ImGui::Text("Debug Shape Draw Calls: "); ImGui::SameLine(); ImGui::Text(std::to_string(Graphics::RendererManager::debugDrawCalls).c_str());
 			ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
+			ImGui::Text("Instance Batches: %u", Graphics::RendererManager::instanceBatches);
+			ImGui::Text("Instance Data Written: %.2f KB", static_cast<double>(Graphics::RendererManager::instanceUploadBytes) / 1024.0);
+			ImGui::Text("Instance Buffer Stalls: %llu", Graphics::RendererManager::instanceBufferStalls);
+			ImGui::Text("Texture Switches: %u", Graphics::RendererManager::textureSwitches);
+			ImGui::Text("Texture Atlas: %zu Textures, %d Pages", ResourceManager::GetInstance().GetTextureAtlas().GetTextureCount(), static_cast<int>(ResourceManager::GetInstance().GetTextureAtlas().GetPageCount()));
+			ImGui::Text("Scene View Culling: %u Visible, %u Culled", Graphics::RendererManager::sceneViewCulling.visible, Graphics::RendererManager::sceneViewCulling.culled);
+			ImGui::Text("Game View Culling: %u Visible, %u Culled", Graphics::RendererManager::gameViewCulling.visible, Graphics::RendererManager::gameViewCulling.culled);
+			ImGui::Text("Static Batches: %u Draws, %u Sprites", Graphics::RendererManager::staticBatchDraws, Graphics::RendererManager::staticBatchSprites);
+			ImGui::Text("Render Build Threads: "); ImGui::SameLine();
+			int buildThreads{ static_cast<int>(Graphics::RendererManager::buildThreads) };
+			ImGui::SliderInt("##RenderBuildThreads", &buildThreads, 1, static_cast<int>(ThreadPool::GetHardwareThreadCount()));
+			Graphics::RendererManager::buildThreads = static_cast<unsigned>(std::max(buildThreads, 1));
+			ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
+
+			if (ImGui::Button("Benchmark Event Dispatch"))
+			{
+				// results are written to the log
+				EventHandler::BenchmarkDispatch(64, 100000);
+			}
+			ImGui::Dummy(ImVec2(0.0f, 5.0f));//add space 
+
+			ImGui::SeparatorText("Queued Events");
+			ImGui::Text("Capacity: %zu", EventHandler::GetQueuedEventCapacity());
+			ImGui::Text("Posted: %llu", EventHandler::GetInstance().GetQueuedEventPostCount());
+			ImGui::Text("Dropped: %llu", EventHandler::GetInstance().GetQueuedEventOverflowCount());
+			ImGui::Text("Sent Last Frame: %zu", EventHandler::GetInstance().GetLastDispatchedCount());
+			ImGui::Text("Most Sent In A Frame: %zu", EventHandler::GetInstance().GetPeakDispatchedCount());
+
+			ImGui::SeparatorText("System Rates");
+			for (SystemID systemID{}; systemID < SystemID::GRAPHICS; ++systemID)
+			{
+				ImGui::Text("%s: %.1f Hz, over budget %u frames, %u steps deferred", SystemNames[systemID],
+					TimeManager::GetInstance().GetSystemUpdateRate(systemID),
+					TimeManager::GetInstance().GetSystemBudgetOverruns(systemID),
+					TimeManager::GetInstance().GetSystemDeferredSteps(systemID));
+			}
+
+			ImGui::SeparatorText("Profiler");
+			bool profilerEnabled{ Profiler::IsEnabled() };
+			if (ImGui::Checkbox("Record Scopes", &profilerEnabled))
+			{
+				Profiler::GetInstance().SetEnabled(profilerEnabled);
+			}
+			static bool freezeFlameChart{ false };
+			ImGui::SameLine();
+			ImGui::Checkbox("Freeze", &freezeFlameChart);
+			ImGui::SameLine();
+			ImGui::BeginDisabled(Profiler::GetInstance().IsCapturing());
+			if (ImGui::Button("Capture 120 Frames"))
+			{
+				// written as a Chrome trace once the frames are done, open it in chrome://tracing or Perfetto
+				Profiler::GetInstance().CaptureFrames(120, "ProfilerCapture.json");
+			}
+			ImGui::EndDisabled();
+
+			// Keep the scopes of the last finished frame unless the chart is frozen
+			static std::vector<ProfileEvent> flameEvents;
+			static std::uint64_t flameFrame{ 0 }, flameStart{ 0 }, flameEnd{ 1 };
+			if (!freezeFlameChart && Profiler::GetFrameIndex() > 0)
+			{
+				flameFrame = Profiler::GetFrameIndex() - 1;
+				flameStart = Profiler::GetInstance().GetFrameStart(flameFrame);
+				flameEnd = std::max(Profiler::GetInstance().GetFrameStart(flameFrame + 1), flameStart + 1);
+				flameEvents.clear();
+				Profiler::GetInstance().GetFrameEvents(flameFrame, flameEvents);
+			}
+			ImGui::Text("Frame %llu: %.3f ms, %zu scopes", flameFrame, static_cast<double>(flameEnd - flameStart) / 1000000.0, flameEvents.size());
+
+			// Lay the threads out one under the other, each with a row for its name and one per scope depth
+			float const flameWidth{ 400.f }, flameRowHeight{ ImGui::GetTextLineHeightWithSpacing() };
+			std::vector<std::pair<std::uint32_t, float>> threadRows;
+			float flameHeight{ 0.f };
+			for (ProfileEvent const& r_event : flameEvents)
+			{
+				if (threadRows.empty() || threadRows.back().first != r_event.thread)
+				{
+					threadRows.emplace_back(r_event.thread, flameHeight);
+					flameHeight += flameRowHeight;
+				}
+				flameHeight = std::max(flameHeight, threadRows.back().second + flameRowHeight * static_cast<float>(r_event.depth + 2));
+			}
+
+			ImDrawList* p_flameDrawList{ ImGui::GetWindowDrawList() };
+			ImVec2 const flameOrigin{ ImGui::GetCursorScreenPos() };
+			for (auto const& [thread, top] : threadRows)
+			{
+				p_flameDrawList->AddText(ImVec2(flameOrigin.x, flameOrigin.y + top), IM_COL32(255, 255, 255, 255), Profiler::GetInstance().GetThreadName(thread).c_str());
+			}
+
+			std::size_t threadRow{ 0 };
+			for (ProfileEvent const& r_event : flameEvents)
+			{
+				while (threadRows[threadRow].first != r_event.thread) { ++threadRow; }
+
+				float const startX{ static_cast<float>(r_event.start > flameStart ? r_event.start - flameStart : 0) / static_cast<float>(flameEnd - flameStart) };
+				float const endX{ static_cast<float>(r_event.end > flameStart ? r_event.end - flameStart : 0) / static_cast<float>(flameEnd - flameStart) };
+				ImVec2 const min{ flameOrigin.x + std::min(startX, 1.f) * flameWidth, flameOrigin.y + threadRows[threadRow].second + flameRowHeight * static_cast<float>(r_event.depth + 1) };
+				ImVec2 const max{ std::max(flameOrigin.x + std::min(endX, 1.f) * flameWidth, min.x + 1.f), min.y + flameRowHeight - 1.f };
+
+				// Same colour for the same scope every frame
+				float const hue{ static_cast<float>(std::hash<std::string_view>{}(r_event.name) % 360) / 360.f };
+				p_flameDrawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.7f));
+				p_flameDrawList->PushClipRect(min, max, true);
+				p_flameDrawList->AddText(ImVec2(min.x + 2.f, min.y), IM_COL32(255, 255, 255, 255), r_event.name);
+				p_flameDrawList->PopClipRect();
+
+				if (ImGui::IsMouseHoveringRect(min, max))
+				{
+					ImGui::SetTooltip("%s\n%.3f ms\n%u allocations", r_event.name, static_cast<double>(r_event.end - r_event.start) / 1000000.0, r_event.allocations);
+				}
+			}
+			ImGui::Dummy(ImVec2(flameWidth, flameHeight));
+
+			ImGui::SeparatorText("Allocations");
+			if (!AllocationTracker::HooksCompiled)
+			{
+				ImGui::TextDisabled("Generate the project with --track-allocations to count allocations");
+			}
+			bool trackAllocations{ AllocationTracker::IsEnabled() };
+			if (ImGui::Checkbox("Track Allocations", &trackAllocations))
+			{
+				AllocationTracker::SetEnabled(trackAllocations);
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Dump Allocation CSV"))
+			{
+				// the last AllocationTracker::FrameHistory frames, one row per frame and system
+				AllocationTracker::DumpCsv("AllocationReport.csv");
+			}
+			if (ImGui::BeginTable("##AllocationTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+			{
+				ImGui::TableSetupColumn("System");
+				ImGui::TableSetupColumn("Allocations");
+				ImGui::TableSetupColumn("Frees");
+				ImGui::TableSetupColumn("KB Allocated");
+				ImGui::TableHeadersRow();
+				for (unsigned category{ 0 }; category < AllocationTracker::CategoryCount; ++category)
+				{
+					AllocationStats const stats{ AllocationTracker::GetLastFrameStats(category) };
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn(); ImGui::Text("%s", AllocationTracker::GetCategoryName(category));
+					ImGui::TableNextColumn(); ImGui::Text("%llu", stats.allocations);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", stats.frees);
+					ImGui::TableNextColumn(); ImGui::Text("%.2f", static_cast<double>(stats.bytesAllocated) / 1024.0);
+				}
+				ImGui::EndTable();
+			}
+
+			ImGui::SeparatorText("Frame Arena");
+			ImGui::Text("Used Last Frame: %.2f / %.2f KB", static_cast<double>(MemoryManager::GetInstance().GetLastFrameArenaUsed()) / 1024.0,
+				static_cast<double>(MemoryManager::GetInstance().GetFrameArenaCapacity()) / 1024.0);
+			ImGui::Text("Peak: %.2f KB", static_cast<double>(MemoryManager::GetInstance().GetPeakFrameArenaUsed()) / 1024.0);
+			ImGui::Text("Overflowed To Heap Last Frame: %.2f KB", static_cast<double>(MemoryManager::GetInstance().GetLastFrameArenaOverflow()) / 1024.0);
+			ImGui::ProgressBar(static_cast<float>(MemoryManager::GetInstance().GetLastFrameArenaUsed()) / static_cast<float>(MemoryManager::GetInstance().GetFrameArenaCapacity()), ImVec2(400.f, 30.0f), NULL);
+
+			ImGui::SeparatorText("Pools");
+			static bool poisonPools{ true };
+			if (ImGui::Checkbox("Poison Pool Blocks", &poisonPools))
+			{
+				MemoryManager::GetInstance().SetPoolPoisoning(poisonPools);
+			}
+			if (ImGui::BeginTable("##PoolTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+			{
+				ImGui::TableSetupColumn("Pool");
+				ImGui::TableSetupColumn("Block Size");
+				ImGui::TableSetupColumn("In Use");
+				ImGui::TableSetupColumn("Peak");
+				ImGui::TableSetupColumn("Allocations");
+				ImGui::TableHeadersRow();
+				for (PoolStats const& r_stats : MemoryManager::GetInstance().GetPoolStats())
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn(); ImGui::Text("%s", r_stats.name.c_str());
+					ImGui::TableNextColumn(); ImGui::Text("%zu", r_stats.blockSize);
+					ImGui::TableNextColumn(); ImGui::Text("%zu / %zu", r_stats.blocksInUse, r_stats.capacity);
+					ImGui::TableNextColumn(); ImGui::Text("%zu", r_stats.peakBlocksInUse);
+					ImGui::TableNextColumn(); ImGui::Text("%llu", r_stats.allocations);
+				}
+				ImGui::EndTable();
+			}
 
 
 			ImGui::End(); //imgui close 
@@ -6045,6 +6239,27 @@ namespace PE {
 
 				ImGui::Text("Grid Active: "); ImGui::SameLine(); ImGui::Checkbox("##Checkers", &CollisionManager::gridActive);
 				ImGui::Dummy(ImVec2(0, 0.2f));
+
+				ImGui::Text("Narrowphase Threads: "); ImGui::SameLine();
+				int threads{ static_cast<int>(CollisionManager::narrowphaseThreads) };
+				ImGui::SliderInt("##NarrowphaseThreads", &threads, 1, static_cast<int>(ThreadPool::GetHardwareThreadCount()));
+				CollisionManager::narrowphaseThreads = static_cast<unsigned>(std::max(threads, 1));
+				ImGui::Dummy(ImVec2(0, 0.2f));
+
+				ImGui::Text("Body Sleeping: "); ImGui::SameLine(); ImGui::Checkbox("##BodySleeping", &PhysicsManager::sleepingActive);
+				ImGui::Text("Steps Before Sleep: "); ImGui::SameLine();
+				int stepsBeforeSleep{ static_cast<int>(PhysicsManager::stepsBeforeSleep) };
+				ImGui::InputInt("##StepsBeforeSleep", &stepsBeforeSleep);
+				PhysicsManager::stepsBeforeSleep = static_cast<unsigned>(std::max(stepsBeforeSleep, 1));
+				ImGui::Text("Awake Bodies: %u", GETPHYSICSMANAGER()->GetAwakeBodyCount());
+				ImGui::Text("Sleeping Bodies: %u", GETPHYSICSMANAGER()->GetSleepingBodyCount());
+				ImGui::Text("Render Interpolation: "); ImGui::SameLine(); ImGui::Checkbox("##RenderInterpolation", &PhysicsManager::interpolationActive);
+				if (ImGui::Button("Benchmark Integration"))
+				{
+					// results are written to the log
+					GETPHYSICSMANAGER()->BenchmarkIntegration(10000, 100);
+				}
+				ImGui::Dummy(ImVec2(0, 0.2f));
 				ImGui::Separator();
 
 
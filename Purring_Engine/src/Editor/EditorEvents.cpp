@@ -107,6 +107,7 @@ namespace PE {
 						if (EntityManager::GetInstance().Get<EntityDescriptor>(m_currentSelectedObject).parent)
 						{
 							EntityManager::GetInstance().Get<EntityDescriptor>(EntityManager::GetInstance().Get<EntityDescriptor>(m_currentSelectedObject).parent.value()).children.erase(m_currentSelectedObject);
+							Hierarchy::GetInstance().MarkStructureDirty();
 						}
 
 						UndoStack::GetInstance().AddChange(new DeleteObjectUndo(m_currentSelectedObject));
@@ -16,12 +16,49 @@
 *************************************************************************************/
 #include "prpch.h"
 #include "UndoStack.h"
+#include "Memory/PoolAllocator.h"
 
 namespace PE
 {
+	namespace
+	{
+		// big enough for every kind of change, anything larger falls back to the heap
+		constexpr std::size_t undoRecordSize{ std::max({ sizeof(ValueChange<float>), sizeof(ValueChange2<float>),
+			sizeof(DeleteObjectUndo), sizeof(CreateObjectUndo), sizeof(GuizmoUndo) }) };
+
+		/*!***********************************************************************************
+		 \brief		Get the pool the undo records are allocated from
+		 \return		PoolAllocator& the pool
+		*************************************************************************************/
+		PoolAllocator& GetUndoRecordPool()
+		{
+			// the undo and redo stacks never hold more than about 20 changes each
+			static PoolAllocator undoRecordPool{ "Undo Records", undoRecordSize, alignof(std::max_align_t), 32 };
+			return undoRecordPool;
+		}
+	}
+
+	void* EditorChanges::operator new(std::size_t size)
+	{
+		if (size > undoRecordSize)
+			return ::operator new(size);
+		return GetUndoRecordPool().Allocate();
+	}
+
+	void EditorChanges::operator delete(void* p_memory, std::size_t size)
+	{
+		if (size > undoRecordSize)
+			::operator delete(p_memory);
+		else
+			GetUndoRecordPool().Free(p_memory);
+	}
+
 	UndoStack::UndoStack()
 	{
 		m_undoCount = 0;
+
+		// create the pool first so it outlives the changes the stack deletes when it is destroyed
+		GetUndoRecordPool();
 	}
 	void UndoStack::AddChange(EditorChanges* p_change)
 	{
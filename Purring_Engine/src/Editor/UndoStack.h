@@ -49,6 +49,18 @@ namespace PE
 		 \brief     virtual destructor to ensure proper destruction of derived classes
 		*************************************************************************************/
 		virtual ~EditorChanges() {}
+		/*!***********************************************************************************
+		 \brief     Allocates changes from the pool of undo records instead of the heap
+		 \param [In]	size of the change being created
+		 \return	void* memory for the change
+		*************************************************************************************/
+		static void* operator new(std::size_t size);
+		/*!***********************************************************************************
+		 \brief     Returns the memory of a change to the pool of undo records
+		 \param [In]	p_memory memory of the change
+		 \param [In]	size of the change being destroyed
+		*************************************************************************************/
+		static void operator delete(void* p_memory, std::size_t size);
 	};
 
 	class UndoStack : public Singleton<UndoStack>
@@ -21,6 +21,10 @@
 --------------------------------------------------------------------------------------------------------------------- */
 #include "CoreApplication.h"
 #include <crtdbg.h>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <string>
 
 
 extern PE::CoreApplication* PE::CreateApplication();
@@ -33,10 +37,43 @@ int WinMain(int argc, char** argv)
 {
 	argc; argv;
 
+#ifndef PE_TRACK_ALLOCATIONS
+	// the tracked operator new takes its blocks straight from malloc, so the debug heap would not see them
 	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif // !PE_TRACK_ALLOCATIONS
+#ifndef GAMERELEASE
+	// --render-benchmark [frames] [trace file] draws every scene without submitting any draws,
+	// and without GLFW, a window or a context as the resources are only given handles
+	bool const renderBenchmark{ argc > 1 && std::string{ argv[1] } == "--render-benchmark" };
+	PE::CoreApplication::SetHeadless(renderBenchmark);
+#endif // !GAMERELEASE
 	auto app = PE::CreateApplication();
 	app->Initialize();
+#ifndef GAMERELEASE
+	if (renderBenchmark)
+	{
+		// fall back to 120 frames if the count is missing, not a positive number or too large
+		unsigned frameCount{ 120U };
+		if (argc > 2)
+		{
+			char* p_end{ nullptr };
+			errno = 0;
+			unsigned long const parsed{ std::strtoul(argv[2], &p_end, 10) };
+			if (p_end != argv[2] && *p_end == '\0' && errno != ERANGE && argv[2][0] != '-'
+				&& parsed > 0 && parsed <= std::numeric_limits<unsigned>::max())
+			{
+				frameCount = static_cast<unsigned>(parsed);
+			}
+		}
+		app->RunRenderBenchmark(frameCount, argc > 3 ? argv[3] : "");
+	}
+	else
+	{
+		app->Run();
+	}
+#else
 	app->Run();
+#endif // !GAMERELEASE
 	app->DestroySystems();
 	delete app;
 
@@ -32,6 +32,13 @@ namespace PE {
 		OnTriggerExit
 	};
 
+	// counted from the last event type, update it when adding event types
+	template <>
+	struct EventTypeCount<CollisionEvents>
+	{
+		static constexpr std::size_t value{ static_cast<std::size_t>(CollisionEvents::OnTriggerExit) + 1 };
+	};
+
 	class OnCollisionEnterEvent : public Event<CollisionEvents>
 	{
 		// ----- Public variables ----- // 
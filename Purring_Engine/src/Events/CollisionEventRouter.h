@@ -0,0 +1,223 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     CollisionEventRouter.h
+ \date     22-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    Declares and defines the CollisionEventRouter class, which delivers the
+		   collision events raised in a physics step only to the listeners subscribed
+		   to the entities or collision layers involved.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#pragma once
+
+/*                                                                                                          includes
+--------------------------------------------------------------------------------------------------------------------- */
+#include <array>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+#include "CollisionEvent.h"
+#include "EventDelegate.h"
+#include "Layers/CollisionLayer.h"
+
+namespace PE
+{
+	/*!***********************************************************************************
+	 \brief     Collision event as stored in the per step buffer and delivered to routed
+				listeners. Entity1 is always the smaller ID of the pair.
+	*************************************************************************************/
+	struct CollisionEventData
+	{
+		CollisionEvents type;
+		EntityID Entity1, Entity2;
+		unsigned Layer1, Layer2; // collision layers of the colliders of Entity1 and Entity2
+
+		/*!***********************************************************************************
+		 \brief     Gets the event type of the event.
+		 \return    CollisionEvents - type of the event
+		*************************************************************************************/
+		inline CollisionEvents GetType() const { return type; }
+
+		/*!***********************************************************************************
+		 \brief     Checks if the event is a stay event, which is only delivered to listeners
+					that asked for them.
+		 \return    bool - true if the event is OnCollisionStay or OnTriggerStay
+		*************************************************************************************/
+		inline bool IsStay() const { return type == CollisionEvents::OnCollisionStay || type == CollisionEvents::OnTriggerStay; }
+	};
+
+	/*!***********************************************************************************
+	 \class     CollisionEventRouter
+	 \brief     Delivers a step's worth of collision events in one go, each only to the
+				listeners of the entities and collision layers involved in it. Listeners
+				can be added and removed while the events are being delivered.
+	*************************************************************************************/
+	class CollisionEventRouter
+	{
+		// ----- Definition ----- //
+		using Func = EventDelegate<const CollisionEventData&>;
+
+		// ----- Public methods ----- //
+	public:
+		/*!***********************************************************************************
+		 \brief     Adds a listener for the collision events involving an entity.
+		 \param[in] EntityID id - entity to listen to
+		 \param[in] const Func& func - callback to invoke with each event involving the entity
+		 \param[in] bool receiveStay - whether stay events should be delivered as well
+		 \return	int - handle to remove the listener with
+		*************************************************************************************/
+		int AddEntityListener(EntityID id, const Func& func, bool receiveStay = false)
+		{
+			int handle = m_NextListenerID++;
+			m_Listeners[handle] = Listener{ func, id, 0, false, receiveStay, false };
+			m_EntityListeners[id].push_back(handle);
+			return handle;
+		}
+
+		/*!***********************************************************************************
+		 \brief     Adds a listener for the collision events involving a collider on a
+					collision layer.
+		 \param[in] unsigned layerIndex - collision layer to listen to
+		 \param[in] const Func& func - callback to invoke with each event involving the layer
+		 \param[in] bool receiveStay - whether stay events should be delivered as well
+		 \return	int - handle to remove the listener with, -1 if the layer does not exist
+		*************************************************************************************/
+		int AddLayerListener(unsigned layerIndex, const Func& func, bool receiveStay = false)
+		{
+			if (layerIndex >= TOTAL_COLLISION_LAYERS)
+				return -1;
+
+			int handle = m_NextListenerID++;
+			m_Listeners[handle] = Listener{ func, 0, layerIndex, true, receiveStay, false };
+			m_LayerListeners[layerIndex].push_back(handle);
+			return handle;
+		}
+
+		/*!***********************************************************************************
+		 \brief     Removes a listener. If events are being delivered, the listener stops
+					receiving them immediately and is erased once delivery is done.
+		 \param[in] int handle - handle returned when the listener was added
+		*************************************************************************************/
+		void RemoveListener(int handle)
+		{
+			auto it = m_Listeners.find(handle);
+			if (it == m_Listeners.end() || it->second.removed)
+				return;
+
+			it->second.removed = true;
+			if (m_Dispatching)
+				m_PendingRemovals.push_back(handle);
+			else
+				EraseListener(handle);
+		}
+
+		/*!***********************************************************************************
+		 \brief     Delivers each event to the listeners of both entities and both collision
+					layers involved, in the order the events are stored.
+		 \param[in] const CollisionEventData* p_events - events raised this step
+		 \param[in] size_t count - number of events
+		*************************************************************************************/
+		void Dispatch(const CollisionEventData* p_events, size_t count)
+		{
+			if (m_Listeners.empty())
+				return;
+
+			m_Dispatching = true;
+			for (size_t i{ 0 }; i < count; ++i)
+			{
+				const CollisionEventData& r_event = p_events[i];
+
+				auto it = m_EntityListeners.find(r_event.Entity1);
+				if (it != m_EntityListeners.end())
+					Deliver(it->second, r_event);
+
+				it = m_EntityListeners.find(r_event.Entity2);
+				if (it != m_EntityListeners.end())
+					Deliver(it->second, r_event);
+
+				if (r_event.Layer1 < TOTAL_COLLISION_LAYERS)
+					Deliver(m_LayerListeners[r_event.Layer1], r_event);
+				if (r_event.Layer2 != r_event.Layer1 && r_event.Layer2 < TOTAL_COLLISION_LAYERS)
+					Deliver(m_LayerListeners[r_event.Layer2], r_event);
+			}
+			m_Dispatching = false;
+
+			for (int handle : m_PendingRemovals)
+				EraseListener(handle);
+			m_PendingRemovals.clear();
+		}
+
+		// ----- Private methods ----- //
+	private:
+		/*!***********************************************************************************
+		 \brief     Calls every listener in r_handles that is still active and wants the event.
+					Indexes are used as listeners added by a callback are appended to r_handles.
+		 \param[in] const std::vector<int>& r_handles - listeners of an entity or layer
+		 \param[in] const CollisionEventData& r_event - event to deliver
+		*************************************************************************************/
+		void Deliver(const std::vector<int>& r_handles, const CollisionEventData& r_event)
+		{
+			for (size_t i{ 0 }; i < r_handles.size(); ++i)
+			{
+				const Listener& r_listener = m_Listeners.at(r_handles[i]);
+				if (r_listener.removed || (r_event.IsStay() && !r_listener.receiveStay))
+					continue;
+				r_listener.func(r_event);
+			}
+		}
+
+		/*!***********************************************************************************
+		 \brief     Erases a listener from the lookup of its entity or layer and from the
+					listener map. Must not be called while events are being delivered.
+		 \param[in] int handle - handle of the listener to erase
+		*************************************************************************************/
+		void EraseListener(int handle)
+		{
+			auto it = m_Listeners.find(handle);
+			if (it == m_Listeners.end())
+				return;
+
+			if (it->second.isLayerListener)
+			{
+				auto& r_handles = m_LayerListeners[it->second.layer];
+				r_handles.erase(std::remove(r_handles.begin(), r_handles.end(), handle), r_handles.end());
+			}
+			else
+			{
+				auto entityIt = m_EntityListeners.find(it->second.entity);
+				if (entityIt != m_EntityListeners.end())
+				{
+					entityIt->second.erase(std::remove(entityIt->second.begin(), entityIt->second.end(), handle), entityIt->second.end());
+					if (entityIt->second.empty())
+						m_EntityListeners.erase(entityIt);
+				}
+			}
+			m_Listeners.erase(it);
+		}
+
+		// ----- Private variables ----- //
+	private:
+		struct Listener
+		{
+			Func func;
+			EntityID entity;
+			unsigned layer;
+			bool isLayerListener;
+			bool receiveStay;
+			bool removed;
+		};
+
+		std::unordered_map<int, Listener> m_Listeners; // every listener by handle
+		std::unordered_map<EntityID, std::vector<int>> m_EntityListeners; // handles of the listeners of each entity
+		std::array<std::vector<int>, TOTAL_COLLISION_LAYERS> m_LayerListeners; // handles of the listeners of each layer
+		std::vector<int> m_PendingRemovals; // listeners removed while events were being delivered
+		int m_NextListenerID = 0;
+		bool m_Dispatching = false;
+	};
+}
@@ -15,16 +15,27 @@
 *************************************************************************************/
 
 #pragma once
-#include <map>
-#include <functional>
+#include <array>
+#include <string>
+#include <string_view>
 #include <vector>
 #include <algorithm>
+#include "EventDelegate.h"
 /*                                                                                                          includes
 --------------------------------------------------------------------------------------------------------------------- */
 
 
 namespace PE {
 
+	/*!***********************************************************************************
+	 \brief				Number of event types in an event type enum, specialised next to each
+						enum so that a dispatcher can keep its listeners in a fixed array
+						indexed by the event type.
+	 \tparam T          Type of Event
+	*************************************************************************************/
+	template <typename T>
+	struct EventTypeCount;
+
 	/*!***********************************************************************************
 	 \brief				Base event class for the other events to inherhit
 	 \tparam T          Type of Event
@@ -41,9 +52,9 @@ namespace PE {
 		/*!***********************************************************************************
 		\brief			Implicit conversion to a std::string, used for output streams.
 		\param [in]		T type type of the event
-		\param [in]		std::string name of the event.
+		\param [in]		std::string_view name of the event, must refer to a string literal
 		*************************************************************************************/
-		Event(T type, const std::string& name = "") : m_Type(type), m_Name(name) {}
+		Event(T type, std::string_view name = "") : m_Type(type), m_Name(name) {}
 		virtual ~Event() {}
 
 		// ----- Public methods ----- // 
@@ -52,7 +63,7 @@ namespace PE {
 		 \brief     Prints out data from the event
 		 \return    std::string - Returns the data of the event as a string
 		*************************************************************************************/
-		virtual std::string ToString() const { return GetName(); }
+		virtual std::string ToString() const { return std::string{ GetName() }; }
 
 		/*!***********************************************************************************
 		 \brief     Checks if the event has been handled.
@@ -70,27 +81,32 @@ namespace PE {
 
 		/*!***********************************************************************************
 		 \brief     Gets the name of the event.
-		 \return    const std::string& - Returns the name of the event.
+		 \return    std::string_view - Returns the name of the event.
 		*************************************************************************************/
-		inline const std::string& GetName() const { return m_Name; }
+		inline std::string_view GetName() const { return m_Name; }
 
 		// ----- Protected variables ----- // 
 	protected:
 		T m_Type;
-		std::string m_Name;
+		std::string_view m_Name;
 		bool m_Handled = false;
 	};
 
 	/*!***********************************************************************************
 	 \class     EventDispatcher<T>
 	 \brief     A templated class responsible for dispatching events to registered listeners.
-	 \details   Supports the addition of listeners and the broadcasting of events.
+	 \details   Supports the addition of listeners and the broadcasting of events. Listeners
+				are kept in a flat array per event type, indexed by the event type, and
+				are called through delegates so neither adding nor sending allocates once
+				the arrays have grown. Listeners can be added and removed while an event
+				is being sent.
 	*************************************************************************************/
 	template<typename T>
 	class EventDispatcher
 	{
 		// ----- Definition ----- // 
-		using Func = std::function<void(const Event<T>&)>;
+		using Func = EventDelegate<const Event<T>&>;
+		static constexpr std::size_t TypeCount{ EventTypeCount<T>::value };
 		// ----- Public methods ----- // 
 	public:
 		/*!***********************************************************************************
@@ -101,57 +117,103 @@ namespace PE {
 		*************************************************************************************/
 		int AddListener(T type, const Func& func)
 		{
-			m_Listerners[type].push_back(std::make_pair(m_NextListenerID,func));
 			int handle = m_NextListenerID++;
-			m_ListenerHandles[handle] = { type, *(long*)(char*)&(func) };
+			m_Listeners[TypeIndex(type)].push_back(Listener{ handle, func });
 			return handle;
 		}
 
 		/*!***********************************************************************************
-		 \brief     remove a listener for a specific event type.
-		 \param[in] int handle the handle to remove from the map
+		 \brief     remove a listener for a specific event type. If an event is being sent,
+					the listener is not called anymore and is erased once sending is done.
+		 \param[in] int handle the handle to remove
 		*************************************************************************************/
 		void RemoveListener(int handle)
 		{
-			auto it = m_ListenerHandles.find(handle);
-			if (it != m_ListenerHandles.end())
+			for (auto& listeners : m_Listeners)
 			{
-				const auto& listenerInfo = it->second;
-				auto& listeners = m_Listerners[listenerInfo.first];
-				//trying to erase a specific element in a vector by iterator
-				listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [=](auto& pr)
-					{
-						return (pr.first == handle && *(long*)(char*)&(pr.second) == listenerInfo.second);
-					}
-				), listeners.end());
-				m_ListenerHandles.erase(it);
+				auto it = std::find_if(listeners.begin(), listeners.end(), [=](const Listener& r_listener) { return r_listener.handle == handle; });
+				if (it == listeners.end())
+					continue;
+
+				if (m_DispatchDepth)
+				{
+					it->func = Func{};
+					m_HasPendingRemovals = true;
+				}
+				else
+				{
+					listeners.erase(it);
+				}
+				return;
 			}
 		}
 
+		/*!***********************************************************************************
+		 \brief     Checks if any listener is subscribed to a specific event type, so that
+					events nobody listens to do not have to be built.
+		 \param[in] T type - The type of event to check.
+		 \return	bool - true if there is at least one listener for the type
+		*************************************************************************************/
+		bool HasListeners(T type) const
+		{
+			const auto& listeners = m_Listeners[TypeIndex(type)];
+			return std::any_of(listeners.begin(), listeners.end(), [](const Listener& r_listener) { return static_cast<bool>(r_listener.func); });
+		}
 
 		// To be defined within engine to makesure only accessible through the engine
 		/*!***********************************************************************************
-		 \brief     Dispatches an event to all registered listeners of its type.
+		 \brief     Dispatches an event to all registered listeners of its type. Listeners
+					added while the event is being sent only receive the next event.
 		 \param[in] Event<T>& event - The event object to be dispatched.
 		*************************************************************************************/
 		void SendEvent(const Event<T>& event)
 		{
-			//check if there is a listerner for this event
-			if (m_Listerners.find(event.GetType()) == m_Listerners.end())
+			auto& listeners = m_Listeners[TypeIndex(event.GetType())];
+			const std::size_t count = listeners.size();
+			if (!count)
 				return;
 
+			++m_DispatchDepth;
 			//loop through all listerners if the event is not handled we process it.
-			for (auto& listener : m_Listerners.at(event.GetType()))
+			for (std::size_t i{ 0 }; i < count; ++i)
 			{
-				if(listener.second)
-				if (!event.Handled()) listener.second(event);
+				// copied as a listener may add listeners and grow the array
+				const Func func = listeners[i].func;
+				if (func && !event.Handled()) func(event);
+			}
+			--m_DispatchDepth;
+
+			if (!m_DispatchDepth && m_HasPendingRemovals)
+			{
+				for (auto& r_listeners : m_Listeners)
+				{
+					r_listeners.erase(std::remove_if(r_listeners.begin(), r_listeners.end(), [](const Listener& r_listener) { return !r_listener.func; }), r_listeners.end());
+				}
+				m_HasPendingRemovals = false;
 			}
 		}
+
+		// ----- Private methods ----- // 
+	private:
+		/*!***********************************************************************************
+		 \brief     Gets the index of the listener array of an event type.
+		 \param[in] T type - The type of event.
+		 \return	std::size_t - index of the array in m_Listeners
+		*************************************************************************************/
+		static constexpr std::size_t TypeIndex(T type) { return static_cast<std::size_t>(type); }
+
 		// ----- Private variables ----- // 
 	private:
-		std::map<T, std::vector<std::pair<int,Func>>> m_Listerners; // subscribed events
+		struct Listener
+		{
+			int handle;
+			Func func; // empty once removed while an event is being sent
+		};
+
+		std::array<std::vector<Listener>, TypeCount> m_Listeners; // subscribed listeners of each event type
 		int m_NextListenerID = 0;
-		std::map<int, std::pair<T, long int>> m_ListenerHandles;
+		unsigned m_DispatchDepth = 0; // number of events currently being sent, as listeners may send events
+		bool m_HasPendingRemovals = false;
 	};
 
 	/*!***********************************************************************************
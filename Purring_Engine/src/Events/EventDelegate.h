@@ -0,0 +1,135 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     EventDelegate.h
+ \date     23-03-2024
+
+ \author:              agent
+ \par      email:      agent@local
+
+ \brief    Declares and defines the EventDelegate class, a non-owning callback made of an
+		   object pointer and a function pointer, used by the event dispatchers instead
+		   of std::function so that adding a listener never allocates.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#pragma once
+
+/*                                                                                                          includes
+--------------------------------------------------------------------------------------------------------------------- */
+#include <cstddef>
+
+namespace PE
+{
+	/*!***********************************************************************************
+	 \class     EventDelegate<Arg>
+	 \brief     Callback taking one argument of type Arg. Only stores the object to call and
+				a stub that calls the bound function on it, so it is two pointers in size,
+				trivially copyable and never owns the object. The object must outlive any
+				dispatcher the delegate is added to, or be removed from it first.
+	 \tparam    Arg - Argument type of the callback
+	*************************************************************************************/
+	template <typename Arg>
+	class EventDelegate
+	{
+		// ----- Definition ----- // 
+		using Stub = void(*)(void*, Arg);
+
+		// ----- Public Constructors ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief     Constructs an empty delegate
+		*************************************************************************************/
+		constexpr EventDelegate() = default;
+
+		// ----- Public methods ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief     Creates a delegate that calls a member function on an object.
+		 \tparam    Method - Member function to call, e.g. &CatScript::OnMouseClick
+		 \tparam    C - Class of the object
+		 \param[in] C* p_object - Object to call the member function on
+		 \return    EventDelegate - Delegate bound to the object
+		*************************************************************************************/
+		template <auto Method, typename C>
+		static EventDelegate FromMethod(C* p_object)
+		{
+			EventDelegate delegate;
+			delegate.p_object = const_cast<void*>(static_cast<const void*>(p_object));
+			delegate.p_stub = [](void* p_obj, Arg arg) { (static_cast<C*>(p_obj)->*Method)(arg); };
+			return delegate;
+		}
+
+		/*!***********************************************************************************
+		 \brief     Creates a delegate that calls a free or static function.
+		 \tparam    Function - Function to call
+		 \return    EventDelegate - Delegate calling the function
+		*************************************************************************************/
+		template <auto Function>
+		static EventDelegate FromFunction()
+		{
+			EventDelegate delegate;
+			delegate.p_stub = [](void*, Arg arg) { Function(arg); };
+			return delegate;
+		}
+
+		/*!***********************************************************************************
+		 \brief     Calls the bound function. The delegate must not be empty.
+		 \param[in] Arg arg - Argument to pass on
+		*************************************************************************************/
+		inline void operator()(Arg arg) const { p_stub(p_object, arg); }
+
+		/*!***********************************************************************************
+		 \brief     Checks if a function is bound to the delegate.
+		 \return    bool - true if the delegate can be called
+		*************************************************************************************/
+		inline explicit operator bool() const { return p_stub != nullptr; }
+
+		/*!***********************************************************************************
+		 \brief     Checks if two delegates call the same function on the same object.
+		 \param[in] const EventDelegate& r_rhs - Delegate to compare with
+		 \return    bool - true if both delegates are bound to the same call
+		*************************************************************************************/
+		inline bool operator==(const EventDelegate& r_rhs) const { return p_object == r_rhs.p_object && p_stub == r_rhs.p_stub; }
+
+		// ----- Private variables ----- // 
+	private:
+		void* p_object{ nullptr }; // object the function is called on, null for free functions
+		Stub p_stub{ nullptr }; // calls the bound function on p_object
+	};
+
+	/*!***********************************************************************************
+	 \brief     Gets the class and argument type of a listener member function.
+	 \tparam    M - Type of the member function pointer
+	*************************************************************************************/
+	template <typename M>
+	struct EventMethodTraits;
+
+	template <typename C, typename A>
+	struct EventMethodTraits<void (C::*)(A)>
+	{
+		using Class = C;
+		using Argument = A;
+	};
+
+	template <typename C, typename A>
+	struct EventMethodTraits<void (C::*)(A) const>
+	{
+		using Class = const C;
+		using Argument = A;
+	};
+
+	/*!***********************************************************************************
+	 \brief     Creates a delegate that calls a member function on an object, deducing the
+				argument type from the member function.
+	 \tparam    Method - Member function to call, e.g. &CatScript::OnMouseClick
+	 \param[in] p_object - Object to call the member function on
+	 \return    EventDelegate - Delegate bound to the object
+	*************************************************************************************/
+	template <auto Method>
+	inline EventDelegate<typename EventMethodTraits<decltype(Method)>::Argument> MakeEventDelegate(typename EventMethodTraits<decltype(Method)>::Class* p_object)
+	{
+		return EventDelegate<typename EventMethodTraits<decltype(Method)>::Argument>::template FromMethod<Method>(p_object);
+	}
+}
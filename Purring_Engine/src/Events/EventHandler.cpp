@@ -0,0 +1,104 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     EventHandler.cpp
+ \date     23-03-2024
+
+ \author:              agent
+ \par      email:      agent@local
+
+ \brief    Contains the definitions of the EventHandler's queued event dispatch and
+		   dispatch benchmark.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "EventHandler.h"
+#include "Logging/Logger.h"
+
+extern Logger engine_logger;
+
+namespace PE
+{
+	void EventHandler::DispatchQueuedEvents()
+	{
+		m_LastDispatchedCount = m_QueuedEvents.Drain([this](const QueuedEvent& r_event)
+			{
+				std::visit([this](const auto& r_queuedEvent) { SendQueuedEvent(r_queuedEvent); }, r_event);
+			});
+		m_PeakDispatchedCount = std::max(m_PeakDispatchedCount, m_LastDispatchedCount);
+	}
+
+#ifndef GAMERELEASE
+	namespace
+	{
+		/*!***********************************************************************************
+		 \brief     Listener used by the benchmark, counts the events it receives.
+		*************************************************************************************/
+		struct BenchmarkListener
+		{
+			unsigned long long count{ 0 };
+
+			/*!***********************************************************************************
+			 \brief     Counts a received event.
+			 \param[in] const Event<KeyEvents>& r_event - received event
+			*************************************************************************************/
+			void OnKeyEvent(const Event<KeyEvents>& r_event) { count += static_cast<unsigned long long>(r_event.GetType() == KeyEvents::KeyTriggered); }
+		};
+	}
+
+	void EventHandler::BenchmarkDispatch(unsigned listenerCount, unsigned eventCount)
+	{
+		using LegacyFunc = std::function<void(const Event<KeyEvents>&)>;
+
+		std::vector<BenchmarkListener> listeners(listenerCount);
+		std::vector<BenchmarkListener> legacyListeners(listenerCount);
+
+		EventDispatcher<KeyEvents> dispatcher;
+		std::map<KeyEvents, std::vector<std::pair<int, LegacyFunc>>> legacyDispatcher;
+		for (unsigned i{ 0 }; i < listenerCount; ++i)
+		{
+			dispatcher.AddListener(KeyEvents::KeyTriggered, MakeEventDelegate<&BenchmarkListener::OnKeyEvent>(&listeners[i]));
+			legacyDispatcher[KeyEvents::KeyTriggered].emplace_back(static_cast<int>(i), std::bind(&BenchmarkListener::OnKeyEvent, &legacyListeners[i], std::placeholders::_1));
+		}
+
+		KeyTriggeredEvent event;
+
+		auto const start{ std::chrono::high_resolution_clock::now() };
+		for (unsigned i{ 0 }; i < eventCount; ++i)
+		{
+			dispatcher.SendEvent(event);
+		}
+		auto const end{ std::chrono::high_resolution_clock::now() };
+
+		// lookup and call as done by the previous EventDispatcher::SendEvent
+		auto const legacyStart{ std::chrono::high_resolution_clock::now() };
+		for (unsigned i{ 0 }; i < eventCount; ++i)
+		{
+			if (legacyDispatcher.find(event.GetType()) == legacyDispatcher.end())
+				continue;
+			for (auto& listener : legacyDispatcher.at(event.GetType()))
+			{
+				if (listener.second)
+					if (!event.Handled()) listener.second(event);
+			}
+		}
+		auto const legacyEnd{ std::chrono::high_resolution_clock::now() };
+
+		bool isIdentical{ true };
+		for (unsigned i{ 0 }; i < listenerCount && isIdentical; ++i)
+		{
+			isIdentical = listeners[i].count == eventCount && legacyListeners[i].count == eventCount;
+		}
+
+		double const callCount{ std::max(static_cast<double>(listenerCount) * static_cast<double>(eventCount), 1.0) };
+		std::stringstream ss;
+		ss << "Event dispatch benchmark (" << listenerCount << " listeners, " << eventCount << " events): "
+			<< std::chrono::duration<double, std::nano>(end - start).count() / callCount << "ns per listener, std::map and std::function "
+			<< std::chrono::duration<double, std::nano>(legacyEnd - legacyStart).count() / callCount << "ns per listener, calls "
+			<< (isIdentical ? "identical" : "DIFFERENT");
+		engine_logger.AddLog(false, ss.str(), __FUNCTION__);
+	}
+#endif
+}
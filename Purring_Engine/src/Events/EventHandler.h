@@ -23,9 +23,19 @@
 #include "WindowEvent.h"
 #include "Singleton.h"
 #include "CollisionEvent.h"
+#include "CollisionEventRouter.h"
+#include "Threading/MPSCQueue.h"
+#include <variant>
 
 namespace PE
 {
+	// Any event that can be posted from another thread to be sent on the main thread
+	using QueuedEvent = std::variant<std::monostate,
+		WindowResizeEvent, WindowCloseEvent, WindowFocusEvent, WindowLostFocusEvent, WindowMovedEvent,
+		MouseMovedEvent, MouseButtonPressedEvent, MouseButtonHoldEvent, MouseButtonReleaseEvent, MouseScrolledEvent,
+		KeyTriggeredEvent, KeyPressedEvent, KeyReleaseEvent,
+		OnCollisionEnterEvent, OnCollisionStayEvent, OnCollisionExitEvent, OnTriggerEnterEvent, OnTriggerStayEvent, OnTriggerExitEvent>;
+
 	class EventHandler : public Singleton <EventHandler>
 	{
 		// ----- Public variables ----- // 
@@ -38,45 +48,128 @@ namespace PE
 
 		EventDispatcher<CollisionEvents> CollisionEventDispatcher;
 
+		CollisionEventRouter CollisionRouter; // delivers collision events per entity or collision layer
+
 		// ----- Constructors ----- // 
 	public:
 		/*!***********************************************************************************
 		 \brief     default constructor for event handler
 		*************************************************************************************/
-		EventHandler() : WindowEventDispatcher(), MouseEventDispatcher(), KeyEventDispatcher() , CollisionEventDispatcher() {}
+		EventHandler() : WindowEventDispatcher(), MouseEventDispatcher(), KeyEventDispatcher() , CollisionEventDispatcher(), CollisionRouter() {}
+
+		// ----- Public methods ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief     Queues an event to be sent by DispatchQueuedEvents on the main thread.
+					Safe to call from any thread and never blocks.
+		 \param[in] const QueuedEvent& r_event - event to send
+		 \return	bool - false if the queue was full and the event was dropped
+		*************************************************************************************/
+		bool PostEvent(const QueuedEvent& r_event) { return m_QueuedEvents.Push(r_event); }
+
+		/*!***********************************************************************************
+		 \brief     Sends the events that were posted before the call, through the same
+					dispatchers as events sent directly. Events posted by one thread are
+					sent in the order they were posted. Events posted while dispatching are
+					sent on the next call. Must be called on the main thread.
+		*************************************************************************************/
+		void DispatchQueuedEvents();
+
+		/*!***********************************************************************************
+		 \brief     Gets the number of events that can wait in the queue.
+		 \return	std::size_t - capacity of the queue
+		*************************************************************************************/
+		static constexpr std::size_t GetQueuedEventCapacity() { return QueuedEventCapacity; }
+
+		/*!***********************************************************************************
+		 \brief     Gets the number of events dropped because the queue was full.
+		 \return	unsigned long long - number of dropped events
+		*************************************************************************************/
+		unsigned long long GetQueuedEventOverflowCount() const { return m_QueuedEvents.GetOverflowCount(); }
 
+		/*!***********************************************************************************
+		 \brief     Gets the number of events posted since the start of the application.
+		 \return	unsigned long long - number of posted events
+		*************************************************************************************/
+		unsigned long long GetQueuedEventPostCount() const { return m_QueuedEvents.GetPushCount(); }
+
+		/*!***********************************************************************************
+		 \brief     Gets the number of events sent by the last DispatchQueuedEvents call.
+		 \return	std::size_t - number of events sent
+		*************************************************************************************/
+		std::size_t GetLastDispatchedCount() const { return m_LastDispatchedCount; }
+
+		/*!***********************************************************************************
+		 \brief     Gets the highest number of events sent by a DispatchQueuedEvents call.
+		 \return	std::size_t - highest number of events sent in one call
+		*************************************************************************************/
+		std::size_t GetPeakDispatchedCount() const { return m_PeakDispatchedCount; }
+
+#ifndef GAMERELEASE
+		/*!***********************************************************************************
+		 \brief     Sends eventCount key events to listenerCount listeners, once through an
+					EventDispatcher and once through the std::map and std::function based
+					dispatcher it replaced, and logs the time taken per listener call of each.
+		 \param[in] unsigned listenerCount - number of listeners to add
+		 \param[in] unsigned eventCount - number of events to send
+		*************************************************************************************/
+		static void BenchmarkDispatch(unsigned listenerCount, unsigned eventCount);
+#endif
+
+		// ----- Private methods ----- // 
+	private:
+		/*!***********************************************************************************
+		 \brief     Sends a dequeued event through the dispatcher of its type.
+		 \param[in] const Event<T>& r_event - event to send
+		*************************************************************************************/
+		void SendQueuedEvent(const Event<WindowEvents>& r_event) { WindowEventDispatcher.SendEvent(r_event); }
+		void SendQueuedEvent(const Event<MouseEvents>& r_event) { MouseEventDispatcher.SendEvent(r_event); }
+		void SendQueuedEvent(const Event<KeyEvents>& r_event) { KeyEventDispatcher.SendEvent(r_event); }
+		void SendQueuedEvent(const Event<CollisionEvents>& r_event) { CollisionEventDispatcher.SendEvent(r_event); }
+		void SendQueuedEvent(std::monostate) {}
+
+		// ----- Private variables ----- // 
+	private:
+		static constexpr std::size_t QueuedEventCapacity{ 1024 };
+		MPSCQueue<QueuedEvent, QueuedEventCapacity> m_QueuedEvents; // events posted from any thread
+		std::size_t m_LastDispatchedCount = 0;
+		std::size_t m_PeakDispatchedCount = 0;
 	};
 
-#define ADD_WINDOW_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(eventType, std::bind(&func,arg,std::placeholders::_1));
-#define ADD_MOUSE_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(eventType, std::bind(&func,arg,std::placeholders::_1));
-#define ADD_KEY_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(eventType, std::bind(&func,arg,std::placeholders::_1));
-#define ADD_COLLISION_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().CollisionEventDispatcher.AddListener(eventType, std::bind(&func,arg,std::placeholders::_1));
+#define ADD_WINDOW_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(eventType, PE::MakeEventDelegate<&func>(arg));
+#define ADD_MOUSE_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(eventType, PE::MakeEventDelegate<&func>(arg));
+#define ADD_KEY_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(eventType, PE::MakeEventDelegate<&func>(arg));
+#define ADD_COLLISION_EVENT_LISTENER(eventType,func,arg) PE::EventHandler::GetInstance().CollisionEventDispatcher.AddListener(eventType, PE::MakeEventDelegate<&func>(arg));
+#define ADD_ENTITY_COLLISION_LISTENER(entityID,func,arg,receiveStay) PE::EventHandler::GetInstance().CollisionRouter.AddEntityListener(entityID, PE::MakeEventDelegate<&func>(arg), receiveStay);
+#define ADD_LAYER_COLLISION_LISTENER(layerIndex,func,arg,receiveStay) PE::EventHandler::GetInstance().CollisionRouter.AddLayerListener(layerIndex, PE::MakeEventDelegate<&func>(arg), receiveStay);
 
 
-#define ADD_ALL_WINDOW_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowClose, std::bind(&func,arg,std::placeholders::_1));\
-											    PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowFocus, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowLostFocus, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowMoved, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowResize, std::bind(&func,arg,std::placeholders::_1));
+#define ADD_ALL_WINDOW_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowClose, PE::MakeEventDelegate<&func>(arg));\
+											    PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowFocus, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowLostFocus, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowMoved, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().WindowEventDispatcher.AddListener(PE::WindowEvents::WindowResize, PE::MakeEventDelegate<&func>(arg));
 
-#define ADD_ALL_MOUSE_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseMoved, std::bind(&func,arg,std::placeholders::_1));\
-											    PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonPressed, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonReleased, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseScrolled, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonHold, std::bind(&func,arg,std::placeholders::_1));								
+#define ADD_ALL_MOUSE_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseMoved, PE::MakeEventDelegate<&func>(arg));\
+											    PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonPressed, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonReleased, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseScrolled, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().MouseEventDispatcher.AddListener(PE::MouseEvents::MouseButtonHold, PE::MakeEventDelegate<&func>(arg));								
 
-#define ADD_ALL_KEY_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyTriggered, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyRelease, std::bind(&func,arg,std::placeholders::_1));\
-												PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyPressed, std::bind(&func,arg,std::placeholders::_1));
+#define ADD_ALL_KEY_EVENT_LISTENER(func,arg) PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyTriggered, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyRelease, PE::MakeEventDelegate<&func>(arg));\
+												PE::EventHandler::GetInstance().KeyEventDispatcher.AddListener(PE::KeyEvents::KeyPressed, PE::MakeEventDelegate<&func>(arg));
 
 #define REMOVE_WINDOW_EVENT_LISTENER(handle) PE::EventHandler::GetInstance().WindowEventDispatcher.RemoveListener(handle);
 #define REMOVE_MOUSE_EVENT_LISTENER(handle) PE::EventHandler::GetInstance().MouseEventDispatcher.RemoveListener(handle);
 #define REMOVE_KEY_EVENT_LISTENER(handle) PE::EventHandler::GetInstance().KeyEventDispatcher.RemoveListener(handle);
 #define REMOVE_KEY_COLLISION_LISTENER(handle) PE::EventHandler::GetInstance().CollisionEventDispatcher.RemoveListener(handle);
+#define REMOVE_ROUTED_COLLISION_LISTENER(handle) PE::EventHandler::GetInstance().CollisionRouter.RemoveListener(handle);
 
 
 #define SEND_WINDOW_EVENT(_event) EventHandler::GetInstance().WindowEventDispatcher.SendEvent(_event);
 #define SEND_MOUSE_EVENT(_event) EventHandler::GetInstance().MouseEventDispatcher.SendEvent(_event);
 #define SEND_KEY_EVENT(_event) EventHandler::GetInstance().KeyEventDispatcher.SendEvent(_event);
 #define SEND_COLLISION_EVENT(_event) EventHandler::GetInstance().CollisionEventDispatcher.SendEvent(_event);
+#define POST_EVENT(_event) PE::EventHandler::GetInstance().PostEvent(_event);
 }
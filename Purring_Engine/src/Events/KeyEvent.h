@@ -31,6 +31,13 @@ namespace PE
 		KeyRelease
 	};
 
+	// counted from the last event type, update it when adding event types
+	template <>
+	struct EventTypeCount<KeyEvents>
+	{
+		static constexpr std::size_t value{ static_cast<std::size_t>(KeyEvents::KeyRelease) + 1 };
+	};
+
 
 	class KeyTriggeredEvent : public Event<KeyEvents>
 	{
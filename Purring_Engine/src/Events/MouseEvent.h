@@ -32,6 +32,13 @@ namespace PE
 		MouseScrolled
 	};
 
+	// counted from the last event type, update it when adding event types
+	template <>
+	struct EventTypeCount<MouseEvents>
+	{
+		static constexpr std::size_t value{ static_cast<std::size_t>(MouseEvents::MouseScrolled) + 1 };
+	};
+
 	class MouseMovedEvent : public Event<MouseEvents>
 	{
 	public:
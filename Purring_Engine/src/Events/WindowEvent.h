@@ -32,6 +32,13 @@ namespace PE
 		WindowMoved
 	};
 
+	// counted from the last event type, update it when adding event types
+	template <>
+	struct EventTypeCount<WindowEvents>
+	{
+		static constexpr std::size_t value{ static_cast<std::size_t>(WindowEvents::WindowMoved) + 1 };
+	};
+
 	// Class for handling window resize events
 	class WindowResizeEvent : public Event<WindowEvents>
 	{
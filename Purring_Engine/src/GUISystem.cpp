@@ -70,7 +70,12 @@ namespace PE
 
 	void GUISystem::UpdateSystem(float deltaTime)
 	{
-		deltaTime; // Prevent warnings
+		// Hover and disabled states of the buttons do not need to change every step,
+		// so the buttons are updated less often than the sliders which follow the mouse
+		m_buttonTimeSinceUpdate += deltaTime;
+		bool const updateButtons{ m_buttonTimeSinceUpdate >= 1.f / m_buttonUpdateFrequency - deltaTime * 0.5f };
+		float const buttonDeltaTime{ m_buttonTimeSinceUpdate };
+		if (updateButtons) { m_buttonTimeSinceUpdate = 0.f; }
 
 		// Store the canvas objects
 		m_activeCanvases.clear();
@@ -97,9 +102,11 @@ namespace PE
 
 		if (m_activeCanvases.empty()) { return; } // Don't bother with anything else if there are no canvases
 
+		if (updateButtons
 #ifndef GAMERELEASE
-		if (Editor::GetInstance().IsRunTime())
+			&& Editor::GetInstance().IsRunTime()
 #endif
+			)
 		for (const auto& layer : LayerView<GUIButton>())
 		{
 			for (EntityID objectID : InternalView(layer))
@@ -108,7 +115,7 @@ namespace PE
 				if (!IsChildedToCanvas(objectID)) { continue; }
 				GUIButton& gui = EntityManager::GetInstance().Get<GUIButton>(objectID);
 				gui.Update();
-				gui.m_clickedTimer -= deltaTime;
+				gui.m_clickedTimer -= buttonDeltaTime;
 
 				if (gui.disabled)
 				{
@@ -367,19 +374,14 @@ namespace PE
 
 	bool GUISystem::IsChildedToCanvas(EntityID uiId) const
 	{
-		// Loop through the parents of the object until we encounter a canvas
-		bool isChilded{ false };
-		while (Hierarchy::GetInstance().HasParent(uiId))
+		// Loop through the canvases the object is childed to until we encounter an active one
+		for (std::optional<EntityID> canvasId{ Hierarchy::GetInstance().GetCanvasAncestor(uiId) }; canvasId.has_value();
+			canvasId = Hierarchy::GetInstance().GetCanvasAncestor(canvasId.value()))
 		{
-			if(IsImmediatelyChildedToCanvas(uiId))
-			{
-				isChilded = true;
-				break;
-			}
-
-			uiId = Hierarchy::GetInstance().GetParent(uiId).value();
+			if (m_activeCanvases.find(canvasId.value()) != m_activeCanvases.end())
+				return true;
 		}
-		return isChilded;
+		return false;
 	}
 
 
@@ -591,7 +593,7 @@ namespace PE
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(1))
 		{
 			EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(1);
-			desc.isActive = !desc.isActive;
+			desc.SetActive(!desc.isActive);
 		}
 		
 	}
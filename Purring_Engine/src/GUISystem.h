@@ -165,6 +165,8 @@ namespace PE
 			// Stores the IDs of the active canvases
 			static std::unordered_set<EntityID> m_activeCanvases;
 			static float m_targetResolutionWidth, m_targetResolutionHeight; // Dimensions the canvases should have
+			static constexpr float m_buttonUpdateFrequency{ 30.f }; // Times per second the states of the buttons are updated
+			float m_buttonTimeSinceUpdate{ 0.f }; // Time since the states of the buttons were last updated
 	};
 
 	//enum to tell type of UI to make
@@ -81,8 +81,8 @@ namespace PE
 			returnButtonID = ResourceManager::GetInstance().LoadPrefabFromFile("PauseMenu/returnbutton.prefab");
 
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).SetActive(false);
 
 			EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).toSave = false;
 			EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).toSave = false;
@@ -96,10 +96,10 @@ namespace PE
 			sadCatID = ResourceManager::GetInstance().LoadPrefabFromFile("PauseMenu/sadcat.prefab");
 
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 
 			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).toSave = false;
 			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).toSave = false;
@@ -144,10 +144,10 @@ namespace PE
 				sadCatID = ResourceManager::GetInstance().LoadPrefabFromFile("PauseMenu/sadcat.prefab");
 
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-				EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-				EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-				EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+				EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+				EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+				EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 
 				EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).toSave = false;
 				EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).toSave = false;
@@ -202,10 +202,10 @@ namespace PE
 			sadCatID = ResourceManager::GetInstance().LoadPrefabFromFile("PauseMenu/sadcat.prefab");
 
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 
 			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).toSave = false;
 			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).toSave = false;
@@ -330,18 +330,18 @@ namespace PE
 
 	void GameStateManager::ToggleWin(bool b)
 	{
-		EntityManager::GetInstance().Get<EntityDescriptor>(winCatID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(winTextID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(endGameRestartButtonID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(endGameExitButtonID).isActive = b;
+		EntityManager::GetInstance().Get<EntityDescriptor>(winCatID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(winTextID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(endGameRestartButtonID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(endGameExitButtonID).SetActive(b);
 	}
 
 	void GameStateManager::ToggleLose(bool b)
 	{
-		EntityManager::GetInstance().Get<EntityDescriptor>(loseCatID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(loseTextID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(endGameRestartButtonID).isActive = b;
-		EntityManager::GetInstance().Get<EntityDescriptor>(endGameExitButtonID).isActive = b;
+		EntityManager::GetInstance().Get<EntityDescriptor>(loseCatID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(loseTextID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(endGameRestartButtonID).SetActive(b);
+		EntityManager::GetInstance().Get<EntityDescriptor>(endGameExitButtonID).SetActive(b);
 	}
 
 	void GameStateManager::ButtonPressSound()
@@ -370,33 +370,33 @@ namespace PE
 
 	void GameStateManager::InactiveMenuButtons()
 	{
-		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).SetActive(false);
 
 	}
 
 	void GameStateManager::InactiveMenu()
 	{
-		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(pauseBGID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(pauseBGID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).SetActive(false);
 
 		if (howToPlay)
 		{
-			EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).SetActive(false);
 		}
 
 		if (areYouSure)
 		{
-			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+			EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 		}
 	}
 
@@ -430,11 +430,11 @@ namespace PE
 
 	void GameStateManager::ActiveMenuButtons()
 	{
-		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(pauseBGID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(resumeButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(pauseBGID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(quitButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(pawsedID).SetActive(true);
 	}
 
 	void GameStateManager::HowToPlay(EntityID)
@@ -443,8 +443,8 @@ namespace PE
 		//set all the 4 buttons inactive
 		InactiveMenuButtons();
 		//create howtoplay menu here
-		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).SetActive(true);
 
 		howToPlay = true;
 	}
@@ -455,8 +455,8 @@ namespace PE
 		//set all the 4 buttons active
 		ActiveMenuButtons();
 		//set inactive how to play menu here
-		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(howToPlayID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(returnButtonID).SetActive(false);
 		howToPlay = false;
 	}
 
@@ -466,10 +466,10 @@ namespace PE
 		//set all 4 button active and pawsed
 		ActiveMenuButtons();
 		//delete yes no and are you sure object
-		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 	}
 
 	void GameStateManager::RestartGame(EntityID)
@@ -495,10 +495,10 @@ namespace PE
 		}
 
 		//delete yes no and are you sure object
-		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = false;
-		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(false);
+		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(false);
 	}
 
 	void GameStateManager::AreYouSureExit(EntityID)
@@ -508,10 +508,10 @@ namespace PE
 		InactiveMenuButtons();
 		//create yes no button
 		//create are you sure object
-		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(true);
 
 		areYouSure = true;
 	}
@@ -529,10 +529,10 @@ namespace PE
 
 		}
 
-		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).isActive = true;
-		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(areYouSureID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(yesButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(noButtonID).SetActive(true);
+		EntityManager::GetInstance().Get<EntityDescriptor>(sadCatID).SetActive(true);
 
 		areYouSure = true;
 	}
@@ -0,0 +1,275 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     CullingGrid.cpp
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions in the CullingGrid
+           class, which finds the entities in a render order that a camera can see.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "CullingGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ECS/Entity.h"
+#include "Math/Transform.h"
+#include "Text.h"
+#include "VisualEffects/ParticleSystem.h"
+
+namespace PE
+{
+    namespace Graphics
+    {
+        void CullingGrid::Update(std::vector<EntityID> const& r_renderOrder, unsigned long long const renderOrderVersion)
+        {
+            EntityManager& r_entityManager{ EntityManager::GetInstance() };
+            ++m_updateCount;
+
+            if (renderOrderVersion != m_renderOrderVersion || r_renderOrder.size() != m_entries.size())
+            {
+                Clear();
+                m_renderOrderVersion = renderOrderVersion;
+                m_entries.resize(r_renderOrder.size());
+                m_visibility.assign(r_renderOrder.size(), 1);
+                m_visibleCount = static_cast<unsigned>(r_renderOrder.size());
+
+                for (unsigned index{}; index < r_renderOrder.size(); ++index)
+                {
+                    EntityID const id{ r_renderOrder[index] };
+                    Entry& r_entry{ m_entries[index] };
+                    r_entry.changedUpdate = m_updateCount;
+
+                    // The particles and glyphs are not inside the transform of the entity
+                    if (!r_entityManager.Has<Transform>(id) || r_entityManager.Has<ParticleEmitter>(id)
+                        || r_entityManager.Has<TextComponent>(id))
+                    {
+                        r_entry.placement = EnumPlacement::ALWAYS;
+                    }
+                    else
+                    {
+                        SetBounds(r_entry, r_entityManager.Get<Transform>(id));
+                    }
+
+                    Insert(index);
+                }
+
+                return;
+            }
+
+            // Rebin only the entities that were moved, resized or rotated since the last update
+            for (unsigned index{}; index < m_entries.size(); ++index)
+            {
+                Entry& r_entry{ m_entries[index] };
+                if (r_entry.placement == EnumPlacement::ALWAYS) { continue; }
+
+                // The transform may have been removed before the render order is rebuilt
+                Transform const* p_transform{ r_entityManager.GetPointer<Transform>(r_renderOrder[index]) };
+                if (!p_transform
+                    || (p_transform->position.x == r_entry.position.x && p_transform->position.y == r_entry.position.y
+                        && p_transform->width == r_entry.width && p_transform->height == r_entry.height
+                        && p_transform->orientation == r_entry.orientation))
+                {
+                    continue;
+                }
+
+                Entry movedEntry{ r_entry };
+                SetBounds(movedEntry, *p_transform);
+                movedEntry.changedUpdate = m_updateCount;
+
+                // Most moves stay inside the same cells
+                if (movedEntry.placement == r_entry.placement
+                    && movedEntry.minCellX == r_entry.minCellX && movedEntry.minCellY == r_entry.minCellY
+                    && movedEntry.maxCellX == r_entry.maxCellX && movedEntry.maxCellY == r_entry.maxCellY)
+                {
+                    r_entry = movedEntry;
+                    continue;
+                }
+
+                Remove(index);
+                r_entry = movedEntry;
+                Insert(index);
+            }
+        }
+
+
+        void CullingGrid::Query(glm::vec2 const& r_min, glm::vec2 const& r_max)
+        {
+            std::fill(m_visibility.begin(), m_visibility.end(), static_cast<unsigned char>(0));
+            m_visibleCount = 0;
+
+            int const minCellX{ static_cast<int>(std::floor(r_min.x / cellSize)) };
+            int const minCellY{ static_cast<int>(std::floor(r_min.y / cellSize)) };
+            int const maxCellX{ static_cast<int>(std::floor(r_max.x / cellSize)) };
+            int const maxCellY{ static_cast<int>(std::floor(r_max.y / cellSize)) };
+
+            // Walk the cells in the area, or every cell in use if there are fewer of them
+            long long const areaCellCount{ (static_cast<long long>(maxCellX) - minCellX + 1) * (static_cast<long long>(maxCellY) - minCellY + 1) };
+            if (areaCellCount > static_cast<long long>(m_cells.size()))
+            {
+                for (auto const& [cellKey, r_indices] : m_cells)
+                {
+                    int const cellX{ static_cast<int>(static_cast<unsigned>(cellKey >> 32)) };
+                    int const cellY{ static_cast<int>(static_cast<unsigned>(cellKey)) };
+                    if (cellX < minCellX || cellX > maxCellX || cellY < minCellY || cellY > maxCellY) { continue; }
+
+                    for (unsigned const index : r_indices)
+                    {
+                        Test(index, r_min, r_max);
+                    }
+                }
+            }
+            else
+            {
+                for (int cellY{ minCellY }; cellY <= maxCellY; ++cellY)
+                {
+                    for (int cellX{ minCellX }; cellX <= maxCellX; ++cellX)
+                    {
+                        auto const cellIterator{ m_cells.find(CellKey(cellX, cellY)) };
+                        if (cellIterator == m_cells.end()) { continue; }
+
+                        for (unsigned const index : cellIterator->second)
+                        {
+                            Test(index, r_min, r_max);
+                        }
+                    }
+                }
+            }
+
+            for (unsigned const index : m_unbinned)
+            {
+                if (m_entries[index].placement == EnumPlacement::ALWAYS)
+                {
+                    m_visibility[index] = 1;
+                    ++m_visibleCount;
+                }
+                else
+                {
+                    Test(index, r_min, r_max);
+                }
+            }
+        }
+
+
+        void CullingGrid::Clear()
+        {
+            m_cells.clear();
+            m_unbinned.clear();
+            m_entries.clear();
+            m_visibility.clear();
+            m_renderOrderVersion = 0;
+            m_visibleCount = 0;
+        }
+
+
+        void CullingGrid::SetBounds(Entry& r_entry, Transform const& r_transform)
+        {
+            r_entry.position = glm::vec2{ r_transform.position.x, r_transform.position.y };
+            r_entry.width = r_transform.width, r_entry.height = r_transform.height;
+            r_entry.orientation = r_transform.orientation;
+
+            // Bounds of the quad once it has been rotated
+            float const cosAngle{ std::abs(std::cos(r_transform.orientation)) };
+            float const sinAngle{ std::abs(std::sin(r_transform.orientation)) };
+            float const halfWidth{ std::abs(r_transform.width) * 0.5f }, halfHeight{ std::abs(r_transform.height) * 0.5f };
+            glm::vec2 const extents{ halfWidth * cosAngle + halfHeight * sinAngle, halfWidth * sinAngle + halfHeight * cosAngle };
+            r_entry.min = r_entry.position - extents;
+            r_entry.max = r_entry.position + extents;
+
+            // Positions far enough to overflow the cell coordinates are left to be tested on every query
+            float const cellLimit{ cellSize * 1e9f };
+            if (!(r_entry.min.x > -cellLimit && r_entry.min.y > -cellLimit && r_entry.max.x < cellLimit && r_entry.max.y < cellLimit))
+            {
+                r_entry.placement = EnumPlacement::OVERSIZED;
+                return;
+            }
+
+            r_entry.minCellX = static_cast<int>(std::floor(r_entry.min.x / cellSize));
+            r_entry.minCellY = static_cast<int>(std::floor(r_entry.min.y / cellSize));
+            r_entry.maxCellX = static_cast<int>(std::floor(r_entry.max.x / cellSize));
+            r_entry.maxCellY = static_cast<int>(std::floor(r_entry.max.y / cellSize));
+
+            long long const cellCount{ (static_cast<long long>(r_entry.maxCellX) - r_entry.minCellX + 1)
+                * (static_cast<long long>(r_entry.maxCellY) - r_entry.minCellY + 1) };
+            r_entry.placement = cellCount > maxCellsPerEntity ? EnumPlacement::OVERSIZED : EnumPlacement::GRID;
+        }
+
+
+        void CullingGrid::Insert(unsigned const index)
+        {
+            Entry const& r_entry{ m_entries[index] };
+            if (r_entry.placement != EnumPlacement::GRID)
+            {
+                m_unbinned.emplace_back(index);
+                return;
+            }
+
+            for (int cellY{ r_entry.minCellY }; cellY <= r_entry.maxCellY; ++cellY)
+            {
+                for (int cellX{ r_entry.minCellX }; cellX <= r_entry.maxCellX; ++cellX)
+                {
+                    m_cells[CellKey(cellX, cellY)].emplace_back(index);
+                }
+            }
+        }
+
+
+        void CullingGrid::Remove(unsigned const index)
+        {
+            // The order of the indices in a cell does not matter, so they are swapped out
+            auto const removeIndex{ [index](std::vector<unsigned>& r_indices)
+            {
+                auto const indexIterator{ std::find(r_indices.begin(), r_indices.end(), index) };
+                if (indexIterator != r_indices.end())
+                {
+                    *indexIterator = r_indices.back();
+                    r_indices.pop_back();
+                }
+            } };
+
+            Entry const& r_entry{ m_entries[index] };
+            if (r_entry.placement != EnumPlacement::GRID)
+            {
+                removeIndex(m_unbinned);
+                return;
+            }
+
+            for (int cellY{ r_entry.minCellY }; cellY <= r_entry.maxCellY; ++cellY)
+            {
+                for (int cellX{ r_entry.minCellX }; cellX <= r_entry.maxCellX; ++cellX)
+                {
+                    auto const cellIterator{ m_cells.find(CellKey(cellX, cellY)) };
+                    if (cellIterator == m_cells.end()) { continue; }
+
+                    removeIndex(cellIterator->second);
+                    if (cellIterator->second.empty())
+                    {
+                        m_cells.erase(cellIterator);
+                    }
+                }
+            }
+        }
+
+
+        void CullingGrid::Test(unsigned const index, glm::vec2 const& r_min, glm::vec2 const& r_max)
+        {
+            // Entities in several cells in the area are only counted once
+            if (m_visibility[index]) { return; }
+
+            Entry const& r_entry{ m_entries[index] };
+            if (r_entry.min.x <= r_max.x && r_min.x <= r_entry.max.x
+                && r_entry.min.y <= r_max.y && r_min.y <= r_entry.max.y)
+            {
+                m_visibility[index] = 1;
+                ++m_visibleCount;
+            }
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
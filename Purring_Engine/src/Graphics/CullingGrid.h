@@ -0,0 +1,222 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     CullingGrid.h
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the CullingGrid class, a uniform grid
+           of the bounds of the entities in a render order, which finds the entities
+           that overlap the area a camera can see.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include <glm/glm.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+typedef unsigned long long EntityID;
+
+namespace PE
+{
+    struct Transform;
+
+    namespace Graphics
+    {
+        /*!***********************************************************************************
+         \brief Number of entities found visible and culled by a view in a frame.
+        *************************************************************************************/
+        struct CullingStats
+        {
+            unsigned visible{};
+            unsigned culled{};
+        };
+
+        /*!***********************************************************************************
+         \brief Uniform grid of the axis aligned bounds of the entities in a render order.
+                Each entity is stored in the cells its bounds overlap. The bounds are kept
+                up to date by comparing the transform of each entity with the values it was
+                last binned with, so only the entities that moved are moved between cells.
+
+                Entities whose bounds cover too many cells are kept in a list that is
+                tested on every query instead, and entities whose bounds are not known
+                from their transform (particle emitters, text and entities without a
+                transform) are always visible.
+        *************************************************************************************/
+        class CullingGrid
+        {
+            // ----- Public constants ----- //
+        public:
+            static constexpr float cellSize{ 512.f };        // Width and height of each cell in world units
+            static constexpr int maxCellsPerEntity{ 16 };    // Most cells an entity is binned into before it is tested on every query
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns whether each entity in the render order overlapped the area of
+                    the last query.
+
+             \return std::vector<unsigned char> const& - 1 for each visible entity and 0 for
+                                                         each culled one, parallel to the
+                                                         render order passed to Update().
+            *************************************************************************************/
+            inline std::vector<unsigned char> const& GetVisibility() const { return m_visibility; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of entities that overlapped the area of the last query.
+
+             \return unsigned - Number of visible entities.
+            *************************************************************************************/
+            inline unsigned GetVisibleCount() const { return m_visibleCount; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of entities that did not overlap the area of the last query.
+
+             \return unsigned - Number of culled entities.
+            *************************************************************************************/
+            inline unsigned GetCulledCount() const { return static_cast<unsigned>(m_entries.size()) - m_visibleCount; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of times the grid has been updated, which is stored in
+                    the entries whose transform changed in that update.
+
+             \return unsigned long long - Number of updates.
+            *************************************************************************************/
+            inline unsigned long long GetUpdateCount() const { return m_updateCount; }
+
+            /*!***********************************************************************************
+             \brief Returns the last update that the transform of an entity was found to have
+                    changed in, or that the entity was added to the grid in.
+
+             \param[in] index Index of the entity in the render order.
+             \return unsigned long long - Update the entity last changed in.
+            *************************************************************************************/
+            inline unsigned long long GetChangedUpdate(unsigned const index) const { return m_entries[index].changedUpdate; }
+
+            /*!***********************************************************************************
+             \brief Gets the axis aligned bounds of an entity.
+
+             \param[in] index Index of the entity in the render order.
+             \param[out] r_min Bottom left corner of the bounds.
+             \param[out] r_max Top right corner of the bounds.
+             \return true - If the bounds of the entity are known.
+             \return false - If the entity is always visible, in which case the bounds are not set.
+            *************************************************************************************/
+            inline bool GetBounds(unsigned const index, glm::vec2& r_min, glm::vec2& r_max) const
+            {
+                Entry const& r_entry{ m_entries[index] };
+                if (r_entry.placement == EnumPlacement::ALWAYS) { return false; }
+
+                r_min = r_entry.min, r_max = r_entry.max;
+                return true;
+            }
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Rebins the entities of a render order. The grid is rebuilt when the render
+                    order has changed, otherwise only the entities whose transform changed
+                    since the last update are moved between cells.
+
+             \param[in] r_renderOrder Entities to cull, in the order they are drawn.
+             \param[in] renderOrderVersion Version of the render order, which changes every
+                                           time the render order is rebuilt.
+            *************************************************************************************/
+            void Update(std::vector<EntityID> const& r_renderOrder, unsigned long long const renderOrderVersion);
+
+            /*!***********************************************************************************
+             \brief Finds the entities whose bounds overlap an area. The result can be read
+                    with GetVisibility().
+
+             \param[in] r_min Bottom left corner of the area in world space.
+             \param[in] r_max Top right corner of the area in world space.
+            *************************************************************************************/
+            void Query(glm::vec2 const& r_min, glm::vec2 const& r_max);
+
+            /*!***********************************************************************************
+             \brief Removes every entity, so that the grid is rebuilt on the next update.
+            *************************************************************************************/
+            void Clear();
+
+            // ----- Private types ----- //
+        private:
+            enum class EnumPlacement : unsigned char
+            {
+                GRID,       // Binned into the cells its bounds overlap
+                OVERSIZED,  // Covers too many cells, tested on every query
+                ALWAYS      // Bounds unknown, visible in every query
+            };
+
+            struct Entry
+            {
+                glm::vec2 position{};               // Transform values the entity was last binned with
+                float width{}, height{}, orientation{};
+                glm::vec2 min{}, max{};             // Axis aligned bounds of the rotated quad
+                int minCellX{}, minCellY{}, maxCellX{}, maxCellY{};
+                unsigned long long changedUpdate{};   // Last update the transform values changed in
+                EnumPlacement placement{ EnumPlacement::GRID };
+            };
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Stores the transform values of an entity and recomputes its bounds and
+                    the cells they overlap.
+
+             \param[in,out] r_entry Entry of the entity.
+             \param[in] r_transform Transform of the entity.
+            *************************************************************************************/
+            static void SetBounds(Entry& r_entry, Transform const& r_transform);
+
+            /*!***********************************************************************************
+             \brief Adds an entry to the cells it overlaps, or to the unbinned entries.
+
+             \param[in] index Index of the entry in the render order.
+            *************************************************************************************/
+            void Insert(unsigned const index);
+
+            /*!***********************************************************************************
+             \brief Removes an entry from the cells it was added to by Insert().
+
+             \param[in] index Index of the entry in the render order.
+            *************************************************************************************/
+            void Remove(unsigned const index);
+
+            /*!***********************************************************************************
+             \brief Marks an entry as visible if its bounds overlap an area.
+
+             \param[in] index Index of the entry in the render order.
+             \param[in] r_min Bottom left corner of the area.
+             \param[in] r_max Top right corner of the area.
+            *************************************************************************************/
+            void Test(unsigned const index, glm::vec2 const& r_min, glm::vec2 const& r_max);
+
+            /*!***********************************************************************************
+             \brief Packs the coordinates of a cell into the key of its entries in m_cells.
+
+             \param[in] cellX Column of the cell.
+             \param[in] cellY Row of the cell.
+             \return unsigned long long - Key of the cell.
+            *************************************************************************************/
+            static inline unsigned long long CellKey(int const cellX, int const cellY)
+            {
+                return (static_cast<unsigned long long>(static_cast<unsigned>(cellX)) << 32) | static_cast<unsigned>(cellY);
+            }
+
+            // ----- Private variables ----- //
+        private:
+            std::unordered_map<unsigned long long, std::vector<unsigned>> m_cells{}; // Indices of the entries in each cell
+            std::vector<unsigned> m_unbinned{};         // Indices of the oversized and always visible entries
+            std::vector<Entry> m_entries{};             // Parallel to the render order
+            std::vector<unsigned char> m_visibility{};  // Result of the last query, parallel to the render order
+            unsigned long long m_renderOrderVersion{};  // Version of the render order the grid was built from, 0 if never built
+            unsigned long long m_updateCount{};         // Number of calls to Update()
+            unsigned m_visibleCount{};                  // Number of entries visible in the last query
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
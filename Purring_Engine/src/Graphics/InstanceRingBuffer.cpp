@@ -0,0 +1,242 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     InstanceRingBuffer.cpp
+ \date     30-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions in the InstanceRingBuffer
+           class, a persistently mapped buffer that the per-instance data of instanced
+           draws is written straight into.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "InstanceRingBuffer.h"
+#include "Logging/Logger.h"
+
+extern Logger engine_logger;
+
+namespace PE
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            // Timeout of each wait on a fence once it has been flushed, in nanoseconds
+            GLuint64 const fenceWaitTimeout{ 1'000'000 };
+        }
+
+
+        bool InstanceRingBuffer::Initialize(RenderBackend& r_backend, std::vector<GLsizeiptr> const& r_bytesPerInstance, std::size_t const instanceCapacity)
+        {
+            Cleanup();
+            m_p_backend = &r_backend;
+
+            m_streams.clear();
+            m_streams.reserve(r_bytesPerInstance.size());
+            for (GLsizeiptr const bytesPerInstance : r_bytesPerInstance)
+            {
+                m_streams.emplace_back(Stream{ bytesPerInstance });
+            }
+
+            m_stallCount = 0, m_growCount = 0;
+            return CreateBuffer(instanceCapacity);
+        }
+
+
+        void InstanceRingBuffer::BeginFrame()
+        {
+            m_frameUploadBytes = 0, m_frameBatchCount = 0;
+            if (!m_bufferObject) { return; }
+
+            m_currentRegion = (m_currentRegion + 1) % framesInFlight;
+
+            // Wait for the GPU to finish the draws that read from this region
+            GLsync& r_fence{ m_fences[m_currentRegion] };
+            if (r_fence)
+            {
+                if (!m_p_backend->WaitFence(r_fence, false, 0))
+                {
+                    ++m_stallCount;
+                    while (!m_p_backend->WaitFence(r_fence, true, fenceWaitTimeout)) {}
+                }
+
+                m_p_backend->DeleteFence(r_fence);
+                r_fence = nullptr;
+            }
+
+            for (Stream& r_stream : m_streams)
+            {
+                r_stream.batchStart = 0, r_stream.head = 0;
+            }
+        }
+
+
+        void InstanceRingBuffer::EndFrame()
+        {
+            if (!m_bufferObject) { return; }
+
+            if (m_fences[m_currentRegion])
+            {
+                m_p_backend->DeleteFence(m_fences[m_currentRegion]);
+            }
+            m_fences[m_currentRegion] = m_p_backend->CreateFence();
+        }
+
+
+        void* InstanceRingBuffer::Allocate(unsigned const streamIndex, GLsizeiptr const size)
+        {
+            Stream& r_stream{ m_streams[streamIndex] };
+            if (r_stream.head + size > r_stream.capacity)
+            {
+                // The batch is moved to the start of the new region, so doubling is always enough
+                Grow(m_instanceCapacity * 2);
+            }
+
+            void* p_element{ m_p_mapped + m_regionSize * static_cast<GLintptr>(m_currentRegion) + r_stream.offset + r_stream.head };
+            r_stream.head += size;
+            m_frameUploadBytes += static_cast<unsigned long long>(size);
+            return p_element;
+        }
+
+
+        void InstanceRingBuffer::DiscardBatch(unsigned const streamIndex)
+        {
+            Stream& r_stream{ m_streams[streamIndex] };
+            m_frameUploadBytes -= static_cast<unsigned long long>(r_stream.head - r_stream.batchStart);
+            r_stream.head = r_stream.batchStart;
+        }
+
+
+        void InstanceRingBuffer::SubmitBatch()
+        {
+            for (Stream& r_stream : m_streams)
+            {
+                r_stream.batchStart = r_stream.head;
+            }
+            ++m_frameBatchCount;
+        }
+
+
+        void InstanceRingBuffer::Cleanup()
+        {
+            for (GLsync& r_fence : m_fences)
+            {
+                if (r_fence)
+                {
+                    m_p_backend->DeleteFence(r_fence);
+                    r_fence = nullptr;
+                }
+            }
+
+            if (m_bufferObject)
+            {
+                m_p_backend->UnmapBuffer(m_bufferObject);
+                m_p_backend->DeleteBuffer(m_bufferObject);
+            }
+
+            m_bufferObject = 0, m_p_mapped = nullptr;
+            m_regionSize = 0, m_instanceCapacity = 0, m_currentRegion = 0;
+        }
+
+
+        bool InstanceRingBuffer::CreateBuffer(std::size_t const instanceCapacity)
+        {
+            // Lay out the range of each stream in a region
+            GLintptr offset{};
+            for (Stream& r_stream : m_streams)
+            {
+                r_stream.offset = offset;
+                r_stream.capacity = (r_stream.bytesPerInstance * static_cast<GLsizeiptr>(instanceCapacity) + streamAlignment - 1) / streamAlignment * streamAlignment;
+                r_stream.batchStart = 0, r_stream.head = 0;
+                offset += r_stream.capacity;
+            }
+
+            void* p_mapped{ nullptr };
+            GLuint const bufferObject{ m_p_backend->CreateMappedBuffer(offset * framesInFlight, p_mapped) };
+            if (0 == bufferObject)
+            {
+                engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+                engine_logger.SetTime();
+                engine_logger.AddLog(false, "Unable to create the instance buffer object.", __FUNCTION__);
+
+                return false;
+            }
+
+            if (!p_mapped)
+            {
+                engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+                engine_logger.SetTime();
+                engine_logger.AddLog(false, "Unable to map the instance buffer object.", __FUNCTION__);
+
+                m_p_backend->DeleteBuffer(bufferObject);
+                return false;
+            }
+
+            m_bufferObject = bufferObject;
+            m_p_mapped = static_cast<unsigned char*>(p_mapped);
+            m_regionSize = offset;
+            m_instanceCapacity = instanceCapacity;
+            m_currentRegion = 0;
+
+            return true;
+        }
+
+
+        void InstanceRingBuffer::Grow(std::size_t const instanceCapacity)
+        {
+            // Keep the old buffer and layout to copy the current batches from
+            GLuint const oldBufferObject{ m_bufferObject };
+            std::vector<Stream> const oldStreams{ m_streams };
+            GLintptr const oldRegionOffset{ m_regionSize * static_cast<GLintptr>(m_currentRegion) };
+            GLsizeiptr const oldRegionSize{ m_regionSize };
+            std::size_t const oldInstanceCapacity{ m_instanceCapacity };
+            unsigned const oldRegion{ m_currentRegion };
+            unsigned char* const p_oldMapped{ m_p_mapped };
+
+            if (!CreateBuffer(instanceCapacity))
+            {
+                m_streams = oldStreams;
+                m_bufferObject = oldBufferObject, m_p_mapped = p_oldMapped;
+                m_regionSize = oldRegionSize, m_instanceCapacity = oldInstanceCapacity, m_currentRegion = oldRegion;
+                throw std::bad_alloc{};
+            }
+
+            // Copy the batches that have not been drawn yet to the start of the first region
+            for (std::size_t i{}; i < m_streams.size(); ++i)
+            {
+                GLsizeiptr const batchSize{ oldStreams[i].head - oldStreams[i].batchStart };
+                if (batchSize > 0)
+                {
+                    m_p_backend->CopyBuffer(oldBufferObject, m_bufferObject,
+                        oldRegionOffset + oldStreams[i].offset + oldStreams[i].batchStart,
+                        m_streams[i].offset, batchSize);
+                }
+                m_streams[i].head = batchSize;
+            }
+
+            // The draws already made from the old buffer keep it alive until the GPU is done with them
+            m_p_backend->UnmapBuffer(oldBufferObject);
+            m_p_backend->DeleteBuffer(oldBufferObject);
+
+            for (GLsync& r_fence : m_fences)
+            {
+                if (r_fence)
+                {
+                    m_p_backend->DeleteFence(r_fence);
+                    r_fence = nullptr;
+                }
+            }
+
+            ++m_growCount;
+
+            engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+            engine_logger.SetTime();
+            engine_logger.AddLog(false, "Instance buffer grown to " + std::to_string(m_instanceCapacity) + " instances per frame.", __FUNCTION__);
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
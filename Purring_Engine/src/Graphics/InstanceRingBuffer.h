@@ -0,0 +1,293 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     InstanceRingBuffer.h
+ \date     30-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the InstanceRingBuffer class, a
+           persistently mapped buffer that the per-instance data of instanced draws
+           is written straight into, and the InstanceStream class used to fill it.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+#include "RenderBackend.h"
+
+#include <array>
+#include <vector>
+#include <new>          // placement new
+#include <type_traits>
+#include <utility>
+
+namespace PE
+{
+    namespace Graphics
+    {
+        /*!***********************************************************************************
+         \brief Buffer object that is created once and stays mapped for its whole lifetime.
+                It is split into one region per frame in flight, and each region into one
+                range per stream of instance data (e.g. colors, matrices). The CPU writes
+                into the region of the current frame while the GPU reads the regions of
+                the previous frames. A fence placed at the end of each frame tells when
+                the GPU is done with a region so that it can be written to again.
+
+                Instances are written into the current batch of each stream. Submitting
+                the batch after drawing it moves the start of the next batch to the end
+                of the data written so far.
+        *************************************************************************************/
+        class InstanceRingBuffer
+        {
+            // ----- Public constants ----- //
+        public:
+            static constexpr unsigned framesInFlight{ 3 };      // Number of regions the buffer is split into
+            static constexpr GLsizeiptr streamAlignment{ 256 }; // Alignment of the start of each stream range
+
+            // ----- Constructors ----- //
+        public:
+            InstanceRingBuffer() = default;
+            InstanceRingBuffer(InstanceRingBuffer const&) = delete;
+            InstanceRingBuffer& operator=(InstanceRingBuffer const&) = delete;
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns the handle of the buffer object. The handle changes when the buffer
+                    has to grow, so it should be fetched again for every batch.
+
+             \return GLuint - Handle of the buffer object, 0 if it has not been created.
+            *************************************************************************************/
+            inline GLuint GetBufferObject() const { return m_bufferObject; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of instances each region can hold.
+
+             \return std::size_t - Number of instances each region can hold.
+            *************************************************************************************/
+            inline std::size_t GetInstanceCapacity() const { return m_instanceCapacity; }
+
+            /*!***********************************************************************************
+             \brief Returns the offset of the current batch of a stream from the start of
+                    the buffer object.
+
+             \param[in] streamIndex Index of the stream.
+             \return GLintptr - Offset in bytes of the first element of the batch.
+            *************************************************************************************/
+            inline GLintptr GetBatchOffset(unsigned const streamIndex) const
+            {
+                return m_regionSize * static_cast<GLintptr>(m_currentRegion) + m_streams[streamIndex].offset + m_streams[streamIndex].batchStart;
+            }
+
+            /*!***********************************************************************************
+             \brief Returns the number of bytes written into the current batch of a stream.
+
+             \param[in] streamIndex Index of the stream.
+             \return GLsizeiptr - Number of bytes written into the batch.
+            *************************************************************************************/
+            inline GLsizeiptr GetBatchSize(unsigned const streamIndex) const
+            {
+                return m_streams[streamIndex].head - m_streams[streamIndex].batchStart;
+            }
+
+            /*!***********************************************************************************
+             \brief Returns the number of bytes written into the buffer this frame.
+
+             \return unsigned long long - Number of bytes written this frame.
+            *************************************************************************************/
+            inline unsigned long long GetFrameUploadBytes() const { return m_frameUploadBytes; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of batches submitted this frame.
+
+             \return unsigned - Number of batches submitted this frame.
+            *************************************************************************************/
+            inline unsigned GetFrameBatchCount() const { return m_frameBatchCount; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of times the CPU had to wait for the GPU to finish
+                    reading a region before writing into it again.
+
+             \return unsigned long long - Number of stalls since the buffer was created.
+            *************************************************************************************/
+            inline unsigned long long GetStallCount() const { return m_stallCount; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of times the buffer had to be recreated with a larger
+                    capacity as a frame wrote more instances than a region could hold.
+
+             \return unsigned long long - Number of times the buffer has grown.
+            *************************************************************************************/
+            inline unsigned long long GetGrowCount() const { return m_growCount; }
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Creates the buffer object and maps it for the rest of its lifetime.
+
+             \param[in,out] r_backend Backend to create the buffer and fences through.
+             \param[in] r_bytesPerInstance Number of bytes each instance takes up in each stream.
+             \param[in] instanceCapacity Number of instances each region can hold to begin with.
+             \return true - If the buffer object was created and mapped.
+             \return false - If the buffer object could not be created or mapped.
+            *************************************************************************************/
+            bool Initialize(RenderBackend& r_backend, std::vector<GLsizeiptr> const& r_bytesPerInstance, std::size_t const instanceCapacity);
+
+            /*!***********************************************************************************
+             \brief Moves on to the region of the next frame, waiting for the GPU to finish
+                    reading it if it has not, and resets the counters of the frame.
+            *************************************************************************************/
+            void BeginFrame();
+
+            /*!***********************************************************************************
+             \brief Places a fence after the draw calls made this frame so that the region
+                    written to this frame is not reused before the GPU is done with it.
+            *************************************************************************************/
+            void EndFrame();
+
+            /*!***********************************************************************************
+             \brief Reserves space for an element at the end of the current batch of a stream.
+                    The buffer is grown if the region is full.
+
+             \param[in] streamIndex Index of the stream.
+             \param[in] size Size of the element in bytes.
+             \return void* - Pointer into the mapped buffer to write the element to.
+            *************************************************************************************/
+            void* Allocate(unsigned const streamIndex, GLsizeiptr const size);
+
+            /*!***********************************************************************************
+             \brief Throws away the elements written into the current batch of a stream.
+
+             \param[in] streamIndex Index of the stream.
+            *************************************************************************************/
+            void DiscardBatch(unsigned const streamIndex);
+
+            /*!***********************************************************************************
+             \brief Ends the current batch of every stream once it has been drawn, so that
+                    the next batch starts after it.
+            *************************************************************************************/
+            void SubmitBatch();
+
+            /*!***********************************************************************************
+             \brief Unmaps and deletes the buffer object and the fences.
+            *************************************************************************************/
+            void Cleanup();
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Creates and maps a buffer object big enough for the capacity passed in and
+                    lays out the range of each stream in a region.
+
+             \param[in] instanceCapacity Number of instances each region should hold.
+             \return true - If the buffer object was created and mapped.
+             \return false - If the buffer object could not be created or mapped.
+            *************************************************************************************/
+            bool CreateBuffer(std::size_t const instanceCapacity);
+
+            /*!***********************************************************************************
+             \brief Replaces the buffer object with one that can hold at least the number of
+                    instances passed in. The current batch of every stream is copied to the
+                    first region of the new buffer, which becomes the current region.
+
+             \param[in] instanceCapacity Minimum number of instances each region should hold.
+            *************************************************************************************/
+            void Grow(std::size_t const instanceCapacity);
+
+            // ----- Private variables ----- //
+        private:
+            struct Stream
+            {
+                GLsizeiptr bytesPerInstance{}; // Number of bytes each instance takes up
+                GLintptr offset{};             // Offset of the range of the stream from the start of a region
+                GLsizeiptr capacity{};         // Size in bytes of the range of the stream
+                GLintptr batchStart{};         // Offset of the current batch from the start of the range
+                GLintptr head{};               // Offset of the end of the data written from the start of the range
+            };
+
+            RenderBackend* m_p_backend{ nullptr };       // Backend the buffer and fences were created through
+            std::vector<Stream> m_streams{};
+            std::array<GLsync, framesInFlight> m_fences{}; // Fence placed after the last frame that wrote into each region
+
+            GLuint m_bufferObject{};               // Handle to the buffer object
+            unsigned char* m_p_mapped{ nullptr };  // Start of the mapped buffer
+            GLsizeiptr m_regionSize{};             // Size in bytes of each region
+            std::size_t m_instanceCapacity{};      // Number of instances each region can hold
+            unsigned m_currentRegion{};            // Region written to this frame
+
+            unsigned long long m_frameUploadBytes{}; // Bytes written this frame
+            unsigned m_frameBatchCount{};            // Batches submitted this frame
+            unsigned long long m_stallCount{};       // Times the CPU waited on a fence
+            unsigned long long m_growCount{};        // Times the buffer was recreated with a larger capacity
+        };
+
+        /*!***********************************************************************************
+         \brief Typed view of a stream of an InstanceRingBuffer. Mirrors the parts of
+                std::vector the batching code uses, so that instances are written straight
+                into the mapped buffer instead of being copied into it when drawn.
+
+         \tparam T Type of the elements of the stream. Must be trivially destructible as the
+                   elements are never destroyed.
+        *************************************************************************************/
+        template <typename T>
+        class InstanceStream
+        {
+            static_assert(std::is_trivially_destructible<T>::value, "Instance data must be trivially destructible");
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Sets the ring buffer and the stream of it to write elements to.
+
+             \param[in,out] r_ringBuffer Ring buffer to write to.
+             \param[in] streamIndex Index of the stream of the ring buffer.
+            *************************************************************************************/
+            void Attach(InstanceRingBuffer& r_ringBuffer, unsigned const streamIndex)
+            {
+                m_p_ringBuffer = &r_ringBuffer;
+                m_streamIndex = streamIndex;
+            }
+
+            /*!***********************************************************************************
+             \brief Constructs an element at the end of the current batch.
+
+             \param[in] args Arguments to construct the element with.
+            *************************************************************************************/
+            template <typename... Args>
+            void emplace_back(Args&&... args)
+            {
+                new (m_p_ringBuffer->Allocate(m_streamIndex, static_cast<GLsizeiptr>(sizeof(T)))) T(std::forward<Args>(args)...);
+            }
+
+            /*!***********************************************************************************
+             \brief Returns the number of elements in the current batch.
+
+             \return std::size_t - Number of elements in the current batch.
+            *************************************************************************************/
+            std::size_t size() const
+            {
+                return static_cast<std::size_t>(m_p_ringBuffer->GetBatchSize(m_streamIndex)) / sizeof(T);
+            }
+
+            /*!***********************************************************************************
+             \brief Throws away the elements in the current batch.
+            *************************************************************************************/
+            void clear() { m_p_ringBuffer->DiscardBatch(m_streamIndex); }
+
+            /*!***********************************************************************************
+             \brief Returns the offset of the current batch from the start of the buffer object.
+
+             \return GLintptr - Offset in bytes of the first element of the batch.
+            *************************************************************************************/
+            GLintptr GetBatchOffset() const { return m_p_ringBuffer->GetBatchOffset(m_streamIndex); }
+
+            // ----- Private variables ----- //
+        private:
+            InstanceRingBuffer* m_p_ringBuffer{ nullptr }; // Ring buffer written to
+            unsigned m_streamIndex{};                      // Stream of the ring buffer written to
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
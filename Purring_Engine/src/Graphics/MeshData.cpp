@@ -17,6 +17,7 @@
 
 #include "prpch.h"
 #include "MeshData.h"
+#include "RenderBackend.h"
 #include "Logging/Logger.h"
 
 extern Logger engine_logger;
@@ -45,8 +46,11 @@ namespace PE
                 return false;
             }
 
+            RenderBackend& r_backend{ RenderBackend::GetResourceBackend() };
+
             // Create buffer object for vertex data
-            glCreateBuffers(1, &m_vertexBufferObject);
+            m_vertexBufferObject = r_backend.CreateBuffer(
+                static_cast<GLsizeiptr>(sizeof(VertexData) * vertices.size()), vertices.data());
             if (0 == m_vertexBufferObject)
             {
                 engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
@@ -55,61 +59,48 @@ namespace PE
 
                 return false;
             }
-            glNamedBufferStorage(m_vertexBufferObject,
-                static_cast<GLsizeiptr>(sizeof(VertexData) * vertices.size()),
-                reinterpret_cast<GLvoid*>(vertices.data()),
-                GL_DYNAMIC_STORAGE_BIT);
 
             // Create buffer object for element data
-            glCreateBuffers(1, &m_elementBufferObject);
+            m_elementBufferObject = r_backend.CreateBuffer(
+                static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)), indices.data());
             if (0 == m_elementBufferObject)
             {
                 engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
                 engine_logger.SetTime();
                 engine_logger.AddLog(false, "Unable to create Element Buffer Object.", __FUNCTION__);
 
-                glDeleteBuffers(1, &m_vertexBufferObject);
+                r_backend.DeleteBuffer(m_vertexBufferObject);
                 return false;
             }
-            glNamedBufferStorage(m_elementBufferObject,
-                static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)),
-                reinterpret_cast<GLvoid*>(indices.data()), GL_DYNAMIC_STORAGE_BIT);
 
             // Create VAO
-            glCreateVertexArrays(1, &m_vertexArrayObject);
+            m_vertexArrayObject = r_backend.CreateVertexArray();
             if (0 == m_vertexArrayObject)
             {
                 engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
                 engine_logger.SetTime();
                 engine_logger.AddLog(false, "Unable to create Vertex Array Object.", __FUNCTION__);
 
-                glDeleteBuffers(1, &m_vertexBufferObject);
-                glDeleteBuffers(1, &m_elementBufferObject);
+                r_backend.DeleteBuffer(m_vertexBufferObject);
+                r_backend.DeleteBuffer(m_elementBufferObject);
                 return false;
             }
 
             // Bind the positions to attrib 0
             GLuint attributeIndex{ 0 }, bindingIndex{ 0 };
-            glEnableVertexArrayAttrib(m_vertexArrayObject, attributeIndex);
-            glVertexArrayVertexBuffer(m_vertexArrayObject, bindingIndex, m_vertexBufferObject, 0,
+            r_backend.BindVertexBuffer(m_vertexArrayObject, bindingIndex, m_vertexBufferObject, 0,
                 static_cast<GLsizei>(sizeof(VertexData)));
-            glVertexArrayAttribFormat(m_vertexArrayObject, attributeIndex, 2, GL_FLOAT, GL_FALSE, 0);
-            glVertexArrayAttribBinding(m_vertexArrayObject, attributeIndex, bindingIndex);
+            r_backend.SetVertexAttribute(m_vertexArrayObject, attributeIndex, bindingIndex, 2, GL_FLOAT, GL_FALSE, 0);
 
             // Bind the texture coordinate to attrib 1
             attributeIndex = 1, bindingIndex = 1;
-            glEnableVertexArrayAttrib(m_vertexArrayObject, attributeIndex);
-            glVertexArrayVertexBuffer(m_vertexArrayObject, bindingIndex, m_vertexBufferObject, 0,
+            r_backend.BindVertexBuffer(m_vertexArrayObject, bindingIndex, m_vertexBufferObject, 0,
                 static_cast<GLsizei>(sizeof(VertexData)));
-            glVertexArrayAttribFormat(m_vertexArrayObject, attributeIndex, 2, GL_FLOAT, GL_FALSE,
-                static_cast<GLintptr>(sizeof(glm::vec2))); // offset by vert pos and color
-            glVertexArrayAttribBinding(m_vertexArrayObject, attributeIndex, bindingIndex);
+            r_backend.SetVertexAttribute(m_vertexArrayObject, attributeIndex, bindingIndex, 2, GL_FLOAT, GL_FALSE,
+                static_cast<GLuint>(sizeof(glm::vec2))); // offset by vert pos and color
 
             // Bind the element array to the vert array
-            glVertexArrayElementBuffer(m_vertexArrayObject, m_elementBufferObject);
-
-            // Break the binding
-            glBindVertexArray(0);
+            r_backend.SetElementBuffer(m_vertexArrayObject, m_elementBufferObject);
 
             return true;
         }
@@ -137,9 +128,10 @@ namespace PE
         void MeshData::Cleanup()
         {
             // Delete the vao, vbo and ebo
-            glDeleteBuffers(1, &m_vertexBufferObject);
-            glDeleteBuffers(1, &m_elementBufferObject);
-            glDeleteVertexArrays(1, &m_vertexArrayObject);
+            RenderBackend& r_backend{ RenderBackend::GetResourceBackend() };
+            r_backend.DeleteBuffer(m_vertexBufferObject);
+            r_backend.DeleteBuffer(m_elementBufferObject);
+            r_backend.DeleteVertexArray(m_vertexArrayObject);
         }
     } // End of Graphics namespace
 } // End of PE namespace
@@ -0,0 +1,892 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     RenderBackend.cpp
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions of the OpenGL, null and
+           trace render backends.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "RenderBackend.h"
+#include "ShaderProgram.h"
+
+#include <cstring>
+
+namespace PE
+{
+    namespace Graphics
+    {
+        // ----- Resource backend ----- //
+
+        namespace
+        {
+            GLRenderBackend glResourceBackend{};
+            RenderBackend* p_resourceBackend{ &glResourceBackend };
+
+
+            /*!***********************************************************************************
+             \brief Compiles a shader and attaches it to a program.
+
+             \param[in] program Handle of the program.
+             \param[in] r_source Code of the shader.
+             \param[in] shaderType Type of the shader (e.g. GL_VERTEX_SHADER).
+             \param[out] r_log What went wrong if the shader could not be compiled.
+             \return true - If the shader was compiled and attached.
+             \return false - If the shader could not be compiled.
+            *************************************************************************************/
+            bool CompileAndAttachShader(GLuint const program, std::string const& r_source, GLenum const shaderType, std::string& r_log)
+            {
+                GLchar const* p_source{ r_source.c_str() };
+                GLuint const shader{ glCreateShader(shaderType) };
+                glShaderSource(shader, 1, &p_source, nullptr);
+                glCompileShader(shader);
+
+                GLint status{};
+                glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+                if (GL_FALSE == status)
+                {
+                    GLchar informationLog[1024]{};
+                    glGetShaderInfoLog(shader, sizeof(informationLog), nullptr, informationLog);
+                    r_log = std::string{ "Unable to compile shader: " } + informationLog;
+                    glDeleteShader(shader);
+                    return false;
+                }
+
+                // Only deleted once the program it is attached to is deleted
+                glAttachShader(program, shader);
+                glDeleteShader(shader);
+                return true;
+            }
+        }
+
+
+        RenderBackend& RenderBackend::GetResourceBackend()
+        {
+            return *p_resourceBackend;
+        }
+
+
+        void RenderBackend::SetResourceBackend(RenderBackend& r_backend)
+        {
+            p_resourceBackend = &r_backend;
+        }
+
+
+        // ----- OpenGL ----- //
+
+        GLuint GLRenderBackend::CreateBuffer(GLsizeiptr const size, void const* p_data)
+        {
+            GLuint buffer{};
+            glCreateBuffers(1, &buffer);
+            glNamedBufferStorage(buffer, size, p_data, GL_DYNAMIC_STORAGE_BIT);
+            return buffer;
+        }
+
+
+        GLuint GLRenderBackend::CreateVertexArray()
+        {
+            GLuint vertexArray{};
+            glCreateVertexArrays(1, &vertexArray);
+            return vertexArray;
+        }
+
+
+        void GLRenderBackend::SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+            GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset)
+        {
+            glEnableVertexArrayAttrib(vertexArray, attributeIndex);
+            glVertexArrayAttribFormat(vertexArray, attributeIndex, size, type, normalized, offset);
+            glVertexArrayAttribBinding(vertexArray, attributeIndex, bindingIndex);
+        }
+
+
+        void GLRenderBackend::SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor)
+        {
+            glVertexArrayBindingDivisor(vertexArray, bindingIndex, divisor);
+        }
+
+
+        void GLRenderBackend::SetElementBuffer(GLuint const vertexArray, GLuint const buffer)
+        {
+            glVertexArrayElementBuffer(vertexArray, buffer);
+        }
+
+
+        void GLRenderBackend::DeleteVertexArray(GLuint const vertexArray)
+        {
+            glDeleteVertexArrays(1, &vertexArray);
+        }
+
+
+        GLuint GLRenderBackend::CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+            GLenum const format, GLint const wrapMode, void const* p_texels)
+        {
+            GLuint texture{};
+            glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+            glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_S, wrapMode);
+            glTextureParameteri(texture, GL_TEXTURE_WRAP_T, wrapMode);
+
+            // Glyphs such as spaces have no texels at all
+            if (width > 0 && height > 0)
+            {
+                // Rows of single channel texels are not padded to 4 bytes
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+                glTextureStorage2D(texture, 1, internalFormat, width, height);
+                glTextureSubImage2D(texture, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, p_texels);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            }
+            return texture;
+        }
+
+
+        GLuint GLRenderBackend::CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat)
+        {
+            GLuint textureArray{};
+            glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &textureArray);
+            glTextureStorage3D(textureArray, 1, internalFormat, width, height, layers);
+            glTextureParameteri(textureArray, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(textureArray, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteri(textureArray, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTextureParameteri(textureArray, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+            // Start every layer transparent
+            glClearTexImage(textureArray, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            return textureArray;
+        }
+
+
+        void GLRenderBackend::CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+            GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+            GLsizei const width, GLsizei const height, GLsizei const depth)
+        {
+            glCopyImageSubData(sourceTexture, sourceTarget, 0, sourceX, sourceY, sourceZ,
+                destinationTexture, destinationTarget, 0, destinationX, destinationY, destinationZ,
+                width, height, depth);
+        }
+
+
+        void GLRenderBackend::DeleteTexture(GLuint const texture)
+        {
+            glDeleteTextures(1, &texture);
+        }
+
+
+        GLint GLRenderBackend::GetMaxTextureSize()
+        {
+            GLint maxTextureSize{};
+            glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+            return maxTextureSize;
+        }
+
+
+        GLuint GLRenderBackend::CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log)
+        {
+            r_log.clear();
+            GLuint const program{ glCreateProgram() };
+            if (!program)
+            {
+                r_log = "Cannot create shader program handle.";
+                return 0;
+            }
+
+            if (!CompileAndAttachShader(program, r_vertexSource, GL_VERTEX_SHADER, r_log) ||
+                !CompileAndAttachShader(program, r_fragmentSource, GL_FRAGMENT_SHADER, r_log))
+            {
+                glDeleteProgram(program);
+                return 0;
+            }
+
+            GLchar informationLog[1024]{};
+            GLint status{};
+            glLinkProgram(program);
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            if (GL_FALSE == status)
+            {
+                glGetProgramInfoLog(program, sizeof(informationLog), nullptr, informationLog);
+                r_log = std::string{ "Unable to link shader program: " } + informationLog;
+                glDeleteProgram(program);
+                return 0;
+            }
+
+            glValidateProgram(program);
+            glGetProgramiv(program, GL_VALIDATE_STATUS, &status);
+            if (GL_FALSE == status)
+            {
+                glGetProgramInfoLog(program, sizeof(informationLog), nullptr, informationLog);
+                r_log = std::string{ "Shader program validation failed: " } + informationLog;
+                glDeleteProgram(program);
+                return 0;
+            }
+            return program;
+        }
+
+
+        void GLRenderBackend::DeleteProgram(GLuint const program)
+        {
+            glDeleteProgram(program);
+        }
+
+
+        GLuint GLRenderBackend::CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped)
+        {
+            // Created and mapped with the same flags so that it can stay mapped while it is drawn from
+            GLbitfield const mapFlags{ GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT };
+
+            r_p_mapped = nullptr;
+            GLuint buffer{};
+            glCreateBuffers(1, &buffer);
+            if (!buffer) { return 0; }
+
+            glNamedBufferStorage(buffer, size, nullptr, mapFlags);
+            r_p_mapped = glMapNamedBufferRange(buffer, 0, size, mapFlags);
+            return buffer;
+        }
+
+
+        void GLRenderBackend::UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data)
+        {
+            if (!r_buffer)
+            {
+                glCreateBuffers(1, &r_buffer);
+            }
+            glNamedBufferData(r_buffer, size, p_data, GL_STATIC_DRAW);
+        }
+
+
+        void GLRenderBackend::UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data)
+        {
+            glNamedBufferSubData(buffer, offset, size, p_data);
+        }
+
+
+        void GLRenderBackend::CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+            GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size)
+        {
+            glCopyNamedBufferSubData(sourceBuffer, destinationBuffer, sourceOffset, destinationOffset, size);
+        }
+
+
+        void GLRenderBackend::UnmapBuffer(GLuint const buffer)
+        {
+            glUnmapNamedBuffer(buffer);
+        }
+
+
+        void GLRenderBackend::DeleteBuffer(GLuint const buffer)
+        {
+            glDeleteBuffers(1, &buffer);
+        }
+
+
+        GLsync GLRenderBackend::CreateFence()
+        {
+            return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+
+        bool GLRenderBackend::WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout)
+        {
+            return glClientWaitSync(fence, flush ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout) != GL_TIMEOUT_EXPIRED;
+        }
+
+
+        void GLRenderBackend::DeleteFence(GLsync const fence)
+        {
+            glDeleteSync(fence);
+        }
+
+
+        void GLRenderBackend::UseProgram(ShaderProgram const& r_program)
+        {
+            r_program.Use();
+        }
+
+
+        void GLRenderBackend::UnuseProgram(ShaderProgram const& r_program)
+        {
+            r_program.UnUse();
+        }
+
+
+        void GLRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value)
+        {
+            r_program.SetUniform(r_name, r_value);
+        }
+
+
+        void GLRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value)
+        {
+            r_program.SetUniform(r_name, r_value);
+        }
+
+
+        void GLRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value)
+        {
+            r_program.SetUniform(r_name, value);
+        }
+
+
+        void GLRenderBackend::BindVertexArray(GLuint const vertexArray)
+        {
+            glBindVertexArray(vertexArray);
+        }
+
+
+        void GLRenderBackend::BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+            GLintptr const offset, GLsizei const stride)
+        {
+            glVertexArrayVertexBuffer(vertexArray, bindingIndex, buffer, offset, stride);
+        }
+
+
+        void GLRenderBackend::BindTextureUnit(GLuint const unit, GLuint const texture)
+        {
+            glBindTextureUnit(unit, texture);
+        }
+
+
+        void GLRenderBackend::DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count)
+        {
+            glDrawArrays(primitiveType, first, count);
+        }
+
+
+        void GLRenderBackend::DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount)
+        {
+            glDrawElementsInstanced(primitiveType, indexCount, GL_UNSIGNED_SHORT, NULL, instanceCount);
+        }
+
+
+        // ----- Null ----- //
+
+        GLuint NullRenderBackend::CreateBuffer(GLsizeiptr const size, void const* p_data)
+        {
+            p_data; // Prevent warnings
+
+            m_stats.bytesUploaded += static_cast<unsigned long long>(size);
+            return m_nextBuffer++;
+        }
+
+
+        GLuint NullRenderBackend::CreateVertexArray()
+        {
+            return m_nextVertexArray++;
+        }
+
+
+        void NullRenderBackend::SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+            GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset)
+        {
+            vertexArray; attributeIndex; bindingIndex; size; type; normalized; offset; // Prevent warnings
+        }
+
+
+        void NullRenderBackend::SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor)
+        {
+            vertexArray; bindingIndex; divisor; // Prevent warnings
+        }
+
+
+        void NullRenderBackend::SetElementBuffer(GLuint const vertexArray, GLuint const buffer)
+        {
+            vertexArray; buffer; // Prevent warnings
+        }
+
+
+        void NullRenderBackend::DeleteVertexArray(GLuint const vertexArray)
+        {
+            vertexArray; // Prevent warnings
+        }
+
+
+        GLuint NullRenderBackend::CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+            GLenum const format, GLint const wrapMode, void const* p_texels)
+        {
+            width; height; internalFormat; format; wrapMode; p_texels; // Prevent warnings
+
+            return m_nextTexture++;
+        }
+
+
+        GLuint NullRenderBackend::CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat)
+        {
+            width; height; layers; internalFormat; // Prevent warnings
+
+            return m_nextTexture++;
+        }
+
+
+        void NullRenderBackend::CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+            GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+            GLsizei const width, GLsizei const height, GLsizei const depth)
+        {
+            sourceTexture; sourceTarget; sourceX; sourceY; sourceZ; // Prevent warnings
+            destinationTexture; destinationTarget; destinationX; destinationY; destinationZ;
+            width; height; depth;
+        }
+
+
+        void NullRenderBackend::DeleteTexture(GLuint const texture)
+        {
+            texture; // Prevent warnings
+        }
+
+
+        GLint NullRenderBackend::GetMaxTextureSize()
+        {
+            return maxTextureSize;
+        }
+
+
+        GLuint NullRenderBackend::CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log)
+        {
+            r_vertexSource; r_fragmentSource; // Prevent warnings
+
+            r_log.clear();
+            return m_nextProgram++;
+        }
+
+
+        void NullRenderBackend::DeleteProgram(GLuint const program)
+        {
+            program; // Prevent warnings
+        }
+
+
+        GLuint NullRenderBackend::CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped)
+        {
+            GLuint const buffer{ m_nextBuffer++ };
+            std::vector<unsigned char>& r_memory{ m_mappedBuffers[buffer] };
+            r_memory.resize(static_cast<std::size_t>(size));
+            r_p_mapped = r_memory.data();
+            return buffer;
+        }
+
+
+        void NullRenderBackend::UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data)
+        {
+            p_data; // Prevent warnings
+
+            if (!r_buffer)
+            {
+                r_buffer = m_nextBuffer++;
+            }
+            m_stats.bytesUploaded += static_cast<unsigned long long>(size);
+        }
+
+
+        void NullRenderBackend::UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data)
+        {
+            buffer; offset; p_data; // Prevent warnings
+
+            m_stats.bytesUploaded += static_cast<unsigned long long>(size);
+        }
+
+
+        void NullRenderBackend::CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+            GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size)
+        {
+            // Keep the data of mapped buffers, as it is read back from them
+            auto const sourceIterator{ m_mappedBuffers.find(sourceBuffer) };
+            auto const destinationIterator{ m_mappedBuffers.find(destinationBuffer) };
+            if (sourceIterator != m_mappedBuffers.end() && destinationIterator != m_mappedBuffers.end())
+            {
+                std::memmove(destinationIterator->second.data() + destinationOffset, sourceIterator->second.data() + sourceOffset,
+                    static_cast<std::size_t>(size));
+            }
+        }
+
+
+        void NullRenderBackend::UnmapBuffer(GLuint const buffer)
+        {
+            buffer; // Prevent warnings
+        }
+
+
+        void NullRenderBackend::DeleteBuffer(GLuint const buffer)
+        {
+            m_mappedBuffers.erase(buffer);
+        }
+
+
+        GLsync NullRenderBackend::CreateFence()
+        {
+            // Never waited on, so the handle only has to be unique
+            return reinterpret_cast<GLsync>(m_nextFence++);
+        }
+
+
+        bool NullRenderBackend::WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout)
+        {
+            fence; flush; timeout; // Prevent warnings
+
+            return true;
+        }
+
+
+        void NullRenderBackend::DeleteFence(GLsync const fence)
+        {
+            fence; // Prevent warnings
+        }
+
+
+        void NullRenderBackend::UseProgram(ShaderProgram const& r_program)
+        {
+            CountBinding(m_p_boundProgram, &r_program);
+        }
+
+
+        void NullRenderBackend::UnuseProgram(ShaderProgram const& r_program)
+        {
+            r_program; // Prevent warnings
+
+            CountBinding(m_p_boundProgram, static_cast<ShaderProgram const*>(nullptr));
+        }
+
+
+        void NullRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value)
+        {
+            r_program; r_name; r_value; // Prevent warnings
+
+            ++m_stats.stateChanges;
+        }
+
+
+        void NullRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value)
+        {
+            r_program; r_name; r_value; // Prevent warnings
+
+            ++m_stats.stateChanges;
+        }
+
+
+        void NullRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value)
+        {
+            r_program; r_name; value; // Prevent warnings
+
+            ++m_stats.stateChanges;
+        }
+
+
+        void NullRenderBackend::BindVertexArray(GLuint const vertexArray)
+        {
+            CountBinding(m_boundVertexArray, vertexArray);
+        }
+
+
+        void NullRenderBackend::BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+            GLintptr const offset, GLsizei const stride)
+        {
+            stride; // Prevent warnings
+
+            unsigned long long const bindingKey{ (static_cast<unsigned long long>(vertexArray) << 32) | bindingIndex };
+            CountBinding(m_boundVertexBuffers[bindingKey], std::pair<GLuint, GLintptr>{ buffer, offset });
+        }
+
+
+        void NullRenderBackend::BindTextureUnit(GLuint const unit, GLuint const texture)
+        {
+            CountBinding(m_boundTextures[unit], texture);
+        }
+
+
+        void NullRenderBackend::DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count)
+        {
+            primitiveType; first; count; // Prevent warnings
+
+            CountDraw(1);
+        }
+
+
+        void NullRenderBackend::DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount)
+        {
+            primitiveType; indexCount; // Prevent warnings
+
+            CountDraw(instanceCount);
+        }
+
+
+        void NullRenderBackend::CountDraw(GLsizei const instanceCount)
+        {
+            ++m_stats.drawCalls;
+            m_stats.instances += static_cast<unsigned long long>(instanceCount);
+
+            // Bucket of the highest power of two in the instance count
+            std::size_t bucket{};
+            for (GLsizei size{ instanceCount }; size > 1 && bucket < batchSizeBuckets - 1; size >>= 1)
+            {
+                ++bucket;
+            }
+            ++m_stats.batchSizes[bucket];
+        }
+
+
+        // ----- Trace ----- //
+
+        TraceRenderBackend::TraceRenderBackend(RenderBackend& r_targetArg, std::string const& r_filePath)
+            : m_r_target{ r_targetArg }, m_file{ r_filePath }
+        {
+            m_file << "Frame 0\n";
+        }
+
+
+        GLuint TraceRenderBackend::CreateBuffer(GLsizeiptr const size, void const* p_data)
+        {
+            GLuint const buffer{ m_r_target.CreateBuffer(size, p_data) };
+            m_file << "CreateBuffer " << size << " -> " << buffer << '\n';
+            return buffer;
+        }
+
+
+        GLuint TraceRenderBackend::CreateVertexArray()
+        {
+            GLuint const vertexArray{ m_r_target.CreateVertexArray() };
+            m_file << "CreateVertexArray -> " << vertexArray << '\n';
+            return vertexArray;
+        }
+
+
+        void TraceRenderBackend::SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+            GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset)
+        {
+            m_file << "SetVertexAttribute " << vertexArray << ' ' << attributeIndex << ' ' << bindingIndex << ' '
+                << size << ' ' << type << ' ' << static_cast<int>(normalized) << ' ' << offset << '\n';
+            m_r_target.SetVertexAttribute(vertexArray, attributeIndex, bindingIndex, size, type, normalized, offset);
+        }
+
+
+        void TraceRenderBackend::SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor)
+        {
+            m_file << "SetBindingDivisor " << vertexArray << ' ' << bindingIndex << ' ' << divisor << '\n';
+            m_r_target.SetBindingDivisor(vertexArray, bindingIndex, divisor);
+        }
+
+
+        void TraceRenderBackend::SetElementBuffer(GLuint const vertexArray, GLuint const buffer)
+        {
+            m_file << "SetElementBuffer " << vertexArray << ' ' << buffer << '\n';
+            m_r_target.SetElementBuffer(vertexArray, buffer);
+        }
+
+
+        void TraceRenderBackend::DeleteVertexArray(GLuint const vertexArray)
+        {
+            m_file << "DeleteVertexArray " << vertexArray << '\n';
+            m_r_target.DeleteVertexArray(vertexArray);
+        }
+
+
+        GLuint TraceRenderBackend::CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+            GLenum const format, GLint const wrapMode, void const* p_texels)
+        {
+            GLuint const texture{ m_r_target.CreateTexture(width, height, internalFormat, format, wrapMode, p_texels) };
+            m_file << "CreateTexture " << width << ' ' << height << ' ' << internalFormat << ' '
+                << format << ' ' << wrapMode << " -> " << texture << '\n';
+            return texture;
+        }
+
+
+        GLuint TraceRenderBackend::CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat)
+        {
+            GLuint const textureArray{ m_r_target.CreateTextureArray(width, height, layers, internalFormat) };
+            m_file << "CreateTextureArray " << width << ' ' << height << ' ' << layers << ' '
+                << internalFormat << " -> " << textureArray << '\n';
+            return textureArray;
+        }
+
+
+        void TraceRenderBackend::CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+            GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+            GLsizei const width, GLsizei const height, GLsizei const depth)
+        {
+            m_file << "CopyTexels " << sourceTexture << ' ' << sourceTarget << ' ' << sourceX << ' ' << sourceY << ' ' << sourceZ << ' '
+                << destinationTexture << ' ' << destinationTarget << ' ' << destinationX << ' ' << destinationY << ' ' << destinationZ << ' '
+                << width << ' ' << height << ' ' << depth << '\n';
+            m_r_target.CopyTexels(sourceTexture, sourceTarget, sourceX, sourceY, sourceZ,
+                destinationTexture, destinationTarget, destinationX, destinationY, destinationZ, width, height, depth);
+        }
+
+
+        void TraceRenderBackend::DeleteTexture(GLuint const texture)
+        {
+            m_file << "DeleteTexture " << texture << '\n';
+            m_r_target.DeleteTexture(texture);
+        }
+
+
+        GLint TraceRenderBackend::GetMaxTextureSize()
+        {
+            return m_r_target.GetMaxTextureSize();
+        }
+
+
+        GLuint TraceRenderBackend::CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log)
+        {
+            GLuint const program{ m_r_target.CreateProgram(r_vertexSource, r_fragmentSource, r_log) };
+            m_file << "CreateProgram -> " << program << '\n';
+            return program;
+        }
+
+
+        void TraceRenderBackend::DeleteProgram(GLuint const program)
+        {
+            m_file << "DeleteProgram " << program << '\n';
+            m_r_target.DeleteProgram(program);
+        }
+
+
+        GLuint TraceRenderBackend::CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped)
+        {
+            GLuint const buffer{ m_r_target.CreateMappedBuffer(size, r_p_mapped) };
+            m_file << "CreateMappedBuffer " << size << " -> " << buffer << '\n';
+            return buffer;
+        }
+
+
+        void TraceRenderBackend::UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data)
+        {
+            m_r_target.UploadBuffer(r_buffer, size, p_data);
+            m_file << "UploadBuffer " << r_buffer << ' ' << size << '\n';
+        }
+
+
+        void TraceRenderBackend::UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data)
+        {
+            m_file << "UpdateBuffer " << buffer << ' ' << offset << ' ' << size << '\n';
+            m_r_target.UpdateBuffer(buffer, offset, size, p_data);
+        }
+
+
+        void TraceRenderBackend::CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+            GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size)
+        {
+            m_file << "CopyBuffer " << sourceBuffer << ' ' << destinationBuffer << ' '
+                << sourceOffset << ' ' << destinationOffset << ' ' << size << '\n';
+            m_r_target.CopyBuffer(sourceBuffer, destinationBuffer, sourceOffset, destinationOffset, size);
+        }
+
+
+        void TraceRenderBackend::UnmapBuffer(GLuint const buffer)
+        {
+            m_file << "UnmapBuffer " << buffer << '\n';
+            m_r_target.UnmapBuffer(buffer);
+        }
+
+
+        void TraceRenderBackend::DeleteBuffer(GLuint const buffer)
+        {
+            m_file << "DeleteBuffer " << buffer << '\n';
+            m_r_target.DeleteBuffer(buffer);
+        }
+
+
+        GLsync TraceRenderBackend::CreateFence()
+        {
+            GLsync const fence{ m_r_target.CreateFence() };
+            m_file << "CreateFence -> " << fence << '\n';
+            return fence;
+        }
+
+
+        bool TraceRenderBackend::WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout)
+        {
+            bool const isDone{ m_r_target.WaitFence(fence, flush, timeout) };
+            m_file << "WaitFence " << fence << ' ' << flush << ' ' << timeout << " -> " << isDone << '\n';
+            return isDone;
+        }
+
+
+        void TraceRenderBackend::DeleteFence(GLsync const fence)
+        {
+            m_file << "DeleteFence " << fence << '\n';
+            m_r_target.DeleteFence(fence);
+        }
+
+
+        void TraceRenderBackend::UseProgram(ShaderProgram const& r_program)
+        {
+            m_file << "UseProgram " << &r_program << '\n';
+            m_r_target.UseProgram(r_program);
+        }
+
+
+        void TraceRenderBackend::UnuseProgram(ShaderProgram const& r_program)
+        {
+            m_file << "UnuseProgram " << &r_program << '\n';
+            m_r_target.UnuseProgram(r_program);
+        }
+
+
+        void TraceRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value)
+        {
+            m_file << "SetUniform " << r_name << " mat4\n";
+            m_r_target.SetUniform(r_program, r_name, r_value);
+        }
+
+
+        void TraceRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value)
+        {
+            m_file << "SetUniform " << r_name << ' ' << r_value.x << ' ' << r_value.y << ' ' << r_value.z << ' ' << r_value.w << '\n';
+            m_r_target.SetUniform(r_program, r_name, r_value);
+        }
+
+
+        void TraceRenderBackend::SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value)
+        {
+            m_file << "SetUniform " << r_name << ' ' << value << '\n';
+            m_r_target.SetUniform(r_program, r_name, value);
+        }
+
+
+        void TraceRenderBackend::BindVertexArray(GLuint const vertexArray)
+        {
+            m_file << "BindVertexArray " << vertexArray << '\n';
+            m_r_target.BindVertexArray(vertexArray);
+        }
+
+
+        void TraceRenderBackend::BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+            GLintptr const offset, GLsizei const stride)
+        {
+            m_file << "BindVertexBuffer " << vertexArray << ' ' << bindingIndex << ' ' << buffer << ' ' << offset << ' ' << stride << '\n';
+            m_r_target.BindVertexBuffer(vertexArray, bindingIndex, buffer, offset, stride);
+        }
+
+
+        void TraceRenderBackend::BindTextureUnit(GLuint const unit, GLuint const texture)
+        {
+            m_file << "BindTextureUnit " << unit << ' ' << texture << '\n';
+            m_r_target.BindTextureUnit(unit, texture);
+        }
+
+
+        void TraceRenderBackend::DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count)
+        {
+            m_file << "DrawArrays " << primitiveType << ' ' << first << ' ' << count << '\n';
+            m_r_target.DrawArrays(primitiveType, first, count);
+        }
+
+
+        void TraceRenderBackend::DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount)
+        {
+            m_file << "DrawElementsInstanced " << primitiveType << ' ' << indexCount << ' ' << instanceCount << '\n';
+            m_r_target.DrawElementsInstanced(primitiveType, indexCount, instanceCount);
+        }
+
+
+        void TraceRenderBackend::EndFrame()
+        {
+            m_r_target.EndFrame();
+            m_file << "Frame " << ++m_frame << '\n';
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
@@ -0,0 +1,650 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     RenderBackend.h
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the RenderBackend interface, which the
+           render passes submit their buffers, state changes and draw calls through and
+           the resources are created through, and of the OpenGL, null and trace backends
+           that implement it.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+#include <glm/glm.hpp>
+
+#include <array>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace PE
+{
+    namespace Graphics
+    {
+        class ShaderProgram;
+
+        /*!***********************************************************************************
+         \brief Everything the render passes send to the GPU each frame: the instance buffers
+                they write into, the program, uniforms, vertex arrays and textures they draw
+                with, and the draw calls themselves. Meshes, shaders, textures and fonts are
+                created through the resource backend when they are loaded, so that nothing
+                needs an OpenGL context when the resource backend is a null one.
+
+                Backends are only used from the main thread.
+        *************************************************************************************/
+        class RenderBackend
+        {
+            // ----- Constructors ----- //
+        public:
+            virtual ~RenderBackend() = default;
+
+            // ----- Resource backend ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns the backend meshes, shaders, textures and fonts are created and
+                    deleted through. This is an OpenGL backend unless another one has been set.
+
+             \return RenderBackend& - Backend of the resources.
+            *************************************************************************************/
+            static RenderBackend& GetResourceBackend();
+
+            /*!***********************************************************************************
+             \brief Sets the backend meshes, shaders, textures and fonts are created and deleted
+                    through. Resources are deleted through the backend they are created with,
+                    so it has to be set before anything is loaded, and has to outlive every
+                    resource.
+
+             \param[in] r_backend Backend of the resources.
+            *************************************************************************************/
+            static void SetResourceBackend(RenderBackend& r_backend);
+
+            // ----- Resources ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Creates a buffer of a fixed size that can be written to with UpdateBuffer().
+
+             \param[in] size Size of the buffer in bytes.
+             \param[in] p_data Data to fill the buffer with, nullptr to leave it empty.
+             \return GLuint - Handle of the buffer, 0 if it could not be created.
+            *************************************************************************************/
+            virtual GLuint CreateBuffer(GLsizeiptr const size, void const* p_data) = 0;
+
+            /*!***********************************************************************************
+             \brief Creates a vertex array without any attributes.
+
+             \return GLuint - Handle of the vertex array, 0 if it could not be created.
+            *************************************************************************************/
+            virtual GLuint CreateVertexArray() = 0;
+
+            /*!***********************************************************************************
+             \brief Enables an attribute of a vertex array, and sets the binding it is read from
+                    and the format it is read in.
+
+             \param[in] vertexArray Handle of the vertex array.
+             \param[in] attributeIndex Attribute of the vertex array.
+             \param[in] bindingIndex Binding the attribute is read from.
+             \param[in] size Number of components of the attribute.
+             \param[in] type Type of each component.
+             \param[in] normalized Whether integer components are mapped to [0, 1].
+             \param[in] offset Offset in bytes of the attribute in each element.
+            *************************************************************************************/
+            virtual void SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+                GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets how many instances are drawn before a binding of a vertex array moves
+                    on to its next element.
+
+             \param[in] vertexArray Handle of the vertex array.
+             \param[in] bindingIndex Binding of the vertex array.
+             \param[in] divisor Instances per element, 0 to move on every vertex.
+            *************************************************************************************/
+            virtual void SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets the buffer a vertex array reads its indices from.
+
+             \param[in] vertexArray Handle of the vertex array.
+             \param[in] buffer Handle of the buffer of indices.
+            *************************************************************************************/
+            virtual void SetElementBuffer(GLuint const vertexArray, GLuint const buffer) = 0;
+
+            /*!***********************************************************************************
+             \brief Deletes a vertex array.
+
+             \param[in] vertexArray Handle of the vertex array.
+            *************************************************************************************/
+            virtual void DeleteVertexArray(GLuint const vertexArray) = 0;
+
+            /*!***********************************************************************************
+             \brief Creates a 2D texture that is sampled with linear filtering, and fills it.
+
+             \param[in] width Width of the texture in texels.
+             \param[in] height Height of the texture in texels.
+             \param[in] internalFormat Format the texels are stored in.
+             \param[in] format Format of the texels passed in, a byte per channel in rows
+                               without padding.
+             \param[in] wrapMode How the texture is sampled outside of [0, 1].
+             \param[in] p_texels Texels to fill the texture with.
+             \return GLuint - Handle of the texture, 0 if it could not be created.
+            *************************************************************************************/
+            virtual GLuint CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+                GLenum const format, GLint const wrapMode, void const* p_texels) = 0;
+
+            /*!***********************************************************************************
+             \brief Creates an array of 2D textures that are sampled with linear filtering and
+                    clamped to their edges, with every texel transparent.
+
+             \param[in] width Width of each layer in texels.
+             \param[in] height Height of each layer in texels.
+             \param[in] layers Number of layers.
+             \param[in] internalFormat Format the texels are stored in.
+             \return GLuint - Handle of the texture array, 0 if it could not be created.
+            *************************************************************************************/
+            virtual GLuint CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat) = 0;
+
+            /*!***********************************************************************************
+             \brief Copies a box of texels from one texture to another. The z coordinate and the
+                    depth are the layers of a texture array, and are 0 and 1 for a 2D texture.
+
+             \param[in] sourceTexture Handle of the texture to copy from.
+             \param[in] sourceTarget Whether the texture to copy from is 2D or an array.
+             \param[in] sourceX Left of the box in the texture to copy from.
+             \param[in] sourceY Bottom of the box in the texture to copy from.
+             \param[in] sourceZ First layer of the box in the texture to copy from.
+             \param[in] destinationTexture Handle of the texture to copy to.
+             \param[in] destinationTarget Whether the texture to copy to is 2D or an array.
+             \param[in] destinationX Left of the box in the texture to copy to.
+             \param[in] destinationY Bottom of the box in the texture to copy to.
+             \param[in] destinationZ First layer of the box in the texture to copy to.
+             \param[in] width Width of the box in texels.
+             \param[in] height Height of the box in texels.
+             \param[in] depth Number of layers of the box.
+            *************************************************************************************/
+            virtual void CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+                GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+                GLsizei const width, GLsizei const height, GLsizei const depth) = 0;
+
+            /*!***********************************************************************************
+             \brief Deletes a texture or texture array.
+
+             \param[in] texture Handle of the texture.
+            *************************************************************************************/
+            virtual void DeleteTexture(GLuint const texture) = 0;
+
+            /*!***********************************************************************************
+             \brief Returns the largest width and height a texture can have.
+
+             \return GLint - Largest size of a texture in texels.
+            *************************************************************************************/
+            virtual GLint GetMaxTextureSize() = 0;
+
+            /*!***********************************************************************************
+             \brief Compiles a vertex and a fragment shader, and links and validates a program
+                    made of them.
+
+             \param[in] r_vertexSource Code of the vertex shader.
+             \param[in] r_fragmentSource Code of the fragment shader.
+             \param[out] r_log What went wrong if the program could not be made, empty otherwise.
+             \return GLuint - Handle of the program, 0 if it could not be made.
+            *************************************************************************************/
+            virtual GLuint CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log) = 0;
+
+            /*!***********************************************************************************
+             \brief Deletes a program.
+
+             \param[in] program Handle of the program.
+            *************************************************************************************/
+            virtual void DeleteProgram(GLuint const program) = 0;
+
+            // ----- Buffers ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Creates a buffer that stays mapped for writing for its whole lifetime, and
+                    whose writes are seen by the GPU without being flushed.
+
+             \param[in] size Size of the buffer in bytes.
+             \param[out] r_p_mapped Start of the mapped buffer, nullptr if it could not be mapped.
+             \return GLuint - Handle of the buffer, 0 if it could not be created.
+            *************************************************************************************/
+            virtual GLuint CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped) = 0;
+
+            /*!***********************************************************************************
+             \brief Replaces the contents of a buffer that is drawn from for many frames,
+                    creating the buffer if it does not exist yet.
+
+             \param[in,out] r_buffer Handle of the buffer, set if it is 0.
+             \param[in] size Size of the data in bytes.
+             \param[in] p_data Data to upload.
+            *************************************************************************************/
+            virtual void UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data) = 0;
+
+            /*!***********************************************************************************
+             \brief Writes data into part of a buffer.
+
+             \param[in] buffer Handle of the buffer.
+             \param[in] offset Offset in bytes to write the data at.
+             \param[in] size Size of the data in bytes.
+             \param[in] p_data Data to write.
+            *************************************************************************************/
+            virtual void UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data) = 0;
+
+            /*!***********************************************************************************
+             \brief Copies data from one buffer to another.
+
+             \param[in] sourceBuffer Handle of the buffer to copy from.
+             \param[in] destinationBuffer Handle of the buffer to copy to.
+             \param[in] sourceOffset Offset in bytes to copy from.
+             \param[in] destinationOffset Offset in bytes to copy to.
+             \param[in] size Number of bytes to copy.
+            *************************************************************************************/
+            virtual void CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+                GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size) = 0;
+
+            /*!***********************************************************************************
+             \brief Unmaps a buffer created by CreateMappedBuffer().
+
+             \param[in] buffer Handle of the buffer.
+            *************************************************************************************/
+            virtual void UnmapBuffer(GLuint const buffer) = 0;
+
+            /*!***********************************************************************************
+             \brief Deletes a buffer.
+
+             \param[in] buffer Handle of the buffer.
+            *************************************************************************************/
+            virtual void DeleteBuffer(GLuint const buffer) = 0;
+
+            // ----- Fences ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Places a fence after the commands submitted so far.
+
+             \return GLsync - Handle of the fence.
+            *************************************************************************************/
+            virtual GLsync CreateFence() = 0;
+
+            /*!***********************************************************************************
+             \brief Waits for the commands before a fence to be done.
+
+             \param[in] fence Handle of the fence.
+             \param[in] flush Whether to flush the commands before the fence first.
+             \param[in] timeout Time to wait for in nanoseconds, 0 to only check the fence.
+             \return true - If the commands before the fence are done.
+             \return false - If the wait timed out.
+            *************************************************************************************/
+            virtual bool WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout) = 0;
+
+            /*!***********************************************************************************
+             \brief Deletes a fence.
+
+             \param[in] fence Handle of the fence.
+            *************************************************************************************/
+            virtual void DeleteFence(GLsync const fence) = 0;
+
+            // ----- State ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Draws with a shader program until another one is used.
+
+             \param[in] r_program Shader program to draw with.
+            *************************************************************************************/
+            virtual void UseProgram(ShaderProgram const& r_program) = 0;
+
+            /*!***********************************************************************************
+             \brief Stops drawing with the shader program in use.
+
+             \param[in] r_program Shader program in use.
+            *************************************************************************************/
+            virtual void UnuseProgram(ShaderProgram const& r_program) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets a uniform of a shader program.
+
+             \param[in,out] r_program Shader program the uniform belongs to.
+             \param[in] r_name Name of the uniform.
+             \param[in] r_value Value to set the uniform to.
+            *************************************************************************************/
+            virtual void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets a uniform of a shader program.
+
+             \param[in,out] r_program Shader program the uniform belongs to.
+             \param[in] r_name Name of the uniform.
+             \param[in] r_value Value to set the uniform to.
+            *************************************************************************************/
+            virtual void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets a uniform of a shader program.
+
+             \param[in,out] r_program Shader program the uniform belongs to.
+             \param[in] r_name Name of the uniform.
+             \param[in] value Value to set the uniform to.
+            *************************************************************************************/
+            virtual void SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value) = 0;
+
+            /*!***********************************************************************************
+             \brief Draws from a vertex array until another one is bound.
+
+             \param[in] vertexArray Handle of the vertex array, 0 to unbind it.
+            *************************************************************************************/
+            virtual void BindVertexArray(GLuint const vertexArray) = 0;
+
+            /*!***********************************************************************************
+             \brief Sets the buffer a binding of a vertex array reads from.
+
+             \param[in] vertexArray Handle of the vertex array.
+             \param[in] bindingIndex Binding of the vertex array.
+             \param[in] buffer Handle of the buffer.
+             \param[in] offset Offset in bytes of the first element in the buffer.
+             \param[in] stride Distance in bytes between the elements.
+            *************************************************************************************/
+            virtual void BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+                GLintptr const offset, GLsizei const stride) = 0;
+
+            /*!***********************************************************************************
+             \brief Binds a texture to a texture unit.
+
+             \param[in] unit Texture unit.
+             \param[in] texture Handle of the texture, 0 to unbind the unit.
+            *************************************************************************************/
+            virtual void BindTextureUnit(GLuint const unit, GLuint const texture) = 0;
+
+            // ----- Draws ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Draws the vertices of the vertex array bound in order.
+
+             \param[in] primitiveType Primitive to draw the vertices as.
+             \param[in] first Index of the first vertex.
+             \param[in] count Number of vertices.
+            *************************************************************************************/
+            virtual void DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count) = 0;
+
+            /*!***********************************************************************************
+             \brief Draws instances of the indexed mesh of the vertex array bound.
+
+             \param[in] primitiveType Primitive to draw the mesh as.
+             \param[in] indexCount Number of indices of the mesh, as unsigned shorts.
+             \param[in] instanceCount Number of instances.
+            *************************************************************************************/
+            virtual void DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount) = 0;
+
+            /*!***********************************************************************************
+             \brief Marks the end of the commands of a frame.
+            *************************************************************************************/
+            virtual void EndFrame() {}
+        };
+
+
+        /*!***********************************************************************************
+         \brief Submits everything to OpenGL.
+        *************************************************************************************/
+        class GLRenderBackend : public RenderBackend
+        {
+        public:
+            GLuint CreateBuffer(GLsizeiptr const size, void const* p_data) override;
+            GLuint CreateVertexArray() override;
+            void SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+                GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset) override;
+            void SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor) override;
+            void SetElementBuffer(GLuint const vertexArray, GLuint const buffer) override;
+            void DeleteVertexArray(GLuint const vertexArray) override;
+            GLuint CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+                GLenum const format, GLint const wrapMode, void const* p_texels) override;
+            GLuint CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat) override;
+            void CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+                GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+                GLsizei const width, GLsizei const height, GLsizei const depth) override;
+            void DeleteTexture(GLuint const texture) override;
+            GLint GetMaxTextureSize() override;
+            GLuint CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log) override;
+            void DeleteProgram(GLuint const program) override;
+
+            GLuint CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped) override;
+            void UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data) override;
+            void UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data) override;
+            void CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+                GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size) override;
+            void UnmapBuffer(GLuint const buffer) override;
+            void DeleteBuffer(GLuint const buffer) override;
+
+            GLsync CreateFence() override;
+            bool WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout) override;
+            void DeleteFence(GLsync const fence) override;
+
+            void UseProgram(ShaderProgram const& r_program) override;
+            void UnuseProgram(ShaderProgram const& r_program) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value) override;
+            void BindVertexArray(GLuint const vertexArray) override;
+            void BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+                GLintptr const offset, GLsizei const stride) override;
+            void BindTextureUnit(GLuint const unit, GLuint const texture) override;
+
+            void DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count) override;
+            void DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount) override;
+        };
+
+
+        /*!***********************************************************************************
+         \brief Counts what would have been submitted instead of submitting it, so that the
+                CPU cost of the render passes can be measured without any draw work for the
+                driver or the GPU. Mapped buffers are backed by memory of their own and
+                fences are always done. Resources are only given handles, so as the resource
+                backend it lets everything be loaded without an OpenGL context.
+        *************************************************************************************/
+        class NullRenderBackend : public RenderBackend
+        {
+            // ----- Public types ----- //
+        public:
+            static constexpr std::size_t batchSizeBuckets{ 9 }; // Buckets of 1, 2-3, 4-7, ... 128-255 and 256 or more instances
+            static constexpr GLint maxTextureSize{ 16384 };     // Reported as the largest size of a texture
+
+            struct Stats
+            {
+                unsigned drawCalls{};
+                unsigned long long instances{};       // Instances drawn, a call to DrawArrays() counts as one
+                unsigned stateChanges{};              // Programs, uniforms, vertex arrays, buffers and textures that were changed
+                unsigned redundantStateChanges{};     // Bindings of what was already bound
+                unsigned long long bytesUploaded{};   // Bytes written through UploadBuffer() and UpdateBuffer()
+                std::array<unsigned, batchSizeBuckets> batchSizes{}; // Draw calls by the number of instances they drew
+            };
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns what has been counted since the stats were last reset.
+
+             \return Stats const& - Counts of the commands.
+            *************************************************************************************/
+            inline Stats const& GetStats() const { return m_stats; }
+
+            /*!***********************************************************************************
+             \brief Resets the counts of the commands.
+            *************************************************************************************/
+            inline void ResetStats() { m_stats = Stats{}; }
+
+            // ----- Public methods ----- //
+        public:
+            GLuint CreateBuffer(GLsizeiptr const size, void const* p_data) override;
+            GLuint CreateVertexArray() override;
+            void SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+                GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset) override;
+            void SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor) override;
+            void SetElementBuffer(GLuint const vertexArray, GLuint const buffer) override;
+            void DeleteVertexArray(GLuint const vertexArray) override;
+            GLuint CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+                GLenum const format, GLint const wrapMode, void const* p_texels) override;
+            GLuint CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat) override;
+            void CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+                GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+                GLsizei const width, GLsizei const height, GLsizei const depth) override;
+            void DeleteTexture(GLuint const texture) override;
+            GLint GetMaxTextureSize() override;
+            GLuint CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log) override;
+            void DeleteProgram(GLuint const program) override;
+
+            GLuint CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped) override;
+            void UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data) override;
+            void UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data) override;
+            void CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+                GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size) override;
+            void UnmapBuffer(GLuint const buffer) override;
+            void DeleteBuffer(GLuint const buffer) override;
+
+            GLsync CreateFence() override;
+            bool WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout) override;
+            void DeleteFence(GLsync const fence) override;
+
+            void UseProgram(ShaderProgram const& r_program) override;
+            void UnuseProgram(ShaderProgram const& r_program) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value) override;
+            void BindVertexArray(GLuint const vertexArray) override;
+            void BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+                GLintptr const offset, GLsizei const stride) override;
+            void BindTextureUnit(GLuint const unit, GLuint const texture) override;
+
+            void DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count) override;
+            void DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount) override;
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Counts a binding as a state change, or as a redundant one if the value
+                    bound has not changed.
+
+             \param[in,out] r_bound Value last bound.
+             \param[in] value Value being bound.
+            *************************************************************************************/
+            template <typename T>
+            void CountBinding(T& r_bound, T const& value)
+            {
+                if (r_bound == value)
+                {
+                    ++m_stats.redundantStateChanges;
+                    return;
+                }
+
+                r_bound = value;
+                ++m_stats.stateChanges;
+            }
+
+            /*!***********************************************************************************
+             \brief Counts a draw call of a number of instances.
+
+             \param[in] instanceCount Number of instances drawn.
+            *************************************************************************************/
+            void CountDraw(GLsizei const instanceCount);
+
+            // ----- Private variables ----- //
+        private:
+            Stats m_stats{};
+            std::unordered_map<GLuint, std::vector<unsigned char>> m_mappedBuffers{}; // Memory behind each mapped buffer
+            GLuint m_nextBuffer{ 1 };
+            GLuint m_nextVertexArray{ 1 };
+            GLuint m_nextTexture{ 1 };
+            GLuint m_nextProgram{ 1 };
+            std::size_t m_nextFence{ 1 };
+
+            // What is bound, to tell the state changes that did nothing
+            ShaderProgram const* m_p_boundProgram{ nullptr };
+            GLuint m_boundVertexArray{};
+            std::unordered_map<unsigned long long, std::pair<GLuint, GLintptr>> m_boundVertexBuffers{}; // By vertex array and binding
+            std::unordered_map<GLuint, GLuint> m_boundTextures{}; // By texture unit
+        };
+
+
+        /*!***********************************************************************************
+         \brief Writes every command to a file, one per line, before passing it on to
+                another backend.
+        *************************************************************************************/
+        class TraceRenderBackend : public RenderBackend
+        {
+            // ----- Constructors ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Opens the file to write the commands to.
+
+             \param[in,out] r_targetArg Backend to pass the commands on to.
+             \param[in] r_filePath Path of the file to write to.
+            *************************************************************************************/
+            TraceRenderBackend(RenderBackend& r_targetArg, std::string const& r_filePath);
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns whether the trace file could be opened.
+
+             \return true - If the commands are being written to the file.
+             \return false - If the file could not be opened.
+            *************************************************************************************/
+            inline bool IsOpen() const { return m_file.is_open(); }
+
+            // ----- Public methods ----- //
+        public:
+            GLuint CreateBuffer(GLsizeiptr const size, void const* p_data) override;
+            GLuint CreateVertexArray() override;
+            void SetVertexAttribute(GLuint const vertexArray, GLuint const attributeIndex, GLuint const bindingIndex,
+                GLint const size, GLenum const type, GLboolean const normalized, GLuint const offset) override;
+            void SetBindingDivisor(GLuint const vertexArray, GLuint const bindingIndex, GLuint const divisor) override;
+            void SetElementBuffer(GLuint const vertexArray, GLuint const buffer) override;
+            void DeleteVertexArray(GLuint const vertexArray) override;
+            GLuint CreateTexture(GLsizei const width, GLsizei const height, GLenum const internalFormat,
+                GLenum const format, GLint const wrapMode, void const* p_texels) override;
+            GLuint CreateTextureArray(GLsizei const width, GLsizei const height, GLsizei const layers, GLenum const internalFormat) override;
+            void CopyTexels(GLuint const sourceTexture, GLenum const sourceTarget, GLint const sourceX, GLint const sourceY, GLint const sourceZ,
+                GLuint const destinationTexture, GLenum const destinationTarget, GLint const destinationX, GLint const destinationY, GLint const destinationZ,
+                GLsizei const width, GLsizei const height, GLsizei const depth) override;
+            void DeleteTexture(GLuint const texture) override;
+            GLint GetMaxTextureSize() override;
+            GLuint CreateProgram(std::string const& r_vertexSource, std::string const& r_fragmentSource, std::string& r_log) override;
+            void DeleteProgram(GLuint const program) override;
+
+            GLuint CreateMappedBuffer(GLsizeiptr const size, void*& r_p_mapped) override;
+            void UploadBuffer(GLuint& r_buffer, GLsizeiptr const size, void const* p_data) override;
+            void UpdateBuffer(GLuint const buffer, GLintptr const offset, GLsizeiptr const size, void const* p_data) override;
+            void CopyBuffer(GLuint const sourceBuffer, GLuint const destinationBuffer,
+                GLintptr const sourceOffset, GLintptr const destinationOffset, GLsizeiptr const size) override;
+            void UnmapBuffer(GLuint const buffer) override;
+            void DeleteBuffer(GLuint const buffer) override;
+
+            GLsync CreateFence() override;
+            bool WaitFence(GLsync const fence, bool const flush, GLuint64 const timeout) override;
+            void DeleteFence(GLsync const fence) override;
+
+            void UseProgram(ShaderProgram const& r_program) override;
+            void UnuseProgram(ShaderProgram const& r_program) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::mat4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, glm::vec4 const& r_value) override;
+            void SetUniform(ShaderProgram& r_program, std::string const& r_name, GLint const value) override;
+            void BindVertexArray(GLuint const vertexArray) override;
+            void BindVertexBuffer(GLuint const vertexArray, GLuint const bindingIndex, GLuint const buffer,
+                GLintptr const offset, GLsizei const stride) override;
+            void BindTextureUnit(GLuint const unit, GLuint const texture) override;
+
+            void DrawArrays(GLenum const primitiveType, GLint const first, GLsizei const count) override;
+            void DrawElementsInstanced(GLenum const primitiveType, GLsizei const indexCount, GLsizei const instanceCount) override;
+            void EndFrame() override;
+
+            // ----- Private variables ----- //
+        private:
+            RenderBackend& m_r_target;
+            std::ofstream m_file;
+            unsigned long long m_frame{};
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
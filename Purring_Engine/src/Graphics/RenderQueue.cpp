@@ -0,0 +1,206 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     RenderQueue.cpp
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions in the RenderQueue
+           class, which sorts the draw commands of a pass by their state.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "RenderQueue.h"
+#include "Memory/FrameArena.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace PE
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            static_assert(RenderQueue::payloadBits % 8 == 0, "The radix sort skips the bytes of the payload index");
+
+            unsigned long long const maxLayer{ (1ull << RenderQueue::layerBits) - 1 };
+            unsigned const maxLevel{ (1u << RenderQueue::levelBits) - 1 };
+            std::size_t const maxCommands{ 1ull << RenderQueue::payloadBits };
+        }
+
+
+        void RenderQueue::Clear(std::pmr::memory_resource* p_resource)
+        {
+            // The containers are made again on the resource, as the memory they had may
+            // belong to an arena that has since been reset
+            std::size_t const lastCount{ m_keys.size() };
+            RecreateOnResource(m_keys, p_resource, lastCount);
+            RecreateOnResource(m_sortBuffer, p_resource);
+            RecreateOnResource(m_commands, p_resource, lastCount);
+            RecreateOnResource(m_levelBounds, p_resource);
+            m_textures.resize(1);
+            m_currentLayer = 0;
+        }
+
+
+        void RenderQueue::PushSprite(unsigned const layer, EntityID const id, SpriteInstance const& r_sprite, GLuint const textureID)
+        {
+            // Bounds of the quad once it has been rotated
+            float const cosAngle{ std::abs(std::cos(r_sprite.rotation)) };
+            float const sinAngle{ std::abs(std::sin(r_sprite.rotation)) };
+            glm::vec2 const extents{ r_sprite.halfSize.x * cosAngle + r_sprite.halfSize.y * sinAngle,
+                                     r_sprite.halfSize.x * sinAngle + r_sprite.halfSize.y * cosAngle };
+
+            Push(layer, EnumShader::SPRITE, textureID, r_sprite.position - extents, r_sprite.position + extents, Command{ r_sprite, id });
+        }
+
+
+        void RenderQueue::PushText(unsigned const layer, EntityID const id)
+        {
+            glm::vec2 const unbounded{ std::numeric_limits<float>::max() };
+            Push(layer, EnumShader::TEXT, 0, -unbounded, unbounded, Command{ SpriteInstance{}, id });
+        }
+
+
+        void RenderQueue::PushBatch(unsigned const layer, unsigned const batchIndex, GLuint const textureID,
+            glm::vec2 const& r_min, glm::vec2 const& r_max)
+        {
+            Push(layer, EnumShader::STATIC_BATCH, textureID, r_min, r_max, Command{ SpriteInstance{}, batchIndex });
+        }
+
+
+        void RenderQueue::Sort()
+        {
+            std::size_t const count{ m_keys.size() };
+            if (count < 2) { return; }
+
+            // Count the values of every byte in one pass over the keys
+            constexpr unsigned firstByte{ payloadBits / 8 };
+            std::array<std::array<std::size_t, 256>, 8 - firstByte> histograms{};
+            for (unsigned long long const key : m_keys)
+            {
+                for (unsigned byte{ firstByte }; byte < 8; ++byte)
+                {
+                    ++histograms[byte - firstByte][(key >> (byte * 8)) & 0xff];
+                }
+            }
+
+            m_sortBuffer.resize(count);
+            unsigned long long* p_source{ m_keys.data() };
+            unsigned long long* p_destination{ m_sortBuffer.data() };
+
+            for (unsigned byte{ firstByte }; byte < 8; ++byte)
+            {
+                std::array<std::size_t, 256>& r_histogram{ histograms[byte - firstByte] };
+                unsigned const shift{ byte * 8 };
+
+                // Every key has the same value in this byte, so the pass would not move anything
+                if (r_histogram[(p_source[0] >> shift) & 0xff] == count) { continue; }
+
+                // Turn the counts into the index of the first key with each value
+                std::size_t offset{};
+                for (std::size_t& r_bucket : r_histogram)
+                {
+                    std::size_t const bucketSize{ r_bucket };
+                    r_bucket = offset;
+                    offset += bucketSize;
+                }
+
+                for (std::size_t i{}; i < count; ++i)
+                {
+                    p_destination[r_histogram[(p_source[i] >> shift) & 0xff]++] = p_source[i];
+                }
+
+                std::swap(p_source, p_destination);
+            }
+
+            // Keep the sorted keys in m_keys
+            if (p_source != m_keys.data())
+            {
+                m_keys.swap(m_sortBuffer);
+            }
+        }
+
+
+        void RenderQueue::Push(unsigned const layer, EnumShader const shader, GLuint const textureID,
+            glm::vec2 const& r_min, glm::vec2 const& r_max, Command const& r_command)
+        {
+            // The payload index would run into the texture bits
+            if (m_commands.size() >= maxCommands) { return; }
+
+            // Render order only goes up through the layers, so the bounds of a layer are not needed after it
+            if (layer != m_currentLayer)
+            {
+                m_levelBounds.clear();
+                m_currentLayer = layer;
+            }
+
+            unsigned long long const textureIndex{ FindTexture(textureID) };
+            unsigned const state{ (static_cast<unsigned>(shader) << textureBits) | static_cast<unsigned>(textureIndex) };
+            unsigned long long const level{ AssignLevel(state, r_min, r_max) };
+
+            m_keys.emplace_back((std::min(static_cast<unsigned long long>(layer), maxLayer) << (levelBits + shaderBits + textureBits + payloadBits))
+                | (level << (shaderBits + textureBits + payloadBits))
+                | (static_cast<unsigned long long>(shader) << (textureBits + payloadBits))
+                | (textureIndex << payloadBits)
+                | static_cast<unsigned long long>(m_commands.size()));
+            m_commands.emplace_back(r_command);
+        }
+
+
+        unsigned RenderQueue::AssignLevel(unsigned const state, glm::vec2 const& r_min, glm::vec2 const& r_max)
+        {
+            // Draw after everything overlapped that was queued before, in the same batch
+            // as the commands with the same state and in a later batch than the others
+            unsigned level{};
+            for (LevelBounds const& r_bounds : m_levelBounds)
+            {
+                if (r_min.x < r_bounds.max.x && r_bounds.min.x < r_max.x
+                    && r_min.y < r_bounds.max.y && r_bounds.min.y < r_max.y)
+                {
+                    level = std::max(level, r_bounds.state == state ? r_bounds.level : r_bounds.level + 1);
+                }
+            }
+
+            // Past the last level, commands are only sorted by state, which is only reached
+            // with tens of thousands of overlapping state changes in one layer
+            level = std::min(level, maxLevel);
+
+            for (LevelBounds& r_bounds : m_levelBounds)
+            {
+                if (r_bounds.level == level && r_bounds.state == state)
+                {
+                    r_bounds.min = glm::min(r_bounds.min, r_min);
+                    r_bounds.max = glm::max(r_bounds.max, r_max);
+                    return level;
+                }
+            }
+
+            m_levelBounds.emplace_back(LevelBounds{ level, state, r_min, r_max });
+            return level;
+        }
+
+
+        unsigned RenderQueue::FindTexture(GLuint const textureID)
+        {
+            if (!textureID) { return 0; }
+
+            // Only textures too large for the atlas are bound on their own, so there are few of them
+            auto const textureIterator{ std::find(m_textures.begin() + 1, m_textures.end(), textureID) };
+            if (textureIterator != m_textures.end())
+            {
+                return static_cast<unsigned>(textureIterator - m_textures.begin());
+            }
+
+            m_textures.emplace_back(textureID);
+            return static_cast<unsigned>(m_textures.size() - 1);
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
@@ -0,0 +1,229 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     RenderQueue.h
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the RenderQueue class, which collects
+           the sprites, particles and text to draw in a frame with a 64-bit sort key
+           each, and radix sorts them so that draws with the same state are grouped.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+#include <glm/glm.hpp>
+
+#include <memory_resource>
+#include <vector>
+
+#include "SpriteInstance.h"
+
+typedef unsigned long long EntityID;
+
+namespace PE
+{
+    namespace Graphics
+    {
+        /*!***********************************************************************************
+         \brief Queue of the draw commands of one pass. Each command gets a sort key made of,
+                from the most significant bits:
+
+                - the render layer of the entity,
+                - its level, the lowest batch it can be drawn in without being drawn before
+                  something it overlaps that was queued before it with a different state,
+                - the shader it is drawn with,
+                - the texture bound on its own for it, 0 if it uses the texture atlas,
+                - the index of the command in the order it was queued, used to find its payload.
+
+                Commands that overlap keep their order, while commands that do not can be
+                moved into an earlier batch with the same state. Every sprite is alpha
+                blended, so the blend mode is not part of the key.
+        *************************************************************************************/
+        class RenderQueue
+        {
+            // ----- Public constants ----- //
+        public:
+            static constexpr unsigned payloadBits{ 24 };
+            static constexpr unsigned textureBits{ 16 };
+            static constexpr unsigned shaderBits{ 2 };
+            static constexpr unsigned levelBits{ 16 };
+            static constexpr unsigned layerBits{ 64 - payloadBits - textureBits - shaderBits - levelBits };
+
+            enum class EnumShader : unsigned char
+            {
+                SPRITE,       // Instanced quads
+                TEXT,         // Text component, drawn a glyph at a time
+                STATIC_BATCH  // Instanced quads baked into a buffer of their own, drawn in one call
+            };
+
+            // ----- Public types ----- //
+        public:
+            struct Command
+            {
+                SpriteInstance sprite{}; // Instance data of the quad, for sprite commands
+                EntityID id{};           // Entity the command was queued for, or the index of the static batch
+            };
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns the sort keys of the commands queued, in draw order once sorted.
+
+             \return std::pmr::vector<unsigned long long> const& - Sort keys of the commands.
+            *************************************************************************************/
+            inline std::pmr::vector<unsigned long long> const& GetKeys() const { return m_keys; }
+
+            /*!***********************************************************************************
+             \brief Returns the command a sort key was made for.
+
+             \param[in] key Sort key of the command.
+             \return Command const& - Command of the key.
+            *************************************************************************************/
+            inline Command const& GetCommand(unsigned long long const key) const { return m_commands[key & ((1ull << payloadBits) - 1)]; }
+
+            /*!***********************************************************************************
+             \brief Returns the part of a sort key that commands drawn in the same batch share.
+
+             \param[in] key Sort key of a command.
+             \return unsigned long long - Layer, level, shader and texture bits of the key.
+            *************************************************************************************/
+            static inline unsigned long long GetBatchState(unsigned long long const key) { return key >> payloadBits; }
+
+            /*!***********************************************************************************
+             \brief Returns the shader a command is drawn with.
+
+             \param[in] key Sort key of the command.
+             \return EnumShader - Shader of the command.
+            *************************************************************************************/
+            static inline EnumShader GetShader(unsigned long long const key)
+            {
+                return static_cast<EnumShader>((key >> (payloadBits + textureBits)) & ((1ull << shaderBits) - 1));
+            }
+
+            /*!***********************************************************************************
+             \brief Returns the texture to bind on its own for a command.
+
+             \param[in] key Sort key of the command.
+             \return GLuint - Handle of the texture, 0 if the command does not need one.
+            *************************************************************************************/
+            inline GLuint GetTexture(unsigned long long const key) const
+            {
+                return m_textures[(key >> payloadBits) & ((1ull << textureBits) - 1)];
+            }
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Removes every command and moves the keys and payloads of the pass onto a
+                    memory resource, with room for as many commands as the last pass had. The
+                    memory of the last pass is not freed, so the resource is meant to be the
+                    arena of the frame.
+
+             \param[in] p_resource Memory resource the commands of the pass are allocated from.
+            *************************************************************************************/
+            void Clear(std::pmr::memory_resource* p_resource);
+
+            /*!***********************************************************************************
+             \brief Queues a quad drawn with the instanced sprite shader. Commands have to be
+                    queued in render order, which keeps the layers in ascending order.
+
+             \param[in] layer Render layer of the entity.
+             \param[in] id Entity the quad is drawn for.
+             \param[in] r_sprite Instance data of the quad.
+             \param[in] textureID Texture to bind on its own for the quad, 0 if it samples
+                                  the texture atlas or is not textured.
+            *************************************************************************************/
+            void PushSprite(unsigned const layer, EntityID const id, SpriteInstance const& r_sprite, GLuint const textureID);
+
+            /*!***********************************************************************************
+             \brief Queues a text component. The area the text covers is not known until its
+                    glyphs are laid out, so it is treated as overlapping everything in its layer.
+
+             \param[in] layer Render layer of the entity.
+             \param[in] id Entity with the text component.
+            *************************************************************************************/
+            void PushText(unsigned const layer, EntityID const id);
+
+            /*!***********************************************************************************
+             \brief Queues a static batch, a set of quads in the same layer that are drawn
+                    together in one call. It is queued where the first of its quads is in the
+                    render order, so it must not be overlapped by something between its quads.
+
+             \param[in] layer Render layer of the quads in the batch.
+             \param[in] batchIndex Index of the batch in the static batches of the pass.
+             \param[in] textureID Texture to bind on its own for the batch, 0 if its quads
+                                  sample the texture atlas or are not textured.
+             \param[in] r_min Bottom left corner of the bounds of the quads in the batch.
+             \param[in] r_max Top right corner of the bounds of the quads in the batch.
+            *************************************************************************************/
+            void PushBatch(unsigned const layer, unsigned const batchIndex, GLuint const textureID,
+                glm::vec2 const& r_min, glm::vec2 const& r_max);
+
+            /*!***********************************************************************************
+             \brief Sorts the keys with an LSD radix sort on the bytes above the payload index.
+                    The keys start out in the order they were queued and the sort is stable, so
+                    commands with the same state stay in that order. Passes on bytes that are
+                    the same in every key are skipped.
+            *************************************************************************************/
+            void Sort();
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Builds the key of a command from its state and bounds and adds it.
+
+             \param[in] layer Render layer of the entity.
+             \param[in] shader Shader the command is drawn with.
+             \param[in] textureID Texture to bind on its own for the command, 0 if none.
+             \param[in] r_min Bottom left corner of the axis aligned bounds of the command.
+             \param[in] r_max Top right corner of the axis aligned bounds of the command.
+             \param[in] r_command Payload of the command.
+            *************************************************************************************/
+            void Push(unsigned const layer, EnumShader const shader, GLuint const textureID,
+                glm::vec2 const& r_min, glm::vec2 const& r_max, Command const& r_command);
+
+            /*!***********************************************************************************
+             \brief Finds the level of a command from the bounds of the levels of its layer,
+                    and grows the bounds of its level and state to include it.
+
+             \param[in] state Shader and texture bits of the key of the command.
+             \param[in] r_min Bottom left corner of the bounds of the command.
+             \param[in] r_max Top right corner of the bounds of the command.
+             \return unsigned - Level of the command.
+            *************************************************************************************/
+            unsigned AssignLevel(unsigned const state, glm::vec2 const& r_min, glm::vec2 const& r_max);
+
+            /*!***********************************************************************************
+             \brief Returns the index of a texture in the textures of this pass, adding it if
+                    it is not there yet.
+
+             \param[in] textureID Handle of the texture, 0 if none.
+             \return unsigned - Index of the texture, 0 if the handle is 0.
+            *************************************************************************************/
+            unsigned FindTexture(GLuint const textureID);
+
+            // ----- Private variables ----- //
+        private:
+            // Union of the bounds of the commands of a layer with the same level and state
+            struct LevelBounds
+            {
+                unsigned level{};
+                unsigned state{};
+                glm::vec2 min{};
+                glm::vec2 max{};
+            };
+
+            std::pmr::vector<unsigned long long> m_keys{};
+            std::pmr::vector<unsigned long long> m_sortBuffer{}; // Keys of the odd passes of the radix sort
+            std::pmr::vector<Command> m_commands{};              // Payloads, in the order they were queued
+            std::vector<GLuint> m_textures{ 0 };                 // Textures bound on their own this pass, 0 first
+            std::pmr::vector<LevelBounds> m_levelBounds{};       // Of the layer being queued
+            unsigned m_currentLayer{};                      // Layer of the last command queued
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
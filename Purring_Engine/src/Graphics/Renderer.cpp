@@ -23,40 +23,63 @@ namespace PE
 {
     namespace Graphics
     {
+        unsigned long long Renderer::revisionCount{};
+
+        // The animation system sets the UV coordinates of every frame, so values that are
+        // set to what they already were do not change the revision
+
         void Renderer::SetColor(float const r, float const g, float const b, float const a)
         {
-            m_color.r = glm::clamp(r, 0.f, 1.f);
-            m_color.g = glm::clamp(g, 0.f, 1.f);
-            m_color.b = glm::clamp(b, 0.f, 1.f);
-            m_color.a = glm::clamp(a, 0.f, 1.f);
+            glm::vec4 const newColor{ glm::clamp(r, 0.f, 1.f), glm::clamp(g, 0.f, 1.f), glm::clamp(b, 0.f, 1.f), glm::clamp(a, 0.f, 1.f) };
+            if (newColor == m_color) { return; }
+
+            m_color = newColor;
+            MarkChanged();
         }
 
         void Renderer::SetAlpha(float const alpha)
         {
-            m_color.a = glm::clamp(alpha, 0.f, 1.f);
+            float const newAlpha{ glm::clamp(alpha, 0.f, 1.f) };
+            if (newAlpha == m_color.a) { return; }
+
+            m_color.a = newAlpha;
+            MarkChanged();
         }
 
 
         void Renderer::SetEnabled(bool const newEnabled)
         {
-            m_enabled = newEnabled;
+            if (newEnabled == m_enabled) { return; }
 
+            m_enabled = newEnabled;
+            MarkChanged();
         }
 
 
         void Renderer::SetTextureKey(std::string const& r_newKey)
         {
+            if (r_newKey == m_textureKey) { return; }
+
             m_textureKey = r_newKey;
+            MarkChanged();
         }
 
         void Renderer::SetUVCoordinatesMin(vec2 const& minUV)
         {
-            m_minUV = glm::vec2{ minUV.x, minUV.y };
+            glm::vec2 const newMinUV{ minUV.x, minUV.y };
+            if (newMinUV == m_minUV) { return; }
+
+            m_minUV = newMinUV;
+            MarkChanged();
         }
 
         void Renderer::SetUVCoordinatesMax(vec2 const& maxUV)
         {
-            m_maxUV = glm::vec2{ maxUV.x, maxUV.y };
+            glm::vec2 const newMaxUV{ maxUV.x, maxUV.y };
+            if (newMaxUV == m_maxUV) { return; }
+
+            m_maxUV = newMaxUV;
+            MarkChanged();
         }
 
 
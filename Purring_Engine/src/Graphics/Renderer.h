@@ -96,6 +96,15 @@ namespace PE
             *************************************************************************************/
             inline glm::vec2 const& GetUVCoordinatesMax() const { return m_maxUV;  }
 
+            /*!***********************************************************************************
+             \brief Gets the revision of the renderer, which changes to a value no renderer has
+                    had before every time one of its values is set to something different.
+                    Copies of a renderer share its revision.
+
+             \return unsigned long long - Revision of the values of the renderer.
+            *************************************************************************************/
+            inline unsigned long long GetRevision() const { return m_revision; }
+
 
             /*!***********************************************************************************
              \brief Sets the RGBA color of the object. If the object has a texture on it, 
@@ -166,6 +175,14 @@ namespace PE
             std::string m_textureKey{ "" }; // Key for the corresponding texture in the resource manager.
             glm::vec2 m_minUV{ 0.f, 0.f };
             glm::vec2 m_maxUV{ 1.f, 1.f };
+            unsigned long long m_revision{}; // Changed by the setters, so that data built from the renderer can tell it is out of date
+
+            static unsigned long long revisionCount; // Last revision given to a renderer
+
+            /*!***********************************************************************************
+             \brief Gives the renderer a new revision after one of its values has changed.
+            *************************************************************************************/
+            inline void MarkChanged() { m_revision = ++revisionCount; }
         };
     } // End of Graphics namespace
 } // End of PE namespace
\ No newline at end of file
@@ -49,10 +49,14 @@
 
 // Physics and collision
 #include "Physics/Colliders.h"
+#include "Physics/PhysicsManager.h"
 
 // text
 #include "Text.h"
 #include "Time/TimeManager.h"
+#include "Time/Profiler.h"
+#include "Memory/MemoryManager.h"
+#include "Threading/ThreadPool.h"
 
 // Animation
 #include "Animation/Animation.h"
@@ -73,6 +77,9 @@
 #include "Logic/LogicSystem.h"
 #include "Logic/Rat/RatScript_v2_0.h"
 
+// Scenes to benchmark
+#include "SceneManager/SceneManager.h"
+
 extern Logger engine_logger;
 
 namespace PE
@@ -85,10 +92,25 @@ namespace PE
         unsigned RendererManager::textDrawCalls{};    // Total draw calls made for text (1 draw call per chara)
         unsigned RendererManager::objectDrawCalls{};  // Total draw calls for gameobjects
         unsigned RendererManager::debugDrawCalls{};   // Total draw calls for debug shapes
+        unsigned RendererManager::instanceBatches{};  // Batches of instances drawn from the instance ring buffer
+        unsigned long long RendererManager::instanceUploadBytes{};  // Bytes of instance data written this frame
+        unsigned long long RendererManager::instanceBufferStalls{}; // Times the CPU waited for the GPU to release instance data
+        unsigned RendererManager::textureSwitches{};  // Times the texture changed between sprites drawn one after another
+        CullingStats RendererManager::sceneViewCulling{}; // Entities visible and culled the last time the editor scene view was drawn
+        CullingStats RendererManager::gameViewCulling{};  // Entities visible and culled the last time the game view was drawn
+        unsigned RendererManager::staticBatchDraws{};     // Draw calls made for static batches
+        unsigned RendererManager::staticBatchSprites{};   // Sprites drawn from static batches
+        unsigned RendererManager::buildThreads{ std::min(ThreadPool::GetHardwareThreadCount(), 4U) }; // Threads the draw packets of a pass are built across
 
         RendererManager::RendererManager(CameraManager& r_cameraManagerArg, int const windowWidth, int const windowHeight)
             : r_cameraManager{ r_cameraManagerArg }, m_windowStartWidth{ windowWidth }, m_windowStartHeight{ windowHeight }
         {
+            // Without a window there is no context to load OpenGL into, and nothing to draw to
+            if (!WindowManager::GetInstance().GetWindow())
+            {
+                return;
+            }
+
             // Initialize GLEW
             if (glewInit() != GLEW_OK)
             {
@@ -125,15 +147,18 @@ namespace PE
 
         void RendererManager::InitializeSystem()
         {
-            // Print the specs
-            PrintSpecifications();
+            if (WindowManager::GetInstance().GetWindow())
+            {
+                // Print the specs
+                PrintSpecifications();
 
-            // Create the framebuffer to render to a texture object
-            int width, height;
-            glfwGetWindowSize(WindowManager::GetInstance().GetWindow(), &width, &height);
-            m_renderFrameBuffer.CreateFrameBuffer(width, height, true, false);
-            m_cachedWindowWidth = static_cast<float>(width),
-                m_cachedWindowHeight = static_cast<float>(height);
+                // Create the framebuffer to render to a texture object
+                int width, height;
+                glfwGetWindowSize(WindowManager::GetInstance().GetWindow(), &width, &height);
+                m_renderFrameBuffer.CreateFrameBuffer(width, height, true, false);
+                m_cachedWindowWidth = static_cast<float>(width),
+                    m_cachedWindowHeight = static_cast<float>(height);
+            }
 
             // Initialize the base meshes to use
             m_meshes.resize(static_cast<size_t>(EnumMeshType::MESH_COUNT));
@@ -144,16 +169,15 @@ namespace PE
             InitializeLineMesh(m_meshes[static_cast<unsigned char>(EnumMeshType::DEBUG_LINE)]);
             InitializePointMesh(m_meshes[static_cast<unsigned char>(EnumMeshType::DEBUG_POINT)]);
 
+            // Submit the frames through the backend the resources are created with, which creates the instance buffer
+            SetBackend(RenderBackend::GetResourceBackend());
+
             // Load a shader program
             ResourceManager::GetInstance().LoadShadersFromFile(m_defaultShaderProgramKey, "../Shaders/Textured.vert", "../Shaders/Textured.frag");
             ResourceManager::GetInstance().LoadShadersFromFile(m_instancedShaderProgramKey, "../Shaders/Instanced.vert", "../Shaders/Instanced.frag");
             ResourceManager::GetInstance().LoadShadersFromFile(m_textShaderProgramKey, "../Shaders/Text.vert", "../Shaders/Text.frag");
 
-            // Reserve memory for the vectors to build the buffer with
-            m_isTextured.reserve(3000);
-            m_modelToWorldMatrices.reserve(3000);
-            m_colors.reserve(3000);
-            m_UV.reserve(3000);
+            // Reserve memory for the render order container
             renderedEntities.reserve(3000);
 
             engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
@@ -171,7 +195,8 @@ namespace PE
             deltaTime; // Prevent warnings
 
             // Reset counters
-            totalDrawCalls = 0, textDrawCalls = 0, objectDrawCalls = 0, debugDrawCalls = 0;
+            totalDrawCalls = 0, textDrawCalls = 0, objectDrawCalls = 0, debugDrawCalls = 0, textureSwitches = 0;
+            staticBatchDraws = 0, staticBatchSprites = 0;
 
             // Get the size of the window to render in
             float windowWidth{}, windowHeight{};
@@ -179,6 +204,9 @@ namespace PE
             // Reset the render order container
             renderedEntities.clear();
 
+            // Move on to the region of the instance buffer the GPU is done reading from
+            m_instanceBuffer.BeginFrame();
+
             // resizing window
 #ifndef GAMERELEASE
             if (Editor::GetInstance().IsEditorActive())
@@ -269,23 +297,46 @@ namespace PE
             glm::mat4 worldToNdcMatrix{ r_cameraManager.GetWorldToNdcMatrix(false) };
 #endif // !GAMERELEASE
 
+#ifndef GAMERELEASE
+            if (!Editor::GetInstance().IsEditorActive())
+#endif // !GAMERELEASE
+            {
+                // Move the main camera along with the body it is attached to between physics steps
+                EntityID const mainCameraId{ r_cameraManager.GetMainCameraId() };
+                if (EntityManager::GetInstance().Has<Transform>(mainCameraId))
+                {
+                    vec2 const& r_cameraPosition{ EntityManager::GetInstance().Get<Transform>(mainCameraId).position };
+                    vec2 const cameraOffset{ GETPHYSICSMANAGER()->GetInterpolatedPosition(mainCameraId, r_cameraPosition) - r_cameraPosition };
+                    worldToNdcMatrix = worldToNdcMatrix * glm::translate(glm::mat4{ 1.f }, glm::vec3{ -cameraOffset.x, -cameraOffset.y, 0.f });
+                }
+            }
+
             // Draw objects in the scene
-            DrawQuadsInstanced<Renderer>(worldToNdcMatrix, Hierarchy::GetInstance().GetRenderOrder());
+            DrawQuadsInstanced<Renderer>(worldToNdcMatrix, Hierarchy::GetInstance().GetRenderOrder(), Hierarchy::GetInstance().GetRenderLayers(), m_worldCullingGrid, &m_worldStaticBatches);
 
 #ifndef GAMERELEASE            
             // Draw UI objects in the scene
-            DrawQuadsInstanced<GUIRenderer>(worldToNdcMatrix, Hierarchy::GetInstance().GetRenderOrderUI());
+            DrawQuadsInstanced<GUIRenderer>(worldToNdcMatrix, Hierarchy::GetInstance().GetRenderOrderUI(), Hierarchy::GetInstance().GetRenderLayersUI(), m_uiCullingGrid, nullptr);
 
             // Render Text
             //RenderText(Editor::GetInstance().IsEditorActive() ? worldToNdcMatrix : r_cameraManager.GetUiViewToNdcMatrix());
 #else
             // Draw UI objects in the scene
-            DrawQuadsInstanced<GUIRenderer>(r_cameraManager.GetUiViewToNdcMatrix(), Hierarchy::GetInstance().GetRenderOrderUI());
+            DrawQuadsInstanced<GUIRenderer>(r_cameraManager.GetUiViewToNdcMatrix(), Hierarchy::GetInstance().GetRenderOrderUI(), Hierarchy::GetInstance().GetRenderLayersUI(), m_uiCullingGrid, nullptr);
 
             // Render Text
             //RenderText(r_cameraManager.GetUiViewToNdcMatrix());
 #endif // !GAMERELEASE
 
+            // Keep the culling counts of the editor scene view and the game view apart
+            CullingStats const viewCulling{ m_worldCullingGrid.GetVisibleCount() + m_uiCullingGrid.GetVisibleCount(),
+                m_worldCullingGrid.GetCulledCount() + m_uiCullingGrid.GetCulledCount() };
+#ifndef GAMERELEASE
+            (Editor::GetInstance().IsEditorActive() ? sceneViewCulling : gameViewCulling) = viewCulling;
+#else
+            gameViewCulling = viewCulling;
+#endif // !GAMERELEASE
+
 #ifndef GAMERELEASE
             if (Editor::GetInstance().IsRenderingDebug())
             {
@@ -309,6 +360,13 @@ namespace PE
 
             totalDrawCalls = textDrawCalls + objectDrawCalls + debugDrawCalls;
 
+            // Fence off the instance data written this frame until the GPU is done with it
+            m_instanceBuffer.EndFrame();
+            m_p_backend->EndFrame();
+            instanceBatches = m_instanceBuffer.GetFrameBatchCount();
+            instanceUploadBytes = m_instanceBuffer.GetFrameUploadBytes();
+            instanceBufferStalls = m_instanceBuffer.GetStallCount();
+
 #ifndef GAMERELEASE
             // Check if the Imgui editor windows are active
             if (!Editor::GetInstance().IsEditorActive())
@@ -332,6 +390,9 @@ namespace PE
 
         void RendererManager::DestroySystem()
         {
+            // Unmap and release the instance buffer
+            m_instanceBuffer.Cleanup();
+
             // Release the buffer objects in each mesh
             for (auto& mesh : m_meshes) {
                 mesh.Cleanup();
@@ -339,7 +400,133 @@ namespace PE
             m_meshes.clear();
 
             // Delete the framebuffer object
-            m_renderFrameBuffer.Cleanup();
+            if (WindowManager::GetInstance().GetWindow())
+            {
+                m_renderFrameBuffer.Cleanup();
+            }
+        }
+
+
+#ifndef GAMERELEASE
+        void RendererManager::BenchmarkScenes(std::string const& r_sceneDirectory, unsigned const frameCount, std::string const& r_tracePath)
+        {
+            if (!std::filesystem::is_directory(r_sceneDirectory))
+            {
+                engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+                engine_logger.SetTime();
+                engine_logger.AddLog(false, "Scene directory " + r_sceneDirectory + " does not exist.", __FUNCTION__);
+                return;
+            }
+
+            // Benchmark the scenes in the order of their names
+            std::vector<std::filesystem::path> scenePaths{};
+            for (auto const& r_entry : std::filesystem::directory_iterator{ r_sceneDirectory })
+            {
+                if (r_entry.path().extension() == ".scene")
+                {
+                    scenePaths.emplace_back(r_entry.path());
+                }
+            }
+            std::sort(scenePaths.begin(), scenePaths.end());
+
+            // Count the commands of the passes instead of submitting them, and write them to a file if asked to
+            NullRenderBackend nullBackend{};
+            std::unique_ptr<TraceRenderBackend> p_traceBackend{};
+            if (!r_tracePath.empty())
+            {
+                p_traceBackend = std::make_unique<TraceRenderBackend>(nullBackend, r_tracePath);
+            }
+            RenderBackend& r_previousBackend{ *m_p_backend };
+            SetBackend(p_traceBackend ? static_cast<RenderBackend&>(*p_traceBackend) : nullBackend);
+
+            unsigned const frames{ std::max(frameCount, 1U) };
+            for (std::filesystem::path const& r_scenePath : scenePaths)
+            {
+                SceneManager::GetInstance().LoadSceneFromPath(r_scenePath.string());
+                Hierarchy::GetInstance().Update();
+                r_cameraManager.UpdateSystem(0.f);
+
+                // Draw the scene through the main camera and the UI camera, as the game does
+                glm::mat4 const worldToNdcMatrix{ r_cameraManager.GetWorldToNdcMatrix(false) };
+                glm::mat4 const uiViewToNdcMatrix{ r_cameraManager.GetUiViewToNdcMatrix() };
+
+                double totalTime{}, minTime{ std::numeric_limits<double>::max() }, maxTime{};
+                NullRenderBackend::Stats totalStats{};
+                unsigned long long instanceBytes{};
+                unsigned long long totalStaticBatchDraws{};
+                for (unsigned frame{}; frame < frames; ++frame)
+                {
+                    objectDrawCalls = 0, textDrawCalls = 0, textureSwitches = 0, staticBatchDraws = 0, staticBatchSprites = 0;
+                    renderedEntities.clear();
+                    nullBackend.ResetStats();
+
+                    auto const frameStart{ std::chrono::high_resolution_clock::now() };
+                    m_instanceBuffer.BeginFrame();
+                    DrawQuadsInstanced<Renderer>(worldToNdcMatrix, Hierarchy::GetInstance().GetRenderOrder(), Hierarchy::GetInstance().GetRenderLayers(), m_worldCullingGrid, &m_worldStaticBatches);
+                    DrawQuadsInstanced<GUIRenderer>(uiViewToNdcMatrix, Hierarchy::GetInstance().GetRenderOrderUI(), Hierarchy::GetInstance().GetRenderLayersUI(), m_uiCullingGrid, nullptr);
+                    m_instanceBuffer.EndFrame();
+                    m_p_backend->EndFrame();
+                    MemoryManager::GetInstance().EndFrame();
+                    auto const frameEnd{ std::chrono::high_resolution_clock::now() };
+
+                    double const frameTime{ std::chrono::duration<double, std::milli>(frameEnd - frameStart).count() };
+                    totalTime += frameTime;
+                    minTime = std::min(minTime, frameTime);
+                    maxTime = std::max(maxTime, frameTime);
+
+                    NullRenderBackend::Stats const& r_frameStats{ nullBackend.GetStats() };
+                    totalStats.drawCalls += r_frameStats.drawCalls;
+                    totalStats.instances += r_frameStats.instances;
+                    totalStats.stateChanges += r_frameStats.stateChanges;
+                    totalStats.redundantStateChanges += r_frameStats.redundantStateChanges;
+                    totalStats.bytesUploaded += r_frameStats.bytesUploaded;
+                    for (std::size_t bucket{}; bucket < NullRenderBackend::batchSizeBuckets; ++bucket)
+                    {
+                        totalStats.batchSizes[bucket] += r_frameStats.batchSizes[bucket];
+                    }
+                    instanceBytes += m_instanceBuffer.GetFrameUploadBytes();
+                    totalStaticBatchDraws += staticBatchDraws;
+                }
+
+                // Counts are averaged over the frames, and the batch sizes are totals
+                std::stringstream ss;
+                ss << "Render benchmark " << r_scenePath.filename().string() << " ("
+                    << Hierarchy::GetInstance().GetRenderOrder().size() + Hierarchy::GetInstance().GetRenderOrderUI().size()
+                    << " entities, " << frames << " frames): CPU per frame avg " << totalTime / frames << "ms, min "
+                    << minTime << "ms, max " << maxTime << "ms, per frame " << totalStats.drawCalls / frames << " draw calls ("
+                    << totalStaticBatchDraws / frames << " static batches), " << totalStats.instances / frames << " instances, "
+                    << totalStats.stateChanges / frames << " state changes (" << totalStats.redundantStateChanges / frames
+                    << " redundant), " << (totalStats.bytesUploaded + instanceBytes) / frames << " bytes uploaded, batch sizes";
+                for (std::size_t bucket{}; bucket < NullRenderBackend::batchSizeBuckets; ++bucket)
+                {
+                    ss << ' ' << (1U << bucket);
+                    if (bucket + 1 == NullRenderBackend::batchSizeBuckets) { ss << '+'; }
+                    else if (bucket) { ss << '-' << ((2U << bucket) - 1); }
+                    ss << ':' << totalStats.batchSizes[bucket];
+                }
+
+                engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+                engine_logger.SetTime();
+                engine_logger.AddLog(false, ss.str(), __FUNCTION__);
+            }
+
+            SetBackend(r_previousBackend);
+        }
+#endif // !GAMERELEASE
+
+
+        void RendererManager::SetBackend(RenderBackend& r_backend)
+        {
+            // The buffers of the static batches and the instance buffer belong to the backend they were created through
+            m_worldStaticBatches.SetBackend(r_backend);
+            m_p_backend = &r_backend;
+
+            // Create the ring buffer the instance data is written into, with room for 3000 quads a frame to begin with
+            if (m_instanceBuffer.Initialize(r_backend, { static_cast<GLsizeiptr>(sizeof(SpriteInstance)) }, 3000))
+            {
+                m_spriteInstances.Attach(m_instanceBuffer, 0);
+                InitializeInstanceAttributes(m_meshes[static_cast<unsigned char>(EnumMeshType::QUAD)]);
+            }
         }
 
         void RendererManager::DrawCameraQuad()
@@ -417,8 +604,11 @@ namespace PE
 
 
         template<typename T>
-        void RendererManager::DrawQuadsInstanced(glm::mat4 const& r_worldToNdc, std::vector<EntityID> const& r_rendererIdContainer)
+        void RendererManager::DrawQuadsInstanced(glm::mat4 const& r_worldToNdc, std::vector<EntityID> const& r_rendererIdContainer,
+            std::vector<unsigned char> const& r_renderLayers, CullingGrid& r_cullingGrid, StaticBatches* p_staticBatches)
         {
+            PE_PROFILE_SCOPE("Draw Quads Instanced");
+
             auto shaderProgramIterator{ ResourceManager::GetInstance().ShaderPrograms.find(m_instancedShaderProgramKey) };
 
             // Check if shader program is valid
@@ -430,92 +620,335 @@ namespace PE
                 return;
             }
 
+            // Check if there is a buffer to write the instance data into
+            if (!m_instanceBuffer.GetBufferObject()) { return; }
+
             ShaderProgram& r_shaderProgram{ *(shaderProgramIterator->second) };
-            r_shaderProgram.Use();
+            m_p_backend->UseProgram(r_shaderProgram);
 
             // Pass the world to NDC transform matrix as a uniform variable
-            r_shaderProgram.SetUniform("uWorldToNdc", r_worldToNdc);
+            m_p_backend->SetUniform(r_shaderProgram, "uWorldToNdc", r_worldToNdc);
 
             // Bind the quad mesh
             size_t meshIndex{ static_cast<unsigned char>(EnumMeshType::QUAD) };
-            m_meshes[meshIndex].Bind();
+            m_p_backend->BindVertexArray(m_meshes[meshIndex].GetVertexArrayObjectIndex());
+
+            // Sample textures in the atlas from one unit and textures outside it from another
+            m_batchTextureKey.clear();
+            m_batchTexture = SpriteTexture{};
+            m_p_backend->SetUniform(r_shaderProgram, "uTextureSampler2d", m_textureUnit);
+            m_p_backend->SetUniform(r_shaderProgram, "uTextureArray", m_textureAtlasUnit);
+
+            // Find the area of the world that is mapped onto the screen from the corners of NDC space
+            glm::mat4 const ndcToWorld{ glm::inverse(r_worldToNdc) };
+            glm::vec2 viewMin{ std::numeric_limits<float>::max() }, viewMax{ -std::numeric_limits<float>::max() };
+            for (glm::vec2 const& r_corner : { glm::vec2{ -1.f, -1.f }, glm::vec2{ 1.f, -1.f }, glm::vec2{ 1.f, 1.f }, glm::vec2{ -1.f, 1.f } })
+            {
+                glm::vec4 const worldCorner{ ndcToWorld * glm::vec4{ r_corner.x, r_corner.y, 0.f, 1.f } };
+                viewMin = glm::min(viewMin, glm::vec2{ worldCorner.x, worldCorner.y });
+                viewMax = glm::max(viewMax, glm::vec2{ worldCorner.x, worldCorner.y });
+            }
 
-            // Store the texture being used
-            std::string currentTexture{};
-            std::shared_ptr<Graphics::Texture> p_texture{};
+            // Rebin the objects that moved and find the ones in view
+            {
+                PE_PROFILE_SCOPE("Cull Quads");
+                r_cullingGrid.Update(r_rendererIdContainer, Hierarchy::GetInstance().GetRenderOrderVersion());
+                r_cullingGrid.Query(viewMin - m_cullingMargin, viewMax + m_cullingMargin);
+            }
+            std::vector<unsigned char> const& r_visibility{ r_cullingGrid.GetVisibility() };
 
-            // Clear the buffers for the 
-            m_isTextured.clear();
-            m_UV.clear();
-            m_modelToWorldMatrices.clear();
-            m_colors.clear();
+            // Take the baked sprites that changed out of their batches and pick the batches to draw
+            if (p_staticBatches)
+            {
+                PE_PROFILE_SCOPE("Validate Static Batches");
+                p_staticBatches->BeginFrame(r_rendererIdContainer, r_renderLayers, Hierarchy::GetInstance().GetRenderOrderVersion(),
+                    ResourceManager::GetInstance().GetTextureAtlas().GetGeneration(), r_cullingGrid,
+                    viewMin - m_cullingMargin, viewMax + m_cullingMargin);
+            }
 
-            int count{};
+            // Build the sprites, particles and text of the objects in view into packets on every
+            // thread, with each task taking a range of the render order
+            std::size_t const entityCount{ r_rendererIdContainer.size() };
+            std::size_t const taskCount{ std::max<std::size_t>(1, std::min<std::size_t>(buildThreads, entityCount / m_minEntitiesPerBuildTask)) };
+            std::size_t const entitiesPerTask{ (entityCount + taskCount - 1) / taskCount };
+            if (m_buildTasks.size() < taskCount)
+            {
+                m_buildTasks.resize(taskCount);
+            }
+
+            ThreadPool::GetInstance().ReserveThreads(buildThreads);
+            ThreadPool::GetInstance().ParallelFor(static_cast<unsigned>(taskCount), [&](unsigned taskIndex)
+                {
+                    std::size_t const beginIndex{ std::min(entityCount, taskIndex * entitiesPerTask) };
+                    std::size_t const endIndex{ std::min(entityCount, beginIndex + entitiesPerTask) };
+                    m_buildTasks[taskIndex].Clear();
+                    BuildDrawPackets<T>(r_rendererIdContainer, r_visibility, p_staticBatches, beginIndex, endIndex, false, m_buildTasks[taskIndex]);
+                });
+
+            // Queue the packets of the tasks in render order, then draw the queue sorted by the state it is drawn with
+            m_renderQueue.Clear(MemoryManager::GetInstance().GetFrameResource());
+            {
+                PE_PROFILE_SCOPE("Queue Draw Packets");
+                std::size_t nextStaticBatch{};
+                for (std::size_t taskIndex{}; taskIndex < taskCount; ++taskIndex)
+                {
+                    QueueDrawPackets<T>(r_rendererIdContainer, r_renderLayers, r_visibility, r_cullingGrid, p_staticBatches, nextStaticBatch, m_buildTasks[taskIndex]);
+                    textureSwitches += m_buildTasks[taskIndex].textureSwitches;
+                }
+
+                // Queue the batches whose first sprite is after the last object in view
+                QueueStaticBatches(p_staticBatches, entityCount, nextStaticBatch);
+            }
 
-            // Make draw call for each game object with a renderer component
-            for (EntityID const& id : r_rendererIdContainer)
+            m_renderQueue.Sort();
+
+            // Throw away any instance data that was not drawn
+            m_spriteInstances.clear();
+
+            // Draw each run of sprites with the same state in one instanced draw call
+            int count{};
+            unsigned long long batchState{ ~0ull };
+            bool restoreState{ false };
+            bool drewStaticBatch{ false };
+            for (unsigned long long const key : m_renderQueue.GetKeys())
             {
+                RenderQueue::Command const& r_command{ m_renderQueue.GetCommand(key) };
+                if (RenderQueue::GetShader(key) == RenderQueue::EnumShader::TEXT)
+                {
+                    DrawInstanced(count, meshIndex, GL_TRIANGLES);
+                    count = 0;
+                    RenderText(r_command.id, r_worldToNdc);
+                    batchState = ~0ull;
+                    restoreState = true;
+                    continue;
+                }
 
-                
-                // break the instanced render
-                if (EntityManager::GetInstance().Has<PE::TextComponent>(id))
+                if (RenderQueue::GetBatchState(key) != batchState || RenderQueue::GetShader(key) == RenderQueue::EnumShader::STATIC_BATCH)
                 {
                     DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                    currentTexture.clear();
                     count = 0;
-                    RenderText(id, r_worldToNdc);
-                    // continue from the next one after it
-                    auto ite = ++(std::find(r_rendererIdContainer.begin(), r_rendererIdContainer.end(), id));
-                    std::vector<size_t> cont;
-                    while (ite != r_rendererIdContainer.end())
+                    batchState = RenderQueue::GetBatchState(key);
+
+                    // Text uses its own shader program and vertex array
+                    if (restoreState)
                     {
-                        cont.emplace_back(*ite);
-                        ++ite;
+                        m_p_backend->UseProgram(r_shaderProgram);
+                        m_p_backend->BindVertexArray(m_meshes[meshIndex].GetVertexArrayObjectIndex());
+                        restoreState = false;
                     }
-                    DrawQuadsInstanced<T>(r_worldToNdc, cont);
-                    return;
+
+                    m_p_backend->BindTextureUnit(static_cast<GLuint>(m_textureUnit), m_renderQueue.GetTexture(key));
+                }
+
+                // Static batches are drawn from their own buffer
+                if (RenderQueue::GetShader(key) == RenderQueue::EnumShader::STATIC_BATCH)
+                {
+                    DrawStaticBatch(p_staticBatches->GetBatch(static_cast<unsigned>(r_command.id)), meshIndex, GL_TRIANGLES);
+                    drewStaticBatch = true;
+                    continue;
+                }
+
+                m_spriteInstances.emplace_back(r_command.sprite);
+                ++count;
+            }
+
+            // Draw the remaining objects
+            DrawInstanced(count, meshIndex, GL_TRIANGLES);
+            count = 0;
+
+            // Point the instance binding back at the ring buffer, so that the mesh does not
+            // refer to the buffer of a batch that is deleted
+            if (drewStaticBatch)
+            {
+                m_p_backend->BindVertexBuffer(m_meshes[meshIndex].GetVertexArrayObjectIndex(), m_instanceBindingIndex,
+                    m_instanceBuffer.GetBufferObject(), 0, static_cast<GLsizei>(sizeof(SpriteInstance)));
+            }
+
+            // Bake the sprites that have stopped changing and upload the batches that changed
+            if (p_staticBatches)
+            {
+                PE_PROFILE_SCOPE("Bake Static Batches");
+                p_staticBatches->EndFrame();
+            }
+            // Unbind everything
+            m_p_backend->BindVertexArray(0);
+            m_p_backend->UnuseProgram(r_shaderProgram);
+
+            m_p_backend->BindTextureUnit(static_cast<GLuint>(m_textureUnit), 0);
+            m_p_backend->BindTextureUnit(static_cast<GLuint>(m_textureAtlasUnit), 0);
+
+
+        }
+
+
+        template<typename T>
+        RendererManager::SpriteTexture RendererManager::ResolveSpriteTexture(T& r_renderer)
+        {
+            std::string const& r_textureKey{ r_renderer.GetTextureKey() };
+            if (r_textureKey.empty()) { return SpriteTexture{}; }
+
+            // Sprites drawn one after another tend to share a texture
+            if (r_textureKey == m_batchTextureKey) { return m_batchTexture; }
+
+            std::shared_ptr<Texture> p_texture{ ResourceManager::GetInstance().GetTexture(r_textureKey) };
+
+            // Check if texture is null
+            if (!p_texture)
+            {
+                // Remove the texture and set the object to neon pink
+                r_renderer.SetTextureKey("");
+                r_renderer.SetColor(1.f, 0.f, 1.f, 1.f);
+
+                return SpriteTexture{};
+            }
+
+            // Count the batches the texture change would have ended without the atlas
+            if (!m_batchTextureKey.empty()) { ++textureSwitches; }
+            m_batchTextureKey = r_textureKey;
+
+            AtlasRegion const* p_region{ ResourceManager::GetInstance().GetTextureAtlas().Find(r_textureKey) };
+            if (p_region)
+            {
+                m_batchTexture = SpriteTexture{ static_cast<float>(p_region->layer), p_region->uvOffset, p_region->uvScale };
+                return m_batchTexture;
+            }
+
+            // The texture is too large for the atlas or did not fit, so it has to be bound on its own
+            m_batchTexture = SpriteTexture{ SpriteInstance::standaloneLayer, glm::vec2{ 0.f }, glm::vec2{ 1.f }, p_texture->GetTextureID() };
+            return m_batchTexture;
+        }
+
+
+        template<typename T>
+        bool RendererManager::FindSpriteTexture(T const& r_renderer, BuildTask& r_task, SpriteTexture& r_texture) const
+        {
+            std::string const& r_textureKey{ r_renderer.GetTextureKey() };
+            if (r_textureKey.empty())
+            {
+                r_texture = SpriteTexture{};
+                return true;
+            }
+
+            // Sprites drawn one after another tend to share a texture
+            if (r_textureKey == r_task.textureKey)
+            {
+                r_texture = r_task.texture;
+                return true;
+            }
+
+            // Loading the texture, or clearing the key if it does not exist, is left to the main thread
+            ResourceManager& r_resourceManager{ ResourceManager::GetInstance() };
+            auto const textureIterator{ r_resourceManager.Textures.find(r_textureKey) };
+            if (textureIterator == r_resourceManager.Textures.end() || !textureIterator->second) { return false; }
+
+            // Count the batches the texture change would have ended without the atlas
+            if (!r_task.textureKey.empty()) { ++r_task.textureSwitches; }
+            r_task.textureKey = r_textureKey;
+
+            AtlasRegion const* p_region{ r_resourceManager.GetTextureAtlas().Find(r_textureKey) };
+            r_task.texture = p_region ? SpriteTexture{ static_cast<float>(p_region->layer), p_region->uvOffset, p_region->uvScale }
+                : SpriteTexture{ SpriteInstance::standaloneLayer, glm::vec2{ 0.f }, glm::vec2{ 1.f }, textureIterator->second->GetTextureID() };
+            r_texture = r_task.texture;
+            return true;
+        }
+
+
+        template<typename T>
+        void RendererManager::BuildDrawPackets(std::vector<EntityID> const& r_rendererIdContainer, std::vector<unsigned char> const& r_visibility,
+            StaticBatches const* p_staticBatches, std::size_t const beginIndex, std::size_t const endIndex,
+            bool const onMainThread, BuildTask& r_task)
+        {
+            PE_PROFILE_SCOPE("Build Draw Packets");
+
+            // Components are only read here, so that the ranges can be built at the same time
+            EntityManager const& r_entityManager{ EntityManager::GetInstance() };
+
+            // Only the main thread can load a texture, or clear the key of one that does not exist
+            auto const lookUpTexture{ [&](EntityID const id, T const& r_renderer, SpriteTexture& r_texture)
+            {
+                if (!onMainThread) { return FindSpriteTexture(r_renderer, r_task, r_texture); }
+
+                r_texture = ResolveSpriteTexture(EntityManager::GetInstance().Get<T>(id));
+                return true;
+            } };
+
+            for (std::size_t index{ beginIndex }; index < endIndex; ++index)
+            {
+                if (!r_visibility[index]) { continue; }
+
+                DrawPacket packet{};
+                packet.id = r_rendererIdContainer[index];
+                packet.index = static_cast<unsigned>(index);
+                EntityID const id{ packet.id };
+
+                if (p_staticBatches)
+                {
+                    if (p_staticBatches->IsDrawnInBatch(packet.index))
+                    {
+                        packet.type = EnumPacket::RENDERED;
+                        r_task.packets.emplace_back(packet);
+                        continue;
+                    }
+
+                    // Sprites of batches that cannot be drawn in one call are still drawn from the baked data
+                    SpriteInstance const* p_bakedSprite{ p_staticBatches->FindBakedSprite(packet.index, packet.textureID) };
+                    if (p_bakedSprite)
+                    {
+                        packet.sprite = *p_bakedSprite;
+                        packet.firstOfEntity = true;
+                        r_task.packets.emplace_back(packet);
+                        continue;
+                    }
+                }
+
+                // Text is drawn with its own shader where it ends up in the sorted queue
+                if (r_entityManager.Has<PE::TextComponent>(id))
+                {
+                    if (!GETGUISYSTEM()->AreThereActiveCanvases() || !r_entityManager.Get<EntityDescriptor>(id).isActive
+                        || r_entityManager.Get<TextComponent>(id).GetFontKey().empty())
+                        continue;
+
+                    packet.type = EnumPacket::TEXT;
+                    r_task.packets.emplace_back(packet);
+                    continue;
                 }
 
                 // handle particle effects
-                if (EntityManager::GetInstance().Has<PE::ParticleEmitter>(id))
+                if (r_entityManager.Has<PE::ParticleEmitter>(id))
                 {
-                    if (!EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive)
+                    if (!r_entityManager.Get<EntityDescriptor>(id).isActive)
                         continue;
-                    // dump current 
-                    DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                    currentTexture.clear();
-                    count = 0;
-                    // Render particle effects
-                    auto& em = EntityManager::GetInstance().Get<ParticleEmitter>(id);
+                    ParticleEmitter const& em{ r_entityManager.Get<ParticleEmitter>(id) };
                     if (!em.isActive)
                         continue;
-                    T& renderer{ EntityManager::GetInstance().Get<T>(id) };
+                    T const& renderer{ r_entityManager.Get<T>(id) };
+
+                    // The emitter is recorded as rendered even if none of its particles are enabled
+                    std::size_t const firstPacket{ r_task.packets.size() };
+                    packet.type = EnumPacket::RENDERED;
+                    r_task.packets.emplace_back(packet);
+                    packet.type = EnumPacket::SPRITE;
+
+                    glm::vec4 const color{ em.startColor.x, em.startColor.y, em.startColor.z, em.startColor.w };
+                    auto const pushParticle{ [&](Particle const& r_particle, glm::vec2 const& r_minUV, glm::vec2 const& r_maxUV, float const layer)
+                    {
+                        Transform const& xform{ r_particle.transform };
+                        packet.sprite = SpriteInstance{ xform.width, xform.height, xform.orientation, // width, height, orientation
+                            xform.position.x, xform.position.y, // x, y position
+                            color, r_minUV, r_maxUV, layer };
+                        r_task.packets.emplace_back(packet);
+                    } };
 
                     switch (em.particleType)
                     {
                     case SQUARE:
                     {
-                        for (auto& p : em.GetParticles())
+                        for (Particle const& p : em.GetParticles())
                         {
                             if (!p.enabled)
                                 continue;
-                            auto& xform = p.transform;
-                            m_isTextured.emplace_back(0.f);
-                            m_modelToWorldMatrices.emplace_back(GenerateTransformMatrix(xform.width, // width
-                                xform.height, xform.orientation, // height, orientation
-                                xform.position.x, xform.position.y)); // x, y position
-                            m_colors.emplace_back(glm::vec4(em.startColor.x, em.startColor.y, em.startColor.z, em.startColor.w));
-
-                            // Add the UV coordinate adjustments
-                            m_UV.emplace_back(renderer.GetUVCoordinatesMin()); // bottom left
-                            m_UV.emplace_back(renderer.GetUVCoordinatesMax().x, renderer.GetUVCoordinatesMin().y); // bottom right
-                            m_UV.emplace_back(renderer.GetUVCoordinatesMax()); // top right
-                            m_UV.emplace_back(renderer.GetUVCoordinatesMin().x, renderer.GetUVCoordinatesMax().y); // top left
-                            ++count;
+                            pushParticle(p, renderer.GetUVCoordinatesMin(), renderer.GetUVCoordinatesMax(), SpriteInstance::untexturedLayer);
                         }
-                        DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                        currentTexture.clear();
-                        count = 0;
                     }
                     break;
                     /*case CIRCLE:
@@ -526,283 +959,174 @@ namespace PE
                     case TEXTURED:
                     case ANIMATED:
                     {
-                        const glm::vec2& minUV = renderer.GetUVCoordinatesMin();
-                        const glm::vec2& maxUV = renderer.GetUVCoordinatesMax();
-                        if (EntityManager::GetInstance().Has<AnimationComponent>(id) && EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetFrameCount())
+                        // Find where the texture is in the atlas, or that it has to be bound on its own
+                        SpriteTexture spriteTexture{};
+                        std::shared_ptr<Animation> p_animation{};
+                        bool resolved{ lookUpTexture(id, renderer, spriteTexture) };
+                        if (resolved && r_entityManager.Has<AnimationComponent>(id))
                         {
-                            std::map<int, std::vector<const PE::Particle*>> particles;
-                            for (auto& p : em.GetParticles())
+                            std::string const animationID{ r_entityManager.Get<AnimationComponent>(id).GetAnimationID() };
+                            if (onMainThread)
                             {
-                                particles[p.spriteID % EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetFrameCount()].emplace_back(&p);
+                                p_animation = ResourceManager::GetInstance().GetAnimation(animationID);
                             }
-                            for (auto& [k, v] : particles)
+                            else
                             {
-                                int frame = ((em.particleType == ANIMATED)? EntityManager::GetInstance().Get<AnimationComponent>(id).GetCurrentFrameIndex() : 0) + k;
-                                frame %= EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetFrameCount();
-                                glm::vec2 minOffset{ EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetCurrentAnimationFrame(frame).m_minUV.x, EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetCurrentAnimationFrame(frame).m_minUV.y };
-                                glm::vec2 maxOffset{ EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetCurrentAnimationFrame(frame).m_maxUV.x, EntityManager::GetInstance().Get<AnimationComponent>(id).GetAnimation()->GetCurrentAnimationFrame(frame).m_maxUV.y };
-                                for (auto& p : v)
-                                {
-                                    if (!p->enabled)
-                                        continue;
-                                    // Attempt to retrieve and bind the texture
-                                    if (renderer.GetTextureKey().empty())
-                                    {
-                                        m_isTextured.emplace_back(0.f);
-                                    }
-                                    else if (currentTexture != renderer.GetTextureKey())
-                                    {
-                                        // Check if we were already 
-                                        if (!currentTexture.empty())
-                                        {
-                                            DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                                            currentTexture.clear();
-                                            count = 0;
-                                        }
-
-                                        std::shared_ptr<Texture> texture{ ResourceManager::GetInstance().GetTexture(renderer.GetTextureKey()) };
-
-                                        // Check if texture is null
-                                        if (!texture)
-                                        {
-                                            // Remove the texture and set the object to neon pink
-                                            renderer.SetTextureKey("");
-                                            renderer.SetColor(1.f, 0.f, 1.f, 1.f);
-
-                                            m_isTextured.emplace_back(0.f);
-                                        }
-                                        else
-                                        {
-                                            // Unbind the existing texture
-                                            if (p_texture)
-                                            {
-                                                p_texture->Unbind();
-                                            }
-
-                                            // Store the texture key of the current texture
-                                            currentTexture = renderer.GetTextureKey();
-
-                                            // Bind the new texture
-                                            GLint textureUnit{ 0 };
-                                            p_texture = texture;
-                                            p_texture->Bind(textureUnit);
-                                            r_shaderProgram.SetUniform("uTextureSampler2d", textureUnit);
-
-                                            m_isTextured.emplace_back(1.f);
-                                        }
-                                    }
-                                    else
-                                    {
-                                        m_isTextured.emplace_back(1.f);
-                                    }
-                                    // change this line + look for texture
-                                    //m_isTextured.emplace_back(0.f);
-                                    auto& xform = p->transform;
-                                    m_modelToWorldMatrices.emplace_back(GenerateTransformMatrix(xform.width, // width
-                                        xform.height, xform.orientation, // height, orientation
-                                        xform.position.x, xform.position.y)); // x, y position
-                                    m_colors.emplace_back(glm::vec4(em.startColor.x, em.startColor.y, em.startColor.z, em.startColor.w));
-
-                                    // Add the UV coordinate adjustments
-                                    m_UV.emplace_back(minOffset); // bottom left
-                                    m_UV.emplace_back(maxOffset.x, minOffset.y); // bottom right
-                                    m_UV.emplace_back(maxOffset); // top right
-                                    m_UV.emplace_back(minOffset.x, maxOffset.y); // top left
-
-                                    ++count;
-
-                                }
-                                DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                                count = 0;
+                                auto const animationIterator{ ResourceManager::GetInstance().Animations.find(animationID) };
+                                resolved = animationIterator != ResourceManager::GetInstance().Animations.end();
+                                if (resolved) { p_animation = animationIterator->second; }
+                            }
+                        }
+
+                        // Build the whole emitter on the main thread instead
+                        if (!resolved)
+                        {
+                            r_task.packets.resize(firstPacket);
+                            packet.type = EnumPacket::RESOLVE;
+                            r_task.packets.emplace_back(packet);
+                            break;
+                        }
+
+                        packet.textureID = spriteTexture.textureID;
+                        if (p_animation && p_animation->GetFrameCount())
+                        {
+                            unsigned const frameCount{ p_animation->GetFrameCount() };
+                            unsigned const currentFrame{ (em.particleType == ANIMATED) ? r_entityManager.Get<AnimationComponent>(id).GetCurrentFrameIndex() : 0 };
+
+                            // Draw the particles grouped by the frame they are offset by
+                            r_task.particles.clear();
+                            for (Particle const& p : em.GetParticles())
+                            {
+                                r_task.particles.emplace_back(static_cast<unsigned>(p.spriteID) % frameCount, &p);
+                            }
+                            std::stable_sort(r_task.particles.begin(), r_task.particles.end(),
+                                [](auto const& r_lhs, auto const& r_rhs) { return r_lhs.first < r_rhs.first; });
+
+                            for (auto const& [frameOffset, p_particle] : r_task.particles)
+                            {
+                                if (!p_particle->enabled)
+                                    continue;
+                                AnimationFrame const& r_frame{ p_animation->GetCurrentAnimationFrame((currentFrame + frameOffset) % frameCount) };
+                                glm::vec2 const minOffset{ r_frame.m_minUV.x, r_frame.m_minUV.y };
+                                glm::vec2 const maxOffset{ r_frame.m_maxUV.x, r_frame.m_maxUV.y };
+                                pushParticle(*p_particle, spriteTexture.MapUV(minOffset), spriteTexture.MapUV(maxOffset), spriteTexture.layer); // UV coordinates of the frame
                             }
                         }
                         else
                         {
-                            for (auto& p : em.GetParticles())
+                            for (Particle const& p : em.GetParticles())
                             {
                                 if (!p.enabled)
                                     continue;
-                                // Attempt to retrieve and bind the texture
-                                if (renderer.GetTextureKey().empty())
-                                {
-                                    m_isTextured.emplace_back(0.f);
-                                }
-                                else if (currentTexture != renderer.GetTextureKey())
-                                {
-                                    // Check if we were already 
-                                    if (!currentTexture.empty())
-                                    {
-                                        DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                                        currentTexture.clear();
-                                        count = 0;
-                                    }
-
-                                    std::shared_ptr<Texture> texture{ ResourceManager::GetInstance().GetTexture(renderer.GetTextureKey()) };
-
-                                    // Check if texture is null
-                                    if (!texture)
-                                    {
-                                        // Remove the texture and set the object to neon pink
-                                        renderer.SetTextureKey("");
-                                        renderer.SetColor(1.f, 0.f, 1.f, 1.f);
-
-                                        m_isTextured.emplace_back(0.f);
-                                    }
-                                    else
-                                    {
-                                        // Unbind the existing texture
-                                        if (p_texture)
-                                        {
-                                            p_texture->Unbind();
-                                        }
-
-                                        // Store the texture key of the current texture
-                                        currentTexture = renderer.GetTextureKey();
-
-                                        // Bind the new texture
-                                        GLint textureUnit{ 0 };
-                                        p_texture = texture;
-                                        p_texture->Bind(textureUnit);
-                                        r_shaderProgram.SetUniform("uTextureSampler2d", textureUnit);
-
-                                        m_isTextured.emplace_back(1.f);
-                                    }
-                                }
-                                else
-                                {
-                                    m_isTextured.emplace_back(1.f);
-                                }
-                                // change this line + look for texture
-                                //m_isTextured.emplace_back(0.f);
-                                auto& xform = p.transform;
-                                m_modelToWorldMatrices.emplace_back(GenerateTransformMatrix(xform.width, // width
-                                    xform.height, xform.orientation, // height, orientation
-                                    xform.position.x, xform.position.y)); // x, y position
-                                m_colors.emplace_back(glm::vec4(em.startColor.x, em.startColor.y, em.startColor.z, em.startColor.w));
-
-                                // Add the UV coordinate adjustments
-                                m_UV.emplace_back(minUV); // bottom left
-                                m_UV.emplace_back(maxUV.x, minUV.y); // bottom right
-                                m_UV.emplace_back(maxUV); // top right
-                                m_UV.emplace_back(minUV.x, maxUV.y); // top left
-
-                                ++count;
+                                pushParticle(p, spriteTexture.MapUV(renderer.GetUVCoordinatesMin()), spriteTexture.MapUV(renderer.GetUVCoordinatesMax()), spriteTexture.layer);
                             }
                         }
-
-                        DrawInstanced(count, meshIndex, GL_TRIANGLES);
-
-                        count = 0;
                     }
                     break;
                     default:
                         break;
                     }
 
-                    renderedEntities.emplace_back(id);
-
                     continue;
-
                 }
 
-                // Skip this object if it has no renderer
-                if (!EntityManager::GetInstance().Has<T>(id))
+                // Skip this object if it has no renderer, or no transform to draw it with
+                if (!r_entityManager.Has<T>(id) || !r_entityManager.Has<Transform>(id))
                 {
-                    return;
+                    continue;
                 }
 
-                T& renderer{ EntityManager::GetInstance().Get<T>(id) };
+                T const& renderer{ r_entityManager.Get<T>(id) };
 
                 // Skip drawing this object is the entity or renderer is not enabled
-                if (!EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive
+                if (!r_entityManager.Get<EntityDescriptor>(id).isActive
                     || !renderer.GetEnabled()/* || !Hierarchy::GetInstance().AreParentsActive(id)*/) {
                     continue;
                 }
 
-                // Store the index of the rendered entity
-                renderedEntities.emplace_back(id);
-
-                const Transform& transform{ EntityManager::GetInstance().Get<Transform>(id) };
-
-                // Attempt to retrieve and bind the texture
-                if (renderer.GetTextureKey().empty())
+                // Find where the texture is in the atlas, or that it has to be bound on its own
+                SpriteTexture spriteTexture{};
+                if (!lookUpTexture(id, renderer, spriteTexture))
                 {
-                    m_isTextured.emplace_back(0.f);
+                    packet.type = EnumPacket::RESOLVE;
+                    r_task.packets.emplace_back(packet);
+                    continue;
                 }
-                else if (currentTexture != renderer.GetTextureKey())
-                {
-                    // Check if we were already 
-                    if (!currentTexture.empty())
-                    {
-                        DrawInstanced(count, meshIndex, GL_TRIANGLES);
-                        currentTexture.clear();
-                        count = 0;
-                    }
-
-                    std::shared_ptr<Texture> texture{ ResourceManager::GetInstance().GetTexture(renderer.GetTextureKey()) };
 
-                    // Check if texture is null
-                    if (!texture)
-                    {
-                        // Remove the texture and set the object to neon pink
-                        renderer.SetTextureKey("");
-                        renderer.SetColor(1.f, 0.f, 1.f, 1.f);
+                const Transform& transform{ r_entityManager.Get<Transform>(id) };
+
+                // Draw objects moved by physics between their last two steps
+                vec2 const position{ GETPHYSICSMANAGER()->GetInterpolatedPosition(id, transform.position) };
+
+                // Queue the transform, color and UV coordinates of the quad,
+                // the vertex shader builds the model to world matrix from them
+                packet.sprite = SpriteInstance{ transform.width, transform.height, transform.orientation, // width, height, orientation
+                    position.x, position.y, // x, y position
+                    renderer.GetColor(), spriteTexture.MapUV(renderer.GetUVCoordinatesMin()), spriteTexture.MapUV(renderer.GetUVCoordinatesMax()), spriteTexture.layer };
+                packet.textureID = spriteTexture.textureID;
+                packet.revision = renderer.GetRevision();
+                packet.firstOfEntity = true;
+                packet.track = p_staticBatches != nullptr;
+                r_task.packets.emplace_back(packet);
+            }
+        }
 
-                        m_isTextured.emplace_back(0.f);
-                    }
-                    else
-                    {
-                        // Unbind the existing texture
-                        if (p_texture)
-                        {
-                            p_texture->Unbind();
-                        }
 
-                        // Store the texture key of the current texture
-                        currentTexture = renderer.GetTextureKey();
+        template<typename T>
+        void RendererManager::QueueDrawPackets(std::vector<EntityID> const& r_rendererIdContainer, std::vector<unsigned char> const& r_renderLayers,
+            std::vector<unsigned char> const& r_visibility, CullingGrid& r_cullingGrid, StaticBatches* p_staticBatches,
+            std::size_t& r_nextStaticBatch, BuildTask const& r_task)
+        {
+            for (DrawPacket const& r_packet : r_task.packets)
+            {
+                // Queue the static batches where their first sprite is, even if it is culled
+                QueueStaticBatches(p_staticBatches, r_packet.index, r_nextStaticBatch);
 
-                        // Bind the new texture
-                        GLint textureUnit{ 0 };
-                        p_texture = texture;
-                        p_texture->Bind(textureUnit);
-                        r_shaderProgram.SetUniform("uTextureSampler2d", textureUnit);
+                unsigned const layer{ r_renderLayers[r_packet.index] };
+                switch (r_packet.type)
+                {
+                case EnumPacket::SPRITE:
+                    if (r_packet.firstOfEntity) { renderedEntities.emplace_back(r_packet.id); }
+                    m_renderQueue.PushSprite(layer, r_packet.id, r_packet.sprite, r_packet.textureID);
 
-                        m_isTextured.emplace_back(1.f);
+                    // Bake the sprite once it has been drawn the same way for long enough
+                    if (r_packet.track && p_staticBatches)
+                    {
+                        p_staticBatches->Track(r_cullingGrid, r_packet.index, layer, r_packet.revision, r_packet.sprite, r_packet.textureID);
                     }
+                    break;
+                case EnumPacket::TEXT:
+                    renderedEntities.emplace_back(r_packet.id);
+                    m_renderQueue.PushText(layer, r_packet.id);
+                    break;
+                case EnumPacket::RENDERED:
+                    renderedEntities.emplace_back(r_packet.id);
+                    break;
+                case EnumPacket::RESOLVE:
+                    // Build the entity again now that its texture and animation can be loaded,
+                    // no packet built on the main thread has to be resolved
+                    m_resolveTask.Clear();
+                    BuildDrawPackets<T>(r_rendererIdContainer, r_visibility, p_staticBatches, r_packet.index, r_packet.index + 1, true, m_resolveTask);
+                    QueueDrawPackets<T>(r_rendererIdContainer, r_renderLayers, r_visibility, r_cullingGrid, p_staticBatches, r_nextStaticBatch, m_resolveTask);
+                    break;
+                default:
+                    break;
                 }
-                else
-                {
-                    m_isTextured.emplace_back(1.f);
-                }
-
-                // Add the matrix and colors to the buffer
-                m_modelToWorldMatrices.emplace_back(GenerateTransformMatrix(transform.width, // width
-                    transform.height, transform.orientation, // height, orientation
-                    transform.position.x, transform.position.y)); // x, y position
-                m_colors.emplace_back(renderer.GetColor());
-
-                // Add the UV coordinate adjustments
-                m_UV.emplace_back(renderer.GetUVCoordinatesMin()); // bottom left
-                m_UV.emplace_back(renderer.GetUVCoordinatesMax().x, renderer.GetUVCoordinatesMin().y); // bottom right
-                m_UV.emplace_back(renderer.GetUVCoordinatesMax()); // top right
-                m_UV.emplace_back(renderer.GetUVCoordinatesMin().x, renderer.GetUVCoordinatesMax().y); // top left
-
-                ++count;
             }
+        }
 
-            // Draw the remaining objects
-            DrawInstanced(count, meshIndex, GL_TRIANGLES);
-            count = 0;
-            // Unbind everything
-            m_meshes[meshIndex].Unbind();
-            r_shaderProgram.UnUse();
 
-            if (p_texture != nullptr)
+        void RendererManager::QueueStaticBatches(StaticBatches const* p_staticBatches, std::size_t const index, std::size_t& r_nextStaticBatch)
+        {
+            if (!p_staticBatches) { return; }
+
+            std::vector<unsigned> const& r_drawnBatches{ p_staticBatches->GetDrawnBatches() };
+            for (; r_nextStaticBatch < r_drawnBatches.size()
+                && p_staticBatches->GetBatch(r_drawnBatches[r_nextStaticBatch]).members.front() <= index; ++r_nextStaticBatch)
             {
-                p_texture->Unbind();
+                StaticBatches::Batch const& r_batch{ p_staticBatches->GetBatch(r_drawnBatches[r_nextStaticBatch]) };
+                m_renderQueue.PushBatch(r_batch.layer, r_drawnBatches[r_nextStaticBatch], r_batch.textureID, r_batch.min, r_batch.max);
             }
-
-
         }
 
 
@@ -1052,108 +1376,69 @@ namespace PE
         {
             if (!count) { return; }
 
-            // Store the sizes of the sub buffers
-            size_t sizeOfTexturedVector{ m_isTextured.size() * sizeof(float) };
-            size_t sizeOfColorVector{ m_colors.size() * sizeof(glm::vec4) };
-            size_t sizeOfMatrixVector{ m_modelToWorldMatrices.size() * sizeof(glm::mat4) };
-            size_t sizeOfUVVector{ m_UV.size() * sizeof(glm::vec2) };
-
-
-            // Create buffer object for additional vertex data
-            GLuint vertexBufferObject{}, vertexArrayObjectIndex{ m_meshes[meshIndex].GetVertexArrayObjectIndex() };
-            glCreateBuffers(1, &vertexBufferObject);
-            glNamedBufferStorage(vertexBufferObject,
-                static_cast<GLsizeiptr>(sizeOfTexturedVector + sizeOfColorVector + sizeOfMatrixVector + sizeOfUVVector),
-                nullptr, GL_DYNAMIC_STORAGE_BIT);
-
-
-            // Store UV coordinates in VBO
-            glNamedBufferSubData(vertexBufferObject, 0,
-                static_cast<GLsizeiptr>(sizeOfUVVector),
-                reinterpret_cast<GLvoid*>(m_UV.data()));
-
-            // Bind the UV coordinates
-            GLuint attributeIndex{ 2 }, bindingIndex{ 2 };
-            glEnableVertexArrayAttrib(vertexArrayObjectIndex, attributeIndex);
-            glVertexArrayVertexBuffer(vertexArrayObjectIndex, bindingIndex, vertexBufferObject, 0,
-                static_cast<GLsizei>(sizeof(glm::vec2)));
-            glVertexArrayAttribFormat(vertexArrayObjectIndex, attributeIndex, 2, GL_FLOAT, GL_FALSE, 0);
-            glVertexArrayAttribBinding(vertexArrayObjectIndex, attributeIndex, bindingIndex);
-
-            // Store textured bools in VBO
-            glNamedBufferSubData(vertexBufferObject, static_cast<GLintptr>(sizeOfUVVector),
-                static_cast<GLsizeiptr>(sizeOfTexturedVector),
-                reinterpret_cast<GLvoid*>(m_isTextured.data()));
-
-            // Bind the textured bools            
-            ++attributeIndex, ++bindingIndex;
-            glEnableVertexArrayAttrib(vertexArrayObjectIndex, attributeIndex);
-            glVertexArrayVertexBuffer(vertexArrayObjectIndex, bindingIndex, vertexBufferObject, static_cast<GLintptr>(sizeOfUVVector),
-                static_cast<GLsizei>(sizeof(float)));
-            glVertexArrayAttribFormat(vertexArrayObjectIndex, attributeIndex, 1, GL_FLOAT, GL_FALSE, 0);
-            glVertexArrayAttribBinding(vertexArrayObjectIndex, attributeIndex, bindingIndex);
-            glVertexAttribDivisor(attributeIndex, 1); // Advance once per instance 
-
-            // Store colors in VBO
-            glNamedBufferSubData(vertexBufferObject,
-                static_cast<GLintptr>(sizeOfUVVector + sizeOfTexturedVector),
-                static_cast<GLsizeiptr>(sizeOfColorVector),
-                reinterpret_cast<GLvoid*>(m_colors.data()));
-
-            // Bind the colors
-            ++attributeIndex, ++bindingIndex;
-            glEnableVertexArrayAttrib(vertexArrayObjectIndex, attributeIndex);
-            glVertexArrayVertexBuffer(vertexArrayObjectIndex, bindingIndex, vertexBufferObject,
-                static_cast<GLintptr>(sizeOfUVVector + sizeOfTexturedVector), static_cast<GLsizei>(sizeof(glm::vec4)));
-            glVertexArrayAttribFormat(vertexArrayObjectIndex, attributeIndex, 4, GL_FLOAT, GL_FALSE, 0);
-            glVertexArrayAttribBinding(vertexArrayObjectIndex, attributeIndex, bindingIndex);
-            glVertexAttribDivisor(attributeIndex, 1); // Advance once per instance
-
-            // Store model to NDC matrices in VBO
-            glNamedBufferSubData(vertexBufferObject,
-                static_cast<GLintptr>(sizeOfUVVector + sizeOfTexturedVector + sizeOfColorVector),
-                static_cast<GLsizeiptr>(sizeOfMatrixVector),
-                reinterpret_cast<GLvoid*>(m_modelToWorldMatrices.data()));
-
-            // Bind the model to NDC matrices
-            ++attributeIndex, ++bindingIndex;
-
-            glVertexArrayVertexBuffer(vertexArrayObjectIndex, bindingIndex, vertexBufferObject,
-                static_cast<GLintptr>(sizeOfUVVector + sizeOfTexturedVector + sizeOfColorVector),
-                static_cast<GLsizei>(sizeof(glm::mat4)));
-
-            for (int i{}; i < 4; ++i)
-            {
-                glEnableVertexArrayAttrib(vertexArrayObjectIndex, attributeIndex);
-
-                glVertexArrayAttribFormat(vertexArrayObjectIndex, attributeIndex, 4, GL_FLOAT, GL_FALSE, sizeof(GL_FLOAT) * 4 * i); // offset by vert pos and color
-                glVertexArrayAttribBinding(vertexArrayObjectIndex, attributeIndex, bindingIndex);
-                ++attributeIndex;
-            }
-            // Advance once per instance
-            glVertexArrayBindingDivisor(vertexArrayObjectIndex, bindingIndex, 1);
+            // Point the instance binding to the start of the current batch, the attribute
+            // formats and divisor were set when the mesh was initialized
+            m_p_backend->BindVertexBuffer(m_meshes[meshIndex].GetVertexArrayObjectIndex(), m_instanceBindingIndex,
+                m_instanceBuffer.GetBufferObject(), m_spriteInstances.GetBatchOffset(), static_cast<GLsizei>(sizeof(SpriteInstance)));
+
+            // The atlas is bound for every batch as it is recreated when it grows
+            m_p_backend->BindTextureUnit(static_cast<GLuint>(m_textureAtlasUnit), ResourceManager::GetInstance().GetTextureAtlas().GetTextureID());
 
             // ------------------------------------------- FOR M2 RUBRIC 1124, ADD BREAKPOINT TO THIS LINE -------------//
             // Make instanced draw
-            glDrawElementsInstanced(primitiveType, static_cast<GLsizei>(m_meshes[meshIndex].indices.size()),
-                GL_UNSIGNED_SHORT, NULL, static_cast<GLsizei>(count));
+            m_p_backend->DrawElementsInstanced(primitiveType, static_cast<GLsizei>(m_meshes[meshIndex].indices.size()),
+                static_cast<GLsizei>(count));
 
-            // Delete the buffer
-            glDeleteBuffers(1, &vertexBufferObject);
+            // Start the next batch after this one
+            m_instanceBuffer.SubmitBatch();
 
-            --attributeIndex;
-            while (attributeIndex >= 2)
-            {
-                glDisableVertexArrayAttrib(vertexArrayObjectIndex, attributeIndex--);
-            }
+            ++objectDrawCalls;
+        }
 
-            // Clear the vectors
-            m_isTextured.clear();
-            m_colors.clear();
-            m_UV.clear();
-            m_modelToWorldMatrices.clear();
+
+        void RendererManager::DrawStaticBatch(StaticBatches::Batch const& r_batch, size_t const meshIndex, GLenum const primitiveType)
+        {
+            if (r_batch.members.empty() || !r_batch.bufferObject) { return; }
+
+            m_p_backend->BindVertexBuffer(m_meshes[meshIndex].GetVertexArrayObjectIndex(), m_instanceBindingIndex,
+                r_batch.bufferObject, 0, static_cast<GLsizei>(sizeof(SpriteInstance)));
+
+            // The atlas is bound for every batch as it is recreated when it grows
+            m_p_backend->BindTextureUnit(static_cast<GLuint>(m_textureAtlasUnit), ResourceManager::GetInstance().GetTextureAtlas().GetTextureID());
+
+            m_p_backend->DrawElementsInstanced(primitiveType, static_cast<GLsizei>(m_meshes[meshIndex].indices.size()),
+                static_cast<GLsizei>(r_batch.members.size()));
 
             ++objectDrawCalls;
+            ++staticBatchDraws;
+            staticBatchSprites += static_cast<unsigned>(r_batch.members.size());
+        }
+
+
+        void RendererManager::InitializeInstanceAttributes(MeshData const& r_mesh)
+        {
+            GLuint const vertexArrayObjectIndex{ r_mesh.GetVertexArrayObjectIndex() };
+
+            // Sets the format of an attribute read from a member of the sprite instance
+            auto setAttribute{ [&](GLuint const attributeIndex, GLint const size, GLenum const type, GLboolean const normalized, std::size_t const offset)
+            {
+                m_p_backend->SetVertexAttribute(vertexArrayObjectIndex, attributeIndex, m_instanceBindingIndex, size, type, normalized, static_cast<GLuint>(offset));
+            } };
+
+            // Locations match the inputs of Shaders/Instanced.vert
+            setAttribute(2, 2, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, position));
+            setAttribute(3, 2, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, halfSize));
+            setAttribute(4, 1, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, rotation));
+            setAttribute(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(SpriteInstance, color)); // Unpacked to [0, 1]
+            setAttribute(6, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, minUV));        // Min and max UV as one vec4
+            setAttribute(7, 1, GL_FLOAT, GL_FALSE, offsetof(SpriteInstance, textureLayer));
+
+            // Advance once per instance
+            m_p_backend->SetBindingDivisor(vertexArrayObjectIndex, m_instanceBindingIndex, 1);
+
+            // Bind the instance buffer so that the enabled attributes always have a buffer, 
+            // even for the draws made with the mesh that do not use them
+            m_p_backend->BindVertexBuffer(vertexArrayObjectIndex, m_instanceBindingIndex, m_instanceBuffer.GetBufferObject(), 0, static_cast<GLsizei>(sizeof(SpriteInstance)));
         }
 
 
@@ -1255,6 +1540,8 @@ namespace PE
 
         void RendererManager::RenderText(glm::mat4 const& r_worldToNdc)
         {
+            PE_PROFILE_SCOPE("Render Text");
+
             // Don't bother if there are no active canvases
             if (!GETGUISYSTEM()->AreThereActiveCanvases()) { return; }
 
@@ -1338,9 +1625,6 @@ namespace PE
                 return;
             }
 
-            // Store the index of the rendered entity
-            renderedEntities.emplace_back(r_id);
-
             std::shared_ptr<Font> p_font{ ResourceManager::GetInstance().GetFont(textComponent.GetFontKey()) };
 
             std::vector<std::string> lines{ SplitTextIntoLines(textComponent, textBox) };
@@ -1348,12 +1632,11 @@ namespace PE
             float hAlignOffset, vAlignOffset;
 
             // activate corresponding render state	
-            p_textShader->Use();
-            p_textShader->SetUniform("u_ViewProjection", r_worldToNdc);
-            p_textShader->SetUniform("textColor", textComponent.GetColor());
+            m_p_backend->UseProgram(*p_textShader);
+            m_p_backend->SetUniform(*p_textShader, "u_ViewProjection", r_worldToNdc);
+            m_p_backend->SetUniform(*p_textShader, "textColor", textComponent.GetColor());
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindVertexArray(p_font->vertexArrayObject);
+            m_p_backend->BindVertexArray(p_font->vertexArrayObject);
 
             // get vertical alignment offset
             VerticalTextAlignment(textComponent, lines, textBox, vAlignOffset);
@@ -1370,10 +1653,10 @@ namespace PE
                 currentY += p_font->lineHeight * textComponent.GetLineSpacing();
             }
 
-            glBindTexture(GL_TEXTURE_2D, 0);
-            glBindVertexArray(0);
+            m_p_backend->BindTextureUnit(0, 0);
+            m_p_backend->BindVertexArray(0);
 
-            p_textShader->UnUse();
+            m_p_backend->UnuseProgram(*p_textShader);
         }
 
         void RendererManager::RenderLine(TextComponent const& r_textComponent, std::string const& r_line, vec2 position, float currentY, float hAlignOffset, float vAlignOffset)
@@ -1409,15 +1692,13 @@ namespace PE
                 };
 
                 // render glyph texture over quad
-                glBindTexture(GL_TEXTURE_2D, ch.textureID);
+                m_p_backend->BindTextureUnit(0, ch.textureID);
 
                 // update content of VBO memory
-                glBindBuffer(GL_ARRAY_BUFFER, p_font->vertexBufferObject);
-                glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                m_p_backend->UpdateBuffer(p_font->vertexBufferObject, 0, sizeof(vertices), vertices);
 
                 // render quad
-                glDrawArrays(GL_TRIANGLES, 0, 6);
+                m_p_backend->DrawArrays(GL_TRIANGLES, 0, 6);
 
                 ++textDrawCalls;
                 // now advance cursors for next glyph
@@ -26,6 +26,12 @@
 
 #include "CameraManager.h"
 #include "MeshData.h"
+#include "InstanceRingBuffer.h"
+#include "RenderBackend.h"
+#include "SpriteInstance.h"
+#include "RenderQueue.h"
+#include "CullingGrid.h"
+#include "StaticBatches.h"
 #include "FrameBuffer.h"
 #include "ShaderProgram.h"
 #include "System.h"
@@ -38,6 +44,8 @@
 
 namespace PE
 {
+    struct Particle;
+
     namespace Graphics
     {
         /*!***********************************************************************************
@@ -53,6 +61,15 @@ namespace PE
             static unsigned textDrawCalls;    // Total draw calls made for text (1 draw call per chara)
             static unsigned objectDrawCalls;  // Total draw calls for gameobjects
             static unsigned debugDrawCalls;   // Total draw calls for debug shapes
+            static unsigned instanceBatches;  // Batches of instances drawn from the instance ring buffer
+            static unsigned long long instanceUploadBytes;  // Bytes of instance data written this frame
+            static unsigned long long instanceBufferStalls; // Times the CPU waited for the GPU to release instance data, since startup
+            static unsigned textureSwitches;  // Times the texture changed between sprites drawn one after another, each used to end the batch
+            static CullingStats sceneViewCulling; // Entities visible and culled the last time the editor scene view was drawn
+            static CullingStats gameViewCulling;  // Entities visible and culled the last time the game view was drawn
+            static unsigned staticBatchDraws;     // Draw calls made for static batches
+            static unsigned staticBatchSprites;   // Sprites drawn from static batches instead of the instance ring buffer
+            static unsigned buildThreads;         // Threads the draw packets of a pass are built across, including the main thread
 
             // ----- Constructors ----- //
         public:
@@ -115,6 +132,24 @@ namespace PE
             *************************************************************************************/
             inline std::string GetName() { return m_systemName; }
 
+#ifndef GAMERELEASE
+            /*!***********************************************************************************
+             \brief Loads each scene in a directory and draws its objects and UI for a number
+                    of frames through a null backend, which counts the commands instead of
+                    submitting them, so that only the CPU cost of the passes is timed. The CPU
+                    time per frame and the draw calls, instances, state changes, bytes
+                    uploaded and batch sizes of each scene are written to the log. The scene
+                    that was loaded is replaced. Loading the scenes creates their textures,
+                    meshes, shaders and fonts through the resource backend, so there only has
+                    to be a window and an OpenGL context if that is an OpenGL backend.
+
+             \param[in] r_sceneDirectory Directory of the .scene files to load.
+             \param[in] frameCount Number of frames to draw each scene for.
+             \param[in] r_tracePath File to write every command to, empty to not write them.
+            *************************************************************************************/
+            void BenchmarkScenes(std::string const& r_sceneDirectory, unsigned const frameCount, std::string const& r_tracePath);
+#endif // !GAMERELEASE
+
             /*!***********************************************************************************
              \brief Draws the texture attached to the render frame buffer to a quad stretched 
                     to the size of the window.
@@ -130,18 +165,30 @@ namespace PE
 
             /*!***********************************************************************************
              \brief Loops through all objects with a Renderer component (or a class that
-                    derives from it) and draws it. Batches the colors, transformation matrices 
-                    and textured status together into a vertex buffer object and makes an 
-                    instanced drawcall. The instanced batch is broken when a new texture is encountered.
+                    derives from it) and draws it. The sprites, particles and text are queued
+                    with a sort key each, and the queue is sorted so that sprites with the same
+                    state are drawn in one instanced drawcall. Sprites only stay in render 
+                    order relative to the sprites and text they overlap, so that transparency
+                    is blended correctly. Objects outside the area the matrix maps onto the
+                    screen are culled with the culling grid before they are queued.
+
+                    The instance data of the objects is built into draw packets across
+                    buildThreads threads, then the packets are queued and drawn on the
+                    main thread, which is the only one that makes OpenGL calls.
 
              \tparam T - A component type derived from the Renderer.
              \param[in] r_worldToNdc 4x4 matrix that transforms coordinates from world to
                             NDC space.
              \param[in] r_rendererContainer Container containing the renderer and transform 
                             components of the objects to draw
+             \param[in] r_renderLayers Render layer of each of the objects to draw.
+             \param[in,out] r_cullingGrid Culling grid of the objects to draw.
+             \param[in,out] p_staticBatches Static batches to bake the objects that stop changing
+                            into, nullptr to draw every object on its own.
             *************************************************************************************/
             template<typename T>
-            void DrawQuadsInstanced(glm::mat4 const& r_worldToNdc, std::vector<EntityID> const& r_rendererIdContainer);
+            void DrawQuadsInstanced(glm::mat4 const& r_worldToNdc, std::vector<EntityID> const& r_rendererIdContainer,
+                std::vector<unsigned char> const& r_renderLayers, CullingGrid& r_cullingGrid, StaticBatches* p_staticBatches);
 
             /*!***********************************************************************************
              \brief Loops through all objects with colliders and rigidbody components and draws 
@@ -181,8 +228,9 @@ namespace PE
                 GLenum const primitiveType, glm::mat4 const& r_modelToNdc);
 
             /*!***********************************************************************************
-             \brief Creates a new VBO with the texture status, color and matrix of each instance
-                    of the mesh, binds it to the VAO and makes an instanced draw call.
+             \brief Points the instance binding of the mesh to the current batch of sprite
+                    instances, binds the texture atlas, makes an instanced draw call and 
+                    submits the batch.
 
              \param[in] count Number of instances to draw.
              \param[in] meshIndex Index of mesh in [m_meshes]. Derived by casting EnumMeshType.
@@ -190,6 +238,16 @@ namespace PE
             *************************************************************************************/
             void DrawInstanced(size_t const count, size_t const meshIndex, GLenum const primitiveType);
 
+            /*!***********************************************************************************
+             \brief Points the instance binding of the mesh to the buffer of a static batch,
+                    binds the texture atlas and makes an instanced draw call.
+
+             \param[in] r_batch Static batch to draw.
+             \param[in] meshIndex Index of mesh in [m_meshes]. Derived by casting EnumMeshType.
+             \param[in] primitiveType GL Primitive type to make the draw call with.
+            *************************************************************************************/
+            void DrawStaticBatch(StaticBatches::Batch const& r_batch, size_t const meshIndex, GLenum const primitiveType);
+
             /*!***********************************************************************************
              \brief Makes a draw call for a square to represent the AABB collider passed in.
 
@@ -362,11 +420,81 @@ namespace PE
             //! Width and height of the ImGui window the last time the framebuffer was resized
             float m_cachedWindowWidth{ -1.f }, m_cachedWindowHeight{ -1.f };
             const int m_windowStartWidth, m_windowStartHeight;
+
+            // Backend the buffers, state changes and draw calls of the passes are submitted through
+            RenderBackend* m_p_backend{ &RenderBackend::GetResourceBackend() };
                         
-            std::vector<float> m_isTextured{}; // Container that stores whether the quad is textured
-            std::vector<glm::mat4> m_modelToWorldMatrices{}; // Container that stores the model to world matrix for the quad
-            std::vector<glm::vec4> m_colors{}; // Container that stores the color for each quad
-            std::vector<glm::vec2> m_UV{};
+            // Persistently mapped buffer the instance data is written into
+            InstanceRingBuffer m_instanceBuffer{};
+            InstanceStream<SpriteInstance> m_spriteInstances{}; // Interleaved transform, color and UV coordinates of each quad
+            GLuint const m_instanceBindingIndex{ 2 }; // Binding of the quad VAO the instance data is read from
+
+            // Layer and UV mapping a sprite texture is drawn with
+            struct SpriteTexture
+            {
+                float layer{ SpriteInstance::untexturedLayer };
+                glm::vec2 uvOffset{ 0.f, 0.f }; // UV coordinates of the bottom left of the texture in the layer
+                glm::vec2 uvScale{ 1.f, 1.f };  // Size of the texture in UV coordinates of the layer
+                GLuint textureID{};             // Texture to bind on its own, 0 if the texture is in the atlas
+
+                // Maps UV coordinates of the texture into the layer
+                glm::vec2 MapUV(glm::vec2 const& r_uv) const { return uvOffset + r_uv * uvScale; }
+            };
+
+            // Texture of the last sprite batched, so that runs of sprites with the same texture skip the lookup
+            std::string m_batchTextureKey{};
+            SpriteTexture m_batchTexture{};
+
+            // What the main thread does with a draw packet
+            enum class EnumPacket : unsigned char
+            {
+                SPRITE,     // Queue the sprite
+                TEXT,       // Queue the text of the entity
+                RENDERED,   // Only record the entity as rendered, its sprite is drawn with its static batch
+                RESOLVE     // Build the packets of the entity on the main thread, as its texture or animation has to be loaded
+            };
+
+            // Sprite, text or entity found while building the packets of a range of the render order
+            struct DrawPacket
+            {
+                SpriteInstance sprite{};
+                EntityID id{};
+                unsigned index{};               // Index of the entity in the render order
+                GLuint textureID{};             // Texture bound on its own for the sprite, 0 if none
+                unsigned long long revision{};  // Revision of the renderer, for sprites that can be baked into static batches
+                EnumPacket type{ EnumPacket::SPRITE };
+                bool firstOfEntity{};           // The entity is recorded as rendered when this packet is queued
+                bool track{};                   // The sprite is counted towards being baked into a static batch
+            };
+
+            // Packets built from one range of the render order, along with the texture last looked up
+            // in it, so that tasks do not share the texture of the last sprite batched
+            struct BuildTask
+            {
+                std::vector<DrawPacket> packets{};
+                std::vector<std::pair<unsigned, Particle const*>> particles{}; // Particles of an emitter sorted by animation frame
+                std::string textureKey{};
+                SpriteTexture texture{};
+                unsigned textureSwitches{};
+
+                // Empties the task before the packets of a frame are built into it
+                void Clear() { packets.clear(); textureKey.clear(); texture = SpriteTexture{}; textureSwitches = 0; }
+            };
+
+            std::vector<BuildTask> m_buildTasks{};
+            BuildTask m_resolveTask{}; // Packets of entities built on the main thread
+            std::size_t const m_minEntitiesPerBuildTask{ 256 };
+            GLint const m_textureUnit{ 0 }, m_textureAtlasUnit{ 1 };
+
+            // Draw commands of the pass being drawn, sorted by the state they are drawn with
+            RenderQueue m_renderQueue{};
+
+            // Bounds of the objects in the world and UI render orders, to cull the ones off screen
+            CullingGrid m_worldCullingGrid{}, m_uiCullingGrid{};
+
+            // Sprites in the world that have stopped changing, baked into buffers of their own
+            StaticBatches m_worldStaticBatches{};
+            float const m_cullingMargin{ 64.f }; // World units kept around the view, for objects drawn between physics steps
 
             // Color that is rendered when there is nothing in the scene
             glm::vec4 m_backgroundColor{ 0.796f, 0.6157f, 0.4588f, 1.f }; // brown by default
@@ -422,6 +550,101 @@ namespace PE
             *************************************************************************************/
             void InitializePointMesh(MeshData& r_mesh);
 
+            /*!***********************************************************************************
+             \brief Sets the format, binding and divisor of the sprite instance attributes of
+                    the VAO of the mesh and binds the instance ring buffer to it. Only the
+                    offset of the binding changes between batches.
+
+             \param[in] r_mesh Mesh to draw instances of.
+            *************************************************************************************/
+            void InitializeInstanceAttributes(MeshData const& r_mesh);
+
+            /*!***********************************************************************************
+             \brief Submits the passes through another backend. The static batches are thrown
+                    away and the instance buffer is created again through the backend, as
+                    their buffers belong to the backend they were created through.
+
+             \param[in,out] r_backend Backend to submit the passes through.
+            *************************************************************************************/
+            void SetBackend(RenderBackend& r_backend);
+
+            /*!***********************************************************************************
+             \brief Finds the layer and UV mapping to draw the texture of a sprite with, or the
+                    texture to bind on its own if it is not in the texture atlas.
+
+             \tparam T - A component type derived from the Renderer.
+             \param[in,out] r_renderer Renderer of the sprite. Its texture key is cleared and
+                                its color set to pink if the texture does not exist.
+             \return SpriteTexture - Layer and UV mapping of the texture.
+            *************************************************************************************/
+            template<typename T>
+            SpriteTexture ResolveSpriteTexture(T& r_renderer);
+
+            /*!***********************************************************************************
+             \brief Looks up the layer and UV mapping of the texture of a sprite without loading
+                    it or changing the renderer, so that it can be called from worker threads.
+
+             \tparam T - A component type derived from the Renderer.
+             \param[in] r_renderer Renderer of the sprite.
+             \param[in,out] r_task Build task the sprite is in, which keeps the texture last
+                                looked up.
+             \param[out] r_texture Layer and UV mapping of the texture.
+             \return true - If the texture was found.
+             \return false - If the texture is not loaded, in which case the sprite has to be
+                             built on the main thread.
+            *************************************************************************************/
+            template<typename T>
+            bool FindSpriteTexture(T const& r_renderer, BuildTask& r_task, SpriteTexture& r_texture) const;
+
+            /*!***********************************************************************************
+             \brief Builds the draw packets of a range of the render order. Only reads the
+                    components and resources, so ranges can be built on worker threads at the
+                    same time. Entities whose texture or animation is not loaded get a RESOLVE
+                    packet instead, unless the range is built on the main thread.
+
+             \tparam T - A component type derived from the Renderer.
+             \param[in] r_rendererIdContainer Entities drawn in the pass, in render order.
+             \param[in] r_visibility Whether each of the entities is in view.
+             \param[in] p_staticBatches Static batches of the pass, nullptr if there are none.
+             \param[in] beginIndex Index of the first entity to build.
+             \param[in] endIndex Index after the last entity to build.
+             \param[in] onMainThread Whether textures and animations can be loaded.
+             \param[in,out] r_task Build task to add the packets to.
+            *************************************************************************************/
+            template<typename T>
+            void BuildDrawPackets(std::vector<EntityID> const& r_rendererIdContainer, std::vector<unsigned char> const& r_visibility,
+                StaticBatches const* p_staticBatches, std::size_t const beginIndex, std::size_t const endIndex,
+                bool const onMainThread, BuildTask& r_task);
+
+            /*!***********************************************************************************
+             \brief Queues the packets of a build task into the render queue, and records the
+                    entities they draw as rendered. The packets of entities that could not be
+                    built on a worker thread are built and queued on the spot.
+
+             \tparam T - A component type derived from the Renderer.
+             \param[in] r_rendererIdContainer Entities drawn in the pass, in render order.
+             \param[in] r_renderLayers Render layer of each of the entities.
+             \param[in] r_visibility Whether each of the entities is in view.
+             \param[in,out] r_cullingGrid Culling grid of the entities.
+             \param[in,out] p_staticBatches Static batches of the pass, nullptr if there are none.
+             \param[in,out] r_nextStaticBatch Index of the next batch in the drawn batches to queue.
+             \param[in] r_task Build task to queue the packets of.
+            *************************************************************************************/
+            template<typename T>
+            void QueueDrawPackets(std::vector<EntityID> const& r_rendererIdContainer, std::vector<unsigned char> const& r_renderLayers,
+                std::vector<unsigned char> const& r_visibility, CullingGrid& r_cullingGrid, StaticBatches* p_staticBatches,
+                std::size_t& r_nextStaticBatch, BuildTask const& r_task);
+
+            /*!***********************************************************************************
+             \brief Queues the static batches whose first sprite comes before an index in the
+                    render order.
+
+             \param[in] p_staticBatches Static batches of the pass, nullptr if there are none.
+             \param[in] index Index in the render order to queue the batches up to.
+             \param[in,out] r_nextStaticBatch Index of the next batch in the drawn batches to queue.
+            *************************************************************************************/
+            void QueueStaticBatches(StaticBatches const* p_staticBatches, std::size_t const index, std::size_t& r_nextStaticBatch);
+
             /*!***********************************************************************************
              \brief Prints the hardware specifications of the device related to graphics.
             *************************************************************************************/
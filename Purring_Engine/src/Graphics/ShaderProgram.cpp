@@ -23,6 +23,7 @@
 
 #include "prpch.h"
 #include "ShaderProgram.h" 
+#include "RenderBackend.h"
 #include "Logging/Logger.h" 
 
 extern Logger engine_logger;
@@ -83,102 +84,20 @@ namespace PE
 
         bool ShaderProgram::CompileLinkValidateProgram(std::string const& vertexString, std::string const& fragmentString)
         {
-            // Check if able to create a program
-            if (!CheckProgramId())
-            {
-                return false;
-            }
-
-            // Compile and attach the shaders
-            if (!CompileShaderSource(vertexString, GL_VERTEX_SHADER) ||
-                !CompileShaderSource(fragmentString, GL_FRAGMENT_SHADER))
-            {
-                // Unable to compile shaders
-                return false;
-            }
-
-            // Link the shaders to the program
-            glLinkProgram(m_programId);
-            GLint status{};
-            glGetProgramiv(m_programId, GL_LINK_STATUS, &status);
-
-            if (GL_FALSE == status)
-            {
-                // Check if there is an info log
-                GLint actualLength{ 0 };
-                glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &actualLength);
-
-                if (actualLength > 0)
-                {
-                    // Character array to store the logs in 
-                    GLsizei maxLogLength{ 1024 };
-                    GLchar informationLog[1024];
-                    glGetProgramInfoLog(m_programId, maxLogLength,
-                        reinterpret_cast<GLsizei*>(&actualLength), &informationLog[0]);
-
-                    std::string logString{ "Unable to link shader program: " };
-                    logString += informationLog;
-
-                    engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
-                    engine_logger.SetTime();
-                    engine_logger.AddLog(true, logString, __FUNCTION__);
-                }
-
-                return false;
-            }
-
-            m_isLinked = true;
-
-            // Validate the program
-            if (!ValidateProgram())
-            {
-                return false;
-            }
-
-            return true;
-        }
-
+            // Replace the program if it has been compiled before
+            DeleteProgram();
 
-        bool ShaderProgram::ValidateProgram()
-        {
-            if (m_programId <= 0 || !m_isLinked)
+            std::string logString{};
+            m_programId = RenderBackend::GetResourceBackend().CreateProgram(vertexString, fragmentString, logString);
+            if (0 == m_programId)
             {
                 engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
                 engine_logger.SetTime();
-                engine_logger.AddLog(false, "No program to check.", __FUNCTION__);
-                return false;
-            }
-
-            // Character array to store the logs in 
-            GLsizei maxLogLength{ 1024 };
-            char informationLog[1024];
-
-            // Check the validation status of the program
-            GLint programStatus;
-            glValidateProgram(m_programId);
-            glGetProgramiv(m_programId, GL_VALIDATE_STATUS, &programStatus);
-
-            // If the status is invalid,
-            if (!programStatus)
-            {
-                // Check if the log contains information
-                GLint infoLogLength;
-                glGetProgramiv(m_programId, GL_INFO_LOG_LENGTH, &infoLogLength);
-
-                if (infoLogLength > 0) {
-                    GLsizei actualLogLength;
-                    glGetProgramInfoLog(m_programId, maxLogLength, &actualLogLength, informationLog);
-
-                    std::string logString{ "Shader program validation failed: " };
-                    logString += informationLog;
-
-                    engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
-                    engine_logger.SetTime();
-                    engine_logger.AddLog(false, logString, __FUNCTION__);
-                }
+                engine_logger.AddLog(true, logString, __FUNCTION__);
                 return false;
             }
 
+            m_isLinked = true;
             return true;
         }
 
@@ -200,10 +119,12 @@ namespace PE
 
         void ShaderProgram::DeleteProgram()
         {
-            UnUse();
+            // A program that is in use is only deleted once it stops being used
             if (m_programId > 0) {
-                glDeleteProgram(m_programId);
+                RenderBackend::GetResourceBackend().DeleteProgram(m_programId);
             }
+            m_programId = 0;
+            m_isLinked = false;
         }
 
 
@@ -315,86 +236,5 @@ namespace PE
             GLint location = glGetUniformLocation(m_programId, name.c_str());
             glUniform3f(location, value.x, value.y, value.z);
         }
-
-
-        bool ShaderProgram::CheckProgramId() 
-        {
-
-            if (m_programId <= 0)
-            {
-                // No program ID, so create one
-                m_programId = glCreateProgram();
-                m_isLinked = false;
-
-                if (0 == m_programId)
-                {
-                    engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
-                    engine_logger.SetTime();
-                    engine_logger.AddLog(true, "Cannot create shader program handle.", __FUNCTION__);
-                    return false;
-                }
-            }
-
-            // Program ID created
-            return true;
-        }
-
-
-        bool ShaderProgram::CompileShaderSource(std::string shaderString, GLenum shaderType)
-        {
-            // Check if able to create a program
-            if (!CheckProgramId())
-            {
-                return false;
-            }
-
-            // Cast the shader code string into chars
-            GLchar const* shaderChar[]{ reinterpret_cast<const GLchar*>(shaderString.c_str()) };
-
-            GLuint shaderHandle = glCreateShader(shaderType);
-            glShaderSource(shaderHandle, 1, shaderChar, NULL);
-            glCompileShader(shaderHandle);
-
-            // Check if compilation was successful
-            GLint status{};
-            glGetShaderiv(shaderHandle, GL_COMPILE_STATUS, &status);
-
-            if (GL_FALSE == status)
-            {
-                // Check if there is an info log
-                GLint actualLength{};
-                glGetShaderiv(shaderHandle, GL_INFO_LOG_LENGTH, &actualLength);
-
-                if (actualLength > 0)
-                {
-                    // Character array to store the logs in 
-                    GLsizei maxLogLength{ 1024 };
-                    GLchar informationLog[1024];
-                    glGetShaderInfoLog(shaderHandle, maxLogLength,
-                        NULL, &informationLog[0]);
-
-                    std::string logString{ "Unable to compile shader: " };
-                    logString += informationLog;
-
-                    engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
-                    engine_logger.SetTime();
-                    engine_logger.AddLog(true, logString, __FUNCTION__);
-                }
-
-                // Delete the shader
-                glDeleteShader(shaderHandle);
-
-                return false;
-            }
-
-            glAttachShader(m_programId, shaderHandle);
-
-            // Flag the compiled shaders for deletion
-            // Note: they will only get deleted 
-            // when the shader program ceases to exist
-            glDeleteShader(shaderHandle);
-
-            return true;
-        }
     } // End of Graphics namespace 
 } // End of PE namespace
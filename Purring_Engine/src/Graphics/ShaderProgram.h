@@ -45,7 +45,8 @@ namespace PE
             bool LoadAndCompileShadersFromFile(std::string const& vertexFile, std::string const& fragmentFile);
 
             /*!***********************************************************************************
-             \brief Compiles and links the shaders to a shader program.
+             \brief Compiles, links and validates the shaders to a shader program through the
+                    resource backend, replacing the program if there already is one.
 
              \param[in,out] vertexString Vertex shader code stored in a string.
              \param[in,out] fragmentString Fragment shader code stored in a string.
@@ -54,14 +55,6 @@ namespace PE
             *************************************************************************************/
             bool CompileLinkValidateProgram(std::string const& vertexString, std::string const& fragmentString);
 
-            /*!***********************************************************************************
-             \brief Validates if the shader program can be executed.
-
-             \return true - If the program was validated successfully and is ready to be executed.
-             \return false - If the program could not be validated and thus cannot be executed.
-            *************************************************************************************/
-            bool ValidateProgram();
-
             /*!***********************************************************************************
              \brief Use this program.
             *************************************************************************************/
@@ -121,27 +114,6 @@ namespace PE
         private:
             unsigned int m_programId{}; // ID of the program created for OpenGL. Set to zero if not linked to a program
             bool m_isLinked{ false }; // True if the program has been compiled and linked successfully, false otherwise.
-
-            // ----- Private methods ----- //
-        private:
-
-            /*!***********************************************************************************
-             \brief Checks for a program ID and creates one if there is none.
-
-             \return true - If able to create a program ID or an ID exists,
-             \return false - If unable to create a program id.
-            *************************************************************************************/
-            bool CheckProgramId();
-
-            /*!***********************************************************************************
-             \brief Compiles and attaches the shader string to the existing program.
-
-             \param[in,out] shaderString Full shader code to generate a shader object from.
-             \param[in,out] shaderType Type of shader (e.g. GL_VERTEX_SHADER or GL_FRAGMENT_SHADER).
-             \return true - If compilation was successful.
-             \return false - If compilation failed.
-            *************************************************************************************/
-            bool CompileShaderSource(std::string shaderString, GLenum shaderType);
         };
     } // End of Graphics namespace
 } // End of PE namespace
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     SpriteInstance.h
+ \date     30-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the SpriteInstance struct, the per-instance data of a
+           quad drawn by the instanced renderer. The vertex shader builds the model
+           to world transform of the quad from it.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+
+#include <glm/glm.hpp>
+#include <cstddef> // offsetof
+
+namespace PE
+{
+    namespace Graphics
+    {
+        /*!***********************************************************************************
+         \brief Interleaved instance data of a 2D sprite, read by Shaders/Instanced.vert.
+                The offsets of the members are used to set up the vertex attributes, so
+                the shader has to be updated along with this struct.
+        *************************************************************************************/
+        struct SpriteInstance
+        {
+            static constexpr float untexturedLayer{ -1.f };  // Texture layer of quads that are drawn with their color only
+            static constexpr float standaloneLayer{ -2.f };  // Texture layer of quads that sample a texture outside the atlas
+
+            glm::vec2 position{};     // Position of the center of the quad in world space
+            glm::vec2 halfSize{};     // Half the width and height of the quad
+            float rotation{};         // Counterclockwise rotation of the quad in radians
+            GLuint color{};           // RGBA color with 8 bits per channel, red in the lowest byte
+            glm::vec2 minUV{};        // UV coordinates of the bottom left corner
+            glm::vec2 maxUV{};        // UV coordinates of the top right corner
+            float textureLayer{};     // Layer of the texture atlas to sample, or one of the negative layers above
+
+            /*!***********************************************************************************
+             \brief Default constructor.
+            *************************************************************************************/
+            SpriteInstance() = default;
+
+            /*!***********************************************************************************
+             \brief Fills in the instance data of a quad.
+
+             \param[in] width Width of the quad.
+             \param[in] height Height of the quad.
+             \param[in] orientation Counterclockwise rotation of the quad in radians.
+             \param[in] positionX X position of the center of the quad in world space.
+             \param[in] positionY Y position of the center of the quad in world space.
+             \param[in] r_color RGBA color of the quad, each component from [0, 1].
+             \param[in] r_minUV UV coordinates of the bottom left corner.
+             \param[in] r_maxUV UV coordinates of the top right corner.
+             \param[in] layer Layer of the texture atlas to sample, untexturedLayer or standaloneLayer.
+            *************************************************************************************/
+            SpriteInstance(float const width, float const height, float const orientation,
+                float const positionX, float const positionY, glm::vec4 const& r_color,
+                glm::vec2 const& r_minUV, glm::vec2 const& r_maxUV, float const layer)
+                : position{ positionX, positionY }, halfSize{ width * 0.5f, height * 0.5f },
+                rotation{ orientation }, color{ PackColor(r_color) },
+                minUV{ r_minUV }, maxUV{ r_maxUV }, textureLayer{ layer }
+            { /* Empty by design */ }
+
+            /*!***********************************************************************************
+             \brief Packs an RGBA color into 8 bits per channel, with red in the lowest byte
+                    so that the bytes are in RGBA order in memory.
+
+             \param[in] r_color RGBA color to pack, each component is clamped to [0, 1].
+             \return GLuint - Packed color.
+            *************************************************************************************/
+            static GLuint PackColor(glm::vec4 const& r_color)
+            {
+                glm::vec4 const scaled{ glm::clamp(r_color, 0.f, 1.f) * 255.f + 0.5f };
+                return static_cast<GLuint>(scaled.r) | (static_cast<GLuint>(scaled.g) << 8)
+                    | (static_cast<GLuint>(scaled.b) << 16) | (static_cast<GLuint>(scaled.a) << 24);
+            }
+        };
+
+        static_assert(sizeof(SpriteInstance) == 44, "SpriteInstance is expected to be tightly packed");
+    } // End of Graphics namespace
+} // End of PE namespace
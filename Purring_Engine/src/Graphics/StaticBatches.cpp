@@ -0,0 +1,398 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     StaticBatches.cpp
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions in the StaticBatches
+           class, which bakes sprites that have stopped changing into GPU buffers.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "StaticBatches.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "CullingGrid.h"
+#include "Renderer.h"
+#include "ECS/Entity.h"
+
+namespace PE
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            /*!***********************************************************************************
+             \brief Computes the axis aligned bounds of a quad once it has been rotated.
+
+             \param[in] r_sprite Instance data of the quad.
+             \param[out] r_min Bottom left corner of the bounds.
+             \param[out] r_max Top right corner of the bounds.
+            *************************************************************************************/
+            void GetSpriteBounds(SpriteInstance const& r_sprite, glm::vec2& r_min, glm::vec2& r_max)
+            {
+                float const cosAngle{ std::abs(std::cos(r_sprite.rotation)) };
+                float const sinAngle{ std::abs(std::sin(r_sprite.rotation)) };
+                glm::vec2 const halfSize{ std::abs(r_sprite.halfSize.x), std::abs(r_sprite.halfSize.y) };
+                glm::vec2 const extents{ halfSize.x * cosAngle + halfSize.y * sinAngle, halfSize.x * sinAngle + halfSize.y * cosAngle };
+                r_min = r_sprite.position - extents;
+                r_max = r_sprite.position + extents;
+            }
+
+            /*!***********************************************************************************
+             \brief Checks whether two axis aligned boxes overlap.
+            *************************************************************************************/
+            inline bool Overlaps(glm::vec2 const& r_minA, glm::vec2 const& r_maxA, glm::vec2 const& r_minB, glm::vec2 const& r_maxB)
+            {
+                return r_minA.x < r_maxB.x && r_minB.x < r_maxA.x && r_minA.y < r_maxB.y && r_minB.y < r_maxA.y;
+            }
+        }
+
+
+        StaticBatches::~StaticBatches()
+        {
+            Clear();
+        }
+
+
+        SpriteInstance const* StaticBatches::FindBakedSprite(unsigned const index, GLuint& r_textureID) const
+        {
+            Member const& r_member{ m_members[index] };
+            if (r_member.batch < 0) { return nullptr; }
+
+            r_textureID = r_member.textureID;
+            return &r_member.sprite;
+        }
+
+
+        void StaticBatches::SetBackend(RenderBackend& r_backend)
+        {
+            Clear();
+            m_p_backend = &r_backend;
+        }
+
+
+        void StaticBatches::BeginFrame(std::vector<EntityID> const& r_renderOrder, std::vector<unsigned char> const& r_renderLayers,
+            unsigned long long const renderOrderVersion, unsigned long long const atlasGeneration,
+            CullingGrid const& r_cullingGrid, glm::vec2 const& r_viewMin, glm::vec2 const& r_viewMax)
+        {
+            // The batches refer to entities by their index in the render order
+            if (renderOrderVersion != m_renderOrderVersion || atlasGeneration != m_atlasGeneration
+                || r_renderOrder.size() != m_members.size())
+            {
+                Clear();
+                m_renderOrderVersion = renderOrderVersion;
+                m_atlasGeneration = atlasGeneration;
+                m_members.resize(r_renderOrder.size());
+                m_inDrawnBatch.assign(r_renderOrder.size(), 0);
+            }
+
+            for (unsigned const batchIndex : m_drawnBatches)
+            {
+                for (unsigned const index : m_batches[batchIndex].members)
+                {
+                    m_inDrawnBatch[index] = 0;
+                }
+            }
+            m_drawnBatches.clear();
+
+            // Batches are validated if they are in view, or if one of their sprites is in view
+            // after having been moved out of the bounds the batch was uploaded with
+            std::vector<unsigned char> const& r_visibility{ r_cullingGrid.GetVisibility() };
+            for (Batch& r_batch : m_batches)
+            {
+                r_batch.visible = !r_batch.members.empty() && Overlaps(r_batch.min, r_batch.max, r_viewMin, r_viewMax);
+                r_batch.drawn = false;
+            }
+            for (unsigned index{}; index < m_members.size(); ++index)
+            {
+                if (r_visibility[index] && m_members[index].batch >= 0)
+                {
+                    m_batches[m_members[index].batch].visible = true;
+                }
+            }
+
+            // Take the sprites whose renderer, transform or active state changed out of their batch
+            EntityManager& r_entityManager{ EntityManager::GetInstance() };
+            for (unsigned batchIndex{}; batchIndex < m_batches.size(); ++batchIndex)
+            {
+                Batch& r_batch{ m_batches[batchIndex] };
+                if (!r_batch.visible) { continue; }
+
+                auto const changedBegin{ std::stable_partition(r_batch.members.begin(), r_batch.members.end(),
+                    [&](unsigned const index)
+                    {
+                        Member const& r_member{ m_members[index] };
+                        Renderer const* p_renderer{ r_entityManager.GetPointer<Renderer>(r_renderOrder[index]) };
+                        EntityDescriptor const* p_descriptor{ r_entityManager.GetPointer<EntityDescriptor>(r_renderOrder[index]) };
+                        return p_renderer && p_descriptor && p_descriptor->isActive
+                            && p_renderer->GetRevision() == r_member.revision
+                            && r_cullingGrid.GetChangedUpdate(index) <= r_member.trackedUpdate;
+                    }) };
+
+                for (auto memberIterator{ changedBegin }; memberIterator != r_batch.members.end(); ++memberIterator)
+                {
+                    Member& r_member{ m_members[*memberIterator] };
+                    r_member.batch = -1;
+                    r_member.stableFrames = 0;
+                    r_batch.dirty = true;
+                }
+                r_batch.members.erase(changedBegin, r_batch.members.end());
+
+                if (!r_batch.dirty && !r_batch.conflicted && r_batch.members.size() >= minBatchSize)
+                {
+                    r_batch.drawn = true;
+                    m_drawnBatches.emplace_back(batchIndex);
+                }
+            }
+
+            for (unsigned const batchIndex : m_drawnBatches)
+            {
+                for (unsigned const index : m_batches[batchIndex].members)
+                {
+                    m_inDrawnBatch[index] = 1;
+                }
+            }
+
+            // A batch is drawn where its first sprite is, so it is drawn a sprite at a time if
+            // something after its first sprite is overlapped by one of its later sprites.
+            // The sprites of those batches are checked against the other batches in turn.
+            m_unbatched.clear();
+            for (unsigned index{}; index < m_members.size(); ++index)
+            {
+                if (r_visibility[index] && !m_inDrawnBatch[index])
+                {
+                    m_unbatched.emplace_back(index);
+                }
+            }
+
+            for (std::size_t i{}; i < m_unbatched.size(); ++i)
+            {
+                unsigned const index{ m_unbatched[i] };
+                glm::vec2 min{ -std::numeric_limits<float>::max() }, max{ std::numeric_limits<float>::max() };
+                bool const bounded{ r_cullingGrid.GetBounds(index, min, max) };
+
+                for (unsigned const batchIndex : m_drawnBatches)
+                {
+                    Batch& r_batch{ m_batches[batchIndex] };
+                    if (!r_batch.drawn || r_batch.layer != r_renderLayers[index]
+                        || index < r_batch.members.front() || index > r_batch.members.back()
+                        || !Overlaps(min, max, r_batch.min, r_batch.max))
+                    {
+                        continue;
+                    }
+
+                    bool conflict{ !bounded };
+                    for (auto memberIterator{ std::upper_bound(r_batch.members.begin(), r_batch.members.end(), index) };
+                        !conflict && memberIterator != r_batch.members.end(); ++memberIterator)
+                    {
+                        glm::vec2 memberMin{}, memberMax{};
+                        GetSpriteBounds(m_members[*memberIterator].sprite, memberMin, memberMax);
+                        conflict = Overlaps(min, max, memberMin, memberMax);
+                    }
+                    if (!conflict) { continue; }
+
+                    r_batch.drawn = false;
+                    for (unsigned const memberIndex : r_batch.members)
+                    {
+                        m_inDrawnBatch[memberIndex] = 0;
+                        if (r_visibility[memberIndex])
+                        {
+                            m_unbatched.emplace_back(memberIndex);
+                        }
+                    }
+                }
+            }
+
+            m_drawnBatches.erase(std::remove_if(m_drawnBatches.begin(), m_drawnBatches.end(),
+                [this](unsigned const batchIndex) { return !m_batches[batchIndex].drawn; }), m_drawnBatches.end());
+            std::sort(m_drawnBatches.begin(), m_drawnBatches.end(), [this](unsigned const lhs, unsigned const rhs)
+                {
+                    return m_batches[lhs].members.front() < m_batches[rhs].members.front();
+                });
+        }
+
+
+        void StaticBatches::Track(CullingGrid const& r_cullingGrid, unsigned const index, unsigned const layer,
+            unsigned long long const revision, SpriteInstance const& r_sprite, GLuint const textureID)
+        {
+            Member& r_member{ m_members[index] };
+            if (r_member.batch >= 0) { return; }
+
+            // The transform is compared through the instance data, which also holds the
+            // position the sprite is drawn at between physics steps
+            bool const unchanged{ revision == r_member.revision && textureID == r_member.textureID
+                && std::memcmp(&r_sprite, &r_member.sprite, sizeof(SpriteInstance)) == 0 };
+
+            r_member.stableFrames = unchanged ? r_member.stableFrames + 1 : 0;
+            r_member.sprite = r_sprite;
+            r_member.textureID = textureID;
+            r_member.revision = revision;
+            r_member.trackedUpdate = r_cullingGrid.GetUpdateCount();
+
+            if (r_member.stableFrames < stableFrameCount) { return; }
+
+            // Bake the sprite into the batch of the chunk its center is in
+            std::tuple<unsigned, GLuint, int, int> const batchKey{ layer, textureID,
+                static_cast<int>(std::floor(r_sprite.position.x / chunkSize)),
+                static_cast<int>(std::floor(r_sprite.position.y / chunkSize)) };
+
+            auto batchIterator{ m_batchIndices.find(batchKey) };
+            if (batchIterator == m_batchIndices.end())
+            {
+                batchIterator = m_batchIndices.emplace(batchKey, static_cast<unsigned>(m_batches.size())).first;
+                m_batches.emplace_back();
+                m_batches.back().layer = layer;
+                m_batches.back().textureID = textureID;
+            }
+
+            r_member.batch = static_cast<int>(batchIterator->second);
+            m_pending.emplace_back(index);
+        }
+
+
+        void StaticBatches::EndFrame()
+        {
+            if (m_pending.empty() && std::none_of(m_batches.begin(), m_batches.end(), [](Batch const& r_batch) { return r_batch.dirty; }))
+            {
+                return;
+            }
+
+            for (unsigned const index : m_pending)
+            {
+                Batch& r_batch{ m_batches[m_members[index].batch] };
+                r_batch.members.insert(std::upper_bound(r_batch.members.begin(), r_batch.members.end(), index), index);
+                r_batch.dirty = true;
+            }
+            m_pending.clear();
+
+            std::vector<unsigned> changedLayers{};
+            for (Batch& r_batch : m_batches)
+            {
+                if (!r_batch.dirty) { continue; }
+                r_batch.dirty = false;
+
+                if (std::find(changedLayers.begin(), changedLayers.end(), r_batch.layer) == changedLayers.end())
+                {
+                    changedLayers.emplace_back(r_batch.layer);
+                }
+
+                if (r_batch.members.empty())
+                {
+                    m_p_backend->DeleteBuffer(r_batch.bufferObject);
+                    r_batch.bufferObject = 0;
+                    continue;
+                }
+
+                // Upload the instance data of the sprites in render order
+                m_uploadData.clear();
+                r_batch.min = glm::vec2{ std::numeric_limits<float>::max() };
+                r_batch.max = glm::vec2{ -std::numeric_limits<float>::max() };
+                for (unsigned const index : r_batch.members)
+                {
+                    SpriteInstance const& r_sprite{ m_members[index].sprite };
+                    m_uploadData.emplace_back(r_sprite);
+
+                    glm::vec2 min{}, max{};
+                    GetSpriteBounds(r_sprite, min, max);
+                    r_batch.min = glm::min(r_batch.min, min);
+                    r_batch.max = glm::max(r_batch.max, max);
+                }
+
+                m_p_backend->UploadBuffer(r_batch.bufferObject, static_cast<GLsizeiptr>(m_uploadData.size() * sizeof(SpriteInstance)),
+                    m_uploadData.data());
+            }
+
+            for (unsigned const layer : changedLayers)
+            {
+                FindConflicts(layer);
+            }
+        }
+
+
+        void StaticBatches::Clear()
+        {
+            for (Batch& r_batch : m_batches)
+            {
+                if (r_batch.bufferObject)
+                {
+                    m_p_backend->DeleteBuffer(r_batch.bufferObject);
+                }
+            }
+
+            m_batches.clear();
+            m_batchIndices.clear();
+            m_members.clear();
+            m_inDrawnBatch.clear();
+            m_drawnBatches.clear();
+            m_pending.clear();
+            m_unbatched.clear();
+            m_renderOrderVersion = 0;
+            m_atlasGeneration = 0;
+        }
+
+
+        void StaticBatches::FindConflicts(unsigned const layer)
+        {
+            std::vector<unsigned> layerBatches{};
+            for (unsigned batchIndex{}; batchIndex < m_batches.size(); ++batchIndex)
+            {
+                if (m_batches[batchIndex].layer == layer && !m_batches[batchIndex].members.empty())
+                {
+                    layerBatches.emplace_back(batchIndex);
+                }
+            }
+            std::sort(layerBatches.begin(), layerBatches.end(), [this](unsigned const lhs, unsigned const rhs)
+                {
+                    return m_batches[lhs].members.front() < m_batches[rhs].members.front();
+                });
+
+            // A later batch is drawn over an earlier one, which is wrong if a sprite of the later
+            // batch overlaps a sprite of the earlier batch that comes after it in the render order
+            for (std::size_t later{}; later < layerBatches.size(); ++later)
+            {
+                Batch& r_laterBatch{ m_batches[layerBatches[later]] };
+                r_laterBatch.conflicted = false;
+
+                for (std::size_t earlier{}; earlier < later && !r_laterBatch.conflicted; ++earlier)
+                {
+                    Batch const& r_earlierBatch{ m_batches[layerBatches[earlier]] };
+                    if (r_earlierBatch.conflicted || r_earlierBatch.members.back() < r_laterBatch.members.front()
+                        || !Overlaps(r_earlierBatch.min, r_earlierBatch.max, r_laterBatch.min, r_laterBatch.max))
+                    {
+                        continue;
+                    }
+
+                    for (auto earlierIterator{ std::upper_bound(r_earlierBatch.members.begin(), r_earlierBatch.members.end(), r_laterBatch.members.front()) };
+                        !r_laterBatch.conflicted && earlierIterator != r_earlierBatch.members.end(); ++earlierIterator)
+                    {
+                        glm::vec2 earlierMin{}, earlierMax{};
+                        GetSpriteBounds(m_members[*earlierIterator].sprite, earlierMin, earlierMax);
+                        if (!Overlaps(earlierMin, earlierMax, r_laterBatch.min, r_laterBatch.max)) { continue; }
+
+                        for (auto laterIterator{ r_laterBatch.members.begin() };
+                            laterIterator != r_laterBatch.members.end() && *laterIterator < *earlierIterator; ++laterIterator)
+                        {
+                            glm::vec2 laterMin{}, laterMax{};
+                            GetSpriteBounds(m_members[*laterIterator].sprite, laterMin, laterMax);
+                            if (Overlaps(earlierMin, earlierMax, laterMin, laterMax))
+                            {
+                                r_laterBatch.conflicted = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
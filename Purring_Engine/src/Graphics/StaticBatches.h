@@ -0,0 +1,210 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     StaticBatches.h
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the StaticBatches class, which bakes
+           the instance data of sprites that have stopped changing into buffers that
+           stay on the GPU, so that they are not rebuilt and uploaded every frame.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+#include <glm/glm.hpp>
+
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "SpriteInstance.h"
+#include "RenderBackend.h"
+
+typedef unsigned long long EntityID;
+
+namespace PE
+{
+    namespace Graphics
+    {
+        class CullingGrid;
+
+        /*!***********************************************************************************
+         \brief Static batches of the sprites in a render order. A sprite that has been drawn
+                with the same instance data for stableFrameCount frames is baked into the
+                batch of its render layer, texture and chunk of the world. Each batch keeps
+                the instance data of its sprites in a buffer of its own, and is drawn in one
+                call when it is in view.
+
+                A baked sprite is taken out of its batch when its renderer, transform or
+                active state changes, and the batch is uploaded again at the end of the frame.
+                A batch is drawn where its first sprite is in the render order, so batches
+                that would be drawn over something between their sprites that overlaps them
+                are drawn a sprite at a time from the baked instance data instead.
+        *************************************************************************************/
+        class StaticBatches
+        {
+            // ----- Public constants ----- //
+        public:
+            static constexpr unsigned stableFrameCount{ 30 };   // Frames a sprite has to be drawn unchanged to be baked
+            static constexpr float chunkSize{ 1024.f };         // Width and height of the area of the world each batch covers
+            static constexpr std::size_t minBatchSize{ 4 };     // Fewest sprites a batch is drawn in one call with
+
+            // ----- Public types ----- //
+        public:
+            struct Batch
+            {
+                unsigned layer{};                 // Render layer of the sprites
+                GLuint textureID{};               // Texture bound on its own for the sprites, 0 if they use the atlas
+                std::vector<unsigned> members{};  // Indices of the sprites in the render order, ascending
+                glm::vec2 min{}, max{};           // Bounds of the sprites in world space
+                GLuint bufferObject{};            // Instance data of the sprites, in render order
+                bool dirty{};                     // The members changed since the buffer was uploaded
+                bool conflicted{};                // Overlaps a sprite of an earlier batch drawn after some of its own
+                bool visible{};                   // Overlaps the view or has a sprite in it this frame
+                bool drawn{};                     // Drawn in one call this frame
+            };
+
+            // ----- Constructors ----- //
+        public:
+            StaticBatches() = default;
+            StaticBatches(StaticBatches const&) = delete;
+            StaticBatches& operator=(StaticBatches const&) = delete;
+
+            /*!***********************************************************************************
+             \brief Deletes the buffers of the batches.
+            *************************************************************************************/
+            ~StaticBatches();
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns a batch.
+
+             \param[in] batchIndex Index of the batch.
+             \return Batch const& - The batch.
+            *************************************************************************************/
+            inline Batch const& GetBatch(unsigned const batchIndex) const { return m_batches[batchIndex]; }
+
+            /*!***********************************************************************************
+             \brief Returns the batches to draw in one call this frame.
+
+             \return std::vector<unsigned> const& - Indices of the batches, in the order of
+                                                    their first sprite in the render order.
+            *************************************************************************************/
+            inline std::vector<unsigned> const& GetDrawnBatches() const { return m_drawnBatches; }
+
+            /*!***********************************************************************************
+             \brief Returns whether a sprite is drawn with its batch this frame.
+
+             \param[in] index Index of the entity in the render order.
+             \return true - If the sprite is in a batch drawn in one call.
+             \return false - If the entity has to be drawn on its own.
+            *************************************************************************************/
+            inline bool IsDrawnInBatch(unsigned const index) const { return m_inDrawnBatch[index] != 0; }
+
+            /*!***********************************************************************************
+             \brief Finds the baked instance data of a sprite whose batch is not drawn in one
+                    call this frame. Sprites that are in view are validated in BeginFrame(),
+                    so the data is up to date.
+
+             \param[in] index Index of the entity in the render order.
+             \param[out] r_textureID Texture to bind on its own for the sprite, 0 if none.
+             \return SpriteInstance const* - Baked instance data, nullptr if the sprite is not baked.
+            *************************************************************************************/
+            SpriteInstance const* FindBakedSprite(unsigned const index, GLuint& r_textureID) const;
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Sets the backend the buffers of the batches are uploaded through. The
+                    batches are removed first, as their buffers belong to the last backend.
+
+             \param[in,out] r_backend Backend to upload the buffers through.
+            *************************************************************************************/
+            void SetBackend(RenderBackend& r_backend);
+
+            /*!***********************************************************************************
+             \brief Takes the sprites that changed out of the batches in view, and picks the
+                    batches to draw in one call this frame. Everything is thrown away when the
+                    render order or the texture atlas has changed, as the indices and the
+                    texture coordinates of the sprites would be out of date.
+
+             \param[in] r_renderOrder Entities drawn in the pass, in the order they are drawn.
+             \param[in] r_renderLayers Render layer of each of the entities.
+             \param[in] renderOrderVersion Version of the render order.
+             \param[in] atlasGeneration Generation of the texture atlas, see TextureAtlas::GetGeneration.
+             \param[in] r_cullingGrid Culling grid of the render order, queried this frame.
+             \param[in] r_viewMin Bottom left corner of the area the grid was queried with.
+             \param[in] r_viewMax Top right corner of the area the grid was queried with.
+            *************************************************************************************/
+            void BeginFrame(std::vector<EntityID> const& r_renderOrder, std::vector<unsigned char> const& r_renderLayers,
+                unsigned long long const renderOrderVersion, unsigned long long const atlasGeneration,
+                CullingGrid const& r_cullingGrid, glm::vec2 const& r_viewMin, glm::vec2 const& r_viewMax);
+
+            /*!***********************************************************************************
+             \brief Counts the frames a sprite drawn on its own has not changed for, and queues
+                    it to be baked once it has been stable for long enough.
+
+             \param[in] r_cullingGrid Culling grid of the render order.
+             \param[in] index Index of the entity in the render order.
+             \param[in] layer Render layer of the entity.
+             \param[in] revision Revision of the renderer of the entity.
+             \param[in] r_sprite Instance data the sprite was drawn with.
+             \param[in] textureID Texture bound on its own for the sprite, 0 if none.
+            *************************************************************************************/
+            void Track(CullingGrid const& r_cullingGrid, unsigned const index, unsigned const layer,
+                unsigned long long const revision, SpriteInstance const& r_sprite, GLuint const textureID);
+
+            /*!***********************************************************************************
+             \brief Adds the sprites queued by Track() to their batches, and uploads the
+                    instance data of the batches whose sprites changed this frame.
+            *************************************************************************************/
+            void EndFrame();
+
+            /*!***********************************************************************************
+             \brief Removes every batch and deletes their buffers.
+            *************************************************************************************/
+            void Clear();
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Checks whether the batches of a layer can be drawn in the order of their
+                    first sprite, and marks the ones that would be drawn over a sprite of an
+                    earlier batch that should be drawn over them.
+
+             \param[in] layer Render layer of the batches to check.
+            *************************************************************************************/
+            void FindConflicts(unsigned const layer);
+
+            // ----- Private variables ----- //
+        private:
+            struct Member
+            {
+                SpriteInstance sprite{};          // Instance data the sprite was last drawn with
+                GLuint textureID{};
+                unsigned long long revision{};    // Revision of the renderer when the sprite was last drawn
+                unsigned long long trackedUpdate{}; // Culling grid update the sprite was last drawn in
+                unsigned stableFrames{};          // Frames drawn in a row with the same instance data
+                int batch{ -1 };                  // Batch the sprite is baked into, -1 if it is not baked
+            };
+
+            RenderBackend* m_p_backend{ nullptr };
+            std::vector<Batch> m_batches{};
+            std::map<std::tuple<unsigned, GLuint, int, int>, unsigned> m_batchIndices{}; // By layer, texture and chunk
+            std::vector<Member> m_members{};            // Parallel to the render order
+            std::vector<unsigned char> m_inDrawnBatch{}; // Parallel to the render order
+            std::vector<unsigned> m_drawnBatches{};
+            std::vector<unsigned> m_pending{};          // Sprites to bake at the end of the frame
+            std::vector<unsigned> m_unbatched{};        // Sprites in view drawn on their own this frame
+            std::vector<SpriteInstance> m_uploadData{}; // Instance data of the batch being uploaded
+            unsigned long long m_renderOrderVersion{};
+            unsigned long long m_atlasGeneration{};
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
@@ -17,6 +17,7 @@
 #include "ft2build.h"
 #include FT_FREETYPE_H
 #include "Text.h"
+#include "Graphics/RenderBackend.h"
 #include "ResourceManager/ResourceManager.h"
 
 namespace PE
@@ -28,15 +29,12 @@ namespace PE
             return false;;
         }
 
-        glGenVertexArrays(1, &vertexArrayObject);
-        glGenBuffers(1, &vertexBufferObject);
-        glBindVertexArray(vertexArrayObject);
-        glBindBuffer(GL_ARRAY_BUFFER, vertexBufferObject);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        // quad of each glyph, rewritten every time a glyph is drawn
+        Graphics::RenderBackend& r_backend{ Graphics::RenderBackend::GetResourceBackend() };
+        vertexArrayObject = r_backend.CreateVertexArray();
+        vertexBufferObject = r_backend.CreateBuffer(sizeof(float) * 6 * 4, nullptr);
+        r_backend.BindVertexBuffer(vertexArrayObject, 0, vertexBufferObject, 0, 4 * sizeof(float));
+        r_backend.SetVertexAttribute(vertexArrayObject, 0, 0, 4, GL_FLOAT, GL_FALSE, 0);
         
         return true;
     }
@@ -64,9 +62,6 @@ namespace PE
         // Define pixel font size to extract
         FT_Set_Pixel_Sizes(face, 0, fontSize);
 
-        // disable byte-alignment restriction
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
         lineHeight = static_cast<float>(face->size->metrics.height >> 6) * 0.7f;
 
         // load first 128 ASCII characters for now
@@ -80,26 +75,9 @@ namespace PE
             }
 
             // generate texture
-            unsigned int texture;
-            glGenTextures(1, &texture);
-            glBindTexture(GL_TEXTURE_2D, texture);
-            glTexImage2D(
-                GL_TEXTURE_2D,
-                0,
-                GL_RED,
-                face->glyph->bitmap.width,
-                face->glyph->bitmap.rows,
-                0,
-                GL_RED,
-                GL_UNSIGNED_BYTE,
-                face->glyph->bitmap.buffer
-            );
-
-            // set texture options
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            unsigned int texture{ Graphics::RenderBackend::GetResourceBackend().CreateTexture(
+                static_cast<GLsizei>(face->glyph->bitmap.width), static_cast<GLsizei>(face->glyph->bitmap.rows),
+                GL_R8, GL_RED, GL_CLAMP_TO_EDGE, face->glyph->bitmap.buffer) };
     
             // now store character for later use
             Character character = {
@@ -111,7 +89,6 @@ namespace PE
 
             characters.insert(std::pair<char, Character>(ch, character));
         }
-        glBindTexture(GL_TEXTURE_2D, 0);
 
         // Clear freetype resource
         FT_Done_Face(face);
@@ -16,6 +16,7 @@
 #include "prpch.h"
 #include "GLHeaders.h"
 #include "Texture.h"
+#include "RenderBackend.h"
 #include "stb_image.h"
 
 namespace PE
@@ -29,7 +30,10 @@ namespace PE
 
 		Texture::~Texture()
 		{
-			glDeleteTextures(1, &m_textureID);
+			if (m_textureID)
+			{
+				RenderBackend::GetResourceBackend().DeleteTexture(m_textureID);
+			}
 		}
 
 		void Texture::Bind(unsigned int textureUnit) const
@@ -54,9 +58,10 @@ namespace PE
 
 		bool Texture::CreateTexture(std::string const& path)
 		{
-			int width, height, channels, internalFormat, imageFormat;
+			int width, height, channels;
 			stbi_set_flip_vertically_on_load(true);
-			unsigned char* textureData = stbi_load(path.c_str(), &width, &height, &channels, 0);
+			// always load 4 channels so that every texture can be copied into the texture atlas
+			unsigned char* textureData = stbi_load(path.c_str(), &width, &height, &channels, 4);
 
 			// if texture data is loaded
 			if (textureData)
@@ -64,19 +69,7 @@ namespace PE
 				m_width = width;
 				m_height = height;
 
-				internalFormat = channels == 4 ? GL_RGBA8 : GL_RGB8;
-				imageFormat = channels == 4 ? GL_RGBA : GL_RGB;
-
-				glCreateTextures(GL_TEXTURE_2D, 1, &m_textureID);
-				glTextureStorage2D(m_textureID, 1, internalFormat, m_width, m_height);
-
-				glTextureParameteri(m_textureID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-				glTextureParameteri(m_textureID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-				glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-				glTextureParameteri(m_textureID, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-				glTextureSubImage2D(m_textureID, 0, 0, 0, m_width, m_height, imageFormat, GL_UNSIGNED_BYTE, textureData);
+				m_textureID = RenderBackend::GetResourceBackend().CreateTexture(m_width, m_height, GL_RGBA8, GL_RGBA, GL_REPEAT, textureData);
 			
 				stbi_image_free(textureData);
 				return true;
@@ -0,0 +1,232 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     TextureAtlas.cpp
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the functions in the TextureAtlas
+           class, which packs textures into the layers of an array texture.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "TextureAtlas.h"
+#include "RenderBackend.h"
+#include <cmath>
+#include "Logging/Logger.h"
+
+extern Logger engine_logger;
+
+namespace PE
+{
+    namespace Graphics
+    {
+        TextureAtlas::~TextureAtlas()
+        {
+            Clear();
+        }
+
+
+        AtlasRegion const* TextureAtlas::Find(std::string const& r_key) const
+        {
+            auto const regionIterator{ m_regions.find(r_key) };
+            return regionIterator == m_regions.end() ? nullptr : &regionIterator->second;
+        }
+
+
+        bool TextureAtlas::Add(std::string const& r_key, Texture& r_texture)
+        {
+            GLsizei const width{ static_cast<GLsizei>(r_texture.GetWidth()) };
+            GLsizei const height{ static_cast<GLsizei>(r_texture.GetHeight()) };
+
+            // A texture that was loaded again may have new texels, or a new size
+            auto const regionIterator{ m_regions.find(r_key) };
+            if (regionIterator != m_regions.end())
+            {
+                AtlasRegion const& r_region{ regionIterator->second };
+                float const pageSize{ static_cast<float>(m_pageSize) };
+                GLsizei const x{ static_cast<GLsizei>(std::lround(r_region.uvOffset.x * pageSize)) };
+                GLsizei const y{ static_cast<GLsizei>(std::lround(r_region.uvOffset.y * pageSize)) };
+                if (width == static_cast<GLsizei>(std::lround(r_region.uvScale.x * pageSize))
+                    && height == static_cast<GLsizei>(std::lround(r_region.uvScale.y * pageSize)))
+                {
+                    // Same size, copy the texels over the old ones in place
+                    CopyTexels(r_texture.GetTextureID(), r_region.layer, x, y, width, height);
+                    return true;
+                }
+
+                // The space of the old texels is left unused until the atlas is cleared,
+                // and the texture moves, so regions that were found before are out of date
+                m_regions.erase(regionIterator);
+                ++m_generation;
+            }
+
+            if (!width || !height || width > maxTextureSize || height > maxTextureSize)
+            {
+                return false;
+            }
+
+            // Find space for the texture and its border
+            unsigned layer{};
+            GLsizei x{}, y{};
+            if (!Allocate(width + padding * 2, height + padding * 2, layer, x, y))
+            {
+                return false;
+            }
+            x += padding, y += padding;
+
+            CopyTexels(r_texture.GetTextureID(), layer, x, y, width, height);
+
+            float const pageSize{ static_cast<float>(m_pageSize) };
+            m_regions[r_key] = AtlasRegion{ layer,
+                glm::vec2{ static_cast<float>(x) / pageSize, static_cast<float>(y) / pageSize },
+                glm::vec2{ static_cast<float>(width) / pageSize, static_cast<float>(height) / pageSize } };
+
+            return true;
+        }
+
+
+        void TextureAtlas::Bind(unsigned int textureUnit) const
+        {
+            // Leave the active texture unit alone for the code that binds textures after this
+            glBindTextureUnit(textureUnit, m_textureID);
+        }
+
+
+        void TextureAtlas::Clear()
+        {
+            if (m_textureID)
+            {
+                RenderBackend::GetResourceBackend().DeleteTexture(m_textureID);
+            }
+
+            m_regions.clear();
+            m_pages.clear();
+            m_textureID = 0, m_pageCapacity = 0;
+            ++m_generation;
+        }
+
+
+        void TextureAtlas::CopyTexels(GLuint const sourceID, unsigned const layer, GLsizei const x, GLsizei const y, GLsizei const width, GLsizei const height)
+        {
+            // Copy the texels of the texture into the layer
+            RenderBackend& r_backend{ RenderBackend::GetResourceBackend() };
+            GLint const z{ static_cast<GLint>(layer) };
+            r_backend.CopyTexels(sourceID, GL_TEXTURE_2D, 0, 0, 0,
+                m_textureID, GL_TEXTURE_2D_ARRAY, x, y, z, width, height, 1);
+
+            // Repeat the edge columns, then the edge rows including the new columns, into the border
+            for (GLsizei i{ 1 }; i <= padding; ++i)
+            {
+                r_backend.CopyTexels(sourceID, GL_TEXTURE_2D, 0, 0, 0,
+                    m_textureID, GL_TEXTURE_2D_ARRAY, x - i, y, z, 1, height, 1);
+                r_backend.CopyTexels(sourceID, GL_TEXTURE_2D, width - 1, 0, 0,
+                    m_textureID, GL_TEXTURE_2D_ARRAY, x + width - 1 + i, y, z, 1, height, 1);
+            }
+            for (GLsizei i{ 1 }; i <= padding; ++i)
+            {
+                r_backend.CopyTexels(m_textureID, GL_TEXTURE_2D_ARRAY, x - padding, y, z,
+                    m_textureID, GL_TEXTURE_2D_ARRAY, x - padding, y - i, z, width + padding * 2, 1, 1);
+                r_backend.CopyTexels(m_textureID, GL_TEXTURE_2D_ARRAY, x - padding, y + height - 1, z,
+                    m_textureID, GL_TEXTURE_2D_ARRAY, x - padding, y + height - 1 + i, z, width + padding * 2, 1, 1);
+            }
+        }
+
+
+        bool TextureAtlas::Allocate(GLsizei const width, GLsizei const height, unsigned& r_layer, GLsizei& r_x, GLsizei& r_y)
+        {
+            // Pick the shelf with the least space left above the rectangle
+            Shelf* p_bestShelf{ nullptr };
+            unsigned bestLayer{};
+            for (unsigned layer{}; layer < m_pages.size(); ++layer)
+            {
+                for (Shelf& r_shelf : m_pages[layer].shelves)
+                {
+                    if (r_shelf.height >= height && r_shelf.x + width <= m_pageSize
+                        && (!p_bestShelf || r_shelf.height < p_bestShelf->height))
+                    {
+                        p_bestShelf = &r_shelf;
+                        bestLayer = layer;
+                    }
+                }
+            }
+
+            if (!p_bestShelf)
+            {
+                // Open a new shelf on the first page with space for it, or on a new page
+                unsigned layer{};
+                while (layer < m_pages.size() && m_pages[layer].top + height > m_pageSize)
+                {
+                    ++layer;
+                }
+
+                if (layer == m_pages.size())
+                {
+                    if (!Reserve(static_cast<GLsizei>(m_pages.size()) + 1) || height > m_pageSize || width > m_pageSize)
+                    {
+                        return false;
+                    }
+                    m_pages.emplace_back();
+                }
+
+                Page& r_page{ m_pages[layer] };
+                r_page.shelves.emplace_back(Shelf{ r_page.top, height, 0 });
+                r_page.top += height;
+                p_bestShelf = &r_page.shelves.back();
+                bestLayer = layer;
+            }
+
+            r_layer = bestLayer;
+            r_x = p_bestShelf->x, r_y = p_bestShelf->y;
+            p_bestShelf->x += width;
+
+            return true;
+        }
+
+
+        bool TextureAtlas::Reserve(GLsizei const pageCount)
+        {
+            if (pageCount <= m_pageCapacity) { return true; }
+            if (pageCount > maxPageCount) { return false; }
+
+            RenderBackend& r_backend{ RenderBackend::GetResourceBackend() };
+            if (!m_pageSize)
+            {
+                m_pageSize = std::min(defaultPageSize, static_cast<GLsizei>(r_backend.GetMaxTextureSize()));
+            }
+
+            GLsizei const newCapacity{ std::min(std::max(pageCount, m_pageCapacity * 2), maxPageCount) };
+
+            // Every layer starts transparent so that the space between textures stays empty
+            GLuint const newTextureID{ r_backend.CreateTextureArray(m_pageSize, m_pageSize, newCapacity, GL_RGBA8) };
+            if (0 == newTextureID)
+            {
+                engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+                engine_logger.SetTime();
+                engine_logger.AddLog(false, "Unable to create the texture atlas.", __FUNCTION__);
+
+                return false;
+            }
+
+            if (m_textureID)
+            {
+                r_backend.CopyTexels(m_textureID, GL_TEXTURE_2D_ARRAY, 0, 0, 0,
+                    newTextureID, GL_TEXTURE_2D_ARRAY, 0, 0, 0, m_pageSize, m_pageSize, m_pageCapacity);
+                r_backend.DeleteTexture(m_textureID);
+            }
+
+            m_textureID = newTextureID;
+            m_pageCapacity = newCapacity;
+
+            engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+            engine_logger.SetTime();
+            engine_logger.AddLog(false, "Texture atlas resized to " + std::to_string(m_pageCapacity) + " layers.", __FUNCTION__);
+
+            return true;
+        }
+    } // End of Graphics namespace
+} // End of PE namespace
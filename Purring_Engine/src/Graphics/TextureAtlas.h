@@ -0,0 +1,204 @@
+#pragma once
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     TextureAtlas.h
+ \date     31-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the declaration of the TextureAtlas class, which packs
+           textures into the layers of an array texture so that sprites with different
+           textures can be drawn in the same instanced draw call.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "Graphics/GLHeaders.h"
+#include <glm/glm.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Texture.h"
+
+namespace PE
+{
+    namespace Graphics
+    {
+        /*!***********************************************************************************
+         \brief Where a texture was packed in the atlas. UV coordinates of the texture are
+                mapped into the atlas with uvOffset + uv * uvScale.
+        *************************************************************************************/
+        struct AtlasRegion
+        {
+            unsigned layer{};       // Layer of the array texture the texture was packed into
+            glm::vec2 uvOffset{};   // UV coordinates of the bottom left corner of the texture in the layer
+            glm::vec2 uvScale{};    // Size of the texture in UV coordinates of the layer
+        };
+
+        /*!***********************************************************************************
+         \brief Array texture whose layers are pages that textures are packed into with a
+                shelf packer. Each texture is surrounded by a border of its edge texels so
+                that linear filtering does not pick up its neighbours. Textures that are too
+                large or do not fit are left out, and have to be drawn on their own.
+        *************************************************************************************/
+        class TextureAtlas
+        {
+            // ----- Public constants ----- //
+        public:
+            static constexpr GLsizei defaultPageSize{ 2048 };  // Width and height of each layer, if the GPU allows it
+            static constexpr GLsizei maxTextureSize{ 1024 };   // Largest width or height of a texture that is packed
+            static constexpr GLsizei maxPageCount{ 16 };       // Most layers the atlas can grow to
+            static constexpr GLsizei padding{ 2 };             // Texels of border around each texture
+
+            // ----- Constructors ----- //
+        public:
+            TextureAtlas() = default;
+            TextureAtlas(TextureAtlas const&) = delete;
+            TextureAtlas& operator=(TextureAtlas const&) = delete;
+
+            /*!***********************************************************************************
+             \brief Deletes the array texture.
+            *************************************************************************************/
+            ~TextureAtlas();
+
+            // ----- Public getters ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Returns the handle of the array texture. The handle changes when the atlas
+                    grows, so it should be fetched again whenever it is bound.
+
+             \return GLuint - Handle of the array texture, 0 if nothing has been packed.
+            *************************************************************************************/
+            inline GLuint GetTextureID() const { return m_textureID; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of layers that have textures packed into them.
+
+             \return GLsizei - Number of layers in use.
+            *************************************************************************************/
+            inline GLsizei GetPageCount() const { return static_cast<GLsizei>(m_pages.size()); }
+
+            /*!***********************************************************************************
+             \brief Returns the width and height of each layer.
+
+             \return GLsizei - Width and height of each layer in texels.
+            *************************************************************************************/
+            inline GLsizei GetPageSize() const { return m_pageSize; }
+
+            /*!***********************************************************************************
+             \brief Returns the number of textures packed into the atlas.
+
+             \return std::size_t - Number of textures packed.
+            *************************************************************************************/
+            inline std::size_t GetTextureCount() const { return m_regions.size(); }
+
+            /*!***********************************************************************************
+             \brief Returns the number of times the atlas has been cleared or a texture in it
+                    has moved. Regions found before the last change may no longer hold the
+                    same texture.
+
+             \return unsigned long long - Number of times the regions have changed.
+            *************************************************************************************/
+            inline unsigned long long GetGeneration() const { return m_generation; }
+
+            /*!***********************************************************************************
+             \brief Finds where a texture was packed.
+
+             \param[in] r_key Key of the texture in the resource manager.
+             \return AtlasRegion const* - Region of the texture, nullptr if it is not in the atlas.
+            *************************************************************************************/
+            AtlasRegion const* Find(std::string const& r_key) const;
+
+            // ----- Public methods ----- //
+        public:
+            /*!***********************************************************************************
+             \brief Copies a texture into the atlas. The texture must be RGBA8. If the key is
+                    already in the atlas, the texels are copied over the old ones when the
+                    size is unchanged, and the texture is packed again otherwise.
+
+             \param[in] r_key Key of the texture in the resource manager.
+             \param[in] r_texture Texture to copy the texels of.
+             \return true - If the texture is in the atlas.
+             \return false - If the texture is too large or there is no space left for it.
+            *************************************************************************************/
+            bool Add(std::string const& r_key, Texture& r_texture);
+
+            /*!***********************************************************************************
+             \brief Binds the array texture to a texture unit.
+
+             \param[in] textureUnit Texture unit to bind the array texture to.
+            *************************************************************************************/
+            void Bind(unsigned int textureUnit) const;
+
+            /*!***********************************************************************************
+             \brief Removes every texture and deletes the array texture.
+            *************************************************************************************/
+            void Clear();
+
+            // ----- Private methods ----- //
+        private:
+            /*!***********************************************************************************
+             \brief Copies the texels of a texture into a rectangle of a layer and repeats its
+                    edges into the border around it.
+
+             \param[in] sourceID Handle of the texture to copy.
+             \param[in] layer Layer to copy the texels into.
+             \param[in] x X position of the bottom left corner of the rectangle.
+             \param[in] y Y position of the bottom left corner of the rectangle.
+             \param[in] width Width of the texture.
+             \param[in] height Height of the texture.
+            *************************************************************************************/
+            void CopyTexels(GLuint const sourceID, unsigned const layer, GLsizei const x, GLsizei const y, GLsizei const width, GLsizei const height);
+
+            /*!***********************************************************************************
+             \brief Finds space for a rectangle of texels, on the shelf that fits it the most
+                    tightly, on a new shelf, or on a new page.
+
+             \param[in] width Width of the rectangle.
+             \param[in] height Height of the rectangle.
+             \param[out] r_layer Layer the rectangle was placed in.
+             \param[out] r_x X position of the bottom left corner of the rectangle.
+             \param[out] r_y Y position of the bottom left corner of the rectangle.
+             \return true - If space was found.
+             \return false - If the atlas is full.
+            *************************************************************************************/
+            bool Allocate(GLsizei const width, GLsizei const height, unsigned& r_layer, GLsizei& r_x, GLsizei& r_y);
+
+            /*!***********************************************************************************
+             \brief Makes sure the array texture has at least the number of layers passed in,
+                    recreating it with twice as many layers and copying the old layers over.
+
+             \param[in] pageCount Number of layers needed.
+             \return true - If the array texture has enough layers.
+             \return false - If the array texture could not be created.
+            *************************************************************************************/
+            bool Reserve(GLsizei const pageCount);
+
+            // ----- Private variables ----- //
+        private:
+            struct Shelf
+            {
+                GLsizei y{};      // Y position of the bottom of the shelf
+                GLsizei height{}; // Height of the tallest texture on the shelf
+                GLsizei x{};      // X position after the last texture on the shelf
+            };
+
+            struct Page
+            {
+                std::vector<Shelf> shelves{};
+                GLsizei top{}; // Y position after the last shelf
+            };
+
+            std::unordered_map<std::string, AtlasRegion> m_regions{}; // Where each texture was packed
+            std::vector<Page> m_pages{};
+            GLuint m_textureID{};      // Handle of the array texture
+            GLsizei m_pageCapacity{};  // Number of layers of the array texture
+            GLsizei m_pageSize{};      // Width and height of each layer
+            unsigned long long m_generation{}; // Number of times the atlas has been cleared or a texture has moved
+        };
+    } // End of Graphics namespace
+} // End of PE namespace
@@ -22,6 +22,8 @@
 #include "Logging/Logger.h"
 #include "Graphics/Text.h"
 #include "Layers/LayerManager.h"
+#include "GUI/Canvas.h"
+#include "Time/Profiler.h"
 
 extern Logger engine_logger;
 
@@ -32,7 +34,11 @@ namespace PE
 
 	void Hierarchy::Update()
 	{
+		PE_PROFILE_SCOPE("Hierarchy");
+#ifndef GAMERELEASE
+		// the parent and hierarchy orders are only used by the editor
 		UpdateParentList();
+#endif
 		UpdateTransform();
 		UpdateETC();
 		UpdateRenderOrder();
@@ -79,15 +85,22 @@ namespace PE
 		if (!EntityManager::GetInstance().Get<EntityDescriptor>(r_parent).isActive)
 			EntityManager::GetInstance().Get<EntityDescriptor>(r_child).DisableEntity();
 		
-		
-		UpdateRenderOrder(r_parent);
+		MoveFlatSubtree(r_child, r_parent);
+		QueueRenderOrderUpdate(r_child);
 	}
 
 	void Hierarchy::DetachChild(const EntityID& r_child)
 	{
 		// entity DNE, return
-		if (!EntityManager::GetInstance().Has<EntityDescriptor>(r_child) || !EntityManager::GetInstance().Get<EntityDescriptor>(r_child).isAlive)
+		if (!EntityManager::GetInstance().Has<EntityDescriptor>(r_child))
 			return;
+		if (!EntityManager::GetInstance().Get<EntityDescriptor>(r_child).isAlive)
+		{
+			// the links of entities that are not alive are left as is, rebuild so the flat hierarchy doesn't keep a stale node
+			if (m_flatIndex.count(r_child))
+				m_structureDirty = true;
+			return;
+		}
 		if (EntityManager::GetInstance().Get<EntityDescriptor>(r_child).parent)
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(EntityManager::GetInstance().Get<EntityDescriptor>(r_child).parent.value()))
@@ -99,7 +112,8 @@ namespace PE
 			EntityManager::GetInstance().Get<Transform>(r_child).relPosition.Zero();
 			EntityManager::GetInstance().Get<Transform>(r_child).relOrientation = 0;
 		}
-		UpdateRenderOrder(r_child);
+		MoveFlatSubtree(r_child, std::nullopt);
+		QueueRenderOrderUpdate(r_child);
 	}
 
 	bool Hierarchy::HasParent(const EntityID& child) const
@@ -117,6 +131,15 @@ namespace PE
 
 	bool Hierarchy::AreParentsActive(EntityID child) const
 	{
+		// read the state cached in the flattened hierarchy if it is up to date
+		if (!m_structureDirty && m_activeFlagsVersion == EntityDescriptor::activeFlagsVersion)
+		{
+			auto it = m_flatIndex.find(child);
+			if (it == m_flatIndex.end() || m_flatHierarchy[it->second].parent == flat_root)
+				return EntityManager::GetInstance().Get<EntityDescriptor>(child).isActive;
+			return m_flatHierarchy[it->second].parentsActive;
+		}
+
 		// Loop through all the parents to check their active statues
 		while (HasParent(child))
 		{
@@ -128,6 +151,26 @@ namespace PE
 		return EntityManager::GetInstance().Get<EntityDescriptor>(child).isActive;
 	}
 
+	std::optional<EntityID> Hierarchy::GetCanvasAncestor(EntityID child) const
+	{
+		// read the state cached in the flattened hierarchy if it is up to date
+		if (!m_structureDirty && !m_canvasAncestorsDirty)
+		{
+			auto it = m_flatIndex.find(child);
+			if (it == m_flatIndex.end() || m_flatHierarchy[it->second].canvasAncestor == ULLONG_MAX)
+				return std::nullopt;
+			return m_flatHierarchy[it->second].canvasAncestor;
+		}
+
+		while (HasParent(child))
+		{
+			child = GetParent(child).value();
+			if (EntityManager::GetInstance().Has<Canvas>(child))
+				return child;
+		}
+		return std::nullopt;
+	}
+
 	const std::optional<EntityID>& Hierarchy::GetAbsoluteParent(EntityID child) const
 	{
 		while (HasParent(child))
@@ -143,28 +186,144 @@ namespace PE
 		return EntityManager::GetInstance().Get<EntityDescriptor>(child).parent;
 	}
 
-	// recursive function to help with parent child ordering
-	void Hierarchy::TransformUpdateHelper(const EntityID& r_parentID)
+	void Hierarchy::RebuildFlatHierarchy()
 	{
-		const Transform& parent = EntityManager::GetInstance().Get<Transform>(r_parentID);
+		m_flatHierarchy.clear();
+		for (const EntityID& id : EntityManager::GetInstance().GetEntitiesInPool(ALL))
+		{
+			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
+				continue;
+
+			// only roots that have children need to be part of the flat hierarchy
+			const EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(id);
+			if (!desc.parent.has_value() && desc.children.size())
+				AppendFlatSubtree(id, 0);
+		}
+		ReindexFlatHierarchy();
+		m_structureDirty = false;
+		UpdateInheritedStates(0, m_flatHierarchy.size(), true);
+		m_canvasAncestorsDirty = false;
+		m_activeFlagsVersion = EntityDescriptor::activeFlagsVersion;
+	}
 
-		for (const EntityID& childrenID : EntityManager::GetInstance().Get<EntityDescriptor>(r_parentID).children)
+	size_t Hierarchy::AppendFlatSubtree(const EntityID& r_id, unsigned depth)
+	{
+		const size_t index{ m_flatHierarchy.size() };
+		HierarchyNode node;
+		node.id = r_id;
+		node.depth = depth;
+		m_flatHierarchy.emplace_back(node);
+
+		for (const EntityID& childID : EntityManager::GetInstance().Get<EntityDescriptor>(r_id).children)
+		{
+			if (!EntityManager::GetInstance().IsEntityValid(childID) || !EntityManager::GetInstance().Has<EntityDescriptor>(childID))
+				continue;
+			const size_t childCount{ AppendFlatSubtree(childID, depth + 1) };
+			m_flatHierarchy[index].subtreeSize += childCount;
+		}
+		return m_flatHierarchy[index].subtreeSize;
+	}
+
+	void Hierarchy::MoveFlatSubtree(const EntityID& r_id, const std::optional<EntityID>& r_newParent)
+	{
+		// a full rebuild is pending anyway
+		if (m_structureDirty)
+			return;
+
+		// take the subtree out of the flat hierarchy, subtrees are stored contiguously
+		std::vector<HierarchyNode> subtree;
+		auto it = m_flatIndex.find(r_id);
+		if (it != m_flatIndex.end())
+		{
+			const size_t begin{ it->second };
+			const size_t size{ m_flatHierarchy[begin].subtreeSize };
+			const size_t oldParent{ m_flatHierarchy[begin].parent };
+			for (size_t ancestor{ oldParent }; ancestor != flat_root; ancestor = m_flatHierarchy[ancestor].parent)
+				m_flatHierarchy[ancestor].subtreeSize -= size;
+
+			subtree.assign(m_flatHierarchy.begin() + begin, m_flatHierarchy.begin() + begin + size);
+			m_flatHierarchy.erase(m_flatHierarchy.begin() + begin, m_flatHierarchy.begin() + begin + size);
+
+			// a root left without children does not need to be in the flat hierarchy anymore
+			// (the old parent comes before the subtree so its index is unchanged)
+			if (oldParent != flat_root && m_flatHierarchy[oldParent].parent == flat_root && m_flatHierarchy[oldParent].subtreeSize == 1
+				&& !(r_newParent.has_value() && r_newParent.value() == m_flatHierarchy[oldParent].id))
+				m_flatHierarchy.erase(m_flatHierarchy.begin() + oldParent);
+
+			ReindexFlatHierarchy();
+		}
+		else if (EntityManager::GetInstance().Get<EntityDescriptor>(r_id).children.size())
 		{
-			if (EntityManager::GetInstance().Has<Transform>(childrenID))
+			// the entity has children that the flat hierarchy does not know of
+			m_structureDirty = true;
+			return;
+		}
+		else
+		{
+			HierarchyNode node;
+			node.id = r_id;
+			subtree.emplace_back(node);
+		}
+
+		// detached entities without children are not part of the flat hierarchy
+		if (!r_newParent.has_value() && subtree.size() == 1)
+			return;
+
+		size_t position{ m_flatHierarchy.size() };
+		unsigned depth{ 0 };
+		if (r_newParent.has_value())
+		{
+			size_t parentIndex;
+			auto parentIt = m_flatIndex.find(r_newParent.value());
+			if (parentIt != m_flatIndex.end())
 			{
-				Transform& trans = EntityManager::GetInstance().Get<Transform>(childrenID);
-				vec3 tmp{ trans.relPosition, 1.f };
-				tmp = parent.GetTransformMatrix3x3() * tmp;
-				trans.position.x = tmp.x;
-				trans.position.y = tmp.y;
-				trans.orientation = parent.orientation + trans.relOrientation;
+				parentIndex = parentIt->second;
 			}
-			// if it has children recursively call this function, with the current ID as the input
-			if(EntityManager::GetInstance().Has<EntityDescriptor>(childrenID))
-			if (EntityManager::GetInstance().Get<EntityDescriptor>(childrenID).children.size())
+			else if (EntityManager::GetInstance().Get<EntityDescriptor>(r_newParent.value()).parent.has_value())
 			{
-				TransformUpdateHelper(childrenID);
+				// the parent should have been in the flat hierarchy already
+				m_structureDirty = true;
+				return;
 			}
+			else
+			{
+				// the parent becomes a root of the flat hierarchy
+				HierarchyNode node;
+				node.id = r_newParent.value();
+				m_flatHierarchy.emplace_back(node);
+				parentIndex = m_flatHierarchy.size() - 1;
+			}
+
+			position = parentIndex + m_flatHierarchy[parentIndex].subtreeSize;
+			depth = m_flatHierarchy[parentIndex].depth + 1;
+			for (size_t ancestor{ parentIndex }; ancestor != flat_root; ancestor = m_flatHierarchy[ancestor].parent)
+				m_flatHierarchy[ancestor].subtreeSize += subtree.size();
+		}
+
+		const unsigned oldDepth{ subtree.front().depth };
+		for (HierarchyNode& r_node : subtree)
+		{
+			r_node.depth = r_node.depth - oldDepth + depth;
+			r_node.forceUpdate = true;
+		}
+		m_flatHierarchy.insert(m_flatHierarchy.begin() + position, subtree.begin(), subtree.end());
+		ReindexFlatHierarchy();
+
+		// the parent link changed, so the moved subtree inherits from different ancestors now
+		UpdateInheritedStates(position, position + subtree.size(), true);
+	}
+
+	void Hierarchy::ReindexFlatHierarchy()
+	{
+		m_flatIndex.clear();
+		std::vector<size_t> ancestors; // index of the last node seen at each depth
+		for (size_t i{ 0 }; i < m_flatHierarchy.size(); ++i)
+		{
+			HierarchyNode& r_node = m_flatHierarchy[i];
+			ancestors.resize(r_node.depth);
+			r_node.parent = (r_node.depth ? ancestors.back() : flat_root);
+			ancestors.emplace_back(i);
+			m_flatIndex[r_node.id] = i;
 		}
 	}
 
@@ -186,7 +345,10 @@ namespace PE
 					if (!HasParent(id))
 					{
 						while (m_sceneOrder.count(EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID))
+						{
 							++EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID;
+							QueueRenderOrderUpdate(id);
+						}
 						m_sceneOrder[EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID] = id;
 					}
 				}
@@ -206,7 +368,10 @@ namespace PE
 					if (!HasParent(id))
 					{
 						while (m_sceneOrder.count(EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID))
+						{
 							++EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID;
+							QueueRenderOrderUpdate(id);
+						}
 						m_sceneOrder[EntityManager::GetInstance().Get<EntityDescriptor>(id).sceneID] = id;
 					}
 				}
@@ -220,158 +385,291 @@ namespace PE
 		}
 	}
 
-	void Hierarchy::UpdateTransform()
+	void Hierarchy::UpdateInheritedStates(size_t begin, size_t end, bool updateCanvas)
 	{
-		if (m_parentOrder.empty() && m_hierarchyOrder.size() == 1)
+		for (size_t i{ begin }; i < end; ++i)
 		{
-			TransformUpdateHelper(m_hierarchyOrder.front());
+			HierarchyNode& r_node = m_flatHierarchy[i];
+			r_node.isActive = !EntityManager::GetInstance().Has<EntityDescriptor>(r_node.id) || EntityManager::GetInstance().Get<EntityDescriptor>(r_node.id).isActive;
+
+			if (r_node.parent == flat_root)
+			{
+				r_node.parentsActive = true;
+				r_node.canvasAncestor = ULLONG_MAX;
+				continue;
+			}
+
+			const HierarchyNode& r_parentNode = m_flatHierarchy[r_node.parent];
+			r_node.parentsActive = r_parentNode.parentsActive && r_parentNode.isActive;
+			if (updateCanvas)
+				r_node.canvasAncestor = (EntityManager::GetInstance().Has<Canvas>(r_parentNode.id) ? r_parentNode.id : r_parentNode.canvasAncestor);
 		}
-		else
+	}
+
+	void Hierarchy::UpdateTransform()
+	{
+		if (m_structureDirty)
+			RebuildFlatHierarchy();
+
+		// parents always come before their children, so one pass propagates any change down
+		for (HierarchyNode& r_node : m_flatHierarchy)
 		{
-			for (const EntityID& parentID : m_parentOrder)
+			if (!EntityManager::GetInstance().Has<Transform>(r_node.id))
 			{
-				TransformUpdateHelper(parentID);
+				// children of an entity without a transform are left where they are
+				r_node.p_transform = nullptr;
+				r_node.changed = false;
+				continue;
+			}
+
+			Transform& trans = EntityManager::GetInstance().Get<Transform>(r_node.id);
+			r_node.p_transform = &trans;
+
+			// anything written to the transform since the last update marks the node dirty
+			bool dirty{ r_node.forceUpdate || trans.position != r_node.lastPosition || trans.orientation != r_node.lastOrientation };
+
+			if (r_node.parent != flat_root)
+			{
+				const HierarchyNode& r_parentNode = m_flatHierarchy[r_node.parent];
+				dirty = dirty || r_parentNode.changed || trans.relPosition != r_node.lastRelPosition || trans.relOrientation != r_node.lastRelOrientation;
+
+				if (dirty && r_parentNode.p_transform)
+				{
+					const Transform& parent = *r_parentNode.p_transform;
+					vec3 tmp{ trans.relPosition, 1.f };
+					tmp = parent.GetTransformMatrix3x3() * tmp;
+					trans.position.x = tmp.x;
+					trans.position.y = tmp.y;
+					trans.orientation = parent.orientation + trans.relOrientation;
+				}
 			}
+
+			r_node.changed = dirty;
+			r_node.forceUpdate = false;
+			r_node.lastPosition = trans.position;
+			r_node.lastOrientation = trans.orientation;
+			r_node.lastRelPosition = trans.relPosition;
+			r_node.lastRelOrientation = trans.relOrientation;
 		}
 	}
 
 	void Hierarchy::UpdateETC()
 	{
-		// empty for now
+		// canvas ancestors only change with the parent links (handled when they change) or components
+		if (m_canvasAncestorsDirty)
+		{
+			UpdateInheritedStates(0, m_flatHierarchy.size(), true);
+			m_canvasAncestorsDirty = false;
+			m_activeFlagsVersion = EntityDescriptor::activeFlagsVersion;
+			return;
+		}
+
+		UpdateActiveStates();
 	}
 
-	void Hierarchy::RenderOrderUpdateHelper(const EntityID& r_parent, float min, float max)
+	void Hierarchy::UpdateActiveStates()
 	{
-		const float delta = (max - min) / (EntityManager::GetInstance().Get<EntityDescriptor>(r_parent).children.size() + 1);
-		EntityID prevSceneID{ EntityManager::GetInstance().Get<EntityDescriptor>(r_parent).sceneID };
-		std::map<EntityID, std::pair<EntityDescriptor*, EntityID>> descs;
-		std::vector<EntityID> rm;
-		for (const auto& id : EntityManager::GetInstance().Get<EntityDescriptor>(r_parent).children)
-		{
-			if (!EntityManager::GetInstance().IsEntityValid(id))
-			{ 
-				rm.push_back(id);
+		if (m_activeFlagsVersion == EntityDescriptor::activeFlagsVersion)
+			return;
+		m_activeFlagsVersion = EntityDescriptor::activeFlagsVersion;
+
+		// only the subtrees under entities whose active flag changed are propagated again,
+		// their parents come before them so the states they inherit from are up to date
+		for (size_t i{ 0 }; i < m_flatHierarchy.size();)
+		{
+			const HierarchyNode& r_node = m_flatHierarchy[i];
+			const bool isActive{ !EntityManager::GetInstance().Has<EntityDescriptor>(r_node.id) || EntityManager::GetInstance().Get<EntityDescriptor>(r_node.id).isActive };
+			if (isActive == r_node.isActive)
+			{
+				++i;
 				continue;
 			}
-			EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(id);
-			if (!desc.sceneID || desc.sceneID == ULLONG_MAX || desc.sceneID == prevSceneID)
-				desc.sceneID = prevSceneID + 1;
-			descs[desc.sceneID] = std::make_pair(&desc, id);
-			prevSceneID = desc.sceneID;
+
+			const size_t end{ i + r_node.subtreeSize };
+			UpdateInheritedStates(i, end, false);
+			i = end;
 		}
-		for (const auto& id : rm)
+	}
+
+	void Hierarchy::AppendRenderEntries(const EntityID& r_id, RenderTree& r_tree, unsigned long long& r_index, std::vector<RenderOrderEntry>& r_entries)
+	{
+		const unsigned long long key{ r_tree.keyPrefix | r_index++ };
+		r_tree.members.emplace_back(r_id);
+		m_renderRootOf[r_id] = r_tree.members.front();
+
+		if (EntityManager::GetInstance().Has<PE::Graphics::Renderer>(r_id))
+			r_entries.emplace_back(RenderOrderEntry{ key, r_id, r_tree.interactionLayer, RenderOrderType::World });
+		else if (EntityManager::GetInstance().Has<PE::Graphics::GUIRenderer>(r_id))
+			r_entries.emplace_back(RenderOrderEntry{ key, r_id, r_tree.interactionLayer, RenderOrderType::UI });
+		else if (EntityManager::GetInstance().Has<PE::TextComponent>(r_id))
+			r_entries.emplace_back(RenderOrderEntry{ key, r_id, r_tree.interactionLayer, RenderOrderType::Text });
+
+		// children are drawn after their parent, in the order of their scene IDs
+		std::vector<std::pair<EntityID, EntityID>> children;
+		for (const EntityID& childID : EntityManager::GetInstance().Get<EntityDescriptor>(r_id).children)
 		{
-			Hierarchy::GetInstance().DetachChild(id);
+			if (EntityManager::GetInstance().IsEntityValid(childID) && EntityManager::GetInstance().Has<EntityDescriptor>(childID))
+				children.emplace_back(EntityManager::GetInstance().Get<EntityDescriptor>(childID).sceneID, childID);
 		}
+		std::sort(children.begin(), children.end());
 
-		unsigned cnt{ 1 };
-		for (auto [k, desc] : descs)
+		for (const auto& [sceneID, childID] : children)
 		{
+			AppendRenderEntries(childID, r_tree, r_index, r_entries);
+		}
+	}
 
-			// how to handle when the layer of the child is diff from parents??
-			// currently ignoring
-			const float order = min + (delta * cnt);
+	void Hierarchy::InsertRenderTree(const EntityID& r_root)
+	{
+		// id 0 is default camera, ignore it
+		if (!r_root || !EntityManager::GetInstance().IsEntityValid(r_root) || m_renderTrees.count(r_root)
+			|| !EntityManager::GetInstance().Has<EntityDescriptor>(r_root) || !EntityManager::GetInstance().Has<Transform>(r_root))
+			return;
 
-			if (desc.first->renderOrder <= min || desc.first->renderOrder >= max || (desc.first->renderOrder != order))
-				m_sceneHierarchy.erase(desc.first->renderOrder);
-			desc.first->renderOrder = order;
-			m_sceneHierarchy[desc.first->renderOrder] = desc.second;
+		EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(r_root);
+		if (desc.parent.has_value())
+			return;
 
-			if (desc.first->children.size())
-			{
-				RenderOrderUpdateHelper(desc.second, desc.first->renderOrder, desc.first->renderOrder + delta);
-			}
-			++cnt;
-		}
+		// keep the scene IDs of the roots unique so that their trees don't interleave
+		if (desc.sceneID == ULLONG_MAX)
+			desc.sceneID = r_root;
+		while (m_renderRootSceneIDs.count(desc.sceneID))
+			++desc.sceneID;
+		m_renderRootSceneIDs[desc.sceneID] = r_root;
+
+		const unsigned long long layer{ static_cast<unsigned long long>(std::clamp(desc.layer, 0, 15)) };
+		const unsigned long long sceneBits{ desc.sceneID & ((1ull << render_scene_bits) - 1) };
+
+		RenderTree& r_tree = m_renderTrees[r_root];
+		r_tree.keyPrefix = (layer << (render_scene_bits + render_index_bits)) | (sceneBits << render_index_bits);
+		r_tree.sceneID = desc.sceneID;
+		r_tree.interactionLayer = desc.interactionLayer;
+
+		std::vector<RenderOrderEntry> entries;
+		unsigned long long index{ 0 };
+		AppendRenderEntries(r_root, r_tree, index, entries);
+
+		auto position = std::lower_bound(m_renderEntries.begin(), m_renderEntries.end(), r_tree.keyPrefix,
+			[](const RenderOrderEntry& r_entry, unsigned long long key) { return r_entry.key < key; });
+		m_renderEntries.insert(position, entries.begin(), entries.end());
+		m_renderOutputDirty = true;
 	}
 
+	void Hierarchy::RemoveRenderTree(const EntityID& r_root)
+	{
+		auto treeIt = m_renderTrees.find(r_root);
+		if (treeIt == m_renderTrees.end())
+			return;
+
+		const RenderTree& r_tree = treeIt->second;
+		auto compare = [](const RenderOrderEntry& r_entry, unsigned long long key) { return r_entry.key < key; };
+		auto begin = std::lower_bound(m_renderEntries.begin(), m_renderEntries.end(), r_tree.keyPrefix, compare);
+		auto end = std::lower_bound(begin, m_renderEntries.end(), r_tree.keyPrefix + (1ull << render_index_bits), compare);
+		m_renderEntries.erase(begin, end);
 
-	void Hierarchy::UpdateRenderOrder(EntityID targetID)
+		for (const EntityID& id : r_tree.members)
+		{
+			auto rootIt = m_renderRootOf.find(id);
+			if (rootIt != m_renderRootOf.end() && rootIt->second == r_root)
+				m_renderRootOf.erase(rootIt);
+		}
+		m_renderRootSceneIDs.erase(r_tree.sceneID);
+		m_renderTrees.erase(treeIt);
+		m_renderOutputDirty = true;
+	}
+
+	void Hierarchy::RebuildRenderOrder()
 	{
-		// update specific entity
-		float delta = 100.f * m_parentOrder.size();
+		m_renderEntries.clear();
+		m_renderTrees.clear();
+		m_renderRootOf.clear();
+		m_renderRootSceneIDs.clear();
 
-		if (targetID != ULLONG_MAX)
+		for (const EntityID& id : EntityManager::GetInstance().GetEntitiesInPool(ALL))
 		{
-			EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(targetID);
-			if (!desc.parent.has_value())
-			{
-				m_sceneHierarchy.erase(desc.renderOrder);
-				desc.renderOrder = static_cast<float>(desc.sceneID) + (desc.layer * delta);
-				m_sceneHierarchy[desc.renderOrder] = targetID;
-			}
+			InsertRenderTree(id);
+		}
 
-			// recursively update children
-			if (desc.children.size())
-			{
-				RenderOrderUpdateHelper(targetID, desc.renderOrder, desc.renderOrder + 1.f);
-			}
+		m_renderOrderQueue.clear();
+		m_renderOrderDirty = false;
+		m_renderOutputDirty = true;
+	}
+
+	void Hierarchy::UpdateRenderOrder()
+	{
+		if (m_renderOrderDirty)
+		{
+			RebuildRenderOrder();
 		}
-		else // update all the parents
+		else if (m_renderOrderQueue.size())
 		{
-			m_sceneHierarchy.clear();
-			for (const EntityID& parentID : m_parentOrder)
+			// the trees the queued entities were in, and the trees they are in now
+			std::vector<EntityID> roots;
+			for (EntityID id : m_renderOrderQueue)
 			{
-				EntityDescriptor& desc = EntityManager::GetInstance().Get<EntityDescriptor>(parentID);
-				// ignoring UI for now
-				if (desc.sceneID == ULLONG_MAX)
-					desc.sceneID = parentID;
+				auto rootIt = m_renderRootOf.find(id);
+				if (rootIt != m_renderRootOf.end())
+					roots.emplace_back(rootIt->second);
+
+				if (!EntityManager::GetInstance().IsEntityValid(id) || !EntityManager::GetInstance().Has<EntityDescriptor>(id))
+					continue;
+				while (HasParent(id) && EntityManager::GetInstance().IsEntityValid(GetParent(id).value()))
+					id = GetParent(id).value();
+				roots.emplace_back(id);
+			}
+			m_renderOrderQueue.clear();
+
+			std::sort(roots.begin(), roots.end());
+			roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+			for (const EntityID& root : roots)
+				RemoveRenderTree(root);
+			for (const EntityID& root : roots)
+				InsertRenderTree(root);
+		}
 
-				float RO = static_cast<float>(desc.sceneID) + (desc.layer * delta);
-				if (RO != desc.renderOrder)
-					m_sceneHierarchy.erase(desc.renderOrder);
+		// the renderOrder vectors also depend on the layers shown and the canvases active
+		const LayerState& r_layerState = LayerManager::GetInstance().GetLayerState();
+		const auto& r_canvases = GUISystem::GetActiveCanvases();
+		if (!m_renderOutputDirty && r_layerState == m_renderLayerState && r_canvases == m_renderCanvases)
+			return;
 
-				desc.renderOrder = RO;
-				m_sceneHierarchy[desc.renderOrder] = parentID;
-				
+		m_renderLayerState = r_layerState;
+		m_renderCanvases = r_canvases;
+		m_renderOutputDirty = false;
+		++m_renderOrderVersion;
 
-				// recursively update children
-				if (desc.children.size())
-				{
-					RenderOrderUpdateHelper(parentID, desc.renderOrder, desc.renderOrder + 1.f);
-				}
-			}
-		}
-		
 		m_renderOrder.clear();
 		m_renderOrderUI.clear();
-		// to update the logic here
-		// main concern is differentiation of UI and world objects will be modified
-		for (auto [k, v] : m_sceneHierarchy)
+		m_renderLayers.clear();
+		m_renderLayersUI.clear();
+		for (const RenderOrderEntry& r_entry : m_renderEntries)
 		{
-			if (EntityManager::GetInstance().Has<PE::Graphics::Renderer>(v))
-			{
-				m_renderOrder.emplace_back(v);
-			}
-			// to change to canvas!!
-			else if (EntityManager::GetInstance().Has<PE::Graphics::GUIRenderer>(v))
-			{
-				if (!GETGUISYSTEM()->AreThereActiveCanvases()) { continue; }
+			if (r_entry.interactionLayer < 0 || static_cast<size_t>(r_entry.interactionLayer) >= MAX_LAYERS || !m_renderLayerState.test(r_entry.interactionLayer))
+				continue;
 
-				if(GETGUISYSTEM()->IsChildedToCanvas(v)) // Check if it's childed to a canvas
-					m_renderOrderUI.emplace_back(v);
-			}
-			else if (EntityManager::GetInstance().Has<PE::TextComponent>(v))
+			// the render layer of the root is in the top bits of the key
+			const unsigned char renderLayer = static_cast<unsigned char>(r_entry.key >> (render_index_bits + render_scene_bits));
+			switch (r_entry.type)
 			{
-				if (GETGUISYSTEM()->IsChildedToCanvas(v)) // Check if it's childed to a canvas
-					m_renderOrderUI.emplace_back(v);
+			case RenderOrderType::World:
+				m_renderOrder.emplace_back(r_entry.id);
+				m_renderLayers.emplace_back(renderLayer);
+				break;
+			case RenderOrderType::UI:
+				if (!m_renderCanvases.empty() && GETGUISYSTEM()->IsChildedToCanvas(r_entry.id)) // Check if it's childed to a canvas
+				{
+					m_renderOrderUI.emplace_back(r_entry.id);
+					m_renderLayersUI.emplace_back(renderLayer);
+				}
+				break;
+			case RenderOrderType::Text:
+				if (GETGUISYSTEM()->IsChildedToCanvas(r_entry.id)) // Check if it's childed to a canvas
+				{
+					m_renderOrderUI.emplace_back(r_entry.id);
+					m_renderLayersUI.emplace_back(renderLayer);
+				}
+				break;
 			}
 		}
-		//std::cout << "-- Scene Hierarchy --" << std::endl;
-		//for (auto[k,v] : sceneHierarchy)
-		//{
-		//	std::cout << k << ", " << v << std::endl;
-		//}
-		/*std::cout << "-- Object Render Order --" << std::endl;
-		for (const auto& id : renderOrder)
-		{
-			std::cout << id << std::endl;
-		}*/
-
-		/*std::cout << "-- UI Render Order --" << std::endl;
-		for (const auto& id : renderOrderUI)
-		{
-			std::cout << id << std::endl;
-		}*/
 	}
 }
\ No newline at end of file
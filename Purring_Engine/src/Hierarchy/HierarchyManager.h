@@ -30,7 +30,12 @@
 // for accessing transform information & methods
 #include "Math/Transform.h"
 
+// for the visible layer states
+#include "Layers/Layer.h"
+
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace PE
 {
@@ -61,6 +66,28 @@ namespace PE
 		*************************************************************************************/
 		const std::vector<EntityID>& GetRenderOrderUI() const { return m_renderOrderUI; }
 
+		/*!***********************************************************************************
+		 \brief Get the render layer of the root of each entity in the Render Order vector
+		 
+		 \return const std::vector<unsigned char>&  the cached vector, parallel to GetRenderOrder()
+		*************************************************************************************/
+		const std::vector<unsigned char>& GetRenderLayers() const { return m_renderLayers; }
+
+		/*!***********************************************************************************
+		 \brief Get the render layer of the root of each entity in the Render Order UI vector
+		 
+		 \return const std::vector<unsigned char>&  the cached vector, parallel to GetRenderOrderUI()
+		*************************************************************************************/
+		const std::vector<unsigned char>& GetRenderLayersUI() const { return m_renderLayersUI; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of times the Render Order vectors have been rebuilt, so that
+		 data kept parallel to them can tell when it has to be rebuilt too
+		 
+		 \return unsigned long long  the version of the Render Order vectors, 0 before the first build
+		*************************************************************************************/
+		unsigned long long GetRenderOrderVersion() const { return m_renderOrderVersion; }
+
 		/*!***********************************************************************************
 		 \brief Get the Parent Order vector object mainly used in Editor.cpp by the object
 		 window
@@ -127,6 +154,15 @@ namespace PE
 		*************************************************************************************/
 		bool AreParentsActive(EntityID child) const;
 
+		/*!***********************************************************************************
+		 \brief Get the closest ancestor of the entity with a Canvas component, read from the
+		 		state cached in the flattened hierarchy
+		 
+		 \param[in] child 	The child to check
+		 \return std::optional<EntityID> The closest canvas ancestor, if any
+		*************************************************************************************/
+		std::optional<EntityID> GetCanvasAncestor(EntityID child) const;
+
 		/*!***********************************************************************************
 		 \brief Get the absolute parent (std::optional, treat properly!) of the current entity 
 		 
@@ -135,6 +171,24 @@ namespace PE
 		*************************************************************************************/
 		const std::optional<EntityID>& GetAbsoluteParent(EntityID child) const;
 
+		/*!***********************************************************************************
+		 \brief Calls a function on every entity in the flattened hierarchy that has a parent,
+		 		parents always before their children, so that values written for a parent 
+		 		can be passed down to its children in one pass
+		 
+		 \tparam Func 		Callable taking (EntityID child, EntityID parent)
+		 \param[in] r_func 	Function to call on each child
+		*************************************************************************************/
+		template <typename Func>
+		void ForEachFlatChild(Func const& r_func) const
+		{
+			for (HierarchyNode const& r_node : m_flatHierarchy)
+			{
+				if (r_node.parent != flat_root)
+					r_func(r_node.id, m_flatHierarchy[r_node.parent].id);
+			}
+		}
+
 	// ----- Public Methods ----- //
 	public:
 		/*!***********************************************************************************
@@ -159,18 +213,105 @@ namespace PE
 		*************************************************************************************/
 		void DetachChild(const EntityID& r_child);
 
+		/*!***********************************************************************************
+		 \brief Flags the flattened hierarchy and the render order to be rebuilt from the 
+		 		entity descriptors on the next update. Call this after changing parent or 
+		 		children links or scene IDs directly instead of through AttachChild/DetachChild
+		 		(e.g. when loading a scene).
+		 
+		*************************************************************************************/
+		void MarkStructureDirty() { m_structureDirty = m_renderOrderDirty = true; }
+
+		/*!***********************************************************************************
+		 \brief Queues the render order of the tree an entity belongs to (before and after
+		 		the change) to be recomputed on the next update. Call this when the entity
+		 		is created or destroyed, its render layer changes or its components change.
+		 
+		 \param[in] r_id 	ID of the entity that changed
+		*************************************************************************************/
+		void QueueRenderOrderUpdate(const EntityID& r_id) { m_renderOrderQueue.emplace_back(r_id); }
+
+		/*!***********************************************************************************
+		 \brief To be called when components are added to or removed from an entity, or the
+		 		entity is created or destroyed. Queues its render order to be updated and
+		 		the canvas ancestors to be recomputed on the next update.
+		 
+		 \param[in] r_id 	ID of the entity that changed
+		*************************************************************************************/
+		void OnComponentsChanged(const EntityID& r_id) { QueueRenderOrderUpdate(r_id); m_canvasAncestorsDirty = true; }
+
 		
 		
 	
+	// ----- Private Types ----- //
+	private:
+		// render sort keys are, from the most significant bits, the render layer of the root,
+		// the scene ID of the root and the depth first index of the entity in its tree
+		static constexpr unsigned render_index_bits{ 24 };
+		static constexpr unsigned render_scene_bits{ 36 };
+
+		enum class RenderOrderType : unsigned char { World, UI, Text };
+
+		struct RenderOrderEntry
+		{
+			unsigned long long key;
+			EntityID id;
+			int interactionLayer; // of the root, to hide the entities on hidden layers
+			RenderOrderType type;
+		};
+
+		struct RenderTree
+		{
+			unsigned long long keyPrefix; // key bits shared by all the entities in the tree
+			EntityID sceneID;
+			int interactionLayer; // of the root
+			std::vector<EntityID> members; // root first, in depth first order
+		};
+
 	// ----- Private Methods ----- //
 	private: 
 		/*!***********************************************************************************
-		 \brief Update function helper to allow recursion for parent/child processing to 
-		 ensure correct transforms are computed(from root, being the parent outward)
+		 \brief Rebuilds the flattened hierarchy from the parent and children links of the
+		 		entity descriptors
+		 
+		*************************************************************************************/
+		void RebuildFlatHierarchy();
+
+		/*!***********************************************************************************
+		 \brief Helper function to append an entity and all its descendants to the flattened
+		 		hierarchy in depth first order
+		 
+		 \param[in] r_id 	ID of the entity to append
+		 \param[in] depth 	Number of ancestors the entity has
+		 \return size_t 	Number of nodes appended
+		*************************************************************************************/
+		size_t AppendFlatSubtree(const EntityID& r_id, unsigned depth);
+
+		/*!***********************************************************************************
+		 \brief Moves the subtree of an entity in the flattened hierarchy to the end of the 
+		 		subtree of its new parent, to be called once the descriptors are updated
+		 
+		 \param[in] r_id 		ID of the entity that was attached or detached
+		 \param[in] r_newParent 	ID of the new parent, std::nullopt if it was detached
+		*************************************************************************************/
+		void MoveFlatSubtree(const EntityID& r_id, const std::optional<EntityID>& r_newParent);
+
+		/*!***********************************************************************************
+		 \brief Recomputes the parent index of every node in the flattened hierarchy from 
+		 		their depths, and the lookup from entity ID to node index
 		 
-		 \param[in] r_id 	Parent EntityID
 		*************************************************************************************/
-		void TransformUpdateHelper(const EntityID& r_id);
+		void ReindexFlatHierarchy();
+
+		/*!***********************************************************************************
+		 \brief Recomputes the inherited states of a range of nodes in the flattened 
+		 		hierarchy from their parents, whose states must be up to date
+		 
+		 \param[in] begin 			Index of the first node to update
+		 \param[in] end 			Index past the last node to update
+		 \param[in] updateCanvas 	Whether to recompute the canvas ancestors as well
+		*************************************************************************************/
+		void UpdateInheritedStates(size_t begin, size_t end, bool updateCanvas);
 
 		/*!***********************************************************************************
 		 \brief Updates the parentOrder vector (grabs all the true parents of the hierarchy, 
@@ -180,42 +321,116 @@ namespace PE
 		void UpdateParentList();
 
 		/*!***********************************************************************************
-		 \brief Updates the transforms of the entities in the scene, utilizes UpdateHelper()
+		 \brief Updates the world transforms of the entities in the flattened hierarchy, in
+		 		one pass from parents to children, recomputing only the nodes whose own 
+		 		transform or parent transform changed since the last update
 		 
 		*************************************************************************************/
 		void UpdateTransform();
 
 		/*!***********************************************************************************
-		 \brief Updates misc stuff (currently empty)
+		 \brief Updates the states inherited through the hierarchy (whether all the ancestors
+		 		of each entity are active, and its closest canvas ancestor)
 		 
 		*************************************************************************************/
 		void UpdateETC(); // for any other misc behaviour that we may want to add for inheriting stuff
 
 		/*!***********************************************************************************
-		 \brief Helper function to allow for easy recursion to update parents & it's children
-		 		entities in the correct order.
+		 \brief Propagates the active states again under the entities whose active flag was
+		 		changed through EntityDescriptor::SetActive since the last propagation
+		 
+		*************************************************************************************/
+		void UpdateActiveStates();
+
+		/*!***********************************************************************************
+		 \brief Helper function to append the render entries of an entity and its descendants
+		 		in depth first order, children sorted by their scene IDs.
 		 
 		 \param[in] r_id 		Target entity ID
-		 \param[in] min 	Minimum value for sorting purposes in the sceneOrder map
-		 \param[in] max 	Maximum value for sorting purposes in the sceneOrder map
+		 \param[in,out] r_tree 	Tree the entity belongs to
+		 \param[in,out] r_index Depth first index of the entity in its tree
+		 \param[out] r_entries 	Entries to append to
+		*************************************************************************************/
+		void AppendRenderEntries(const EntityID& r_id, RenderTree& r_tree, unsigned long long& r_index, std::vector<RenderOrderEntry>& r_entries);
+
+		/*!***********************************************************************************
+		 \brief Inserts the render entries of a root entity and its descendants into the
+		 		sorted render order, if the root is to be rendered at all
+		 
+		 \param[in] r_root 	ID of the root entity
 		*************************************************************************************/
-		void RenderOrderUpdateHelper(const EntityID& r_id, float min, float max);
+		void InsertRenderTree(const EntityID& r_root);
 
 		/*!***********************************************************************************
-		 \brief Updates the renderOrder vector (TODO)
+		 \brief Removes the render entries of the tree of a root entity from the sorted 
+		 		render order
 		 
+		 \param[in] r_root 	ID of the root entity
 		*************************************************************************************/
-		void UpdateRenderOrder(EntityID targetID = ULLONG_MAX);
+		void RemoveRenderTree(const EntityID& r_root);
+
+		/*!***********************************************************************************
+		 \brief Rebuilds the sorted render order from every root entity in the scene
+		 
+		*************************************************************************************/
+		void RebuildRenderOrder();
+
+		/*!***********************************************************************************
+		 \brief Applies the queued render order updates (or a full rebuild if one was forced),
+		 		then refreshes the renderOrder vectors if the sorted render order, the visible
+		 		layers or the active canvases changed
+		 
+		*************************************************************************************/
+		void UpdateRenderOrder();
 
 	// ----- Private Variables ----- //
 	private: 
+		static constexpr size_t flat_root{ static_cast<size_t>(-1) }; // parent index of root nodes
+
+		struct HierarchyNode
+		{
+			EntityID id;
+			size_t parent{ flat_root }; // index of the parent node
+			size_t subtreeSize{ 1 };  // number of nodes in the subtree of this node, itself included
+			unsigned depth{ 0 };
+			bool forceUpdate{ true };  // recompute the transform even if nothing seems to have changed
+			bool changed{ false };	   // world transform changed during this update
+			bool isActive{ true };	   // active flag of the entity at the last update
+			bool parentsActive{ true };  // every ancestor was active at the last update
+			EntityID canvasAncestor{ ULLONG_MAX }; // closest ancestor with a canvas component
+			Transform* p_transform{ nullptr }; // only valid during UpdateTransform()
+
+			// transform values at the end of the last update, to detect writes since then
+			vec2 lastPosition{};
+			float lastOrientation{};
+			vec2 lastRelPosition{};
+			float lastRelOrientation{};
+		};
+
+		std::vector<HierarchyNode> m_flatHierarchy; // entities with a parent or children, parents always before their children
+		std::unordered_map<EntityID, size_t> m_flatIndex; // index of each entity in m_flatHierarchy
+		bool m_structureDirty{ true };
+		bool m_canvasAncestorsDirty{ true };
+		unsigned long long m_activeFlagsVersion{}; // EntityDescriptor::activeFlagsVersion when the active states were last propagated
+
+		std::vector<RenderOrderEntry> m_renderEntries; // sorted by key, the trees are contiguous
+		std::unordered_map<EntityID, RenderTree> m_renderTrees; // trees in the render order by root
+		std::unordered_map<EntityID, EntityID> m_renderRootOf; // root of the tree of every entity in the render order
+		std::unordered_map<EntityID, EntityID> m_renderRootSceneIDs; // root using each scene ID, kept unique so trees don't interleave
+		std::vector<EntityID> m_renderOrderQueue;
+		bool m_renderOrderDirty{ true }; // rebuild the render order fully on the next update
+		bool m_renderOutputDirty{ true }; // refresh the renderOrder vectors on the next update
+		LayerState m_renderLayerState;
+		std::unordered_set<EntityID> m_renderCanvases;
+
 		std::vector<EntityID> m_renderOrder;
 		std::vector<EntityID> m_renderOrderUI;
+		std::vector<unsigned char> m_renderLayers; // render layer of each entity in m_renderOrder
+		std::vector<unsigned char> m_renderLayersUI; // render layer of each entity in m_renderOrderUI
+		unsigned long long m_renderOrderVersion{}; // incremented every time the renderOrder vectors are rebuilt
 
 		std::map<EntityID, EntityID> m_sceneOrder;
 		std::vector<EntityID> m_parentOrder; // wiped every frame? used to keep track of update order for parents, might change to list if i start inserting more...
 		std::vector<EntityID> m_hierarchyOrder;
-
-		std::map<float, EntityID> m_sceneHierarchy;
 	};
 }
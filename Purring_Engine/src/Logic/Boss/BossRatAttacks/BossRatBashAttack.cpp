@@ -137,7 +137,7 @@ namespace PE
 					if (EntityManager::GetInstance().Get<AnimationComponent>(iz).HasAnimationEnded())
 					{
 						if(EntityManager::GetInstance().Has<EntityDescriptor>(iz))
-							EntityManager::GetInstance().Get<EntityDescriptor>(iz).isActive = false;
+							EntityManager::GetInstance().Get<EntityDescriptor>(iz).SetActive(false);
 					}
 				}
 			}
@@ -147,7 +147,7 @@ namespace PE
 				EntityID tid = m_telegraphPoitions[m_attacksActivated++];
 				for (auto ie : EntityManager::GetInstance().Get<EntityDescriptor>(tid).children)
 				{
-					EntityManager::GetInstance().Get<EntityDescriptor>(ie).isActive = true;
+					EntityManager::GetInstance().Get<EntityDescriptor>(ie).SetActive(true);
 					p_script->PlayBashSpikeAudio();
 				}
 				m_attackDelay = p_data->attackDelay;
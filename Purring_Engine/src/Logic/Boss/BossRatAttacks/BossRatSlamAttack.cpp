@@ -47,7 +47,7 @@ namespace PE
 		DecideSide();
 
 		if(EntityManager::GetInstance().Has<EntityDescriptor>(p_data->slamTelegraph))
-			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamTelegraph).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamTelegraph).SetActive(true);
 
 		if (p_script->currentSlamTurnCounter == 2)
 		{
@@ -211,7 +211,7 @@ namespace PE
 	void BossRatSlamAttack::HideTelegraph(EntityID)
 	{
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->slamTelegraph))
-			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamTelegraph).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamTelegraph).SetActive(false);
 	}
 
 	void BossRatSlamAttack::DrawDamageTelegraph(EntityID)
@@ -219,10 +219,10 @@ namespace PE
 		if (m_attackIsLeft)
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->leftSideSlam))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlam).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlam).SetActive(true);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->slamAreaTelegraph))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).SetActive(true);
 
 			if (EntityManager::GetInstance().Has<Transform>(p_data->slamAreaTelegraph))
 			{
@@ -234,10 +234,10 @@ namespace PE
 		else
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->rightSideSlam))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlam).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlam).SetActive(true);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->slamAreaTelegraph))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).SetActive(true);
 
 			if (EntityManager::GetInstance().Has<Transform>(p_data->slamAreaTelegraph))
 			{
@@ -297,11 +297,11 @@ namespace PE
 	void BossRatSlamAttack::HideDamageTelegraph(EntityID)
 	{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->leftSideSlam))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlam).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlam).SetActive(false);
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->rightSideSlam))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlam).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlam).SetActive(false);
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->slamAreaTelegraph))
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->slamAreaTelegraph).SetActive(false);
 	}
 
 	void BossRatSlamAttack::CheckDamage(EntityID)
@@ -339,7 +339,7 @@ namespace PE
 					m_shockWavePrefabID = ResourceManager::GetInstance().LoadPrefabFromFile(m_shockWavePrefab);
 				}
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlamAnimation).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlamAnimation).SetActive(true);
 			}
 
 
@@ -364,7 +364,7 @@ namespace PE
 					m_shockWavePrefabID = ResourceManager::GetInstance().LoadPrefabFromFile(m_shockWavePrefab);
 				}
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlamAnimation).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlamAnimation).SetActive(true);
 			}
 
 			if (EntityManager::GetInstance().Has<AnimationComponent>(p_data->rightSideSlamAnimation))
@@ -383,9 +383,9 @@ namespace PE
 	{
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->leftSideSlamAnimation))
-			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlamAnimation).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->leftSideSlamAnimation).SetActive(false);
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(p_data->rightSideSlamAnimation))
-			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlamAnimation).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(p_data->rightSideSlamAnimation).SetActive(false);
 
 		EntityManager::GetInstance().RemoveEntity(m_shockWavePrefabID);
 
@@ -94,7 +94,7 @@ namespace PE
 				{
 					m_deathDelayTimeBeforeOutro = m_deathDelayTimeBeforeOutro;
 					p_gsc->GoToOutroCutscene();
-					EntityManager::GetInstance().Get<EntityDescriptor>(currentBoss).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(currentBoss).SetActive(false);
 				}
 
 			}
@@ -424,7 +424,7 @@ namespace PE
 			return;
 
 		//set active the current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(true);
 
 		//set active the childrens if there are any
 		for (auto id2 : EntityManager::GetInstance().Get<EntityDescriptor>(id).children)
@@ -437,7 +437,7 @@ namespace PE
 			{
 				EntityManager::GetInstance().Get<ParticleEmitter>(id2).ResetAllParticles();
 			}
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 		}
 	}
 	void BossRatScript::DeactiveObject(EntityID id)
@@ -454,13 +454,13 @@ namespace PE
 				if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 					break;
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 
 		if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
 			return;
 
 		//deactive current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(false);
 	}
 } // End of namespace PE
\ No newline at end of file
@@ -94,7 +94,7 @@ namespace PE
 			{
 				// Toggle the entity
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(id))
-					EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+					EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 			}
 
 			/*!***********************************************************************************
@@ -61,9 +61,14 @@ namespace PE
 		while (!(GETSCRIPTDATA(FollowScript_v2_0, id))->cacheFollowerPosition.empty())
 			(GETSCRIPTDATA(FollowScript_v2_0, id))->cacheFollowerPosition.pop();
 		
-		// subscribe to collision events
-		m_triggerEnterEventListener = ADD_COLLISION_EVENT_LISTENER(PE::CollisionEvents::OnTriggerEnter, CatMovement_v2_0PLAN::OnPathCollision, this);
-		m_triggerStayEventListener = ADD_COLLISION_EVENT_LISTENER(PE::CollisionEvents::OnTriggerStay, CatMovement_v2_0PLAN::OnPathCollision, this);
+		// subscribe to the collision events of the cat and its path nodes only
+		int listener = ADD_ENTITY_COLLISION_LISTENER(p_data->catID, CatMovement_v2_0PLAN::OnPathCollision, this, true);
+		m_pathCollisionListeners.emplace_back(listener);
+		for (EntityID nodeID : p_data->pathQuads)
+		{
+			listener = ADD_ENTITY_COLLISION_LISTENER(nodeID, CatMovement_v2_0PLAN::OnPathCollision, this, true);
+			m_pathCollisionListeners.emplace_back(listener);
+		}
 
 		// reset energy, toggle off all path nodes, reset path node colors and add a path position
 		p_data->catCurrentEnergy = p_data->catMaxMovementEnergy;
@@ -136,8 +141,11 @@ namespace PE
 
 	void CatMovement_v2_0PLAN::CleanUp()
 	{
-		REMOVE_KEY_COLLISION_LISTENER(m_triggerEnterEventListener);
-		REMOVE_KEY_COLLISION_LISTENER(m_triggerStayEventListener);
+		for (int listener : m_pathCollisionListeners)
+		{
+			REMOVE_ROUTED_COLLISION_LISTENER(listener);
+		}
+		m_pathCollisionListeners.clear();
 	}
 
 	void CatMovement_v2_0PLAN::Exit(EntityID id)
@@ -370,7 +378,7 @@ namespace PE
 		return m_invalidPath;
 	}
 
-	void CatMovement_v2_0PLAN::OnPathCollision(const Event<CollisionEvents>& r_CE)
+	void CatMovement_v2_0PLAN::OnPathCollision(const CollisionEventData& r_CE)
 	{
 		auto PlayHeart =
 			[&](EntityID cagedCatID)
@@ -416,7 +424,7 @@ namespace PE
 					PE::GlobalMusicManager::GetInstance().PlaySFX(soundPrefabPath, false);
 				};
 			
-			OnTriggerEnterEvent OTEE = dynamic_cast<const OnTriggerEnterEvent&>(r_CE);
+			const CollisionEventData& OTEE = r_CE;
 			// Check if the cat is colliding with an obstacle
 			if (CatHelperFunctions::IsObstacle(OTEE.Entity2))
 			{
@@ -476,7 +484,7 @@ namespace PE
 		}
 		else if (r_CE.GetType() == CollisionEvents::OnTriggerStay)
 		{
-			OnTriggerStayEvent OTEE = dynamic_cast<const OnTriggerStayEvent&>(r_CE);
+			const CollisionEventData& OTEE = r_CE;
 			if (IsCatAndCaged(OTEE.Entity2))
 			{
 				if (OTEE.Entity1 == GETSCRIPTINSTANCEPOINTER(CatController_v2_0)->GetMainCatID())
@@ -122,11 +122,11 @@ namespace PE
 		// ----- EVENTS ----- //
 
 		/*!***********************************************************************************
-		 \brief Callback function for collision events.
+		 \brief Callback function for the collision events of the cat and its path nodes.
 
-		 \param[in] r_mouseEvent - Collision event data.
+		 \param[in] r_TE - Collision event data.
 		*************************************************************************************/
-		void OnPathCollision(const Event<CollisionEvents>& r_TE);
+		void OnPathCollision(const CollisionEventData& r_TE);
 
 		/*!**********************************************************************************
 		 \brief Resets the position of the player to the beginning of their drawn path,
@@ -156,7 +156,7 @@ namespace PE
 		std::vector<EntityID> m_pathCollidersOnCage{}; // vector of path colliders that are colliding with the caged cat, saved to play animation
 		EntityID m_cagedCatID, m_heartIcon, m_storeLastPathNode;
 		bool m_pathHasCagedCat{ false };
-		int m_triggerEnterEventListener{}, m_triggerStayEventListener{}; // Stores the handler for the mouse click and release events
+		std::vector<int> m_pathCollisionListeners{}; // Stores the handles of the collision listeners of the cat and its path nodes
 		bool m_pathBeingDrawn{ false }; // Set to true when the player path is being drawn
 		bool m_invalidPath{ false };
 	};
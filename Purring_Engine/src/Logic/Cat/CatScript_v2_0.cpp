@@ -296,7 +296,7 @@ namespace PE
 		EntityManager::GetInstance().Get<Collider>(nodeId).colliderVariant = circleCollider;
 		EntityManager::GetInstance().Get<Collider>(nodeId).isTrigger = true;
 		EntityManager::GetInstance().Get<Collider>(nodeId).collisionLayerIndex = 9;
-		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).SetActive(false);
 		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).toSave = false;
 
 		m_scriptData[id].pathQuads.emplace_back(nodeId);
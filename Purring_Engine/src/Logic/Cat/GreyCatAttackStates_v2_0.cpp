@@ -64,7 +64,7 @@ namespace PE
 			//EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).parent = id; // telegraph follows the cat entity
 			Hierarchy::GetInstance().AttachChild(telegraphParentID, telegraphID); // new way of attatching parent child
 			telegraphTransform.relPosition.Zero();
-			EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).isActive = false; // telegraph to not show until attack planning
+			EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).SetActive(false); // telegraph to not show until attack planning
 			EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).toSave = false; // telegraph to not show until attack planning
 
 
@@ -119,7 +119,7 @@ namespace PE
 								}
 								else
 								{
-									EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).isActive = false;
+									EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).SetActive(false);
 								}
 							}
 							break;
@@ -410,7 +410,7 @@ namespace PE
 						int damage = (GameStateManager::GetInstance().godMode) ? (p_data->attackDamage * 2) : p_data->attackDamage;
 						GETSCRIPTINSTANCEPOINTER(RatScript)->LoseHP(collidedEntities.second, damage);
 					}catch(...){}
-					EntityManager::GetInstance().Get<EntityDescriptor>(p_data->projectileID).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(p_data->projectileID).SetActive(false);
 					m_bulletCollided = true;
 					return;
 				}
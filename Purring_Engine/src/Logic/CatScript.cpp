@@ -384,7 +384,7 @@ namespace PE
 			if (!EntityManager::GetInstance().IsEntityValid(id)) { return; }
 
 		// Toggle the entity
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 	}
 
 
@@ -493,7 +493,7 @@ namespace PE
 		//EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).parent = id; // telegraph follows the cat entity
 		Hierarchy::GetInstance().AttachChild(id, telegraphID); // new way of attatching parent child
 		telegraphTransform.relPosition.Zero();
-		EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).isActive = false; // telegraph to not show until attack planning
+		EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).SetActive(false); // telegraph to not show until attack planning
 		EntityManager::GetInstance().Get<EntityDescriptor>(telegraphID).toSave = false; // telegraph to not show until attack planning
 		
 
@@ -532,7 +532,7 @@ namespace PE
 	{
 			// Creates an entity for the projectile
 			m_scriptData[id].projectileID = ResourceManager::GetInstance().LoadPrefabFromFile("Projectile.prefab");
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].projectileID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].projectileID).SetActive(false);
 	}
 
 
@@ -546,7 +546,7 @@ namespace PE
 		EntityManager::GetInstance().Get<Transform>(nodeId).width = m_scriptData[id].nodeSize;
 		EntityManager::GetInstance().Get<Transform>(nodeId).height = m_scriptData[id].nodeSize;
 				
-		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).SetActive(false);
 		EntityManager::GetInstance().Get<EntityDescriptor>(nodeId).toSave = false;
 
 		m_scriptData[id].pathQuads.emplace_back(nodeId);
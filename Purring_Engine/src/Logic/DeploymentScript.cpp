@@ -45,7 +45,7 @@ namespace PE
 				EntityManager::GetInstance().Get<Graphics::Renderer>(m_scriptData[id].DeploymentArea).SetColor(1, 1, 1, 0);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].FollowingTextureObject))
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).SetActive(false);
 
 				m_gameStateController->StartGameLoop();
 				m_catController->UpdateCurrentCats(m_catController->mainInstance);
@@ -58,7 +58,7 @@ namespace PE
 				EntityManager::GetInstance().Get<Graphics::Renderer>(m_scriptData[id].DeploymentArea).SetColor(1,1, 1, 0);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].FollowingTextureObject))
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).SetActive(false);
 
 			m_inNoGoArea = true;
 
@@ -69,7 +69,7 @@ namespace PE
 			EntityManager::GetInstance().Get<Graphics::Renderer>(m_scriptData[id].DeploymentArea).SetColor(1,1,1,1);
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].FollowingTextureObject))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].FollowingTextureObject).SetActive(true);
 
 		GetMouseCurrentPosition(m_mousepos);
 
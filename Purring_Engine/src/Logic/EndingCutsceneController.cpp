@@ -234,10 +234,10 @@ namespace PE
 		//	EntityManager::GetInstance().Get<TextComponent>(m_scriptData[id].Text).SetText("Next");
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].ContinueButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].ContinueButton).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].ContinueButton).SetActive(true);
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].SkipButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SkipButton).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SkipButton).SetActive(false);
 	}
 
 	void EndingCutsceneController::StartCutscene(EntityID id)
@@ -258,7 +258,7 @@ namespace PE
 			return;
 
 		//set active the current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(true);
 
 		//set active the childrens if there are any
 		for (auto id2 : EntityManager::GetInstance().Get<EntityDescriptor>(id).children)
@@ -279,12 +279,12 @@ namespace PE
 				if (!EntityManager::GetInstance().Has<EntityDescriptor>(id3))
 					break;
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(id3).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id3).SetActive(true);
 			}
 			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 				break;
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 		}
 	}
 
@@ -297,14 +297,14 @@ namespace PE
 				if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 					break;
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 
 		if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
 			return;
 
 		//deactive current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(false);
 	}
 
 	
@@ -318,10 +318,10 @@ namespace PE
 		GETSCRIPTINSTANCEPOINTER(GameStateController_v2_0)->currentState = GameStates_v2_0::WIN;
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].ContinueButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].ContinueButton).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].ContinueButton).SetActive(false);
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].SkipButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].SkipButton).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[m_currentCutsceneObject].SkipButton).SetActive(false);
 
 		m_hasStoppedCutscene = true;
 
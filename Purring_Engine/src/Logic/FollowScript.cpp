@@ -96,7 +96,7 @@ namespace PE
 				for (int i = cd->catHealth; i < m_ScriptData[id].NumberOfFollower; ++i)
 				{
 					if(EntityManager::GetInstance().Has<EntityDescriptor>(m_ScriptData[id].FollowingObject[i]))
-						EntityManager::GetInstance().Get<EntityDescriptor>(m_ScriptData[id].FollowingObject[i]).isActive = false;
+						EntityManager::GetInstance().Get<EntityDescriptor>(m_ScriptData[id].FollowingObject[i]).SetActive(false);
 					m_ScriptData[id].NumberOfFollower--;
 					CatScript::SetMaximumEnergyLevel(CatScript::GetBaseMaximumEnergyLevel() + (m_ScriptData[id].NumberOfFollower - 1) * 2);
 				}
@@ -31,7 +31,7 @@ namespace PE
 	{
 		m_currentEntityID = id;
 		if(EntityManager::GetInstance().Has<EntityDescriptor>(m_currentEntityID))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).SetActive(false);
 		m_keyPressedKey = ADD_KEY_EVENT_LISTENER(PE::KeyEvents::KeyTriggered, FpsScript::OnKeyEvent, this)
 	}
 
@@ -79,7 +79,7 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_currentEntityID))
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).isActive = !EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).isActive;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).SetActive(!EntityManager::GetInstance().Get<EntityDescriptor>(m_currentEntityID).isActive);
 			}
 		}
 	}
@@ -387,7 +387,7 @@ namespace PE
 	{
 			if (EntityManager::GetInstance().Has(id, EntityManager::GetInstance().GetComponentID<EntityDescriptor>()))
 			{
-					EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = enable;
+					EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(enable);
 					return true;
 			}
 
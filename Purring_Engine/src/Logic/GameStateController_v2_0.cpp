@@ -169,14 +169,14 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).GodModeText))
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).GodModeText).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).GodModeText).SetActive(true);
 			}
 		}
 		else
 		{
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).GodModeText))
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).GodModeText).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).GodModeText).SetActive(false);
 			}
 
 		}
@@ -290,7 +290,7 @@ namespace PE
 				{
 					if (EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 					{
-						EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+						EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 					}
 					continue;
 				}
@@ -299,7 +299,7 @@ namespace PE
 				{
 					if (EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 					{
-						EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+						EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 					}
 					continue;
 				}
@@ -308,7 +308,7 @@ namespace PE
 				{
 					if (EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 					{
-						EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+						EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 					}
 					continue;
 				}
@@ -869,7 +869,7 @@ namespace PE
 			return;
 
 		//set active the current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(true);
 
 		//set active the childrens if there are any
 		for (auto id2 : EntityManager::GetInstance().Get<EntityDescriptor>(id).children)
@@ -890,12 +890,12 @@ namespace PE
 				if (!EntityManager::GetInstance().Has<EntityDescriptor>(id3))
 					break;
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(id3).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id3).SetActive(true);
 			}
 			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 				break;
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 		}
 	}
 
@@ -909,14 +909,14 @@ namespace PE
 			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 				break;
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 		}
 
 		if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
 			return;
 
 		//deactive current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(false);
 	}
 
 	void GameStateController_v2_0::FadeAllObject(EntityID id, float const alpha)
@@ -1030,7 +1030,7 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 		}
 		PlayClickAudio();
@@ -1045,11 +1045,11 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 			}
 			else if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg2")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 		}
 		PlayClickAudio();
@@ -1065,11 +1065,11 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 			else if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg2")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 			}
 		}
 		PlayClickAudio();
@@ -202,10 +202,10 @@ namespace PE
 		//	EntityManager::GetInstance().Get<TextComponent>(m_scriptData[id].Text).SetText("Continue");
 
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].ContinueButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].ContinueButton).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].ContinueButton).SetActive(true);
 				
 		if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData[id].SkipButton))
-			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SkipButton).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SkipButton).SetActive(false);
 
 
 	}
@@ -28,6 +28,7 @@
 #include "ECS/Components.h"
 #include "ECS/Prefabs.h"
 #include "ECS/SceneView.h"
+#include "Time/Profiler.h"
 #include "testScript.h"
 #include "testScript2.h"
 #include "EnemyTestScript.h"
@@ -82,6 +83,10 @@ PE::LogicSystem::LogicSystem()
 	//m_createScriptObjectQueue.resize(100);
 	//m_newScriptObjectQueue.reserve(100);
 	//m_newScriptObjectQueue.resize(100);
+
+	// Cap the time the scripts (mostly the rat perception and AI) take per frame, so a long
+	// frame is caught up with fewer, longer logic steps instead of spiralling
+	SetFrameBudget(1.f / 120.f);
 }
 	
 PE::LogicSystem::~LogicSystem()
@@ -137,6 +142,8 @@ void PE::LogicSystem::UpdateSystem(float deltaTime)
 		//ClearCreatedList();
 		CreateQueuedObjects();
 
+		PE_PROFILE_SCOPE("Scripts");
+
 		for (EntityID objectID : SceneView<ScriptComponent>())
 		{
 			if (!EntityManager::GetInstance().Get<EntityDescriptor>(objectID).isActive || !EntityManager::GetInstance().Get<EntityDescriptor>(objectID).isAlive)
@@ -145,19 +152,22 @@ void PE::LogicSystem::UpdateSystem(float deltaTime)
 			ScriptComponent& sc = EntityManager::GetInstance().Get<ScriptComponent>(objectID);
 			for (auto& [key, state] : sc.m_scriptKeys)
 			{
-				if (m_scriptContainer.find(key) != m_scriptContainer.end())
+				auto scriptIt{ m_scriptContainer.find(key) };
+				if (scriptIt != m_scriptContainer.end())
 				{
+					// the keys of the script container live as long as the engine
+					PE_PROFILE_SCOPE(scriptIt->first.c_str());
 					switch (state)
 					{
 					case ScriptState::INIT:
-						m_scriptContainer.find(key)->second->Init(objectID);
+						scriptIt->second->Init(objectID);
 						state = ScriptState::UPDATE;
 						break;
 					case ScriptState::UPDATE:
-						m_scriptContainer.find(key)->second->Update(objectID, deltaTime);
+						scriptIt->second->Update(objectID, deltaTime);
 						break;
 					case ScriptState::EXIT:
-						m_scriptContainer.find(key)->second->Destroy(objectID);
+						scriptIt->second->Destroy(objectID);
 						state = ScriptState::DEAD;
 						break;
 					}
@@ -199,7 +199,7 @@ namespace PE
 			return;
 
 		//set active the current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = true;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(true);
 
 		//set active the childrens if there are any
 		for (auto id2 : EntityManager::GetInstance().Get<EntityDescriptor>(id).children)
@@ -220,12 +220,12 @@ namespace PE
 				if (!EntityManager::GetInstance().Has<EntityDescriptor>(id3))
 					break;
 
-				EntityManager::GetInstance().Get<EntityDescriptor>(id3).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id3).SetActive(true);
 			}
 			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 				break;
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 		}
 	}
 
@@ -238,14 +238,14 @@ namespace PE
 			if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 				break;
 
-			EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+			EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 		}
 
 		if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
 			return;
 
 		//deactive current object
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = false;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(false);
 	}
 
 	void MainMenuController::SplashScreenFade(EntityID const id, float deltaTime)
@@ -275,7 +275,7 @@ namespace PE
 			if (fadeInSpeed >= 1)
 			{
 				DeactiveObject(EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SplashScreen).parent.value());
-				EntityManager::GetInstance().Get<EntityDescriptor>(EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SplashScreen).parent.value()).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData[id].SplashScreen).parent.value()).SetActive(false);
 
 				EntityID bgm = ResourceManager::GetInstance().LoadPrefabFromFile("AudioObject/Menu Background Music.prefab");
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(bgm))
@@ -386,7 +386,7 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 		}
 		PlayClickAudio();
@@ -401,11 +401,11 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 			}
 			else if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg2")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 		}
 		PlayClickAudio();
@@ -420,11 +420,11 @@ namespace PE
 		{
 			if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg1")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 			}
 			else if (EntityManager::GetInstance().Get<EntityDescriptor>(id2).name == "pg2")
 			{
-				EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = true;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(true);
 			}
 		}
 		PlayClickAudio();
@@ -111,7 +111,7 @@ namespace PE
 
 			// Pick the closest cat to move 
 			// ASSUMPTION: container of cats in detection radius has at least 1 element. 
-			EntityID closestCat{ RatScript_v2_0::GetCloserTarget(RatScript_v2_0::GetEntityPosition(p_data->myID), p_data->catsInDetectionRadius) };
+			EntityID closestCat{ GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->GetClosestDetectedCat(p_data->myID) };
 
 			// Set the position for the rat to move to
 			GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->SetTarget(p_data->myID, closestCat, false);
@@ -45,7 +45,6 @@ namespace PE
         m_collisionEnterEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnCollisionEnter, RatAttack_v2_0::OnCollisionEnter, this);
         m_triggerEnterEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerEnter, RatAttack_v2_0::OnTriggerEnterAndStay, this);
         m_triggerStayEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerStay, RatAttack_v2_0::OnTriggerEnterAndStay, this);
-        m_triggerExitEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerExit, RatAttack_v2_0::OnTriggerExit, this);
 
         // Reset variables
         m_delay = 0.1f;
@@ -100,7 +99,6 @@ namespace PE
         REMOVE_KEY_COLLISION_LISTENER(m_triggerEnterEventListener);
         REMOVE_KEY_COLLISION_LISTENER(m_collisionEnterEventListener);
         REMOVE_KEY_COLLISION_LISTENER(m_triggerStayEventListener);
-        REMOVE_KEY_COLLISION_LISTENER(m_triggerExitEventListener);
     }
 
     void RatAttack_v2_0::StateExit(EntityID id)
@@ -188,10 +186,10 @@ namespace PE
         if (r_TE.GetType() == CollisionEvents::OnTriggerEnter)
         {
             OnTriggerEnterEvent OTEE = dynamic_cast<OnTriggerEnterEvent const&>(r_TE);
-            // check if a cat has entered the rat's detection collider
-            bool inDetectionRadius{ GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerEntered(p_data->myID, OTEE.Entity1, OTEE.Entity2) };
+            // the detection collider is handled by the detection query, ignore its trigger events
+            bool isDetectionCollider{ OTEE.Entity1 == p_data->detectionRadiusId || OTEE.Entity2 == p_data->detectionRadiusId };
             
-            if (!inDetectionRadius && p_data->attacking && p_data->p_attackData) // Currently attacking 
+            if (!isDetectionCollider && p_data->attacking && p_data->p_attackData) // Currently attacking 
             {
                 p_data->p_attackData->OnCollisionEnter(OTEE.Entity1, OTEE.Entity2);
             } // end of if (p_data->attacking)
@@ -199,24 +197,14 @@ namespace PE
         else if (r_TE.GetType() == CollisionEvents::OnTriggerStay)
         {
             OnTriggerStayEvent OTSE = dynamic_cast<OnTriggerStayEvent const&>(r_TE);
-            // check if a cat has entered the rat's detection collider
-            bool inDetectionRadius{ GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerEntered(p_data->myID, OTSE.Entity1, OTSE.Entity2) };
+            // the detection collider is handled by the detection query, ignore its trigger events
+            bool isDetectionCollider{ OTSE.Entity1 == p_data->detectionRadiusId || OTSE.Entity2 == p_data->detectionRadiusId };
 
-            if (!inDetectionRadius && p_data->attacking && p_data->p_attackData) // Currently attacking 
+            if (!isDetectionCollider && p_data->attacking && p_data->p_attackData) // Currently attacking 
             {
                 p_data->p_attackData->OnCollisionEnter(OTSE.Entity1, OTSE.Entity2);
             } // end of if (p_data->attacking)
         } // end of if (r_TE.GetType() == CollisionEvents::OnTriggerStay)
     }
 
-
-    void RatAttack_v2_0::OnTriggerExit(const Event<CollisionEvents>& r_TE)
-    {
-        if (!p_data) { return; }
-        else if (gameStateController && gameStateController->currentState != GameStates_v2_0::EXECUTE) { return; }
-
-        OnTriggerExitEvent OTEE = dynamic_cast<OnTriggerExitEvent const&>(r_TE);
-        // check if a cat has exited the rat's detection collider
-        GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerExited(p_data->myID, OTEE.Entity1, OTEE.Entity2);
-    }
 } // namespace PE
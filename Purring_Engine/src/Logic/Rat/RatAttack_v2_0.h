@@ -81,22 +81,13 @@ namespace PE
 
         /*!***********************************************************************************
          \brief Called when a trigger enter or stay event has occured. If an event has
-          occurred between this script's rat's detection collider or attack collider and a cat, 
+          occurred between this script's rat's attack collider and a cat, 
           the parent rat is notified.
 
          \param[in,out] r_TE - Trigger event data.
         *************************************************************************************/
         void OnTriggerEnterAndStay(const Event<CollisionEvents>& r_TE);
 
-        /*!***********************************************************************************
-         \brief Called when a trigger exit event has occured. If an event has occurred
-          between this script's rat's detection collider and a cat, the parent rat
-          is notified.
-
-         \param[in,out] r_TE - Trigger event data.
-        *************************************************************************************/
-        void OnTriggerExit(const Event<CollisionEvents>& r_TE);
-
         /*!***********************************************************************************
             \brief Returns the name of the state, useful for debugging and logging.
 
@@ -116,7 +107,7 @@ namespace PE
 
         // Event listener IDs 
         int m_collisionEnterEventListener{}, m_collisionExitEventListener{};
-        int m_triggerEnterEventListener{}, m_triggerStayEventListener{}, m_triggerExitEventListener{};
+        int m_triggerEnterEventListener{}, m_triggerStayEventListener{};
 
         // ----- PRIVATE METHODS ----- //
     private:
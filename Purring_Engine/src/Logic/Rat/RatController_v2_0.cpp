@@ -150,7 +150,7 @@ namespace PE
 			if(EntityManager::GetInstance().Has<EntityDescriptor>(id))
 			{
 				// Toggle the entity
-				EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 			}
 		}
 
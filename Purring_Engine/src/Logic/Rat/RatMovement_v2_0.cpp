@@ -51,10 +51,6 @@ namespace PE
         m_collisionEnterEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnCollisionEnter, RatMovement_v2_0::OnCollisionEnterOrStay, this);
         m_collisionStayEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnCollisionStay, RatMovement_v2_0::OnCollisionEnterOrStay, this);
         m_collisionExitEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnCollisionExit, RatMovement_v2_0::OnCollisionExit, this);
-        
-        m_triggerEnterEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerEnter, RatMovement_v2_0::OnTriggerEnterAndStay, this);
-        m_triggerStayEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerStay, RatMovement_v2_0::OnTriggerEnterAndStay, this);
-        m_triggerExitEventListener = ADD_COLLISION_EVENT_LISTENER(CollisionEvents::OnTriggerExit, RatMovement_v2_0::OnTriggerExit, this);
     }
 
     void RatMovement_v2_0::StateUpdate(EntityID id, float deltaTime)
@@ -149,10 +145,6 @@ namespace PE
         REMOVE_KEY_COLLISION_LISTENER(m_collisionEnterEventListener);
         REMOVE_KEY_COLLISION_LISTENER(m_collisionStayEventListener);
         REMOVE_KEY_COLLISION_LISTENER(m_collisionExitEventListener);
-
-        REMOVE_KEY_COLLISION_LISTENER(m_triggerEnterEventListener);
-        REMOVE_KEY_COLLISION_LISTENER(m_triggerStayEventListener);
-        REMOVE_KEY_COLLISION_LISTENER(m_triggerExitEventListener);
     }
 
     void RatMovement_v2_0::StateExit(EntityID id)
@@ -210,35 +202,6 @@ namespace PE
         }
     }
 
-    void RatMovement_v2_0::OnTriggerEnterAndStay(const Event<CollisionEvents>& r_TE)
-    {
-        if (!p_data) { return; }
-        else if (gameStateController && gameStateController->currentState != GameStates_v2_0::EXECUTE) { return; }
-
-        if (r_TE.GetType() == CollisionEvents::OnTriggerEnter)
-        {
-            OnTriggerEnterEvent OTEE = dynamic_cast<OnTriggerEnterEvent const&>(r_TE);
-            // check if a cat has entered the rat's detection collider
-            GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerEntered(p_data->myID, OTEE.Entity1, OTEE.Entity2);
-        }
-        else if (r_TE.GetType() == CollisionEvents::OnTriggerStay)
-        {
-            OnTriggerStayEvent OTSE = dynamic_cast<OnTriggerStayEvent const&>(r_TE);
-            // check if a cat has entered the rat's detection collider
-            GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerEntered(p_data->myID, OTSE.Entity1, OTSE.Entity2);
-        }
-    }
-
-
-    void RatMovement_v2_0::OnTriggerExit(const Event<CollisionEvents>& r_TE)
-    {
-        if (!p_data) { return; }
-        else if (gameStateController && gameStateController->currentState != GameStates_v2_0::EXECUTE) { return; }
-
-        OnTriggerExitEvent OTEE = dynamic_cast<OnTriggerExitEvent const&>(r_TE);
-        // check if a cat has exited the rat's detection collider
-        GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CheckDetectionTriggerExited(p_data->myID, OTEE.Entity1, OTEE.Entity2);
-    }
 
 
     vec2 RatMovement_v2_0::PickTargetPosition()
@@ -97,22 +97,6 @@ namespace PE
         *************************************************************************************/
         void OnCollisionExit(const Event<CollisionEvents>& r_event);
 
-        /*!***********************************************************************************
-            \brief Called when a trigger enter or stay event has occurred
-
-            \param[in,out] r_TE - Trigger event data
-        *************************************************************************************/
-        void OnTriggerEnterAndStay(const Event<CollisionEvents>& r_TE);
-
-        /*!***********************************************************************************
-         \brief Called when a trigger exit event has occured. If an event has occurred
-          between this script's rat's detection collider and a cat, the parent rat
-          is notified.
-
-         \param[in,out] r_TE - Trigger event data.
-        *************************************************************************************/
-        void OnTriggerExit(const Event<CollisionEvents>& r_TE);
-
         /*!***********************************************************************************
             \brief Returns the name of this state
 
@@ -135,7 +119,6 @@ namespace PE
 
         // ID of the event listener for collision events, used to register and unregister the rat for collision notifications
         int m_collisionEnterEventListener{}, m_collisionStayEventListener{}, m_collisionExitEventListener{};
-        int m_triggerEnterEventListener{}, m_triggerStayEventListener{}, m_triggerExitEventListener{};
 
         bool m_planningRunOnce{}; // True if the planning phase has been run once
 
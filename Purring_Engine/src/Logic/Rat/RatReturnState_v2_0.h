@@ -67,7 +67,6 @@ namespace PE
 
 		// Event listener IDs 
 		int m_collisionEnterEventListener{}, m_collisionStayEventListener{}, m_collisionExitEventListener{};
-		int m_triggerEnterEventListener{}, m_triggerStayEventListener{}, m_triggerExitEventListener{};
 
 	private:
 		/*!***********************************************************************************
@@ -106,23 +105,5 @@ namespace PE
 		 \param[in] r_event - Event data.
 		*************************************************************************************/
 		void OnCollisionExit(const Event<CollisionEvents>& r_event);
-
-		/*!***********************************************************************************
-		 \brief Called when a trigger enter or stay event has occured. If an event has
-			occurred between this script's rat's detection collider and a cat, the parent rat
-			is notified.
-
-		 \param[in,out] r_TE - Trigger event data.
-		*************************************************************************************/
-		void OnTriggerEnterAndStay(const Event<CollisionEvents>& r_TE);
-
-		/*!***********************************************************************************
-		 \brief Called when a trigger exit event has occured. If an event has occurred
-			between this script's rat's detection collider and a cat, the parent rat
-			is notified.
-
-		 \param[in,out] r_TE - Trigger event data.
-		*************************************************************************************/
-		void OnTriggerExit(const Event<CollisionEvents>& r_TE);
 	};
 } // End of namespace PE
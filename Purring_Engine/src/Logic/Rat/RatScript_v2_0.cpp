@@ -18,6 +18,8 @@
 
 #include "../Physics/RigidBody.h"
 #include "../Physics/Colliders.h"
+#include "../Physics/CollisionManager.h"
+#include "System.h" // GETCOLLISIONMANAGER()
 #include "../Data/SerializationManager.h"
 #include "../Hierarchy/HierarchyManager.h"
 #include "../ResourceManager/ResourceManager.h"
@@ -120,6 +122,12 @@ namespace PE
 
 				ToggleEntity(m_scriptData.at(id).ratWalkParticles, false);
 			}
+			// Track the cats in the detection radius during the execution phase
+			if (gameStateController->currentState == GameStates_v2_0::EXECUTE && it->second.isAlive)
+			{
+				UpdateDetectionSlice();
+			}
+
 			// Update the rat state
 			CreateCheckStateManager(id);
 			it->second.p_stateManager->Update(id, deltaTime);
@@ -213,7 +221,7 @@ namespace PE
 
 			// Toggle the entity
 			if(EntityManager::GetInstance().Has<EntityDescriptor>(id))
-				EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+				EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 		}
 
 		void RatScript_v2_0::PositionEntity(EntityID const transformId, vec2 const& r_position)
@@ -829,45 +837,95 @@ namespace PE
 		}
 
 
-		bool RatScript_v2_0::CheckDetectionTriggerEntered(EntityID const ratId, EntityID const entity1, EntityID const entity2)
+		void RatScript_v2_0::UpdateDetectionSlice()
 		{
-				auto it = m_scriptData.find(ratId);
-				if (it == m_scriptData.end()) { return false; }
+				// The first rat updated in a step runs the slice for all of them
+				unsigned long long const fixedStep{ TimeManager::GetInstance().GetFixedStepCount() };
+				if (m_lastDetectionStep == fixedStep) { return; }
+				m_lastDetectionStep = fixedStep;
 
-				// check if entity1 is the rat's detection collider and entity2 is cat
-				if ((entity1 == it->second.detectionRadiusId) && RatScript_v2_0::GetIsNonCagedCat(entity2))
+				m_detectionQueue.clear();
+				for (auto const& [ratId, data] : m_scriptData)
 				{
-						GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CatEntered(it->second.myID, entity2);
-						return true;
-				}
-				// check if entity2 is the rat's detection collider and entity1 is cat
-				else if ((entity2 == it->second.detectionRadiusId) && RatScript_v2_0::GetIsNonCagedCat(entity1))
-				{
-						GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CatEntered(it->second.myID, entity1);
-						return true;
+						if (data.isAlive && EntityManager::GetInstance().Get<EntityDescriptor>(ratId).isActive)
+						{
+								m_detectionQueue.emplace_back(ratId);
+						}
 				}
-				return false;
+
+				m_detectionSlicer.Run(m_detectionQueue, [this](EntityID const ratId) { UpdateDetection(ratId); });
 		}
 
 
-		bool RatScript_v2_0::CheckDetectionTriggerExited(EntityID const ratId, EntityID const entity1, EntityID const entity2)
+		void RatScript_v2_0::UpdateDetection(EntityID const id)
 		{
-				auto it = m_scriptData.find(ratId);
-				if (it == m_scriptData.end()) { return false; }
+				auto it = m_scriptData.find(id);
+				if (it == m_scriptData.end()) { return; }
 
-				// check if entity1 is the rat's detection collider and entity2 is cat
-				if ((entity1 == it->second.detectionRadiusId) && RatScript_v2_0::GetIsNonCagedCat(entity2))
+				// The detection collider is only used for its shape, the collision manager keeps it up to date
+				EntityID const radiusId{ it->second.detectionRadiusId };
+				if (!EntityManager::GetInstance().Has<Collider>(radiusId) || !EntityManager::GetInstance().Get<EntityDescriptor>(radiusId).isActive) { return; }
+				Collider const& detectionCollider{ EntityManager::GetInstance().Get<Collider>(radiusId) };
+				if (!std::holds_alternative<CircleCollider>(detectionCollider.colliderVariant)) { return; }
+				CircleCollider const& detectionCircle{ std::get<CircleCollider>(detectionCollider.colliderVariant) };
+
+				// Find the non-caged cats in the radius, filtering in the query so other colliders do not fill up the buffer
+				std::array<EntityID, maxDetectedColliders> overlapping{};
+				size_t const overlapCount{ GETCOLLISIONMANAGER()->OverlapCircle(detectionCircle.center, detectionCircle.radius, overlapping,
+						CollisionManager::GetInteractingLayerMask(detectionCollider.collisionLayerIndex), true, &GetIsNonCagedCat) };
+				auto const overlappingEnd{ overlapping.begin() + overlapCount };
+
+				// A full buffer may have cut off cats that are still in the radius, so only cats that
+				// are no longer valid targets count as having exited in that case
+				bool const overlapComplete{ overlapCount < overlapping.size() };
+
+				// Cats that are no longer overlapping have exited the radius
+				std::array<EntityID, maxDetectedColliders> exitedCats{};
+				size_t exitedCount{ 0 };
+				for (EntityID const catID : it->second.catsInDetectionRadius)
 				{
-						GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CatExited(ratId, entity2);
-						return true;
+						bool const exited{ overlapComplete ? std::find(overlapping.begin(), overlappingEnd, catID) == overlappingEnd
+								: !GetIsNonCagedCat(catID) };
+						if (exitedCount < exitedCats.size() && exited)
+						{
+								exitedCats[exitedCount++] = catID;
+						}
 				}
-				// check if entity2 is the rat's detection collider and entity1 is cat
-				else if ((entity2 == it->second.detectionRadiusId) && RatScript_v2_0::GetIsNonCagedCat(entity1))
+				for (size_t i{ 0 }; i < exitedCount; ++i)
 				{
-						GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->CatExited(ratId, entity1);
-						return true;
+						CatExited(id, exitedCats[i]);
 				}
-				return false;
+
+				// Non-caged cats that are overlapping are in the radius
+				for (auto overlapIt{ overlapping.begin() }; overlapIt != overlappingEnd; ++overlapIt)
+				{
+						CatEntered(id, *overlapIt);
+				}
+		}
+
+
+		EntityID RatScript_v2_0::GetClosestDetectedCat(EntityID const id)
+		{
+				auto it = m_scriptData.find(id);
+				if (it == m_scriptData.end()) { return 0; }
+
+				EntityID const radiusId{ it->second.detectionRadiusId };
+				if (EntityManager::GetInstance().Has<Collider>(radiusId) && 
+						std::holds_alternative<CircleCollider>(EntityManager::GetInstance().Get<Collider>(radiusId).colliderVariant))
+				{
+						Collider const& detectionCollider{ EntityManager::GetInstance().Get<Collider>(radiusId) };
+						CircleCollider const& detectionCircle{ std::get<CircleCollider>(detectionCollider.colliderVariant) };
+
+						// Only non-caged cats are found and they come back sorted by distance, so the first is the closest
+						NearestHit nearest[1]{};
+						if (GETCOLLISIONMANAGER()->NearestK(detectionCircle.center, detectionCircle.radius, nearest,
+								CollisionManager::GetInteractingLayerMask(detectionCollider.collisionLayerIndex), true, &GetIsNonCagedCat))
+						{
+								return nearest[0].entity;
+						}
+				}
+
+				return GetCloserTarget(GetEntityPosition(id), it->second.catsInDetectionRadius);
 		}
 
 
@@ -24,6 +24,7 @@
 #include "../Math/MathCustom.h"
 #include "../Events/EventHandler.h"
 #include "../GameStateController_v2_0.h"
+#include "../Time/TimeSlicer.h"
 
 namespace PE
 {	
@@ -35,6 +36,7 @@ namespace PE
 		std::map<EntityID, RatScript_v2_0_Data> m_scriptData;
 
 		static const inline int detectionColliderLayer{ 5 };
+		static const inline size_t maxDetectedColliders{ 32 }; // max number of colliders a detection query can return
 
 		// ----- Constructors ----- //
 	public:
@@ -476,30 +478,30 @@ namespace PE
 		void CatExited(EntityID const id, EntityID const catID);
 
 		/*!***********************************************************************************
-		\brief Checks if the collision event involved the rat's detection radius and a cat,
-				calls the CatEntered() function if true.
+		\brief Queries the colliders overlapping the rat's detection radius, calls CatEntered()
+				for every non-caged cat inside it and CatExited() for every detected cat that
+				is no longer inside it.
 
-		\param[in] ratId - EntityID of the rat to check the detection radius of.
-		\param entity1 - One of the entities involved in the trigger event.
-		\param entity2 - One of the entities involved in the trigger event.
-
-		\return Returns true if the collision involved the rat's detection radius and a cat,
-				false otherwise.
+		\param[in] id - EntityID of the rat to update the detection of.
 		*************************************************************************************/
-		bool CheckDetectionTriggerEntered(EntityID const ratId, EntityID const entity1, EntityID const entity2);
+		void UpdateDetection(EntityID const id);
 
 		/*!***********************************************************************************
-		\brief Checks if the collision event involved the rat's detection radius and a cat,
-				calls the CatExited() function if true.
+		\brief Updates the detection of the next slice of living rats, picking up from the rat
+				after the last one updated. Only runs once per fixed step no matter how many
+				rats call it, and stops once the detection time budget for the step is spent.
+		*************************************************************************************/
+		void UpdateDetectionSlice();
 
-		\param[in] ratId - EntityID of the rat to check the detection radius of.
-		\param entity1 - One of the entities involved in the trigger event.
-		\param entity2 - One of the entities involved in the trigger event.
+		/*!***********************************************************************************
+		\brief Returns the ID of the non-caged cat closest to the rat within its detection
+				radius, using the scene query of the collision manager.
 
-		\return Returns true if the collision involved the rat's detection radius and a cat,
-				false otherwise.
+		\param[in] id - EntityID of the rat.
+		\return EntityID - ID of the closest cat, falls back to the closest cat in
+				catsInDetectionRadius if the query finds none.
 		*************************************************************************************/
-		bool CheckDetectionTriggerExited(EntityID const ratId, EntityID const entity1, EntityID const entity2);
+		EntityID GetClosestDetectedCat(EntityID const id);
 
 		/*!***********************************************************************************
 		\brief Checks if the collision event involves the rat's collider and a cat,
@@ -649,6 +651,9 @@ namespace PE
 			GameStates_v2_0 previousGameState; // The game state in the previous frame
 			float timeSinceLastSFX{ 0.f }; // Time in seconds since the last rat SFX was played
 			float SFXcooldown{ 0.25f }; // Time in seconds before the next SFX can be played
+			TimeSlicer m_detectionSlicer{ 0.0005f }; // Spreads the detection queries of the rats over steps when there are too many for one
+			std::vector<EntityID> m_detectionQueue; // IDs of the rats whose detection is updated by the slicer
+			unsigned long long m_lastDetectionStep{ std::numeric_limits<unsigned long long>::max() }; // Fixed step count the last detection slice ran in
 
 		// ----- Private Methods ----- // 
 	private:
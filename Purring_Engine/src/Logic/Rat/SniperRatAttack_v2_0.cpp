@@ -132,7 +132,7 @@ namespace PE
 		// Pick the closest cat to move 
 		// ASSUMPTION: container of cats in detection radius has at least 1 element. 
 		vec2 ratPosition{ RatScript_v2_0::GetEntityPosition(p_data->myID) };
-		EntityID closestCat{ RatScript_v2_0::GetCloserTarget(ratPosition, p_data->catsInDetectionRadius) };
+		EntityID closestCat{ GETSCRIPTINSTANCEPOINTER(RatScript_v2_0)->GetClosestDetectedCat(p_data->myID) };
 
 
 		// Set the shot target position
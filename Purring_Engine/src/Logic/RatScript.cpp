@@ -313,7 +313,7 @@ namespace PE
 		if (!EntityManager::GetInstance().IsEntityValid(id)) { return; }
 
 		// Toggle the entity
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 	}
 
 
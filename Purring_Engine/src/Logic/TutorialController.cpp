@@ -50,54 +50,54 @@ namespace PE
 			if (p_gsc->currentTurn == 0)
 			{
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).isActive = true;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).SetActive(true);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).SetActive(false);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).SetActive(false);
 			}
 			else if (p_gsc->currentTurn == 1)
 			{
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).isActive = true;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).SetActive(true);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).SetActive(false);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).SetActive(false);
 			}
 			else if (p_gsc->currentTurn >= 5)
 			{
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).isActive = true;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).SetActive(true);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).SetActive(false);
 
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).isActive = false;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).SetActive(false);
 			}
 
 			if (p_rc->GetRats(p_rc->mainInstance).empty())
 			{
 				if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3))
-					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).isActive = true;
+					EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).SetActive(true);
 			}
 
 		}
 		else
 		{
 			if(EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1))
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel1).SetActive(false);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2))
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel2).SetActive(false);
 
 			if (EntityManager::GetInstance().Has<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3))
-				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).isActive = false;
+				EntityManager::GetInstance().Get<EntityDescriptor>(m_scriptData.at(id).TutorialPanel3).SetActive(false);
 		}
 
 
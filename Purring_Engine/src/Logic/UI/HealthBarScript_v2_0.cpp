@@ -59,14 +59,14 @@ namespace PE
 								if (!EntityManager::GetInstance().Has<EntityDescriptor>(id2))
 										break;
 
-								EntityManager::GetInstance().Get<EntityDescriptor>(id2).isActive = false;
+								EntityManager::GetInstance().Get<EntityDescriptor>(id2).SetActive(false);
 						}
 
 						if (!EntityManager::GetInstance().Has<EntityDescriptor>(id))
 								return;
 
 						//deactive current object
-						EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = false;
+						EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(false);
 				}
 
 				SetFillAmount(id, (currentHealth <= 0.f || maxHealth == 0.f) ? 0.f : currentHealth / maxHealth);
@@ -166,7 +166,7 @@ namespace PE
 		}
 
 		// Toggle the entity
-		EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive = setToActive;
+		EntityManager::GetInstance().Get<EntityDescriptor>(id).SetActive(setToActive);
 	}
 
 	void HealthBarScript_v2_0::PositionEntity(EntityID const transformId, vec2 const &r_position)
@@ -0,0 +1,198 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     AllocationTracker.cpp
+ \date     27-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	cpp file containing the definitions of the AllocationTracker and, when built with
+	PE_TRACK_ALLOCATIONS, the global operator new and delete that report to it
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#include "prpch.h"
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace PE
+{
+	std::atomic<bool> AllocationTracker::s_enabled{ false };
+	std::array<std::atomic<unsigned long long>, AllocationTracker::CategoryCount> AllocationTracker::s_allocations{};
+	std::array<std::atomic<unsigned long long>, AllocationTracker::CategoryCount> AllocationTracker::s_frees{};
+	std::array<std::atomic<unsigned long long>, AllocationTracker::CategoryCount> AllocationTracker::s_bytesAllocated{};
+	std::array<std::atomic<unsigned long long>, AllocationTracker::CategoryCount> AllocationTracker::s_bytesFreed{};
+	std::array<std::array<AllocationStats, AllocationTracker::CategoryCount>, AllocationTracker::FrameHistory> AllocationTracker::s_history{};
+	unsigned long long AllocationTracker::s_frameCount{ 0 };
+
+	namespace
+	{
+		// trivially constructed so they can be used from operator new at any time
+		thread_local unsigned currentCategory{ AllocationTracker::OtherCategory };
+		thread_local unsigned long long threadAllocationCount{ 0 };
+	}
+
+	void AllocationTracker::SetEnabled(bool enabled)
+	{
+		// drop what was left from the last time counting was stopped halfway through a frame
+		if (enabled && !IsEnabled())
+		{
+			for (unsigned category{ 0 }; category < CategoryCount; ++category)
+			{
+				s_allocations[category].store(0, std::memory_order_relaxed);
+				s_frees[category].store(0, std::memory_order_relaxed);
+				s_bytesAllocated[category].store(0, std::memory_order_relaxed);
+				s_bytesFreed[category].store(0, std::memory_order_relaxed);
+			}
+		}
+		s_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void AllocationTracker::RecordAllocation(std::size_t bytes)
+	{
+		if (!IsEnabled()) { return; }
+
+		++threadAllocationCount;
+		s_allocations[currentCategory].fetch_add(1, std::memory_order_relaxed);
+		s_bytesAllocated[currentCategory].fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void AllocationTracker::RecordFree(std::size_t bytes)
+	{
+		if (!IsEnabled()) { return; }
+
+		s_frees[currentCategory].fetch_add(1, std::memory_order_relaxed);
+		s_bytesFreed[currentCategory].fetch_add(bytes, std::memory_order_relaxed);
+	}
+
+	void AllocationTracker::EndFrame()
+	{
+		if (!IsEnabled()) { return; }
+
+		std::array<AllocationStats, CategoryCount>& r_frame{ s_history[s_frameCount % FrameHistory] };
+		for (unsigned category{ 0 }; category < CategoryCount; ++category)
+		{
+			r_frame[category].allocations = s_allocations[category].exchange(0, std::memory_order_relaxed);
+			r_frame[category].frees = s_frees[category].exchange(0, std::memory_order_relaxed);
+			r_frame[category].bytesAllocated = s_bytesAllocated[category].exchange(0, std::memory_order_relaxed);
+			r_frame[category].bytesFreed = s_bytesFreed[category].exchange(0, std::memory_order_relaxed);
+		}
+		++s_frameCount;
+	}
+
+	bool AllocationTracker::DumpCsv(std::string const& r_filepath)
+	{
+		std::ofstream outFile{ r_filepath };
+		if (!outFile.is_open()) { return false; }
+
+		outFile << "frame,category,allocations,frees,bytesAllocated,bytesFreed\n";
+		unsigned long long const firstFrame{ s_frameCount > FrameHistory ? s_frameCount - FrameHistory : 0 };
+		for (unsigned long long frame{ firstFrame }; frame < s_frameCount; ++frame)
+		{
+			std::array<AllocationStats, CategoryCount> const& r_frame{ s_history[frame % FrameHistory] };
+			for (unsigned category{ 0 }; category < CategoryCount; ++category)
+			{
+				outFile << frame << ',' << GetCategoryName(category) << ',' << r_frame[category].allocations << ',' << r_frame[category].frees
+					<< ',' << r_frame[category].bytesAllocated << ',' << r_frame[category].bytesFreed << '\n';
+			}
+		}
+		return true;
+	}
+
+	AllocationStats AllocationTracker::GetLastFrameStats(unsigned category)
+	{
+		if (!s_frameCount || category >= CategoryCount) { return AllocationStats{}; }
+		return s_history[(s_frameCount - 1) % FrameHistory][category];
+	}
+
+	const char* AllocationTracker::GetCategoryName(unsigned category)
+	{
+		if (category == OtherCategory) { return "Other"; }
+		return category < SystemID::SYSTEMCOUNT ? SystemNames[category] : "";
+	}
+
+	unsigned long long AllocationTracker::GetThreadAllocationCount()
+	{
+		return threadAllocationCount;
+	}
+
+	AllocationTracker::SystemScope::SystemScope(SystemID system) : m_previousCategory{ currentCategory }
+	{
+		currentCategory = static_cast<unsigned>(system);
+	}
+
+	AllocationTracker::SystemScope::~SystemScope()
+	{
+		currentCategory = m_previousCategory;
+	}
+}
+
+#ifdef PE_TRACK_ALLOCATIONS
+namespace
+{
+	/*!***********************************************************************************
+	 \brief					get the size of a block from malloc
+	 \param[in]				void* p_memory the block
+	 \return				std::size_t usable size of the block
+	*************************************************************************************/
+	std::size_t GetBlockSize(void* p_memory)
+	{
+#ifdef _WIN32
+		return _msize(p_memory);
+#else
+		return malloc_usable_size(p_memory);
+#endif
+	}
+
+	/*!***********************************************************************************
+	 \brief					allocate a block and record it
+	 \param[in]				std::size_t size the size of the block
+	 \return				void* the block, nullptr if malloc failed
+	*************************************************************************************/
+	void* TrackedAllocate(std::size_t size)
+	{
+		void* p_memory{ std::malloc(size ? size : 1) };
+		if (p_memory) { PE::AllocationTracker::RecordAllocation(GetBlockSize(p_memory)); }
+		return p_memory;
+	}
+
+	/*!***********************************************************************************
+	 \brief					record a block and free it
+	 \param[in]				void* p_memory the block
+	*************************************************************************************/
+	void TrackedFree(void* p_memory)
+	{
+		if (!p_memory) { return; }
+		PE::AllocationTracker::RecordFree(GetBlockSize(p_memory));
+		std::free(p_memory);
+	}
+}
+
+// the sizes are read back from malloc so that blocks allocated before counting started are freed correctly
+void* operator new(std::size_t size)
+{
+	if (void* p_memory{ TrackedAllocate(size) }) { return p_memory; }
+	throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+	if (void* p_memory{ TrackedAllocate(size) }) { return p_memory; }
+	throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept { return TrackedAllocate(size); }
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept { return TrackedAllocate(size); }
+
+void operator delete(void* p_memory) noexcept { TrackedFree(p_memory); }
+void operator delete[](void* p_memory) noexcept { TrackedFree(p_memory); }
+void operator delete(void* p_memory, std::size_t) noexcept { TrackedFree(p_memory); }
+void operator delete[](void* p_memory, std::size_t) noexcept { TrackedFree(p_memory); }
+void operator delete(void* p_memory, std::nothrow_t const&) noexcept { TrackedFree(p_memory); }
+void operator delete[](void* p_memory, std::nothrow_t const&) noexcept { TrackedFree(p_memory); }
+#endif // PE_TRACK_ALLOCATIONS
@@ -0,0 +1,138 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     AllocationTracker.h
+ \date     27-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	Header file containing the declerations of the AllocationTracker, which counts the
+	heap allocations made through the global operator new each frame and attributes them
+	to the system that was updating at the time. Only builds with PE_TRACK_ALLOCATIONS
+	replace operator new, so the others pay nothing for it.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include "System.h"
+
+namespace PE {
+	/*!***********************************************************************************
+	 \brief				Number of heap allocations and frees and the bytes they moved
+	*************************************************************************************/
+	struct AllocationStats
+	{
+		unsigned long long allocations{ 0 };
+		unsigned long long frees{ 0 };
+		unsigned long long bytesAllocated{ 0 };
+		unsigned long long bytesFreed{ 0 };
+	};
+
+	//counts the allocations of every frame, the hooks are only compiled in with PE_TRACK_ALLOCATIONS (premake --track-allocations)
+	class AllocationTracker
+	{
+		// ----- Constants ----- // 
+	public:
+#ifdef PE_TRACK_ALLOCATIONS
+		static constexpr bool HooksCompiled{ true };
+#else
+		static constexpr bool HooksCompiled{ false }; // nothing is counted, the global operator new is the default one
+#endif // PE_TRACK_ALLOCATIONS
+		static constexpr unsigned CategoryCount{ SystemID::SYSTEMCOUNT + 1 }; // one per system plus one for everything outside them
+		static constexpr unsigned OtherCategory{ SystemID::SYSTEMCOUNT };
+		static constexpr std::size_t FrameHistory{ 600 }; // frames kept for the CSV dump
+
+		// ----- Public methods ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					Start or stop counting allocations
+		 \param[in]				bool enabled true to count allocations
+		*************************************************************************************/
+		static void SetEnabled(bool enabled);
+		/*!***********************************************************************************
+		 \brief					Record an allocation, called by the global operator new
+		 \param[in]				std::size_t bytes the size of the allocation
+		*************************************************************************************/
+		static void RecordAllocation(std::size_t bytes);
+		/*!***********************************************************************************
+		 \brief					Record a free, called by the global operator delete
+		 \param[in]				std::size_t bytes the size of the freed allocation
+		*************************************************************************************/
+		static void RecordFree(std::size_t bytes);
+		/*!***********************************************************************************
+		 \brief					Move the counts of the frame into the history and start
+								counting the next frame. Only call from the main thread.
+		*************************************************************************************/
+		static void EndFrame();
+		/*!***********************************************************************************
+		 \brief					Write the counts of the frames in the history to a CSV file,
+								one row per frame and category
+		 \param[in]				std::string const& r_filepath the file to write to
+		 \return				bool true if the file was written
+		*************************************************************************************/
+		static bool DumpCsv(std::string const& r_filepath);
+		// ----- Public getters ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					check if allocations are being counted
+		 \return				bool true if allocations are being counted
+		*************************************************************************************/
+		static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+		/*!***********************************************************************************
+		 \brief					get the counts of a category in the last finished frame
+		 \param[in]				unsigned category the system ID or OtherCategory
+		 \return				AllocationStats the counts of the category
+		*************************************************************************************/
+		static AllocationStats GetLastFrameStats(unsigned category);
+		/*!***********************************************************************************
+		 \brief					get the name of a category
+		 \param[in]				unsigned category the system ID or OtherCategory
+		 \return				const char* name of the category
+		*************************************************************************************/
+		static const char* GetCategoryName(unsigned category);
+		/*!***********************************************************************************
+		 \brief					get the number of allocations made by the calling thread while
+								counting was enabled, used to attribute allocations to scopes
+		 \return				unsigned long long number of allocations
+		*************************************************************************************/
+		static unsigned long long GetThreadAllocationCount();
+
+		/*!***********************************************************************************
+		 \brief					Attributes the allocations of the calling thread to a system
+								until it is destroyed
+		*************************************************************************************/
+		class SystemScope
+		{
+		public:
+			/*!***********************************************************************************
+			 \brief					Constructor
+			 \param[in]				SystemID system the system to attribute allocations to
+			*************************************************************************************/
+			explicit SystemScope(SystemID system);
+			/*!***********************************************************************************
+			 \brief					Destructor, restores the previous system
+			*************************************************************************************/
+			~SystemScope();
+
+			SystemScope(SystemScope const&) = delete;
+			SystemScope& operator=(SystemScope const&) = delete;
+		private:
+			unsigned m_previousCategory;
+		};
+	private:
+		static std::atomic<bool> s_enabled;
+		static std::array<std::atomic<unsigned long long>, CategoryCount> s_allocations;
+		static std::array<std::atomic<unsigned long long>, CategoryCount> s_frees;
+		static std::array<std::atomic<unsigned long long>, CategoryCount> s_bytesAllocated;
+		static std::array<std::atomic<unsigned long long>, CategoryCount> s_bytesFreed;
+		static std::array<std::array<AllocationStats, CategoryCount>, FrameHistory> s_history; // counts of the last frames, indexed by frame % FrameHistory
+		static unsigned long long s_frameCount; // frames ended while counting
+	};
+}
@@ -0,0 +1,57 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     FrameArena.cpp
+ \date     28-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	cpp file containing the definitions of FrameArena
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#include "prpch.h"
+#include "FrameArena.h"
+
+namespace PE
+{
+	FrameArena::FrameArena(std::size_t size) : p_block{ new char[size] }, m_capacity{ size } {}
+
+	void FrameArena::Reset()
+	{
+		m_used = 0;
+		m_overflowCount = 0;
+		m_overflowBytes = 0;
+	}
+
+	void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		//align the top of the block for the allocation
+		std::uintptr_t const top{ reinterpret_cast<std::uintptr_t>(p_block.get()) + m_used };
+		std::size_t const padding{ (alignment - top % alignment) % alignment };
+
+		if (m_used + padding + bytes <= m_capacity)
+		{
+			void* p_newPtr{ p_block.get() + m_used + padding };
+			m_used += padding + bytes;
+			return p_newPtr;
+		}
+
+		//the block is full, fall back to the heap so the frame still works
+		++m_overflowCount;
+		m_overflowBytes += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void FrameArena::do_deallocate(void* p_memory, std::size_t bytes, std::size_t alignment)
+	{
+		char* const p_bytes{ static_cast<char*>(p_memory) };
+		if (p_bytes >= p_block.get() && p_bytes < p_block.get() + m_capacity)
+			return;
+
+		std::pmr::new_delete_resource()->deallocate(p_memory, bytes, alignment);
+	}
+}
@@ -0,0 +1,121 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     FrameArena.h
+ \date     28-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	Header file containing the declerations of the FrameArena, a linear allocator for
+	data that only lives for a frame, usable by std::pmr containers
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+// CONSTANT VARIABLES
+constexpr std::size_t frame_arena_size = 4 * 1024 * 1024;
+
+namespace PE {
+	//a bump allocator that is reset as a whole, allocations that do not fit go to the heap
+	class FrameArena : public std::pmr::memory_resource
+	{
+		// ----- Constructors ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					Constructor, allocates the block of the arena
+		 \param[in]				std::size_t size the size of the block in bytes
+		*************************************************************************************/
+		explicit FrameArena(std::size_t size = frame_arena_size);
+
+		FrameArena(FrameArena const&) = delete;
+		FrameArena& operator=(FrameArena const&) = delete;
+		// ----- Public methods ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					Frees everything allocated from the block at once. Anything
+								still using memory from the arena must not be used afterwards.
+		*************************************************************************************/
+		void Reset();
+		// ----- Public getters ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					get the size of the block
+		 \return				std::size_t size of the block in bytes
+		*************************************************************************************/
+		std::size_t GetCapacity() const { return m_capacity; }
+		/*!***********************************************************************************
+		 \brief					get how much of the block has been allocated since the last reset
+		 \return				std::size_t bytes allocated, including alignment padding
+		*************************************************************************************/
+		std::size_t GetUsed() const { return m_used; }
+		/*!***********************************************************************************
+		 \brief					get the number of allocations since the last reset that did
+								not fit in the block and went to the heap instead
+		 \return				std::size_t number of allocations
+		*************************************************************************************/
+		std::size_t GetOverflowCount() const { return m_overflowCount; }
+		/*!***********************************************************************************
+		 \brief					get the bytes of the allocations that went to the heap since
+								the last reset
+		 \return				std::size_t bytes allocated from the heap
+		*************************************************************************************/
+		std::size_t GetOverflowBytes() const { return m_overflowBytes; }
+		// ----- Private methods ----- // 
+	private:
+		/*!***********************************************************************************
+		 \brief					Bumps the top of the block, or allocates from the heap if the
+								block is full
+		 \param[in]				std::size_t bytes the size to allocate
+		 \param[in]				std::size_t alignment the alignment of the memory
+		 \return				void* the allocated memory
+		*************************************************************************************/
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		/*!***********************************************************************************
+		 \brief					Does nothing for memory in the block as it is freed by Reset(),
+								frees memory that was allocated from the heap
+		 \param[in]				void* p_memory the memory to free
+		 \param[in]				std::size_t bytes the size that was allocated
+		 \param[in]				std::size_t alignment the alignment that was asked for
+		*************************************************************************************/
+		void do_deallocate(void* p_memory, std::size_t bytes, std::size_t alignment) override;
+		/*!***********************************************************************************
+		 \brief					check if another memory resource is this arena
+		 \param[in]				std::pmr::memory_resource const& r_other the other resource
+		 \return				bool true if it is the same arena
+		*************************************************************************************/
+		bool do_is_equal(std::pmr::memory_resource const& r_other) const noexcept override { return this == &r_other; }
+
+	private:
+		std::unique_ptr<char[]> p_block; // where all the allocations of the arena are stored
+		std::size_t m_capacity; // size of the block
+		std::size_t m_used{ 0 }; // current top of the block
+		std::size_t m_overflowCount{ 0 };
+		std::size_t m_overflowBytes{ 0 };
+	};
+
+	/*!***********************************************************************************
+	 \brief				Destroys a std::pmr container and constructs it again, empty, on a new
+						memory resource. Assigning does not change the resource of a std::pmr
+						container, so this is how a member container is moved onto the arena
+						of the current frame.
+	 \param[in]			Container& r_container the container to recreate
+	 \param[in]			std::pmr::memory_resource* p_resource the resource it should use
+	 \param[in]			std::size_t reserveCount the number of elements to reserve, if any
+	*************************************************************************************/
+	template <typename Container>
+	void RecreateOnResource(Container& r_container, std::pmr::memory_resource* p_resource, std::size_t reserveCount = 0)
+	{
+		r_container.~Container();
+		::new (static_cast<void*>(&r_container)) Container(p_resource);
+		if (reserveCount) { r_container.reserve(reserveCount); }
+	}
+}
@@ -102,6 +102,49 @@ namespace PE
 		}
 	}
 
+	void MemoryManager::EndFrame()
+	{
+		//record the high water mark of the frame
+		FrameArena const& r_currentArena{ m_frameArenas[m_currentFrameArena] };
+		m_lastFrameArenaUsed = r_currentArena.GetUsed();
+		m_lastFrameArenaOverflow = r_currentArena.GetOverflowBytes();
+		if (m_lastFrameArenaUsed + m_lastFrameArenaOverflow > m_peakFrameArenaUsed)
+			m_peakFrameArenaUsed = m_lastFrameArenaUsed + m_lastFrameArenaOverflow;
+
+		//the other arena was last used two frames ago, so nothing points into it anymore
+		m_currentFrameArena = (m_currentFrameArena + 1) % m_frameArenas.size();
+		m_frameArenas[m_currentFrameArena].Reset();
+	}
+
+	void MemoryManager::RegisterPool(PoolAllocator* p_pool)
+	{
+		std::lock_guard<std::mutex> lock{ m_poolsMutex };
+		m_pools.emplace_back(p_pool);
+	}
+
+	void MemoryManager::UnregisterPool(PoolAllocator* p_pool)
+	{
+		std::lock_guard<std::mutex> lock{ m_poolsMutex };
+		m_pools.erase(std::remove(m_pools.begin(), m_pools.end(), p_pool), m_pools.end());
+	}
+
+	void MemoryManager::SetPoolPoisoning(bool poisoning)
+	{
+		std::lock_guard<std::mutex> lock{ m_poolsMutex };
+		for (PoolAllocator* p_pool : m_pools)
+			p_pool->SetPoisoning(poisoning);
+	}
+
+	std::vector<PoolStats> MemoryManager::GetPoolStats()
+	{
+		std::lock_guard<std::mutex> lock{ m_poolsMutex };
+		std::vector<PoolStats> stats;
+		stats.reserve(m_pools.size());
+		for (PoolAllocator* p_pool : m_pools)
+			stats.emplace_back(p_pool->GetStats());
+		return stats;
+	}
+
 	void MemoryManager::PrintData()
 	{
 #ifndef GAMERELEASE
@@ -114,6 +157,14 @@ namespace PE
 		for (int i = 0; i < m_memoryAllocationData.size(); i++) {
 			Editor::GetInstance().AddInfoLog(m_memoryAllocationData[i].ToString());
 		}
+
+		//print pool data
+		for (PoolStats const& r_stats : GetPoolStats()) {
+			std::stringstream ss;
+			ss << r_stats.name << " pool: " << r_stats.blocksInUse << "/" << r_stats.capacity << " blocks of " << r_stats.blockSize
+				<< " bytes in use, peak " << r_stats.peakBlocksInUse;
+			Editor::GetInstance().AddInfoLog(ss.str());
+		}
 #endif
 	}
 
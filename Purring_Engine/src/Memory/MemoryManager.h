@@ -15,6 +15,10 @@
 *************************************************************************************/
 #pragma once
 #include "Singleton.h"
+#include "FrameArena.h"
+#include "PoolAllocator.h"
+#include <array>
+#include <mutex>
 
 // CONSTANT VARIABLES
 constexpr size_t max_size = 1000000;
@@ -122,10 +126,72 @@ namespace PE {
 		 \brief					print all the details of allocated memory
 		*************************************************************************************/
 		void PrintData();
+		/*!***********************************************************************************
+		 \brief					Ends the frame for the frame arenas, records how much of the
+								current arena was used and resets the other one for the next
+								frame. Memory from the frame arena stays valid until the end of
+								the frame after the one it was allocated in.
+		*************************************************************************************/
+		void EndFrame();
+		/*!***********************************************************************************
+		 \brief					Add a pool to the ones reported, called by the pool
+		 \param[in]				PoolAllocator* p_pool the pool
+		*************************************************************************************/
+		void RegisterPool(PoolAllocator* p_pool);
+		/*!***********************************************************************************
+		 \brief					Remove a pool from the ones reported, called by the pool
+		 \param[in]				PoolAllocator* p_pool the pool
+		*************************************************************************************/
+		void UnregisterPool(PoolAllocator* p_pool);
+		/*!***********************************************************************************
+		 \brief					Turn poisoning on or off for every pool
+		 \param[in]				bool poisoning true to poison the blocks of the pools
+		*************************************************************************************/
+		void SetPoolPoisoning(bool poisoning);
 		// ----- Public getters ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					get the statistics of every pool
+		 \return				std::vector<PoolStats> statistics of each pool
+		*************************************************************************************/
+		std::vector<PoolStats> GetPoolStats();
+		/*!***********************************************************************************
+		 \brief					get the memory resource of the current frame arena, for std::pmr
+								containers that are rebuilt every frame. Only use from the main thread.
+		 \return				std::pmr::memory_resource* the arena of the current frame
+		*************************************************************************************/
+		std::pmr::memory_resource* GetFrameResource() { return &m_frameArenas[m_currentFrameArena]; }
+		/*!***********************************************************************************
+		 \brief					get the size of each frame arena
+		 \return				std::size_t size in bytes
+		*************************************************************************************/
+		std::size_t GetFrameArenaCapacity() const { return m_frameArenas[m_currentFrameArena].GetCapacity(); }
+		/*!***********************************************************************************
+		 \brief					get how much of the frame arena the last frame used
+		 \return				std::size_t bytes used
+		*************************************************************************************/
+		std::size_t GetLastFrameArenaUsed() const { return m_lastFrameArenaUsed; }
+		/*!***********************************************************************************
+		 \brief					get the most of the frame arena any frame has used
+		 \return				std::size_t bytes used
+		*************************************************************************************/
+		std::size_t GetPeakFrameArenaUsed() const { return m_peakFrameArenaUsed; }
+		/*!***********************************************************************************
+		 \brief					get how many bytes the last frame had to allocate from the heap
+								because the frame arena was full
+		 \return				std::size_t bytes allocated from the heap
+		*************************************************************************************/
+		std::size_t GetLastFrameArenaOverflow() const { return m_lastFrameArenaOverflow; }
 	private:
 		std::vector<MemoryData> m_memoryAllocationData;		//for storing what memory allocated to where
 		StackAllocator m_stackAllocator; //the stack allocator
+		std::array<FrameArena, 2> m_frameArenas; //arenas of the current and the last frame
+		std::size_t m_currentFrameArena{ 0 }; //index of the arena of the current frame
+		std::size_t m_lastFrameArenaUsed{ 0 };
+		std::size_t m_peakFrameArenaUsed{ 0 };
+		std::size_t m_lastFrameArenaOverflow{ 0 };
+		std::vector<PoolAllocator*> m_pools; //pools to report
+		std::mutex m_poolsMutex; //pools can be created from any thread
 	};
 
 
@@ -0,0 +1,117 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     PoolAllocator.cpp
+ \date     29-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	cpp file containing the definitions of PoolAllocator
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#include "prpch.h"
+#include "PoolAllocator.h"
+#include "MemoryManager.h"
+#include <cstring>
+
+namespace PE
+{
+	PoolAllocator::PoolAllocator(std::string name, std::size_t blockSize, std::size_t blockAlignment, std::size_t blocksPerSlab)
+		: m_name{ std::move(name) }, m_blocksPerSlab{ blocksPerSlab ? blocksPerSlab : 1 }
+	{
+		//every block has to fit the free list link and keep the blocks after it aligned
+		std::size_t const alignment{ std::max(blockAlignment, alignof(FreeBlock)) };
+		std::size_t const size{ std::max(blockSize, sizeof(FreeBlock)) };
+		m_blockSize = (size + alignment - 1) / alignment * alignment;
+
+		MemoryManager::GetInstance().RegisterPool(this);
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		MemoryManager::GetInstance().UnregisterPool(this);
+	}
+
+	void* PoolAllocator::Allocate()
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		if (!p_freeList)
+			AddSlab();
+
+		FreeBlock* p_block{ p_freeList };
+		p_freeList = p_block->p_next;
+
+		++m_allocations;
+		if (++m_blocksInUse > m_peakBlocksInUse)
+			m_peakBlocksInUse = m_blocksInUse;
+
+		if (m_poisoning)
+			std::memset(p_block, allocated_poison, m_blockSize);
+		return p_block;
+	}
+
+	void PoolAllocator::Free(void* p_block)
+	{
+		if (!p_block)
+			return;
+
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		if (m_poisoning)
+			std::memset(p_block, freed_poison, m_blockSize);
+
+		FreeBlock* p_freeBlock{ static_cast<FreeBlock*>(p_block) };
+		p_freeBlock->p_next = p_freeList;
+		p_freeList = p_freeBlock;
+		--m_blocksInUse;
+	}
+
+	bool PoolAllocator::Owns(void const* p_block) const
+	{
+		char const* p_bytes{ static_cast<char const*>(p_block) };
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		for (auto const& rp_slab : m_slabs)
+		{
+			if (p_bytes >= rp_slab.get() && p_bytes < rp_slab.get() + m_blockSize * m_blocksPerSlab)
+				return true;
+		}
+		return false;
+	}
+
+	void PoolAllocator::SetPoisoning(bool poisoning)
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		m_poisoning = poisoning;
+	}
+
+	PoolStats PoolAllocator::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock{ m_mutex };
+		PoolStats stats;
+		stats.name = m_name;
+		stats.blockSize = m_blockSize;
+		stats.slabCount = m_slabs.size();
+		stats.capacity = m_slabs.size() * m_blocksPerSlab;
+		stats.blocksInUse = m_blocksInUse;
+		stats.peakBlocksInUse = m_peakBlocksInUse;
+		stats.allocations = m_allocations;
+		return stats;
+	}
+
+	void PoolAllocator::AddSlab()
+	{
+		m_slabs.emplace_back(new char[m_blockSize * m_blocksPerSlab]);
+		char* p_slab{ m_slabs.back().get() };
+
+		//link the blocks in order so they are handed out front to back
+		for (std::size_t i{ m_blocksPerSlab }; i > 0; --i)
+		{
+			FreeBlock* p_block{ reinterpret_cast<FreeBlock*>(p_slab + (i - 1) * m_blockSize) };
+			p_block->p_next = p_freeList;
+			p_freeList = p_block;
+		}
+	}
+}
@@ -0,0 +1,185 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     PoolAllocator.h
+ \date     29-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief
+	Header file containing the declerations of the PoolAllocator, a thread safe allocator
+	of fixed size blocks carved out of slabs, and the standard allocator built on it that
+	gives container nodes their own pool
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+
+*************************************************************************************/
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace PE {
+	/*!***********************************************************************************
+	 \brief				Statistics of a pool, copied out so they can be read while the pool
+						is in use
+	*************************************************************************************/
+	struct PoolStats
+	{
+		std::string name;
+		std::size_t blockSize{ 0 };
+		std::size_t slabCount{ 0 };
+		std::size_t capacity{ 0 }; // blocks in all the slabs
+		std::size_t blocksInUse{ 0 };
+		std::size_t peakBlocksInUse{ 0 };
+		unsigned long long allocations{ 0 }; // blocks handed out since the pool was created
+	};
+
+	//hands out blocks of one size from slabs that are never freed until the pool is destroyed
+	class PoolAllocator
+	{
+		// ----- Constants ----- // 
+	public:
+		static constexpr unsigned char allocated_poison{ 0xCD }; // written over blocks when they are handed out
+		static constexpr unsigned char freed_poison{ 0xDD }; // written over blocks when they are freed
+
+		// ----- Constructors ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					Constructor, registers the pool with the memory manager
+		 \param[in]				std::string name the name to report the pool under
+		 \param[in]				std::size_t blockSize the size of each block
+		 \param[in]				std::size_t blockAlignment the alignment of each block, at most
+								the alignment of operator new
+		 \param[in]				std::size_t blocksPerSlab the number of blocks to add each time
+								the pool runs out
+		*************************************************************************************/
+		PoolAllocator(std::string name, std::size_t blockSize, std::size_t blockAlignment = alignof(std::max_align_t), std::size_t blocksPerSlab = 64);
+		/*!***********************************************************************************
+		 \brief					Destructor, unregisters the pool and frees the slabs
+		*************************************************************************************/
+		~PoolAllocator();
+
+		PoolAllocator(PoolAllocator const&) = delete;
+		PoolAllocator& operator=(PoolAllocator const&) = delete;
+		// ----- Public methods ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					Takes a block off the free list, adding a slab if it is empty
+		 \return				void* the block
+		*************************************************************************************/
+		void* Allocate();
+		/*!***********************************************************************************
+		 \brief					Puts a block back on the free list
+		 \param[in]				void* p_block the block, must have come from this pool
+		*************************************************************************************/
+		void Free(void* p_block);
+		/*!***********************************************************************************
+		 \brief					Check if a block came from this pool
+		 \param[in]				void const* p_block the block
+		 \return				bool true if the block is inside one of the slabs of the pool
+		*************************************************************************************/
+		bool Owns(void const* p_block) const;
+		/*!***********************************************************************************
+		 \brief					Turn writing the poison values over blocks on or off, so that
+								reads of uninitialised or freed blocks stand out in the debugger
+		 \param[in]				bool poisoning true to poison blocks
+		*************************************************************************************/
+		void SetPoisoning(bool poisoning);
+		// ----- Public getters ----- // 
+	public:
+		/*!***********************************************************************************
+		 \brief					get a copy of the statistics of the pool
+		 \return				PoolStats the statistics
+		*************************************************************************************/
+		PoolStats GetStats() const;
+		/*!***********************************************************************************
+		 \brief					check if blocks are poisoned
+		 \return				bool true if blocks are poisoned
+		*************************************************************************************/
+		bool IsPoisoning() const { return m_poisoning; }
+		/*!***********************************************************************************
+		 \brief					get the size of each block
+		 \return				std::size_t size of the blocks in bytes
+		*************************************************************************************/
+		std::size_t GetBlockSize() const { return m_blockSize; }
+		// ----- Private methods ----- // 
+	private:
+		/*!***********************************************************************************
+		 \brief					Allocates another slab and adds its blocks to the free list,
+								the mutex must be held
+		*************************************************************************************/
+		void AddSlab();
+
+	private:
+		struct FreeBlock { FreeBlock* p_next; };
+
+		mutable std::mutex m_mutex;
+		std::string m_name;
+		std::size_t m_blockSize;
+		std::size_t m_blocksPerSlab;
+		std::vector<std::unique_ptr<char[]>> m_slabs;
+		FreeBlock* p_freeList{ nullptr };
+		std::size_t m_blocksInUse{ 0 };
+		std::size_t m_peakBlocksInUse{ 0 };
+		unsigned long long m_allocations{ 0 };
+#ifndef GAMERELEASE
+		bool m_poisoning{ true };
+#else
+		bool m_poisoning{ false };
+#endif
+	};
+
+	//standard allocator that takes single elements, such as the nodes of a std::set or std::map, from a pool shared by every container of the same element type
+	template <typename T>
+	class PoolStdAllocator
+	{
+		static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "PoolStdAllocator does not support over-aligned types");
+	public:
+		using value_type = T;
+
+		PoolStdAllocator() noexcept = default;
+		template <typename U>
+		PoolStdAllocator(PoolStdAllocator<U> const&) noexcept {}
+
+		/*!***********************************************************************************
+		 \brief					Allocates n elements, single elements come from the pool
+		 \param[in]				std::size_t n number of elements
+		 \return				T* the memory
+		*************************************************************************************/
+		T* allocate(std::size_t n)
+		{
+			if (n == 1) { return static_cast<T*>(GetPool().Allocate()); }
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+		/*!***********************************************************************************
+		 \brief					Frees n elements allocated by allocate()
+		 \param[in]				T* p_memory the memory
+		 \param[in]				std::size_t n number of elements
+		*************************************************************************************/
+		void deallocate(T* p_memory, std::size_t n) noexcept
+		{
+			if (n == 1) { GetPool().Free(p_memory); }
+			else { ::operator delete(p_memory); }
+		}
+		/*!***********************************************************************************
+		 \brief					get the pool shared by every allocator of T
+		 \return				PoolAllocator& the pool
+		*************************************************************************************/
+		static PoolAllocator& GetPool()
+		{
+			static PoolAllocator pool{ "Container Nodes (" + std::to_string(sizeof(T)) + " bytes)", sizeof(T), alignof(T) };
+			return pool;
+		}
+
+		template <typename U>
+		bool operator==(PoolStdAllocator<U> const&) const noexcept { return true; }
+		template <typename U>
+		bool operator!=(PoolStdAllocator<U> const&) const noexcept { return false; }
+	};
+}
@@ -170,7 +170,6 @@ namespace PE
 		public:
 
 		std::variant<AABBCollider, CircleCollider> colliderVariant; // contains the different types of colliders
-		std::set<size_t> collisionChecked; // contains the IDs of the entities which the collider has checked for collision against
 		bool isTrigger{ false }; // determines whether the collider will need to resolve its collision
 		unsigned collisionLayerIndex{ 0 }; // determines which collision layer the collider is in
 
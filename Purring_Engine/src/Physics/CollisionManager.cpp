@@ -22,6 +22,8 @@
 #include "Events/EventHandler.h"
 #include "Layers/CollisionLayer.h"
 #include "Layers/LayerManager.h"
+#include "Threading/ThreadPool.h"
+#include "Time/Profiler.h"
 
 #ifndef GAMERELEASE
 #include "Editor/Editor.h"
@@ -33,6 +35,8 @@ namespace PE
 	vec2 CollisionManager::gridSize{ 5000.f, 5000.f };
 
 	bool CollisionManager::gridActive{ true };
+
+	unsigned CollisionManager::narrowphaseThreads{ 1 };
 	
 	// ----- Constructor/Destructors ----- //
 	CollisionManager::CollisionManager() 
@@ -48,6 +52,10 @@ namespace PE
 				gridSize.x = cfgJson["Gridsize"]["x"].get<float>();
 				gridSize.y = cfgJson["Gridsize"]["y"].get<float>();
 			}
+			if (cfgJson.contains("NarrowphaseThreads"))
+			{
+				narrowphaseThreads = std::clamp(cfgJson["NarrowphaseThreads"].get<unsigned>(), 1U, ThreadPool::GetHardwareThreadCount());
+			}
 			if (cfgJson.contains("collisionLayers"))
 			{
 				for (auto const& layerJson : cfgJson["collisionLayers"])
@@ -73,6 +81,7 @@ namespace PE
 
 		cfgjson["Gridsize"]["x"] = gridSize.x;
 		cfgjson["Gridsize"]["y"] = gridSize.y;
+		cfgjson["NarrowphaseThreads"] = narrowphaseThreads;
 		
 		for (auto const& layer : CollisionLayerManager::GetInstance().GetCollisionLayers())
 		{
@@ -118,9 +127,14 @@ namespace PE
 
 	void CollisionManager::UpdateSystem(float)
 	{
+		PE_PROFILE_SCOPE("Collision");
+
 		// Update the Collider's specs
 		UpdateColliders();
 
+		// the scene queries fall back to checking every collider until the grid is refilled below
+		m_gridUpdated = false;
+
 #ifndef GAMERELEASE
 		if (Editor::GetInstance().IsEditorActive())
 		{
@@ -142,7 +156,10 @@ namespace PE
 		{
 #endif
 			if (gridActive)
+			{
 				m_grid.UpdateGrid();
+				m_gridUpdated = true;
+			}
 #ifndef GAMERELEASE
 		}
 #endif
@@ -160,6 +177,306 @@ namespace PE
 #endif
 	}
 
+	// ----- Scene Queries ----- //
+
+	bool CollisionManager::Raycast(vec2 const& r_origin, vec2 const& r_direction, float maxDistance, RaycastHit& r_hit,
+								   unsigned layerMask, bool hitTriggers) const
+	{
+		if (r_direction.LengthSquared() == 0.f || maxDistance < 0.f) { return false; }
+
+		vec2 const direction{ r_direction.GetNormalized() };
+		vec2 const end{ r_origin + direction * maxDistance };
+		bool hasHit{ false };
+
+		ForEachColliderInArea(vec2{ std::min(r_origin.x, end.x), std::min(r_origin.y, end.y) },
+							  vec2{ std::max(r_origin.x, end.x), std::max(r_origin.y, end.y) },
+							  layerMask, hitTriggers, [&](EntityID id, Collider const& r_collider)
+			{
+				float distance{ 0.f };
+				vec2 normal{};
+				bool hit{ false };
+				std::visit([&](auto const& r_col)
+					{
+						hit = RayIntersection(r_col, r_origin, direction, maxDistance, distance, normal);
+					}, r_collider.colliderVariant);
+
+				// keep the closest hit, ties go to the collider visited first
+				if (hit && (!hasHit || distance < r_hit.distance))
+				{
+					hasHit = true;
+					r_hit.entity = id;
+					r_hit.distance = distance;
+					r_hit.point = r_origin + direction * distance;
+					r_hit.normal = normal;
+				}
+			});
+
+		return hasHit;
+	}
+
+	size_t CollisionManager::OverlapCircle(vec2 const& r_center, float radius, QuerySpan<EntityID> results,
+										   unsigned layerMask, bool hitTriggers, QueryFilter p_filter) const
+	{
+		CircleCollider query;
+		query.center = r_center;
+		query.radius = radius;
+
+		vec2 queryMin{}, queryMax{};
+		GetColliderBounds(query, queryMin, queryMax);
+
+		size_t count{ 0 };
+		ForEachColliderInArea(queryMin, queryMax, layerMask, hitTriggers, [&](EntityID id, Collider const& r_collider)
+			{
+				if (count >= results.capacity || (p_filter && !p_filter(id))) { return; }
+
+				bool overlap{ false };
+				std::visit([&](auto const& r_col)
+					{
+						overlap = QueryOverlap(r_col, query);
+					}, r_collider.colliderVariant);
+
+				if (overlap)
+					results.p_data[count++] = id;
+			});
+
+		return count;
+	}
+
+	size_t CollisionManager::OverlapAABB(vec2 const& r_min, vec2 const& r_max, QuerySpan<EntityID> results,
+										 unsigned layerMask, bool hitTriggers) const
+	{
+		AABBCollider query;
+		query.min = r_min;
+		query.max = r_max;
+
+		size_t count{ 0 };
+		ForEachColliderInArea(r_min, r_max, layerMask, hitTriggers, [&](EntityID id, Collider const& r_collider)
+			{
+				if (count >= results.capacity) { return; }
+
+				bool overlap{ false };
+				std::visit([&](auto const& r_col)
+					{
+						overlap = QueryOverlap(r_col, query);
+					}, r_collider.colliderVariant);
+
+				if (overlap)
+					results.p_data[count++] = id;
+			});
+
+		return count;
+	}
+
+	bool CollisionManager::SweepCircle(vec2 const& r_center, float radius, vec2 const& r_direction, float maxDistance, SweepHit& r_hit,
+									   unsigned layerMask, bool hitTriggers) const
+	{
+		if (r_direction.LengthSquared() == 0.f || maxDistance < 0.f) { return false; }
+
+		CircleCollider sweptCircle;
+		sweptCircle.center = r_center;
+		sweptCircle.radius = radius;
+
+		vec2 const direction{ r_direction.GetNormalized() };
+		vec2 const end{ r_center + direction * maxDistance };
+		bool hasHit{ false };
+
+		// the area covers the circle at both ends of its movement
+		ForEachColliderInArea(vec2{ std::min(r_center.x, end.x) - radius, std::min(r_center.y, end.y) - radius },
+							  vec2{ std::max(r_center.x, end.x) + radius, std::max(r_center.y, end.y) + radius },
+							  layerMask, hitTriggers, [&](EntityID id, Collider const& r_collider)
+			{
+				float distance{ 0.f };
+				vec2 normal{};
+				bool hit{ false };
+				std::visit([&](auto const& r_col)
+					{
+						hit = SweepIntersection(r_col, sweptCircle, direction, maxDistance, distance, normal);
+					}, r_collider.colliderVariant);
+
+				// keep the earliest hit, ties go to the collider visited first
+				if (hit && (!hasHit || distance < r_hit.distance))
+				{
+					hasHit = true;
+					r_hit.entity = id;
+					r_hit.distance = distance;
+					r_hit.position = r_center + direction * distance;
+					r_hit.point = r_hit.position - normal * radius;
+					r_hit.normal = normal;
+				}
+			});
+
+		return hasHit;
+	}
+
+	bool CollisionManager::SweepCollider(EntityID id, vec2 const& r_start, vec2 const& r_displacement, SweepHit& r_hit) const
+	{
+		if (!EntityManager::GetInstance().Has<Collider>(id) || !EntityManager::GetInstance().Has<Transform>(id)) { return false; }
+
+		float const maxDistance{ r_displacement.Length() };
+		if (maxDistance <= 0.f) { return false; }
+		vec2 const direction{ r_displacement / maxDistance };
+
+		// place a copy of the collider where the movement starts
+		Transform const& transform{ EntityManager::GetInstance().Get<Transform>(id) };
+		Collider sweptCollider{ EntityManager::GetInstance().Get<Collider>(id) };
+		vec2 startMin{}, startMax{};
+		std::visit([&](auto& r_col)
+			{
+				Update(r_col, r_start, vec2{ transform.width, transform.height });
+				GetColliderBounds(r_col, startMin, startMax);
+			}, sweptCollider.colliderVariant);
+
+		bool hasHit{ false };
+
+		// the area covers the collider at both ends of its movement
+		ForEachColliderInArea(vec2{ std::min(startMin.x, startMin.x + r_displacement.x), std::min(startMin.y, startMin.y + r_displacement.y) },
+							  vec2{ std::max(startMax.x, startMax.x + r_displacement.x), std::max(startMax.y, startMax.y + r_displacement.y) },
+							  GetInteractingLayerMask(sweptCollider.collisionLayerIndex), false, [&](EntityID otherID, Collider const& r_collider)
+			{
+				if (otherID == id) { return; }
+
+				float distance{ 0.f };
+				vec2 normal{}, point{};
+				bool hit{ false };
+				std::visit([&](auto const& r_col)
+					{
+						std::visit([&](auto const& r_swept)
+							{
+								hit = SweepIntersection(r_col, r_swept, direction, maxDistance, distance, normal);
+								point = ClosestPoint(r_col, r_swept.center + direction * distance);
+							}, sweptCollider.colliderVariant);
+					}, r_collider.colliderVariant);
+
+				// keep the earliest hit, colliders overlapped at the start are left to the discrete test
+				if (hit && distance > 0.f && (!hasHit || distance < r_hit.distance))
+				{
+					hasHit = true;
+					r_hit.entity = otherID;
+					r_hit.distance = distance;
+					r_hit.position = r_start + direction * distance;
+					r_hit.point = point;
+					r_hit.normal = normal;
+				}
+			});
+
+		return hasHit;
+	}
+
+	size_t CollisionManager::NearestK(vec2 const& r_position, float maxDistance, QuerySpan<NearestHit> results,
+									  unsigned layerMask, bool hitTriggers, QueryFilter p_filter) const
+	{
+		if (!results.capacity || maxDistance < 0.f) { return 0; }
+
+		size_t count{ 0 };
+		ForEachColliderInArea(r_position - vec2{ maxDistance, maxDistance }, r_position + vec2{ maxDistance, maxDistance },
+							  layerMask, hitTriggers, [&](EntityID id, Collider const& r_collider)
+			{
+				if (p_filter && !p_filter(id)) { return; }
+
+				vec2 closestPoint{};
+				std::visit([&](auto const& r_col)
+					{
+						closestPoint = ClosestPoint(r_col, r_position);
+					}, r_collider.colliderVariant);
+
+				float const distance{ (closestPoint - r_position).Length() };
+				if (distance > maxDistance) { return; }
+
+				// the buffer is full and this collider is further than all of them
+				if (count == results.capacity && distance >= results.p_data[count - 1].distance) { return; }
+
+				// insert the hit in order of distance, dropping the furthest one if the buffer is full
+				size_t index{ (count < results.capacity) ? count++ : count - 1 };
+				for (; index > 0 && results.p_data[index - 1].distance > distance; --index)
+				{
+					results.p_data[index] = results.p_data[index - 1];
+				}
+				results.p_data[index] = NearestHit{ id, distance };
+			});
+
+		return count;
+	}
+
+	unsigned CollisionManager::GetInteractingLayerMask(unsigned collisionLayerIndex)
+	{
+		unsigned mask{ 0 };
+		std::shared_ptr<CollisionLayer> const p_layer{ CollisionLayerManager::GetInstance().GetCollisionLayer(collisionLayerIndex) };
+		for (unsigned i{ 0 }; i < TOTAL_COLLISION_LAYERS; ++i)
+		{
+			// same rule as the collision pairs, the layers interact if either one collides with the other
+			if (p_layer->IsCollidingWith(i) || CollisionLayerManager::GetInstance().GetCollisionLayer(i)->IsCollidingWith(collisionLayerIndex))
+				mask |= (1U << i);
+		}
+		return mask;
+	}
+
+	template <typename Func>
+	void CollisionManager::ForEachColliderInArea(vec2 const& r_min, vec2 const& r_max, unsigned layerMask, bool hitTriggers, Func const& r_func) const
+	{
+		// returns the collider of the entity if it should be visited, nullptr otherwise
+		auto const filterCollider = [&](EntityID id) -> Collider const*
+			{
+				// the entity may have been destroyed or disabled since the last collision step
+				if (!EntityManager::GetInstance().Has<Collider>(id)) { return nullptr; }
+				if (!EntityManager::GetInstance().Get<EntityDescriptor>(id).isActive) { return nullptr; }
+
+				Collider const& r_collider{ EntityManager::GetInstance().Get<Collider>(id) };
+				if (!(layerMask & (1U << r_collider.collisionLayerIndex))) { return nullptr; }
+				if (!hitTriggers && r_collider.isTrigger) { return nullptr; }
+				return &r_collider;
+			};
+
+		if (!m_gridUpdated || m_grid.m_cells.empty() || m_grid.m_cells.front().empty())
+		{
+			for (const auto& layer : LayerView<Collider, Transform>())
+			{
+				for (EntityID colliderID : InternalView(layer))
+				{
+					if (Collider const* p_collider{ filterCollider(colliderID) })
+						r_func(colliderID, *p_collider);
+				}
+			}
+			return;
+		}
+
+		int const lastColumn{ static_cast<int>(m_grid.m_cells.size()) - 1 };
+		int const lastRow{ static_cast<int>(m_grid.m_cells.front().size()) - 1 };
+		auto const getClampedIndex = [&](vec2 const& r_point)
+			{
+				GridID index{ m_grid.GetIndex(r_point.x, r_point.y) };
+				index.x = std::clamp(index.x, 0, lastColumn);
+				index.y = std::clamp(index.y, 0, lastRow);
+				return index;
+			};
+
+		GridID const minID{ getClampedIndex(r_min) };
+		GridID const maxID{ getClampedIndex(r_max) };
+
+		for (int col{ minID.x }; col <= maxID.x; ++col)
+		{
+			for (int row{ minID.y }; row <= maxID.y; ++row)
+			{
+				for (EntityID colliderID : m_grid.m_cells[col][row].GetEntityIDs())
+				{
+					Collider const* p_collider{ filterCollider(colliderID) };
+					if (!p_collider) { continue; }
+
+					// only visit the collider from the cell holding the lowest corner of its overlap with the area
+					vec2 colliderMin{}, colliderMax{};
+					std::visit([&](auto const& r_col)
+						{
+							GetColliderBounds(r_col, colliderMin, colliderMax);
+						}, p_collider->colliderVariant);
+
+					GridID const ownerID{ getClampedIndex(vec2{ std::max(colliderMin.x, r_min.x), std::max(colliderMin.y, r_min.y) }) };
+					if (ownerID.x != col || ownerID.y != row) { continue; }
+
+					r_func(colliderID, *p_collider);
+				}
+			}
+		}
+	}
+
 	void CollisionManager::DestroySystem()
 	{
 		m_manifolds.clear();
@@ -178,14 +495,26 @@ namespace PE
 				Transform const& transform = EntityManager::GetInstance().Get<Transform>(ColliderID);
 				Collider& collider = EntityManager::GetInstance().Get<Collider>(ColliderID);
 
-				// remove objects that were checked for collision from previous frame
-				collider.collisionChecked.clear();
+				RigidBody* p_rigidBody{ EntityManager::GetInstance().Has<RigidBody>(ColliderID) ? EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID) : nullptr };
+				bool const isResting{ p_rigidBody && p_rigidBody->IsResting(transform.position, vec2{ transform.width, transform.height }) };
 
 				// update each collider
 				std::visit([&](auto& col)
 					{
+						vec2 restMin{}, restMax{};
+						if (isResting) { GetColliderBounds(col, restMin, restMax); }
+
 						Update(col, transform.position, vec2(transform.width, transform.height));
 
+						// sleeping bodies that have not been moved keep the same collider unless its offsets were edited
+						if (!isResting) { return; }
+						vec2 newMin{}, newMax{};
+						GetColliderBounds(col, newMin, newMax);
+						float const epsilonSquared{ RigidBody::restingEpsilon * RigidBody::restingEpsilon };
+						if ((newMin - restMin).LengthSquared() > epsilonSquared || (newMax - restMax).LengthSquared() > epsilonSquared)
+						{
+							p_rigidBody->WakeUp();
+						}
 					}, collider.colliderVariant);
 			}
 		}
@@ -193,6 +522,36 @@ namespace PE
 
 	void CollisionManager::TestColliders()
 	{
+		GatherCandidates();
+
+		// split the candidates into contiguous ranges, one per task. as the candidates are sorted
+		// by pair key, merging the task buffers in order gives the same result for any thread count
+		constexpr size_t minCandidatesPerTask{ 32 };
+		size_t taskCount{ std::max<size_t>(1, std::min<size_t>(narrowphaseThreads, m_candidates.size() / minCandidatesPerTask)) };
+		size_t const candidatesPerTask{ (m_candidates.size() + taskCount - 1) / taskCount };
+
+		if (m_narrowphaseBuffers.size() < taskCount)
+			m_narrowphaseBuffers.resize(taskCount);
+
+		ThreadPool::GetInstance().ReserveThreads(narrowphaseThreads);
+		ThreadPool::GetInstance().ParallelFor(static_cast<unsigned>(taskCount), [&](unsigned taskIndex)
+			{
+				size_t const beginIndex{ std::min(m_candidates.size(), taskIndex * candidatesPerTask) };
+				size_t const endIndex{ std::min(m_candidates.size(), beginIndex + candidatesPerTask) };
+				RunNarrowphase(beginIndex, endIndex, m_narrowphaseBuffers[taskIndex]);
+			});
+
+		m_stepEvents.clear();
+		MergeNarrowphaseResults(taskCount);
+		DispatchCollisionEvents();
+	}
+
+	void CollisionManager::GatherCandidates()
+	{
+		PE_PROFILE_SCOPE("Collision Broadphase");
+		m_candidateKeys.clear();
+		m_candidates.clear();
+
 		if (gridActive)
 		{
 			for (auto& r_col : m_grid.m_cells)
@@ -201,140 +560,15 @@ namespace PE
 				{
 					if (r_cell.CheckToTest())
 						continue;
-					std::vector<EntityID> const IDs = r_cell.GetEntityIDs();
+					std::vector<EntityID> const& IDs = r_cell.GetEntityIDs();
 
-					for (EntityID ColliderID_1 : IDs)
+					for (size_t i{ 0 }; i < IDs.size(); ++i)
 					{
-						// if the entity is not active, do not check for collision
-						if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_1).isActive) { continue; }
-
-						Collider& collider1 = EntityManager::GetInstance().Get<Collider>(ColliderID_1);
-						for (EntityID ColliderID_2 : IDs)
+						for (size_t j{ i + 1 }; j < IDs.size(); ++j)
 						{
-							// if the entity is not active, do not check for collision
-							if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_2).isActive) { continue; }
-
-							Collider& collider2 = EntityManager::GetInstance().Get<Collider>(ColliderID_2);
-
 							// if its the same don't check
-							if (ColliderID_1 == ColliderID_2) { continue; }
-							// if they have been checked before don't check again
-							if (collider1.collisionChecked.count(ColliderID_2)) { continue; }
-							// if the layers are not colliding, don't check
-							if (!CollisionLayerManager::GetInstance().GetCollisionLayer(collider1.collisionLayerIndex)->IsCollidingWith(collider2.collisionLayerIndex)) { continue; }
-
-							std::visit([&](auto& col1)
-								{
-									std::visit([&](auto& col2)
-										{
-											Contact contactPt;
-											if (CollisionIntersection(col1, col2, contactPt)) // responsive collision
-											{
-												// adds collided objects so that it won't be checked again
-												collider1.collisionChecked.emplace(ColliderID_2);
-												collider2.collisionChecked.emplace(ColliderID_1);
-												if (!collider1.isTrigger && !collider2.isTrigger)
-												{
-													if (EntityManager::GetInstance().Has<RigidBody>(ColliderID_1) && EntityManager::GetInstance().Has<RigidBody>(ColliderID_2))
-													{
-														if (m_collisionPairs.count(std::pair{ ColliderID_1, ColliderID_2 }) || m_collisionPairs.count(std::pair{ColliderID_2, ColliderID_1}))
-														{
-															// if the current pair being checked was already collided in previous frame send stay collision event
-															OnCollisionStayEvent OCSE;
-															OCSE.Entity1 = ColliderID_1;
-															OCSE.Entity2= ColliderID_2;
-															SEND_COLLISION_EVENT(OCSE);
-														}
-														else
-														{
-															// else add it to the set
-															OnCollisionEnterEvent OCEE;
-															OCEE.Entity1 = ColliderID_1;
-															OCEE.Entity2 = ColliderID_2;
-															SEND_COLLISION_EVENT(OCEE);
-															m_collisionPairs.emplace(std::pair{ ColliderID_1, ColliderID_2 });
-														}
-														
-														if (std::holds_alternative<AABBCollider>(collider1.colliderVariant) && std::holds_alternative<CircleCollider>(collider2.colliderVariant))
-														{
-															m_manifolds.emplace_back
-															(Manifold{ contactPt,
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_2),
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_1),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_2),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_1) });
-														}
-														else
-														{
-															m_manifolds.emplace_back
-															(Manifold{ contactPt,
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_1),
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_2),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_1),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_2) });
-														}
-													}
-													else
-													{
-														std::stringstream ss;
-														ss << "Error: Missing RigidBody at Collision between Entities " << ColliderID_1 << " & " << ColliderID_2 << '\n';
-														engine_logger.AddLog(false, ss.str(), "");
-													}
-												}
-												else // trigger collision
-												{
-													// else send message to trigger event associated with this entity
-													//engine_logger.AddLog(false, "Collided with Trigger!\n", "");
-													
-													//sending trigger enter event
-													if (m_collisionPairs.count(std::pair{ ColliderID_1, ColliderID_2 }) || m_collisionPairs.count(std::pair{ ColliderID_2, ColliderID_1 }))
-													{
-														// if the current pair being checked was already collided in previous frame send stay collision event
-														OnTriggerStayEvent OTSE;
-														OTSE.Entity1 = ColliderID_1;
-														OTSE.Entity2 = ColliderID_2;
-														SEND_COLLISION_EVENT(OTSE);
-													}
-													else
-													{
-														// else add it to the set
-														OnTriggerEnterEvent OTEE;
-														OTEE.Entity1 = ColliderID_1;
-														OTEE.Entity2 = ColliderID_2;
-														SEND_COLLISION_EVENT(OTEE);
-														m_collisionPairs.emplace(std::pair{ ColliderID_1, ColliderID_2 });
-													}
-												}
-											}
-											else // no collision
-											{
-												if (m_collisionPairs.count(std::pair{ ColliderID_1, ColliderID_2 }) || m_collisionPairs.count(std::pair{ ColliderID_2, ColliderID_1 }))
-												{
-													if (!collider1.isTrigger && !collider2.isTrigger)
-													{
-														// if the current pair being checked was already collided in previous frame and is not colliding anymore, send collision exit event
-														OnCollisionExitEvent OCExitE;
-														OCExitE.Entity1 = ColliderID_1;
-														OCExitE.Entity2 = ColliderID_2;
-														SEND_COLLISION_EVENT(OCExitE);
-													}
-													else
-													{
-														// if the current pair being checked was already triggered in previous frame and is not triggered anymore, send trigger exit event
-														OnTriggerExitEvent OTExitE;
-														OTExitE.Entity1 = ColliderID_1;
-														OTExitE.Entity2 = ColliderID_2;
-														SEND_COLLISION_EVENT(OTExitE);
-													}
-													
-													// if 1,2 arent the pair in the set try erasing 2,1 combo
-													!m_collisionPairs.erase(std::pair{ ColliderID_1, ColliderID_2 }) || m_collisionPairs.erase(std::pair{ ColliderID_2, ColliderID_1 });
-												}
-											}
-
-										}, collider2.colliderVariant);
-
-								}, collider1.colliderVariant);
+							if (IDs[i] == IDs[j]) { continue; }
+							m_candidateKeys.emplace_back(std::min(IDs[i], IDs[j]), std::max(IDs[i], IDs[j]));
 						}
 					}
 				}
@@ -342,100 +576,269 @@ namespace PE
 		}
 		else
 		{
+			std::vector<EntityID> colliderIDs;
 			for (const auto& layer : LayerView<Collider, Transform>())
 			{
-				for (EntityID ColliderID_1 : InternalView(layer))
+				for (EntityID colliderID : InternalView(layer))
 				{
-					// if the entity is not active, do not check for collision
-					if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_1).isActive) { continue; }
+					colliderIDs.emplace_back(colliderID);
+				}
+			}
 
-					Collider& collider1 = EntityManager::GetInstance().Get<Collider>(ColliderID_1);
+			for (size_t i{ 0 }; i < colliderIDs.size(); ++i)
+			{
+				for (size_t j{ i + 1 }; j < colliderIDs.size(); ++j)
+				{
+					if (colliderIDs[i] == colliderIDs[j]) { continue; }
+					m_candidateKeys.emplace_back(std::min(colliderIDs[i], colliderIDs[j]), std::max(colliderIDs[i], colliderIDs[j]));
+				}
+			}
+		}
 
-					for (const auto& layer2 : LayerView<Collider, Transform>())
-					{
-						for (EntityID ColliderID_2 : InternalView(layer2))
+		// pairs that share more than one cell only need to be tested once
+		std::sort(m_candidateKeys.begin(), m_candidateKeys.end());
+		m_candidateKeys.erase(std::unique(m_candidateKeys.begin(), m_candidateKeys.end()), m_candidateKeys.end());
+
+		for (auto const& [ColliderID_1, ColliderID_2] : m_candidateKeys)
+		{
+			// if the entity is not active, do not check for collision
+			if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_1).isActive) { continue; }
+			if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_2).isActive) { continue; }
+
+			Collider& collider1 = EntityManager::GetInstance().Get<Collider>(ColliderID_1);
+			Collider& collider2 = EntityManager::GetInstance().Get<Collider>(ColliderID_2);
+
+			// if the layers are not colliding, don't check
+			if (!CollisionLayerManager::GetInstance().GetCollisionLayer(collider1.collisionLayerIndex)->IsCollidingWith(collider2.collisionLayerIndex)
+				&& !CollisionLayerManager::GetInstance().GetCollisionLayer(collider2.collisionLayerIndex)->IsCollidingWith(collider1.collisionLayerIndex)) { continue; }
+
+			Transform* p_transform1{ EntityManager::GetInstance().GetPointer<Transform>(ColliderID_1) };
+			Transform* p_transform2{ EntityManager::GetInstance().GetPointer<Transform>(ColliderID_2) };
+			RigidBody* p_rigidBody1{ EntityManager::GetInstance().Has<RigidBody>(ColliderID_1) ? EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_1) : nullptr };
+			RigidBody* p_rigidBody2{ EntityManager::GetInstance().Has<RigidBody>(ColliderID_2) ? EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_2) : nullptr };
+
+			// neither collider has changed since the last step if both bodies are asleep and unmoved
+			bool const isResting{ p_rigidBody1 && p_rigidBody2
+				&& p_rigidBody1->IsResting(p_transform1->position, vec2{ p_transform1->width, p_transform1->height })
+				&& p_rigidBody2->IsResting(p_transform2->position, vec2{ p_transform2->width, p_transform2->height }) };
+
+			m_candidates.emplace_back(CollisionCandidate{ ColliderID_1, ColliderID_2, &collider1, &collider2,
+				p_transform1, p_transform2, p_rigidBody1, p_rigidBody2, isResting });
+		}
+	}
+
+	void CollisionManager::RunNarrowphase(size_t beginIndex, size_t endIndex, NarrowphaseBuffer& r_buffer) const
+	{
+		PE_PROFILE_SCOPE("Collision Narrowphase");
+		r_buffer.manifolds.clear();
+		r_buffer.events.clear();
+		r_buffer.missingRigidBodies.clear();
+
+		for (size_t i{ beginIndex }; i < endIndex; ++i)
+		{
+			CollisionCandidate const& r_candidate{ m_candidates[i] };
+			Collider const& collider1{ *r_candidate.p_collider1 };
+			Collider const& collider2{ *r_candidate.p_collider2 };
+
+			// the set is only read here, it is updated when the results are merged
+			bool const wasColliding{ m_collisionPairs.count(std::pair{ r_candidate.entity1, r_candidate.entity2 }) > 0 };
+			bool const isSolid{ !collider1.isTrigger && !collider2.isTrigger };
+
+			// resting pairs cannot have started or stopped colliding
+			if (r_candidate.isResting)
+			{
+				if (wasColliding)
+				{
+					r_buffer.events.emplace_back(CollisionEventData{ isSolid ? CollisionEvents::OnCollisionStay : CollisionEvents::OnTriggerStay,
+																	 r_candidate.entity1, r_candidate.entity2, collider1.collisionLayerIndex, collider2.collisionLayerIndex });
+				}
+				continue;
+			}
+
+			Contact contactPt;
+			bool collided{ false };
+			std::visit([&](auto const& col1)
+				{
+					std::visit([&](auto const& col2)
 						{
-							// if the entity is not active, do not check for collision
-							if (!EntityManager::GetInstance().Get<EntityDescriptor>(ColliderID_2).isActive) { continue; }
+							collided = CollisionIntersection(col1, col2, contactPt);
+						}, collider2.colliderVariant);
+				}, collider1.colliderVariant);
 
-							Collider& collider2 = EntityManager::GetInstance().Get<Collider>(ColliderID_2);
+			if (collided)
+			{
+				if (isSolid) // responsive collision
+				{
+					if (r_candidate.p_rigidBody1 && r_candidate.p_rigidBody2)
+					{
+						// stay if the pair was already collided in the previous step, enter otherwise
+						r_buffer.events.emplace_back(CollisionEventData{ wasColliding ? CollisionEvents::OnCollisionStay : CollisionEvents::OnCollisionEnter,
+																		 r_candidate.entity1, r_candidate.entity2, collider1.collisionLayerIndex, collider2.collisionLayerIndex });
 
-							// if its the same don't check
-							if (ColliderID_1 == ColliderID_2) { continue; }
-							// if they have been checked before don't check again
-							if (collider1.collisionChecked.count(ColliderID_2)) { continue; }
-							// if the layers are not colliding, don't check
-							if (!CollisionLayerManager::GetInstance().GetCollisionLayer(collider1.collisionLayerIndex)->IsCollidingWith(collider2.collisionLayerIndex)) { continue; }
-
-							std::visit([&](auto& col1)
-								{
-									std::visit([&](auto& col2)
-										{
-											Contact contactPt;
-											if (CollisionIntersection(col1, col2, contactPt))
-											{
-												// adds collided objects so that it won't be checked again
-												collider1.collisionChecked.emplace(ColliderID_2);
-												collider2.collisionChecked.emplace(ColliderID_1);
-												if (!collider1.isTrigger && !collider2.isTrigger)
-												{
-													if (EntityManager::GetInstance().Has<RigidBody>(ColliderID_1) && EntityManager::GetInstance().Has<RigidBody>(ColliderID_2))
-													{
-														OnCollisionEnterEvent OCEE;
-														OCEE.Entity1 = ColliderID_1;
-														OCEE.Entity2 = ColliderID_2;
-														SEND_COLLISION_EVENT(OCEE);
-														if (std::holds_alternative<AABBCollider>(collider1.colliderVariant) && std::holds_alternative<CircleCollider>(collider2.colliderVariant))
-														{
-															m_manifolds.emplace_back
-															(Manifold{ contactPt,
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_2),
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_1),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_2),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_1) });
-														}
-														else
-														{
-															m_manifolds.emplace_back
-															(Manifold{ contactPt,
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_1),
-																		EntityManager::GetInstance().Get<Transform>(ColliderID_2),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_1),
-																		EntityManager::GetInstance().GetPointer<RigidBody>(ColliderID_2) });
-														}
-													}
-													else
-													{
-														std::stringstream ss;
-														ss << "Error: Missing RigidBody at Collision between Entities " << ColliderID_1 << " & " << ColliderID_2 << '\n';
-														engine_logger.AddLog(false, ss.str(), "");
-													}
-												}
-												else
-												{
-													// else send message to trigger event associated with this entity
-													engine_logger.AddLog(false, "Collided with Trigger!\n", "");
-													//sending collision enter event
-													OnTriggerEnterEvent OTEE;
-													OTEE.Entity1 = ColliderID_1;
-													OTEE.Entity2 = ColliderID_2;
-													SEND_COLLISION_EVENT(OTEE);
-												}
-
-											}
-
-										}, collider2.colliderVariant);
-
-								}, collider1.colliderVariant);
+						if (std::holds_alternative<AABBCollider>(collider1.colliderVariant) && std::holds_alternative<CircleCollider>(collider2.colliderVariant))
+						{
+							r_buffer.manifolds.emplace_back
+							(Manifold{ contactPt,
+										*r_candidate.p_transform2, *r_candidate.p_transform1,
+										r_candidate.p_rigidBody2, r_candidate.p_rigidBody1 });
+						}
+						else
+						{
+							r_buffer.manifolds.emplace_back
+							(Manifold{ contactPt,
+										*r_candidate.p_transform1, *r_candidate.p_transform2,
+										r_candidate.p_rigidBody1, r_candidate.p_rigidBody2 });
 						}
 					}
+					else
+					{
+						r_buffer.missingRigidBodies.emplace_back(r_candidate.entity1, r_candidate.entity2);
+					}
+				}
+				else // trigger collision
+				{
+					r_buffer.events.emplace_back(CollisionEventData{ wasColliding ? CollisionEvents::OnTriggerStay : CollisionEvents::OnTriggerEnter,
+																	 r_candidate.entity1, r_candidate.entity2, collider1.collisionLayerIndex, collider2.collisionLayerIndex });
+				}
+			}
+			else if (wasColliding) // no collision, but they were colliding in the previous step
+			{
+				r_buffer.events.emplace_back(CollisionEventData{ isSolid ? CollisionEvents::OnCollisionExit : CollisionEvents::OnTriggerExit,
+																 r_candidate.entity1, r_candidate.entity2, collider1.collisionLayerIndex, collider2.collisionLayerIndex });
+			}
+		}
+	}
+
+	void CollisionManager::MergeNarrowphaseResults(size_t bufferCount)
+	{
+		for (size_t i{ 0 }; i < bufferCount; ++i)
+		{
+			NarrowphaseBuffer& r_buffer{ m_narrowphaseBuffers[i] };
+
+			for (Manifold const& r_manifold : r_buffer.manifolds)
+			{
+				RigidBody& r_rigidBodyA{ *r_manifold.p_rigidBodyA };
+				RigidBody& r_rigidBodyB{ *r_manifold.p_rigidBodyB };
+
+				// a sleeping body is only woken by a partner that is awake and moving, or by a contact
+				// that would push it by more than the resting epsilon, so bodies resting on each other
+				// or on the floor can stay asleep
+				float const approachSpeed{ std::abs(Dot(r_rigidBodyA.velocity - r_rigidBodyB.velocity, r_manifold.contactData.normal)) };
+				bool const isPushing{ approachSpeed > RigidBody::restingEpsilon || r_manifold.contactData.penetrationDepth > RigidBody::restingEpsilon };
+				if (!r_rigidBodyA.IsAwake() && (isPushing || (r_rigidBodyB.IsAwake() && !r_rigidBodyB.HasRestingVelocity())))
+					r_rigidBodyA.WakeUp();
+				if (!r_rigidBodyB.IsAwake() && (isPushing || (r_rigidBodyA.IsAwake() && !r_rigidBodyA.HasRestingVelocity())))
+					r_rigidBodyB.WakeUp();
+
+				// contacts that leave a body asleep are too small to need resolving
+				if (!r_rigidBodyA.IsAwake() || !r_rigidBodyB.IsAwake()) { continue; }
+				m_manifolds.emplace_back(r_manifold);
+			}
+
+			for (CollisionEventData const& r_record : r_buffer.events)
+			{
+				switch (r_record.type)
+				{
+				case CollisionEvents::OnCollisionEnter:
+				case CollisionEvents::OnTriggerEnter:
+					m_collisionPairs.emplace(std::pair{ r_record.Entity1, r_record.Entity2 });
+					break;
+				case CollisionEvents::OnCollisionExit:
+				case CollisionEvents::OnTriggerExit:
+					m_collisionPairs.erase(std::pair{ r_record.Entity1, r_record.Entity2 });
+					break;
+				default:
+					break;
 				}
+				m_stepEvents.emplace_back(r_record);
+			}
+
+			for (auto const& [ColliderID_1, ColliderID_2] : r_buffer.missingRigidBodies)
+			{
+				std::stringstream ss;
+				ss << "Error: Missing RigidBody at Collision between Entities " << ColliderID_1 << " & " << ColliderID_2 << '\n';
+				engine_logger.AddLog(false, ss.str(), "");
 			}
+
+			r_buffer.manifolds.clear();
+		}
+	}
+
+	void CollisionManager::DispatchCollisionEvents()
+	{
+		PE_PROFILE_SCOPE("Collision Events");
+
+		// listeners of the dispatcher receive every event of the types they subscribed to,
+		// events of types nobody subscribed to are not built
+		EventDispatcher<CollisionEvents> const& r_dispatcher{ EventHandler::GetInstance().CollisionEventDispatcher };
+		for (CollisionEventData const& r_event : m_stepEvents)
+		{
+			if (r_dispatcher.HasListeners(r_event.type))
+				SendCollisionEvent(r_event);
+		}
+
+		// routed listeners only receive the events of their entities or collision layers
+		EventHandler::GetInstance().CollisionRouter.Dispatch(m_stepEvents.data(), m_stepEvents.size());
+	}
+
+	void CollisionManager::SendCollisionEvent(CollisionEventData const& r_record)
+	{
+		switch (r_record.type)
+		{
+		case CollisionEvents::OnCollisionEnter:
+		{
+			OnCollisionEnterEvent OCEE;
+			OCEE.Entity1 = r_record.Entity1;
+			OCEE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OCEE);
+			break;
+		}
+		case CollisionEvents::OnCollisionStay:
+		{
+			OnCollisionStayEvent OCSE;
+			OCSE.Entity1 = r_record.Entity1;
+			OCSE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OCSE);
+			break;
+		}
+		case CollisionEvents::OnCollisionExit:
+		{
+			OnCollisionExitEvent OCExitE;
+			OCExitE.Entity1 = r_record.Entity1;
+			OCExitE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OCExitE);
+			break;
+		}
+		case CollisionEvents::OnTriggerEnter:
+		{
+			OnTriggerEnterEvent OTEE;
+			OTEE.Entity1 = r_record.Entity1;
+			OTEE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OTEE);
+			break;
+		}
+		case CollisionEvents::OnTriggerStay:
+		{
+			OnTriggerStayEvent OTSE;
+			OTSE.Entity1 = r_record.Entity1;
+			OTSE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OTSE);
+			break;
+		}
+		case CollisionEvents::OnTriggerExit:
+		{
+			OnTriggerExitEvent OTExitE;
+			OTExitE.Entity1 = r_record.Entity1;
+			OTExitE.Entity2 = r_record.Entity2;
+			SEND_COLLISION_EVENT(OTExitE);
+			break;
+		}
 		}
 	}
 
 	void CollisionManager::ResolveCollision()
 	{
+		PE_PROFILE_SCOPE("Collision Resolution");
 		for (Manifold& r_manifold : m_manifolds)
 		{
 			r_manifold.ResolveCollision();
@@ -662,4 +1065,175 @@ namespace PE
 		if (r_point.y < r_AABB.min.y || r_point.y > r_AABB.max.y) { return false; }
 		return true;
 	}
+
+	// ----- Scene Query Helper Functions ----- //
+	void GetColliderBounds(AABBCollider const& r_AABB, vec2& r_min, vec2& r_max)
+	{
+		r_min = r_AABB.min;
+		r_max = r_AABB.max;
+	}
+
+	void GetColliderBounds(CircleCollider const& r_circle, vec2& r_min, vec2& r_max)
+	{
+		r_min = r_circle.center - vec2{ r_circle.radius, r_circle.radius };
+		r_max = r_circle.center + vec2{ r_circle.radius, r_circle.radius };
+	}
+
+	vec2 ClosestPoint(AABBCollider const& r_AABB, vec2 const& r_point)
+	{
+		vec2 closestPoint{ r_point };
+		Clamp(closestPoint.x, r_AABB.min.x, r_AABB.max.x);
+		Clamp(closestPoint.y, r_AABB.min.y, r_AABB.max.y);
+		return closestPoint;
+	}
+
+	vec2 ClosestPoint(CircleCollider const& r_circle, vec2 const& r_point)
+	{
+		vec2 const centerToPoint{ r_point - r_circle.center };
+		float const lengthSquared{ centerToPoint.LengthSquared() };
+		if (lengthSquared <= r_circle.radius * r_circle.radius) { return r_point; }
+
+		return r_circle.center + centerToPoint * (r_circle.radius / sqrtf(lengthSquared));
+	}
+
+	bool QueryOverlap(AABBCollider const& r_AABB, AABBCollider const& r_query)
+	{
+		if (r_AABB.max.x < r_query.min.x || r_AABB.min.x > r_query.max.x) { return false; }
+		if (r_AABB.max.y < r_query.min.y || r_AABB.min.y > r_query.max.y) { return false; }
+		return true;
+	}
+
+	bool QueryOverlap(CircleCollider const& r_circle, AABBCollider const& r_query)
+	{
+		return (ClosestPoint(r_query, r_circle.center) - r_circle.center).LengthSquared() <= r_circle.radius * r_circle.radius;
+	}
+
+	bool RayIntersection(AABBCollider const& r_AABB, vec2 const& r_origin, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		float entryDistance{ 0.f };
+		float exitDistance{ maxDistance };
+		vec2 normal{ -r_direction }; // kept if the ray starts inside the box
+
+		// clips the ray against the pair of faces of one axis, returns false if the ray misses them
+		auto const clipAxis = [&](float origin, float direction, float min, float max, vec2 const& r_axis)
+			{
+				if (std::abs(direction) < std::numeric_limits<float>::epsilon())
+				{
+					// parallel to the faces, the ray has to start between them
+					return origin >= min && origin <= max;
+				}
+
+				float nearDistance{ (min - origin) / direction };
+				float farDistance{ (max - origin) / direction };
+				vec2 faceNormal{ -r_axis };
+				if (nearDistance > farDistance)
+				{
+					std::swap(nearDistance, farDistance);
+					faceNormal = r_axis;
+				}
+
+				if (nearDistance > entryDistance)
+				{
+					entryDistance = nearDistance;
+					normal = faceNormal;
+				}
+				exitDistance = std::min(exitDistance, farDistance);
+				return entryDistance <= exitDistance;
+			};
+
+		if (!clipAxis(r_origin.x, r_direction.x, r_AABB.min.x, r_AABB.max.x, vec2{ 1.f, 0.f })) { return false; }
+		if (!clipAxis(r_origin.y, r_direction.y, r_AABB.min.y, r_AABB.max.y, vec2{ 0.f, 1.f })) { return false; }
+
+		r_distance = entryDistance;
+		r_normal = normal;
+		return true;
+	}
+
+	bool RayIntersection(CircleCollider const& r_circle, vec2 const& r_origin, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		vec2 const centerToOrigin{ r_origin - r_circle.center };
+		float const c{ centerToOrigin.LengthSquared() - r_circle.radius * r_circle.radius };
+
+		// the ray starts inside the circle
+		if (c <= 0.f)
+		{
+			r_distance = 0.f;
+			r_normal = -r_direction;
+			return true;
+		}
+
+		// the ray starts outside and points away from the circle
+		float const b{ centerToOrigin.Dot(r_direction) };
+		if (b > 0.f) { return false; }
+
+		float const discriminant{ b * b - c };
+		if (discriminant < 0.f) { return false; }
+
+		float const distance{ -b - sqrtf(discriminant) };
+		if (distance > maxDistance) { return false; }
+
+		r_distance = distance;
+		r_normal = (r_origin + r_direction * distance - r_circle.center).GetNormalized();
+		return true;
+	}
+
+	bool SweepIntersection(AABBCollider const& r_AABB, CircleCollider const& r_sweptCircle, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		AABBCollider grownAABB{ r_AABB };
+		grownAABB.min -= vec2{ r_sweptCircle.radius, r_sweptCircle.radius };
+		grownAABB.max += vec2{ r_sweptCircle.radius, r_sweptCircle.radius };
+
+		float distance{ 0.f };
+		vec2 normal{};
+		if (!RayIntersection(grownAABB, r_sweptCircle.center, r_direction, maxDistance, distance, normal)) { return false; }
+
+		// past the corners of the original box the grown box is rounded off,
+		// so the circle's center has to hit the circle around that corner instead
+		vec2 const entryPoint{ r_sweptCircle.center + r_direction * distance };
+		bool const pastX{ entryPoint.x < r_AABB.min.x || entryPoint.x > r_AABB.max.x };
+		bool const pastY{ entryPoint.y < r_AABB.min.y || entryPoint.y > r_AABB.max.y };
+		if (pastX && pastY)
+		{
+			CircleCollider corner;
+			corner.center = vec2{ (entryPoint.x < r_AABB.min.x) ? r_AABB.min.x : r_AABB.max.x,
+								  (entryPoint.y < r_AABB.min.y) ? r_AABB.min.y : r_AABB.max.y };
+			corner.radius = r_sweptCircle.radius;
+			return RayIntersection(corner, r_sweptCircle.center, r_direction, maxDistance, r_distance, r_normal);
+		}
+
+		r_distance = distance;
+		r_normal = normal;
+		return true;
+	}
+
+	bool SweepIntersection(CircleCollider const& r_circle, CircleCollider const& r_sweptCircle, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		// moving a circle against a circle is the same as casting its center against
+		// a circle with the sum of both radii
+		CircleCollider grownCircle{ r_circle };
+		grownCircle.radius += r_sweptCircle.radius;
+		return RayIntersection(grownCircle, r_sweptCircle.center, r_direction, maxDistance, r_distance, r_normal);
+	}
+
+	bool SweepIntersection(AABBCollider const& r_AABB, AABBCollider const& r_sweptAABB, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		// moving a box against a box is the same as casting its center against
+		// the other box grown by half of its size
+		vec2 const halfSize{ (r_sweptAABB.max - r_sweptAABB.min) * 0.5f };
+		AABBCollider grownAABB{ r_AABB };
+		grownAABB.min -= halfSize;
+		grownAABB.max += halfSize;
+		return RayIntersection(grownAABB, (r_sweptAABB.min + r_sweptAABB.max) * 0.5f, r_direction, maxDistance, r_distance, r_normal);
+	}
+
+	bool SweepIntersection(CircleCollider const& r_circle, AABBCollider const& r_sweptAABB, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal)
+	{
+		// the box touches the circle after the same distance as the circle moving
+		// the opposite way would touch the box, with the contact normal flipped
+		vec2 normal{};
+		if (!SweepIntersection(r_sweptAABB, r_circle, -r_direction, maxDistance, r_distance, normal)) { return false; }
+
+		r_normal = -normal;
+		return true;
+	}
 }
\ No newline at end of file
@@ -16,9 +16,63 @@
 #pragma once
 #include "System.h"
 #include "SpatialGrid.h"
+#include "Events/CollisionEvent.h"
+#include "Events/CollisionEventRouter.h"
+#include <array>
+#include "Memory/PoolAllocator.h"
 
 namespace PE
 {
+	// ----- Scene Query Types ----- //
+
+	//! Layer mask with the bit of every collision layer set, lets a scene query hit colliders on any layer
+	constexpr unsigned ALL_COLLISION_LAYERS_MASK{ (1U << TOTAL_COLLISION_LAYERS) - 1U };
+
+	//! Non-owning view of a buffer provided by the caller that a scene query writes its results into
+	template <typename T>
+	struct QuerySpan
+	{
+		T* p_data{ nullptr };
+		size_t capacity{ 0 };
+
+		QuerySpan(T* p_buffer, size_t bufferCapacity) : p_data{ p_buffer }, capacity{ bufferCapacity } {}
+
+		template <size_t N>
+		QuerySpan(T(&r_buffer)[N]) : p_data{ r_buffer }, capacity{ N } {}
+
+		template <size_t N>
+		QuerySpan(std::array<T, N>& r_buffer) : p_data{ r_buffer.data() }, capacity{ N } {}
+	};
+
+	//! Optional filter for scene queries, entities it returns false for are skipped before they take up space in the results
+	using QueryFilter = bool(*)(EntityID);
+
+	//! Closest collider hit by a raycast
+	struct RaycastHit
+	{
+		EntityID entity{ 0 };
+		vec2 point{}; // point where the ray first touches the collider
+		vec2 normal{}; // surface normal at the point, facing the ray origin
+		float distance{ 0.f }; // distance along the ray to the point
+	};
+
+	//! First collider touched by a swept circle
+	struct SweepHit
+	{
+		EntityID entity{ 0 };
+		vec2 position{}; // center of the swept circle when it first touches the collider
+		vec2 point{}; // point of contact between the swept circle and the collider
+		vec2 normal{}; // surface normal at the point, facing the swept circle
+		float distance{ 0.f }; // distance the circle travelled before touching the collider
+	};
+
+	//! Collider found by a nearest query along with its distance from the query position
+	struct NearestHit
+	{
+		EntityID entity{ 0 };
+		float distance{ 0.f }; // distance from the query position to the closest point on the collider
+	};
+
 
 	class CollisionManager : public System
 	{
@@ -27,6 +81,7 @@ namespace PE
 		// ----- Public Variable ----- //
 		static vec2 gridSize;
 		static bool gridActive;
+		static unsigned narrowphaseThreads; // number of threads the narrowphase is split across, 1 runs it all on the main thread
 
 		// ----- Constructors/Destructors ----- //
 		/*!***********************************************************************************
@@ -89,6 +144,9 @@ namespace PE
 		/*!***********************************************************************************
 		 \brief Tests for collision between two objects by inputting them as parameters into a
 		 		helper function that tests collision for various types of collisions.
+				The candidate pairs are split across narrowphaseThreads threads and the results
+				are merged in pair order, so events and manifolds come out the same regardless
+				of the number of threads used.
 		 
 		*************************************************************************************/
 		void TestColliders();
@@ -103,13 +161,212 @@ namespace PE
 		 \brief Sets up the private grid in the manager
 
 		*************************************************************************************/
-		void SetUpGrid() { m_grid.SetupGrid(gridSize.x, gridSize.y); }
+		void SetUpGrid() { m_grid.SetupGrid(gridSize.x, gridSize.y); m_gridUpdated = false; }
+
+		// ----- Scene Queries ----- //
+		// The queries look at the colliders as of the last collision step and only visit the grid
+		// cells that overlap the query area. If the grid was not updated in the last step, every
+		// collider is checked instead. Inactive entities are always skipped.
+
+		/*!***********************************************************************************
+		 \brief Casts a ray and finds the closest collider it hits
+
+		 \param[in] r_origin 		- start point of the ray
+		 \param[in] r_direction 	- direction of the ray, does not need to be normalized
+		 \param[in] maxDistance 	- length of the ray
+		 \param[out] r_hit 			- filled with the closest hit if there is one
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i can be hit
+		 \param[in] hitTriggers 	- whether trigger colliders can be hit
+		 \return true - the ray hit a collider
+		 \return false - the ray did not hit any collider
+		*************************************************************************************/
+		bool Raycast(vec2 const& r_origin, vec2 const& r_direction, float maxDistance, RaycastHit& r_hit,
+					 unsigned layerMask = ALL_COLLISION_LAYERS_MASK, bool hitTriggers = true) const;
+
+		/*!***********************************************************************************
+		 \brief Finds the colliders that overlap a circle
+
+		 \param[in] r_center 		- center of the circle
+		 \param[in] radius 			- radius of the circle
+		 \param[out] results 		- buffer the IDs of the overlapping entities are written into
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i should be found
+		 \param[in] hitTriggers 	- whether trigger colliders should be found
+		 \param[in] p_filter 		- if set, only entities it returns true for are found and
+		 							  count towards the capacity of the buffer
+		 \return size_t - number of IDs written, never more than the capacity of the buffer
+		*************************************************************************************/
+		size_t OverlapCircle(vec2 const& r_center, float radius, QuerySpan<EntityID> results,
+							 unsigned layerMask = ALL_COLLISION_LAYERS_MASK, bool hitTriggers = true,
+							 QueryFilter p_filter = nullptr) const;
+
+		/*!***********************************************************************************
+		 \brief Finds the colliders that overlap an axis aligned box
+
+		 \param[in] r_min 			- bottom left corner of the box
+		 \param[in] r_max 			- top right corner of the box
+		 \param[out] results 		- buffer the IDs of the overlapping entities are written into
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i should be found
+		 \param[in] hitTriggers 	- whether trigger colliders should be found
+		 \return size_t - number of IDs written, never more than the capacity of the buffer
+		*************************************************************************************/
+		size_t OverlapAABB(vec2 const& r_min, vec2 const& r_max, QuerySpan<EntityID> results,
+						   unsigned layerMask = ALL_COLLISION_LAYERS_MASK, bool hitTriggers = true) const;
+
+		/*!***********************************************************************************
+		 \brief Moves a circle along a direction and finds the first collider it touches
+
+		 \param[in] r_center 		- starting center of the circle
+		 \param[in] radius 			- radius of the circle
+		 \param[in] r_direction 	- direction to move the circle in, does not need to be normalized
+		 \param[in] maxDistance 	- distance to move the circle by
+		 \param[out] r_hit 			- filled with the first hit if there is one
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i can be hit
+		 \param[in] hitTriggers 	- whether trigger colliders can be hit
+		 \return true - the circle touched a collider
+		 \return false - the circle can move the full distance without touching any collider
+		*************************************************************************************/
+		bool SweepCircle(vec2 const& r_center, float radius, vec2 const& r_direction, float maxDistance, SweepHit& r_hit,
+						 unsigned layerMask = ALL_COLLISION_LAYERS_MASK, bool hitTriggers = true) const;
+
+		/*!***********************************************************************************
+		 \brief Moves the collider of an entity from a start position along a displacement
+				and finds the first solid collider on an interacting layer that it touches.
+				Colliders that it already overlaps at the start are left to the discrete
+				collision test. Used for continuous collision of fast moving RigidBodies.
+
+		 \param[in] id 				- entity whose collider is moved
+		 \param[in] r_start 		- position of the entity at the start of its movement
+		 \param[in] r_displacement 	- movement of the entity
+		 \param[out] r_hit 			- filled with the first hit if there is one, position is
+		 							  the entity's position at the time of impact
+		 \return true - the collider touched another collider
+		 \return false - the collider can move the full displacement without touching any collider
+		*************************************************************************************/
+		bool SweepCollider(EntityID id, vec2 const& r_start, vec2 const& r_displacement, SweepHit& r_hit) const;
+
+		/*!***********************************************************************************
+		 \brief Finds the colliders closest to a position, up to as many as the buffer can hold
+
+		 \param[in] r_position 		- position to measure the distances from
+		 \param[in] maxDistance 	- colliders further than this are ignored
+		 \param[out] results 		- buffer the hits are written into, sorted from closest to furthest
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i should be found
+		 \param[in] hitTriggers 	- whether trigger colliders should be found
+		 \param[in] p_filter 		- if set, only entities it returns true for are found and
+		 							  count towards the capacity of the buffer
+		 \return size_t - number of hits written, never more than the capacity of the buffer
+		*************************************************************************************/
+		size_t NearestK(vec2 const& r_position, float maxDistance, QuerySpan<NearestHit> results,
+						unsigned layerMask = ALL_COLLISION_LAYERS_MASK, bool hitTriggers = true,
+						QueryFilter p_filter = nullptr) const;
+
+		/*!***********************************************************************************
+		 \brief Builds the layer mask of every collision layer that interacts with a layer
+				according to the collision matrix, the same rule used to pick collision pairs
+
+		 \param[in] collisionLayerIndex - layer to build the mask for
+		 \return unsigned - bit i set if layer i interacts with collisionLayerIndex
+		*************************************************************************************/
+		static unsigned GetInteractingLayerMask(unsigned collisionLayerIndex);
+
+	private:
+		// ----- Private Structs ----- //
+
+		//! Pair of colliders found by the broadphase that still needs to be tested. entity1 is always the smaller ID.
+		struct CollisionCandidate
+		{
+			EntityID entity1, entity2;
+			Collider const* p_collider1;
+			Collider const* p_collider2;
+			Transform* p_transform1;
+			Transform* p_transform2;
+			RigidBody* p_rigidBody1; // nullptr if the entity does not have a RigidBody
+			RigidBody* p_rigidBody2;
+			bool isResting; // both entities are sleeping RigidBodies, so the result of the last step still holds
+		};
+
+		//! Output of a single narrowphase task, only ever written to by the thread running the task
+		struct NarrowphaseBuffer
+		{
+			std::vector<Manifold> manifolds;
+			std::vector<CollisionEventData> events; // sent out on the main thread once the results are merged
+			std::vector<std::pair<EntityID, EntityID>> missingRigidBodies; // solid collisions between entities without RigidBodies
+		};
+
+		// ----- Private Methods ----- //
+		/*!***********************************************************************************
+		 \brief Fills m_candidates with each unique pair of active colliders (sorted by pair
+				key) that share a grid cell, or every pair of active colliders if the grid is
+				not active, skipping pairs whose collision layers do not interact. Pairs of
+				sleeping RigidBodies are marked as resting.
+
+		*************************************************************************************/
+		void GatherCandidates();
+
+		/*!***********************************************************************************
+		 \brief Tests the candidates in [beginIndex, endIndex) for collision and writes the
+				resulting manifolds and events into r_buffer. Resting candidates are not
+				tested and only repeat their stay event. Only reads shared state, so it
+				is safe to run on worker threads.
+
+		 \param[in] beginIndex 	- index of the first candidate to test
+		 \param[in] endIndex 	- one past the index of the last candidate to test
+		 \param[out] r_buffer 	- buffer to write the results into
+		*************************************************************************************/
+		void RunNarrowphase(size_t beginIndex, size_t endIndex, NarrowphaseBuffer& r_buffer) const;
+
+		/*!***********************************************************************************
+		 \brief Merges the narrowphase buffers in task order into m_manifolds, wakes the
+				RigidBodies in contact, updates the set of colliding pairs and collects the
+				collision events into m_stepEvents. Must be called on the main thread.
+
+		 \param[in] bufferCount - number of buffers that were used this step
+		*************************************************************************************/
+		void MergeNarrowphaseResults(size_t bufferCount);
+
+		/*!***********************************************************************************
+		 \brief Delivers the events collected in m_stepEvents this step, once to the listeners
+				of the collision event dispatcher and once to the listeners of the entities
+				and collision layers involved through the collision event router.
+
+		*************************************************************************************/
+		void DispatchCollisionEvents();
+
+		/*!***********************************************************************************
+		 \brief Builds the collision event matching r_record and sends it to the listeners of
+				the collision event dispatcher
+
+		 \param[in] r_record - event to send
+		*************************************************************************************/
+		void SendCollisionEvent(CollisionEventData const& r_record);
+
+		/*!***********************************************************************************
+		 \brief Calls r_func once for every active collider that passes the layer and trigger
+				filters and whose grid cells overlap the area from r_min to r_max. Colliders
+				that span multiple cells are only visited from the cell holding the lowest
+				corner of their overlap with the area, so no scratch memory is needed to skip
+				duplicates.
+
+		 \tparam Func 				- callable taking (EntityID, Collider const&)
+		 \param[in] r_min 			- bottom left corner of the area
+		 \param[in] r_max 			- top right corner of the area
+		 \param[in] layerMask 		- bit i set if colliders on collision layer i should be visited
+		 \param[in] hitTriggers 	- whether trigger colliders should be visited
+		 \param[in] r_func 			- function to call with each collider
+		*************************************************************************************/
+		template <typename Func>
+		void ForEachColliderInArea(vec2 const& r_min, vec2 const& r_max, unsigned layerMask, bool hitTriggers, Func const& r_func) const;
 
 	private:
 
 		Grid m_grid;
-		std::vector<Manifold> m_manifolds;
-		std::set <std::pair<size_t, size_t>> m_collisionPairs;
+		std::vector<Manifold> m_manifolds; // only live until they are resolved at the end of the step, cleared without freeing so the capacity is reused
+		std::set <std::pair<size_t, size_t>, std::less<std::pair<size_t, size_t>>, PoolStdAllocator<std::pair<size_t, size_t>>> m_collisionPairs; // pairs colliding in the previous step, stored as (smaller ID, larger ID), nodes come from a pool
+		std::vector<std::pair<EntityID, EntityID>> m_candidateKeys; // reused every step to collect candidate pairs
+		std::vector<CollisionCandidate> m_candidates;
+		std::vector<NarrowphaseBuffer> m_narrowphaseBuffers;
+		std::vector<CollisionEventData> m_stepEvents; // collision events raised this step, in pair key order
+		bool m_gridUpdated{ false }; // whether the grid cells match the colliders of the last collision step
 		std::string m_systemName{ "CollisionManager" };
 	};
 
@@ -189,4 +446,162 @@ namespace PE
 	 \return false - Point not in AABB
 	*************************************************************************************/
 	bool PointCollision(AABBCollider const& r_AABB, vec2 const& r_point);
+
+	// ----- Scene Query Helper Functions ----- //
+
+	/*!***********************************************************************************
+	 \brief Gets the bounds of an AABB collider
+
+	 \param[in] r_AABB - collider to get the bounds of
+	 \param[out] r_min - bottom left corner of the bounds
+	 \param[out] r_max - top right corner of the bounds
+	*************************************************************************************/
+	void GetColliderBounds(AABBCollider const& r_AABB, vec2& r_min, vec2& r_max);
+
+	/*!***********************************************************************************
+	 \brief Gets the bounds of a circle collider
+
+	 \param[in] r_circle - collider to get the bounds of
+	 \param[out] r_min - bottom left corner of the bounds
+	 \param[out] r_max - top right corner of the bounds
+	*************************************************************************************/
+	void GetColliderBounds(CircleCollider const& r_circle, vec2& r_min, vec2& r_max);
+
+	/*!***********************************************************************************
+	 \brief Gets the point in or on an AABB collider that is closest to r_point
+
+	 \param[in] r_AABB - collider to find the point on
+	 \param[in] r_point - point to measure from
+	 \return vec2 - r_point itself if it is inside the collider, the closest point on its edge otherwise
+	*************************************************************************************/
+	vec2 ClosestPoint(AABBCollider const& r_AABB, vec2 const& r_point);
+
+	/*!***********************************************************************************
+	 \brief Gets the point in or on a circle collider that is closest to r_point
+
+	 \param[in] r_circle - collider to find the point on
+	 \param[in] r_point - point to measure from
+	 \return vec2 - r_point itself if it is inside the collider, the closest point on its edge otherwise
+	*************************************************************************************/
+	vec2 ClosestPoint(CircleCollider const& r_circle, vec2 const& r_point);
+
+	/*!***********************************************************************************
+	 \brief Checks if a collider overlaps the query circle r_query
+
+	 \param[in] r_collider - AABB or circle collider to check
+	 \param[in] r_query - circle to check against
+	 \return true - the collider overlaps the circle
+	 \return false - the collider does not overlap the circle
+	*************************************************************************************/
+	template <typename ColliderType>
+	bool QueryOverlap(ColliderType const& r_collider, CircleCollider const& r_query)
+	{
+		return (ClosestPoint(r_collider, r_query.center) - r_query.center).LengthSquared() <= r_query.radius * r_query.radius;
+	}
+
+	/*!***********************************************************************************
+	 \brief Checks if an AABB collider overlaps the query box r_query
+
+	 \param[in] r_AABB - collider to check
+	 \param[in] r_query - box to check against
+	 \return true - the collider overlaps the box
+	 \return false - the collider does not overlap the box
+	*************************************************************************************/
+	bool QueryOverlap(AABBCollider const& r_AABB, AABBCollider const& r_query);
+
+	/*!***********************************************************************************
+	 \brief Checks if a circle collider overlaps the query box r_query
+
+	 \param[in] r_circle - collider to check
+	 \param[in] r_query - box to check against
+	 \return true - the collider overlaps the box
+	 \return false - the collider does not overlap the box
+	*************************************************************************************/
+	bool QueryOverlap(CircleCollider const& r_circle, AABBCollider const& r_query);
+
+	/*!***********************************************************************************
+	 \brief Finds where a ray enters an AABB collider using the slab method
+
+	 \param[in] r_AABB 			- collider to test the ray against
+	 \param[in] r_origin 		- start point of the ray
+	 \param[in] r_direction 	- normalized direction of the ray
+	 \param[in] maxDistance 	- length of the ray
+	 \param[out] r_distance 	- distance along the ray to the entry point, 0 if the ray starts inside
+	 \param[out] r_normal 		- normal of the face the ray enters through, facing the ray origin
+	 \return true - the ray hits the collider within maxDistance
+	 \return false - the ray misses the collider
+	*************************************************************************************/
+	bool RayIntersection(AABBCollider const& r_AABB, vec2 const& r_origin, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
+
+	/*!***********************************************************************************
+	 \brief Finds where a ray enters a circle collider
+
+	 \param[in] r_circle 		- collider to test the ray against
+	 \param[in] r_origin 		- start point of the ray
+	 \param[in] r_direction 	- normalized direction of the ray
+	 \param[in] maxDistance 	- length of the ray
+	 \param[out] r_distance 	- distance along the ray to the entry point, 0 if the ray starts inside
+	 \param[out] r_normal 		- normal of the circle at the entry point, facing the ray origin
+	 \return true - the ray hits the collider within maxDistance
+	 \return false - the ray misses the collider
+	*************************************************************************************/
+	bool RayIntersection(CircleCollider const& r_circle, vec2 const& r_origin, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
+
+	/*!***********************************************************************************
+	 \brief Finds when a circle moving along a direction first touches an AABB collider,
+			by casting its center against the box grown by the circle's radius with
+			rounded corners
+
+	 \param[in] r_AABB 			- collider to test the circle against
+	 \param[in] r_sweptCircle 	- circle at the start of its movement
+	 \param[in] r_direction 	- normalized direction the circle moves in
+	 \param[in] maxDistance 	- distance the circle moves
+	 \param[out] r_distance 	- distance moved when the circle first touches the collider
+	 \param[out] r_normal 		- normal of the collider at the contact, facing the circle
+	 \return true - the circle touches the collider within maxDistance
+	 \return false - the circle does not touch the collider
+	*************************************************************************************/
+	bool SweepIntersection(AABBCollider const& r_AABB, CircleCollider const& r_sweptCircle, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
+
+	/*!***********************************************************************************
+	 \brief Finds when a circle moving along a direction first touches a circle collider
+
+	 \param[in] r_circle 		- collider to test the circle against
+	 \param[in] r_sweptCircle 	- circle at the start of its movement
+	 \param[in] r_direction 	- normalized direction the circle moves in
+	 \param[in] maxDistance 	- distance the circle moves
+	 \param[out] r_distance 	- distance moved when the circle first touches the collider
+	 \param[out] r_normal 		- normal of the collider at the contact, facing the circle
+	 \return true - the circle touches the collider within maxDistance
+	 \return false - the circle does not touch the collider
+	*************************************************************************************/
+	bool SweepIntersection(CircleCollider const& r_circle, CircleCollider const& r_sweptCircle, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
+
+	/*!***********************************************************************************
+	 \brief Finds when an AABB moving along a direction first touches an AABB collider
+
+	 \param[in] r_AABB 			- collider to test the moving AABB against
+	 \param[in] r_sweptAABB 	- AABB at the start of its movement
+	 \param[in] r_direction 	- normalized direction the AABB moves in
+	 \param[in] maxDistance 	- distance the AABB moves
+	 \param[out] r_distance 	- distance moved when the AABB first touches the collider
+	 \param[out] r_normal 		- normal of the collider at the contact, facing the moving AABB
+	 \return true - the AABB touches the collider within maxDistance
+	 \return false - the AABB does not touch the collider
+	*************************************************************************************/
+	bool SweepIntersection(AABBCollider const& r_AABB, AABBCollider const& r_sweptAABB, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
+
+	/*!***********************************************************************************
+	 \brief Finds when an AABB moving along a direction first touches a circle collider
+
+	 \param[in] r_circle 		- collider to test the moving AABB against
+	 \param[in] r_sweptAABB 	- AABB at the start of its movement
+	 \param[in] r_direction 	- normalized direction the AABB moves in
+	 \param[in] maxDistance 	- distance the AABB moves
+	 \param[out] r_distance 	- distance moved when the AABB first touches the collider
+	 \param[out] r_normal 		- normal of the collider at the contact, facing the moving AABB
+	 \return true - the AABB touches the collider within maxDistance
+	 \return false - the AABB does not touch the collider
+	*************************************************************************************/
+	bool SweepIntersection(CircleCollider const& r_circle, AABBCollider const& r_sweptAABB, vec2 const& r_direction, float maxDistance, float& r_distance, vec2& r_normal);
 }
\ No newline at end of file
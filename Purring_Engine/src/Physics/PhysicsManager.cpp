@@ -18,9 +18,12 @@
 #include "ECS/SceneView.h"
 #include "Math/Transform.h"
 #include "RigidBody.h"
+#include "CollisionManager.h"
 #include "Logging/Logger.h"
 #include "PauseManager.h"
 #include "Layers/LayerManager.h"
+#include "Time/TimeManager.h"
+#include "Hierarchy/HierarchyManager.h"
 
 #ifndef GAMERELEASE
 #include "Editor/Editor.h"
@@ -34,6 +37,9 @@ namespace PE
 
 	bool PhysicsManager::m_applyStepPhysics{ false };
 	bool PhysicsManager::m_advanceStep{ false };
+	bool PhysicsManager::sleepingActive{ true };
+	unsigned PhysicsManager::stepsBeforeSleep{ 30 };
+	bool PhysicsManager::interpolationActive{ true };
 
 	// ----- Constructor ----- //
 
@@ -74,6 +80,9 @@ namespace PE
 
 	void PhysicsManager::UpdateSystem(float deltaTime)
 	{
+		// nothing is interpolated unless this update steps the simulation
+		m_hasStepped = false;
+
 #ifndef GAMERELEASE
 		if (Editor::GetInstance().IsRunTime())
 		{
@@ -111,6 +120,7 @@ namespace PE
 					rb.ZeroForce();
 					rb.velocity.Zero();
 					rb.rotationVelocity = 0.f;
+					rb.WakeUp(); // the transform may be edited freely in the editor
 				}
 			}
 		}
@@ -130,6 +140,10 @@ namespace PE
 		if (PauseManager::GetInstance().IsPaused())
 			return;
 
+		m_awakeBodyCount = 0;
+		m_sleepingBodyCount = 0;
+		m_batch.Clear();
+
 		for (const auto& layer : LayerView<RigidBody, Transform>())
 		{
 			for (EntityID RigidBodyID : InternalView(layer))
@@ -139,29 +153,323 @@ namespace PE
 
 				RigidBody& rb = EntityManager::GetInstance().Get<RigidBody>(RigidBodyID);
 				Transform& transform = EntityManager::GetInstance().Get<Transform>(RigidBodyID);
+				vec2 const scale{ transform.width, transform.height };
 
-				if (rb.GetType() == EnumRigidBodyType::DYNAMIC)
+				if (!rb.IsAwake())
 				{
-					// Applies drag force
-					rb.ApplyForce(rb.velocity * rb.GetMass() * rb.GetLinearDrag() * -1.f);
-
-					// Update Speed based on total forces
-					rb.velocity += rb.force * rb.GetInverseMass() * deltaTime;
+					// stays asleep unless it was pushed, moved or given a velocity since the last step
+					bool const isDisturbed{ !rb.IsResting(transform.position, scale) || !rb.HasRestingVelocity() };
+					if (sleepingActive && !isDisturbed)
+					{
+						++m_sleepingBodyCount;
+						continue;
+					}
+					rb.WakeUp();
 				}
+				++m_awakeBodyCount;
 
-				if (rb.GetType() != EnumRigidBodyType::STATIC)
+				// dynamic bodies are integrated together once every body has been gathered
+				if (rb.GetType() == EnumRigidBodyType::DYNAMIC)
 				{
-					// at negligible velocity, velocity will set to 0.f
-					rb.velocity.x = (rb.velocity.x < m_velocityNegligence && rb.velocity.x > -m_velocityNegligence) ? 0.f : rb.velocity.x;
-					rb.velocity.y = (rb.velocity.y < m_velocityNegligence && rb.velocity.y > -m_velocityNegligence) ? 0.f : rb.velocity.y;
-					rb.prevPosition = transform.position;
-					transform.position += rb.velocity * deltaTime;
-					transform.orientation += rb.rotationVelocity * deltaTime;
-					Wrap(transform.orientation, 0.f, 2.f * PE_PI);
+					m_batch.Gather(RigidBodyID, rb, transform);
+					continue;
 				}
+
 				rb.ZeroForce();
 				rb.rotationVelocity = 0.f;
+
+				// bodies that have not moved for long enough are put to sleep
+				if (sleepingActive && rb.UpdateRestingSteps(transform.position, scale) >= stepsBeforeSleep)
+				{
+					rb.Sleep();
+				}
+			}
+		}
+
+		IntegrateBatch(m_batch, m_velocityNegligence, deltaTime);
+		m_batch.Scatter();
+		UpdateContinuousCollision();
+
+		// store where the integrated bodies started the step to draw them in between
+		UpdateInterpolationOffsets();
+		m_hasStepped = true;
+
+		if (!sleepingActive)
+			return;
+
+		for (size_t i{ 0 }; i < m_batch.Size(); ++i)
+		{
+			RigidBody& rb = *m_batch.rigidBodies[i];
+			Transform const& transform = *m_batch.transforms[i];
+
+			// bodies that have not moved for long enough are put to sleep
+			if (rb.UpdateRestingSteps(transform.position, vec2{ transform.width, transform.height }) >= stepsBeforeSleep)
+			{
+				rb.Sleep();
 			}
 		}
 	}
+
+	vec2 PhysicsManager::GetInterpolatedPosition(EntityID id, vec2 const& r_position) const
+	{
+		if (!interpolationActive || !m_hasStepped || id >= m_interpolationSteps.size() || m_interpolationSteps[id] != m_stepIndex)
+			return r_position;
+
+		return r_position + m_interpolationOffsets[id] * (1.f - TimeManager::GetInstance().GetInterpolationAlpha());
+	}
+
+	void PhysicsManager::UpdateInterpolationOffsets()
+	{
+		// offsets of older steps are told apart by their step index instead of being cleared
+		++m_stepIndex;
+
+		for (size_t i{ 0 }; i < m_batch.Size(); ++i)
+		{
+			EntityID const id{ m_batch.entityIDs[i] };
+			if (id >= m_interpolationSteps.size())
+			{
+				m_interpolationOffsets.resize(id + 1);
+				m_interpolationSteps.resize(id + 1, 0);
+			}
+
+			Transform const& r_transform{ *m_batch.transforms[i] };
+			m_interpolationOffsets[id] = vec2{ m_batch.prevPositionX[i], m_batch.prevPositionY[i] } - r_transform.position;
+			m_interpolationSteps[id] = m_stepIndex;
+		}
+
+		if (!m_batch.Size())
+			return;
+
+		// the closest ancestor moved by the step decides the offset of an entity that was not moved itself,
+		// parents come before their children so their offsets are final by the time the children read them
+		Hierarchy::GetInstance().ForEachFlatChild([this](EntityID child, EntityID parent)
+			{
+				if (parent >= m_interpolationSteps.size() || m_interpolationSteps[parent] != m_stepIndex) { return; }
+				if (child >= m_interpolationSteps.size())
+				{
+					m_interpolationOffsets.resize(child + 1);
+					m_interpolationSteps.resize(child + 1, 0);
+				}
+				else if (m_interpolationSteps[child] == m_stepIndex) { return; } // moved by the step itself
+
+				m_interpolationOffsets[child] = m_interpolationOffsets[parent];
+				m_interpolationSteps[child] = m_stepIndex;
+			});
+	}
+
+	void PhysicsManager::UpdateContinuousCollision()
+	{
+		// how far the body is moved into the collider it hits, so the discrete test picks up the contact
+		constexpr float contactDepth{ 0.5f };
+
+		for (size_t i{ 0 }; i < m_batch.Size(); ++i)
+		{
+			RigidBody& rb = *m_batch.rigidBodies[i];
+			if (!rb.GetContinuousCollision()) { continue; }
+
+			Transform& transform = *m_batch.transforms[i];
+			vec2 const displacement{ transform.position - rb.prevPosition };
+			float const distance{ displacement.Length() };
+
+			SweepHit hit;
+			if (GETCOLLISIONMANAGER()->SweepCollider(m_batch.entityIDs[i], rb.prevPosition, displacement, hit)
+				&& hit.distance + contactDepth < distance)
+			{
+				// stop at the time of impact instead of passing through the collider
+				transform.position = rb.prevPosition + displacement * ((hit.distance + contactDepth) / distance);
+			}
+		}
+	}
+
+	void PhysicsManager::IntegrateBatch(RigidBodyBatch& r_batch, float velocityNegligence, float deltaTime)
+	{
+		size_t const count{ r_batch.Size() };
+		float* const p_velocityX{ r_batch.velocityX.data() };
+		float* const p_velocityY{ r_batch.velocityY.data() };
+		float* const p_forceX{ r_batch.forceX.data() };
+		float* const p_forceY{ r_batch.forceY.data() };
+		float const* const p_mass{ r_batch.mass.data() };
+		float const* const p_inverseMass{ r_batch.inverseMass.data() };
+		float const* const p_linearDrag{ r_batch.linearDrag.data() };
+		float* const p_positionX{ r_batch.positionX.data() };
+		float* const p_positionY{ r_batch.positionY.data() };
+		float* const p_prevPositionX{ r_batch.prevPositionX.data() };
+		float* const p_prevPositionY{ r_batch.prevPositionY.data() };
+
+		// the operations are done in the same order as IntegrateBody so the results are identical
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			// Applies drag force
+			p_forceX[i] += p_velocityX[i] * p_mass[i] * p_linearDrag[i] * -1.f;
+			p_forceY[i] += p_velocityY[i] * p_mass[i] * p_linearDrag[i] * -1.f;
+
+			// Update Speed based on total forces
+			p_velocityX[i] += p_forceX[i] * p_inverseMass[i] * deltaTime;
+			p_velocityY[i] += p_forceY[i] * p_inverseMass[i] * deltaTime;
+		}
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			// at negligible velocity, velocity will set to 0.f
+			p_velocityX[i] = (p_velocityX[i] < velocityNegligence && p_velocityX[i] > -velocityNegligence) ? 0.f : p_velocityX[i];
+			p_velocityY[i] = (p_velocityY[i] < velocityNegligence && p_velocityY[i] > -velocityNegligence) ? 0.f : p_velocityY[i];
+		}
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			p_prevPositionX[i] = p_positionX[i];
+			p_prevPositionY[i] = p_positionY[i];
+			p_positionX[i] += p_velocityX[i] * deltaTime;
+			p_positionY[i] += p_velocityY[i] * deltaTime;
+		}
+
+		// wrapping uses fmodf, so the orientation is kept out of the loops above
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			r_batch.orientation[i] += r_batch.rotationVelocity[i] * deltaTime;
+			Wrap(r_batch.orientation[i], 0.f, 2.f * PE_PI);
+		}
+	}
+
+	void PhysicsManager::IntegrateBody(RigidBody& r_rigidBody, Transform& r_transform, float velocityNegligence, float deltaTime)
+	{
+		// Applies drag force
+		r_rigidBody.force += r_rigidBody.velocity * r_rigidBody.GetMass() * r_rigidBody.GetLinearDrag() * -1.f;
+
+		// Update Speed based on total forces
+		r_rigidBody.velocity += r_rigidBody.force * r_rigidBody.GetInverseMass() * deltaTime;
+
+		// at negligible velocity, velocity will set to 0.f
+		r_rigidBody.velocity.x = (r_rigidBody.velocity.x < velocityNegligence && r_rigidBody.velocity.x > -velocityNegligence) ? 0.f : r_rigidBody.velocity.x;
+		r_rigidBody.velocity.y = (r_rigidBody.velocity.y < velocityNegligence && r_rigidBody.velocity.y > -velocityNegligence) ? 0.f : r_rigidBody.velocity.y;
+		r_rigidBody.prevPosition = r_transform.position;
+		r_transform.position += r_rigidBody.velocity * deltaTime;
+		r_transform.orientation += r_rigidBody.rotationVelocity * deltaTime;
+		Wrap(r_transform.orientation, 0.f, 2.f * PE_PI);
+
+		r_rigidBody.ZeroForce();
+		r_rigidBody.rotationVelocity = 0.f;
+	}
+
+#ifndef GAMERELEASE
+	void PhysicsManager::BenchmarkIntegration(unsigned bodyCount, unsigned stepCount) const
+	{
+		constexpr float deltaTime{ 1.f / 60.f };
+
+		// generate the same bodies for both runs
+		std::mt19937 generator{ 2024 };
+		std::uniform_real_distribution<float> distribution{ -500.f, 500.f };
+
+		std::vector<RigidBody> bodies(bodyCount);
+		std::vector<Transform> transforms(bodyCount);
+		std::vector<vec2> forces(bodyCount);
+		for (unsigned i{ 0 }; i < bodyCount; ++i)
+		{
+			bodies[i].SetType(EnumRigidBodyType::DYNAMIC);
+			bodies[i].SetMass(1.f + std::abs(distribution(generator)) * 0.1f);
+			bodies[i].SetLinearDrag(std::abs(distribution(generator)) * 0.01f);
+			bodies[i].velocity = vec2{ distribution(generator), distribution(generator) };
+			bodies[i].rotationVelocity = distribution(generator) * 0.01f;
+			transforms[i].position = vec2{ distribution(generator), distribution(generator) } * 10.f;
+			forces[i] = vec2{ distribution(generator), distribution(generator) } * 50.f;
+		}
+
+		std::vector<RigidBody> batchBodies{ bodies };
+		std::vector<Transform> batchTransforms{ transforms };
+		RigidBodyBatch batch;
+
+		// one body at a time
+		auto const bodyStart{ std::chrono::high_resolution_clock::now() };
+		for (unsigned step{ 0 }; step < stepCount; ++step)
+		{
+			for (unsigned i{ 0 }; i < bodyCount; ++i)
+			{
+				bodies[i].force = forces[i];
+				IntegrateBody(bodies[i], transforms[i], m_velocityNegligence, deltaTime);
+			}
+		}
+		auto const bodyEnd{ std::chrono::high_resolution_clock::now() };
+
+		// gathered into a batch, integrated and scattered back every step
+		auto const batchStart{ std::chrono::high_resolution_clock::now() };
+		for (unsigned step{ 0 }; step < stepCount; ++step)
+		{
+			batch.Clear();
+			for (unsigned i{ 0 }; i < bodyCount; ++i)
+			{
+				batchBodies[i].force = forces[i];
+				batch.Gather(static_cast<EntityID>(i), batchBodies[i], batchTransforms[i]);
+			}
+			IntegrateBatch(batch, m_velocityNegligence, deltaTime);
+			batch.Scatter();
+		}
+		auto const batchEnd{ std::chrono::high_resolution_clock::now() };
+
+		bool isIdentical{ true };
+		for (unsigned i{ 0 }; i < bodyCount && isIdentical; ++i)
+		{
+			isIdentical = bodies[i].velocity == batchBodies[i].velocity && bodies[i].prevPosition == batchBodies[i].prevPosition
+				&& transforms[i].position == batchTransforms[i].position && transforms[i].orientation == batchTransforms[i].orientation;
+		}
+
+		std::stringstream ss;
+		ss << "Integration benchmark (" << bodyCount << " bodies, " << stepCount << " steps): per body "
+			<< std::chrono::duration<double, std::milli>(bodyEnd - bodyStart).count() << "ms, batched "
+			<< std::chrono::duration<double, std::milli>(batchEnd - batchStart).count() << "ms, results "
+			<< (isIdentical ? "identical" : "DIFFERENT");
+		engine_logger.AddLog(false, ss.str(), __FUNCTION__);
+	}
+#endif
+
+
+	// ----- RigidBodyBatch ----- //
+
+	void RigidBodyBatch::Clear()
+	{
+		entityIDs.clear();
+		rigidBodies.clear();
+		transforms.clear();
+		velocityX.clear(); velocityY.clear();
+		forceX.clear(); forceY.clear();
+		mass.clear(); inverseMass.clear(); linearDrag.clear();
+		positionX.clear(); positionY.clear();
+		prevPositionX.clear(); prevPositionY.clear();
+		orientation.clear(); rotationVelocity.clear();
+	}
+
+	void RigidBodyBatch::Gather(EntityID id, RigidBody& r_rigidBody, Transform& r_transform)
+	{
+		entityIDs.emplace_back(id);
+		rigidBodies.emplace_back(&r_rigidBody);
+		transforms.emplace_back(&r_transform);
+		velocityX.emplace_back(r_rigidBody.velocity.x);
+		velocityY.emplace_back(r_rigidBody.velocity.y);
+		forceX.emplace_back(r_rigidBody.force.x);
+		forceY.emplace_back(r_rigidBody.force.y);
+		mass.emplace_back(r_rigidBody.GetMass());
+		inverseMass.emplace_back(r_rigidBody.GetInverseMass());
+		linearDrag.emplace_back(r_rigidBody.GetLinearDrag());
+		positionX.emplace_back(r_transform.position.x);
+		positionY.emplace_back(r_transform.position.y);
+		prevPositionX.emplace_back(r_rigidBody.prevPosition.x);
+		prevPositionY.emplace_back(r_rigidBody.prevPosition.y);
+		orientation.emplace_back(r_transform.orientation);
+		rotationVelocity.emplace_back(r_rigidBody.rotationVelocity);
+	}
+
+	void RigidBodyBatch::Scatter()
+	{
+		for (size_t i{ 0 }; i < rigidBodies.size(); ++i)
+		{
+			RigidBody& rb = *rigidBodies[i];
+			Transform& transform = *transforms[i];
+
+			rb.velocity = vec2{ velocityX[i], velocityY[i] };
+			rb.prevPosition = vec2{ prevPositionX[i], prevPositionY[i] };
+			transform.position = vec2{ positionX[i], positionY[i] };
+			transform.orientation = orientation[i];
+			rb.ZeroForce();
+			rb.rotationVelocity = 0.f;
+		}
+	}
 }
\ No newline at end of file
@@ -14,11 +14,68 @@
 *************************************************************************************/
 #pragma once
 #include "System.h"
+#include "ECS/Entity.h"
+#include "Math/MathCustom.h"
+#include <vector>
+
 namespace PE
 {
+	class RigidBody;
+	struct Transform;
+
+	//! Dynamic RigidBodies gathered into packed arrays so they can be integrated in simple
+	//! loops the compiler can vectorize. The component pools are indexed through a map, so
+	//! the values are gathered from and scattered back to the components every step.
+	struct RigidBodyBatch
+	{
+		std::vector<EntityID> entityIDs;
+		std::vector<RigidBody*> rigidBodies;
+		std::vector<Transform*> transforms;
+		std::vector<float> velocityX, velocityY;
+		std::vector<float> forceX, forceY;
+		std::vector<float> mass, inverseMass, linearDrag;
+		std::vector<float> positionX, positionY;
+		std::vector<float> prevPositionX, prevPositionY;
+		std::vector<float> orientation, rotationVelocity;
+
+		/*!***********************************************************************************
+		 \brief Removes every body from the batch, keeping the allocated memory
+
+		*************************************************************************************/
+		void Clear();
+
+		/*!***********************************************************************************
+		 \brief Copies the values of a dynamic RigidBody and its Transform into the batch
+
+		 \param[in] id - entity the RigidBody belongs to
+		 \param[in] r_rigidBody - RigidBody to add
+		 \param[in] r_transform - Transform of the RigidBody
+		*************************************************************************************/
+		void Gather(EntityID id, RigidBody& r_rigidBody, Transform& r_transform);
+
+		/*!***********************************************************************************
+		 \brief Writes the integrated values back into the RigidBodies and Transforms that
+				were gathered, zeroing their force and rotation velocity
+
+		*************************************************************************************/
+		void Scatter();
+
+		/*!***********************************************************************************
+		 \brief Get the number of bodies in the batch
+
+		 \return size_t - number of bodies
+		*************************************************************************************/
+		size_t Size() const { return rigidBodies.size(); }
+	};
+
 	class PhysicsManager : public System
 	{
 	public:
+		// ----- Public Variables ----- //
+		static bool sleepingActive; // whether resting bodies are allowed to fall asleep
+		static unsigned stepsBeforeSleep; // number of resting steps before a body falls asleep
+		static bool interpolationActive; // whether bodies are drawn between their last two steps
+
 		// ----- Constructor ----- //
 		/*!***********************************************************************************
 		 \brief Construct a new Physics Manager object
@@ -57,6 +114,44 @@ namespace PE
 		*************************************************************************************/
 		static bool& GetAdvanceStep();
 
+		/*!***********************************************************************************
+		 \brief Get the number of RigidBodies that were simulated in the last physics step
+		 
+		 \return unsigned - m_awakeBodyCount variable
+		*************************************************************************************/
+		unsigned GetAwakeBodyCount() const { return m_awakeBodyCount; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of RigidBodies that were asleep in the last physics step
+		 
+		 \return unsigned - m_sleepingBodyCount variable
+		*************************************************************************************/
+		unsigned GetSleepingBodyCount() const { return m_sleepingBodyCount; }
+
+		/*!***********************************************************************************
+		 \brief Get where to draw an entity between the last two physics steps. Entities
+				moved by the last step, and the children of such entities, are moved back
+				towards where the step started by the time left in the accumulator. Any
+				other entity is drawn where it is. Safe to call from several threads.
+
+		 \param[in] id - entity to draw
+		 \param[in] r_position - position of the entity after the last step
+		 \return vec2 - position to draw the entity at
+		*************************************************************************************/
+		vec2 GetInterpolatedPosition(EntityID id, vec2 const& r_position) const;
+
+	private:
+		/*!***********************************************************************************
+		 \brief Writes the interpolation offset of every body integrated in the last step,
+				then passes the offsets down the flattened hierarchy so children of moved
+				bodies are drawn with their parent. Called once per step so that drawing
+				an entity only reads its offset.
+
+		*************************************************************************************/
+		void UpdateInterpolationOffsets();
+
+	public:
+
 		/*!***********************************************************************************
 		 \brief Get the m_systemName object
 		 
@@ -87,17 +182,68 @@ namespace PE
 
 		// ----- Physics Methods ----- //
 		/*!***********************************************************************************
-		 \brief Updates the velocity and positions of each object with a RigidBody.
+		 \brief Updates the velocity and positions of each object with a RigidBody. Bodies
+		 		that stay below the velocity negligence for stepsBeforeSleep steps are put
+				to sleep and skipped until they are pushed, moved or have a force applied.
 		 
 		 \param[in] deltaTime - difference in time between previous frame and current frame
 		*************************************************************************************/
 		void UpdateDynamics(float deltaTime);
 
+		/*!***********************************************************************************
+		 \brief Sweeps the collider of each integrated body that has continuous collision
+				on from where it started the step to where it ended up, and moves it back
+				to the first solid collider it would have touched, so fast bodies cannot
+				pass through thin colliders between two steps.
+
+		*************************************************************************************/
+		void UpdateContinuousCollision();
+
+		/*!***********************************************************************************
+		 \brief Applies drag, integrates the velocity, clamps negligible velocities and
+				integrates the position and orientation of every body in the batch.
+
+		 \param[in,out] r_batch - bodies to integrate
+		 \param[in] velocityNegligence - velocity components below this are set to 0
+		 \param[in] deltaTime - time to integrate over
+		*************************************************************************************/
+		static void IntegrateBatch(RigidBodyBatch& r_batch, float velocityNegligence, float deltaTime);
+
+		/*!***********************************************************************************
+		 \brief Integrates a single dynamic body. This is the reference that IntegrateBatch
+				has to match and is only used for comparison.
+
+		 \param[in,out] r_rigidBody - RigidBody to integrate
+		 \param[in,out] r_transform - Transform of the RigidBody
+		 \param[in] velocityNegligence - velocity components below this are set to 0
+		 \param[in] deltaTime - time to integrate over
+		*************************************************************************************/
+		static void IntegrateBody(RigidBody& r_rigidBody, Transform& r_transform, float velocityNegligence, float deltaTime);
+
+#ifndef GAMERELEASE
+		/*!***********************************************************************************
+		 \brief Integrates bodyCount generated bodies for a number of steps, once one body at
+				a time and once through a RigidBodyBatch, and logs the time taken by each
+				and whether the results are identical.
+
+		 \param[in] bodyCount - number of bodies to generate
+		 \param[in] stepCount - number of steps to integrate
+		*************************************************************************************/
+		void BenchmarkIntegration(unsigned bodyCount, unsigned stepCount) const;
+#endif
+
 	private:
 		// ----- Private Variables ----- //
 		float m_velocityNegligence{};
 		static bool m_applyStepPhysics;
 		static bool m_advanceStep;
+		unsigned m_awakeBodyCount{};
+		unsigned m_sleepingBodyCount{};
+		RigidBodyBatch m_batch; // awake dynamic bodies gathered this step
+		std::vector<vec2> m_interpolationOffsets; // by entity ID, from where the entity ended the last step to where it started it
+		std::vector<unsigned long long> m_interpolationSteps; // by entity ID, the step its interpolation offset was written in
+		unsigned long long m_stepIndex{}; // number of steps taken, tells the offsets of the last step from older ones
+		bool m_hasStepped{ false }; // whether the last fixed update stepped the simulation
 		std::string m_systemName{ "PhysicsManager" };
 	};
 }
\ No newline at end of file
@@ -19,6 +19,15 @@
 
 namespace PE
 {
+	namespace
+	{
+		//! Whether two vectors are close enough for a RigidBody to still be considered at rest
+		bool IsWithinRestingEpsilon(vec2 const& r_lhs, vec2 const& r_rhs)
+		{
+			return (r_lhs - r_rhs).LengthSquared() <= RigidBody::restingEpsilon * RigidBody::restingEpsilon;
+		}
+	}
+
 	// ------ RigidBody Class ----- //
 	
 	// ----- Constructors/Copy Assignment ------ //
@@ -32,7 +41,10 @@ namespace PE
 		velocity{ r_cpy.velocity }, rotationVelocity{ r_cpy.rotationVelocity },
 		force{ r_cpy.force }, m_linearDrag{ r_cpy.m_linearDrag },
 		m_mass{ r_cpy.m_mass }, m_inverseMass{ r_cpy.m_inverseMass }, 
-		prevPosition{ r_cpy.prevPosition }, m_type{ r_cpy.m_type } {}
+		prevPosition{ r_cpy.prevPosition }, m_type{ r_cpy.m_type },
+		m_continuousCollision{ r_cpy.m_continuousCollision },
+		m_isAwake{ r_cpy.m_isAwake }, m_restingSteps{ r_cpy.m_restingSteps },
+		m_restPosition{ r_cpy.m_restPosition }, m_restScale{ r_cpy.m_restScale } {}
 
 	RigidBody& RigidBody::operator=(RigidBody const& r_cpy)
 	{
@@ -43,6 +55,11 @@ namespace PE
 		m_inverseMass = r_cpy.m_inverseMass;
 		prevPosition = r_cpy.prevPosition;
 		m_type = r_cpy.m_type;
+		m_continuousCollision = r_cpy.m_continuousCollision;
+		m_isAwake = r_cpy.m_isAwake;
+		m_restingSteps = r_cpy.m_restingSteps;
+		m_restPosition = r_cpy.m_restPosition;
+		m_restScale = r_cpy.m_restScale;
 		return *this;
 	}
 
@@ -72,6 +89,16 @@ namespace PE
 		m_linearDrag = drag;
 	}
 
+	bool RigidBody::GetContinuousCollision() const
+	{
+		return m_continuousCollision;
+	}
+
+	void RigidBody::SetContinuousCollision(bool continuousCollision)
+	{
+		m_continuousCollision = continuousCollision;
+	}
+
 	void RigidBody::ZeroForce()
 	{
 		if (m_type != EnumRigidBodyType::DYNAMIC)
@@ -87,6 +114,27 @@ namespace PE
 	void RigidBody::SetType(EnumRigidBodyType newType)
 	{
 		m_type = newType;
+		WakeUp();
+	}
+
+	bool RigidBody::IsAwake() const
+	{
+		return m_isAwake;
+	}
+
+	bool RigidBody::IsResting(vec2 const& r_position, vec2 const& r_scale) const
+	{
+		return !m_isAwake && IsWithinRestingEpsilon(r_position, m_restPosition) && IsWithinRestingEpsilon(r_scale, m_restScale);
+	}
+
+	bool RigidBody::HasRestingVelocity() const
+	{
+		return velocity.LengthSquared() <= restingEpsilon * restingEpsilon && std::abs(rotationVelocity) <= restingEpsilon;
+	}
+
+	unsigned RigidBody::GetRestingSteps() const
+	{
+		return m_restingSteps;
 	}
 
 	// ----- Public Methods ----- //
@@ -98,6 +146,7 @@ namespace PE
 			return;
 
 		force += r_addOnForce;
+		WakeUp();
 	}
 
 	// Adds on immediately to object's velocity for burst movement
@@ -106,5 +155,32 @@ namespace PE
 		if (m_type != EnumRigidBodyType::DYNAMIC || (!PhysicsManager::GetAdvanceStep() && PhysicsManager::GetStepPhysics()))
 			return;
 		velocity += r_impulseForce * m_inverseMass;
+		WakeUp();
+	}
+
+	void RigidBody::WakeUp()
+	{
+		if (m_isAwake)
+			return;
+
+		m_isAwake = true;
+		m_restingSteps = 0;
+	}
+
+	void RigidBody::Sleep()
+	{
+		m_isAwake = false;
+		velocity.Zero();
+		force.Zero();
+		rotationVelocity = 0.f;
+	}
+
+	unsigned RigidBody::UpdateRestingSteps(vec2 const& r_position, vec2 const& r_scale)
+	{
+		bool const isResting{ HasRestingVelocity() && IsWithinRestingEpsilon(r_position, m_restPosition) && IsWithinRestingEpsilon(r_scale, m_restScale) };
+		m_restingSteps = isResting ? m_restingSteps + 1 : 0;
+		m_restPosition = r_position;
+		m_restScale = r_scale;
+		return m_restingSteps;
 	}
 }
@@ -48,6 +48,8 @@ namespace PE
 		float rotationVelocity{};
 		vec2 force{};
 
+		static constexpr float restingEpsilon{ 0.01f }; // changes in position, scale and speed below this still count as resting
+
 		// ----- Constructors ----- //
 		public:
 		
@@ -112,6 +114,22 @@ namespace PE
 		*************************************************************************************/
 		void SetLinearDrag(float drag);
 
+		/*!***********************************************************************************
+		 \brief Check if the object's movement is swept against other colliders every step
+		 		so it cannot pass through them when moving fast
+
+		 \return true - Continuous collision is on
+		 \return false - Only discrete collision is used
+		*************************************************************************************/
+		bool GetContinuousCollision() const;
+
+		/*!***********************************************************************************
+		 \brief Set whether the object's movement is swept against other colliders every step
+
+		 \param[in] continuousCollision - whether continuous collision should be on
+		*************************************************************************************/
+		void SetContinuousCollision(bool continuousCollision);
+
 		/*!***********************************************************************************
 		 \brief Set 'force' of RigidBody to zero vec2
 		 
@@ -132,12 +150,73 @@ namespace PE
 		*************************************************************************************/
 		void SetType(EnumRigidBodyType newType);
 
+		/*!***********************************************************************************
+		 \brief Check if the RigidBody is awake. Sleeping bodies are skipped by the physics
+				integration, the collider updates and the narrowphase.
+
+		 \return true - The RigidBody is awake
+		 \return false - The RigidBody is asleep
+		*************************************************************************************/
+		bool IsAwake() const;
+
+		/*!***********************************************************************************
+		 \brief Check if the RigidBody is asleep and its transform has not been edited by more
+				than restingEpsilon since it fell asleep, i.e. its collider is still valid and
+				does not need updating.
+
+		 \param[in] r_position - current position of the RigidBody's transform
+		 \param[in] r_scale - current width and height of the RigidBody's transform
+		 \return true - The RigidBody is asleep and has not moved
+		 \return false - The RigidBody is awake or has been moved
+		*************************************************************************************/
+		bool IsResting(vec2 const& r_position, vec2 const& r_scale) const;
+
+		/*!***********************************************************************************
+		 \brief Check if the linear and rotational velocities of the RigidBody are small
+				enough for it to be considered at rest
+
+		 \return true - Both velocities are within restingEpsilon of zero
+		 \return false - The RigidBody is moving or rotating
+		*************************************************************************************/
+		bool HasRestingVelocity() const;
+
+		/*!***********************************************************************************
+		 \brief Get the number of consecutive steps the RigidBody has been at rest
+
+		 \return unsigned - m_restingSteps variable of the RigidBody
+		*************************************************************************************/
+		unsigned GetRestingSteps() const;
+
 	public:
 		// ----- Public Methods ----- //
 
+		/*!***********************************************************************************
+		 \brief Wakes the RigidBody up so it is simulated again.
+
+		*************************************************************************************/
+		void WakeUp();
+
+		/*!***********************************************************************************
+		 \brief Puts the RigidBody to sleep and zeroes its velocity and force.
+
+		*************************************************************************************/
+		void Sleep();
+
+		/*!***********************************************************************************
+		 \brief Counts one more resting step if the RigidBody has a resting velocity and its
+				transform has not changed by more than restingEpsilon since the previous call,
+				resets the count otherwise. The
+				transform is stored so edits made to it while asleep can be detected.
+
+		 \param[in] r_position - current position of the RigidBody's transform
+		 \param[in] r_scale - current width and height of the RigidBody's transform
+		 \return unsigned - number of consecutive resting steps
+		*************************************************************************************/
+		unsigned UpdateRestingSteps(vec2 const& r_position, vec2 const& r_scale);
+
 		/*!***********************************************************************************
 		 \brief Adds on to objects existing force. Force will be used to calculate objects
-		 		acceleration.
+		 		acceleration. Wakes the object up if it is asleep.
 		 
 		 \param[in,out] r_addOnForce - force to add on to the objects 'force'
 		*************************************************************************************/
@@ -145,7 +224,7 @@ namespace PE
 
 		/*!***********************************************************************************
 		 \brief Applies impulse to the object, directly adding on to 'velocity', allowing
-		 		burst movement
+		 		burst movement. Wakes the object up if it is asleep.
 		 
 		 \param[in,out] r_impulseForce 
 		*************************************************************************************/
@@ -166,6 +245,7 @@ namespace PE
 			j["type"] = static_cast<int>(GetType()); // right now its an enum
 			j["mass"] = m_mass;
 			j["linearDrag"] = m_linearDrag;
+			j["continuousCollision"] = m_continuousCollision;
 
 			return j;
 		}
@@ -182,6 +262,8 @@ namespace PE
 			rb.SetType(static_cast<EnumRigidBodyType>(j["type"].get<int>())); // right now its an enum
 			rb.m_mass = j["mass"];
 			rb.m_linearDrag = j["linearDrag"];
+			if (j.contains("continuousCollision"))
+				rb.m_continuousCollision = j["continuousCollision"].get<bool>();
 
 
 			return rb;
@@ -194,6 +276,12 @@ namespace PE
 		float m_mass{10.f};
 		float m_inverseMass{1.f/10.f};
 		float m_linearDrag{};
+		bool m_continuousCollision{ false };
+
+		bool m_isAwake{ true };
+		unsigned m_restingSteps{}; // consecutive steps spent without moving
+		vec2 m_restPosition{}; // transform position at the end of the last physics step
+		vec2 m_restScale{}; // transform width and height at the end of the last physics step
 	};
 
 }
\ No newline at end of file
@@ -77,7 +77,7 @@ namespace PE
 		m_entitiesInCell.clear();
 	}
 
-	std::vector<EntityID> const& Cell::GetEntityIDs()
+	std::vector<EntityID> const& Cell::GetEntityIDs() const
 	{
 		return m_entitiesInCell;
 	}
@@ -252,7 +252,7 @@ namespace PE
 		return std::pair<GridID, GridID>{ minID, maxID };
 	}
 
-	GridID Grid::GetIndex(float posX, float posY)
+	GridID Grid::GetIndex(float posX, float posY) const
 	{
 		vec2 lengths{ ((m_max - m_min) * 0.5f) };
 		return GridID{ static_cast<int>((lengths.x + posX)/m_cellWidth), static_cast<int>((lengths.y + posY)/m_cellWidth) };
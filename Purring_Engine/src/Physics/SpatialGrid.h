@@ -105,7 +105,7 @@ namespace PE
 		 
 		 \return std::vector<EntityID> const& - the internal vector in the cell
 		*************************************************************************************/
-		std::vector<EntityID> const& GetEntityIDs();
+		std::vector<EntityID> const& GetEntityIDs() const;
 
 	private:
 		// ----- Private Variables ----- //
@@ -207,7 +207,7 @@ namespace PE
 		 \param[in] posY - y coordinate of the point
 		 \return GridID - ID of the grid the point is in
 		*************************************************************************************/
-		GridID GetIndex(float posX, float posY);
+		GridID GetIndex(float posX, float posY) const;
 		
 		// ----- Getters/Setters ----- //
 		/*!***********************************************************************************
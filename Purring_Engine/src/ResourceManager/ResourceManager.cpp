@@ -197,6 +197,9 @@ namespace PE
                 Textures.erase(r_name);
                 return false;
             }
+
+            // Pack a copy into the atlas so that it can be drawn with sprites of other textures
+            m_textureAtlas.Add(r_name, *Textures[r_name]);
         }
 
         return true;
@@ -717,6 +720,7 @@ namespace PE
         engine_logger.AddLog(false, "Unloading all resources", __FUNCTION__);
 
         Textures.clear();
+        m_textureAtlas.Clear();
         Sounds.clear();
         Fonts.clear();
         Animations.clear();
@@ -46,6 +46,7 @@
 #include "Singleton.h"
 #include "Graphics/ShaderProgram.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureAtlas.h"
 #include "AudioManager/AudioManager.h"
 #include "Graphics/Text.h"
 #include "Animation/Animation.h"
@@ -234,6 +235,14 @@ namespace PE
         *************************************************************************************/
         std::shared_ptr<Graphics::Texture> GetTexture(std::string const& r_name);
 
+        /*!***********************************************************************************
+            \brief Gets the atlas that the textures loaded into the Textures map container 
+                   are packed into, if they are small enough.
+
+            \return Texture atlas of the loaded textures.
+        *************************************************************************************/
+        inline Graphics::TextureAtlas& GetTextureAtlas() { return m_textureAtlas; }
+
         /*!***********************************************************************************
             \brief Gets the icon object store in the resource manager.
 
@@ -371,6 +380,8 @@ namespace PE
         std::shared_ptr<Graphics::Texture> m_defaultCursorTexture;
         std::shared_ptr<Graphics::Texture> m_hoverCursorTexture;
 
+        Graphics::TextureAtlas m_textureAtlas; // Copies of the loaded textures packed together to batch draws
+
         std::string m_defaultTextureKey;
         std::string m_defaultAudioKey;
         std::string m_defaultFontKey;
@@ -96,6 +96,9 @@ namespace PE
 		SYSTEMCOUNT
 	};
 
+	// Names of the systems for the profiler and debug windows, indexed by SystemID
+	inline constexpr const char* SystemNames[SystemID::SYSTEMCOUNT]{ "Input", "GUI", "Logic", "Physics", "Collision", "Animation", "Camera", "Visual Effects", "Graphics" };
+
 	class System
 	{
 	public:
@@ -126,6 +129,42 @@ namespace PE
 		 \return    std::string The name of the system.
 		*************************************************************************************/
 		virtual std::string GetName() = 0;
+
+		/*!***********************************************************************************
+		 \brief     Get how many times per second the system wants to be updated. A system
+					with a frequency of 0 is updated every fixed step, otherwise it skips
+					steps and is passed the time since its last update.
+
+		 \return    float Update frequency in updates per second.
+		*************************************************************************************/
+		float GetUpdateFrequency() const { return m_updateFrequency; }
+
+		/*!***********************************************************************************
+		 \brief     Set how many times per second the system wants to be updated.
+
+		 \param     frequency Update frequency in updates per second, 0 to update every fixed step.
+		*************************************************************************************/
+		void SetUpdateFrequency(float frequency) { m_updateFrequency = frequency > 0.f ? frequency : 0.f; }
+
+		/*!***********************************************************************************
+		 \brief     Get the time the system may spend updating per frame. Once a system has
+					used its budget, its remaining fixed steps of the frame are deferred to
+					the next frame.
+
+		 \return    float Time budget in seconds, 0 if the system has no budget.
+		*************************************************************************************/
+		float GetFrameBudget() const { return m_frameBudget; }
+
+		/*!***********************************************************************************
+		 \brief     Set the time the system may spend updating per frame.
+
+		 \param     budget Time budget in seconds, 0 for no budget.
+		*************************************************************************************/
+		void SetFrameBudget(float budget) { m_frameBudget = budget > 0.f ? budget : 0.f; }
+
+	protected:
+		float m_updateFrequency{ 0.f }; // updates per second, 0 to update every fixed step
+		float m_frameBudget{ 0.f }; // seconds the system may spend updating per frame, 0 for no budget
 	};
 
 	class SystemManager : public Singleton<SystemManager>
@@ -0,0 +1,175 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     MPSCQueue.h
+ \date     24-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    Contains the declaration and definition of the MPSCQueue class, a fixed
+		   capacity lock-free queue that any number of threads can push into and a
+		   single thread pops from.
+
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace PE
+{
+	/*!***********************************************************************************
+	 \brief Bounded multi-producer single-consumer queue. Each slot carries a sequence
+			number that tells producers whether the slot is free and the consumer whether
+			the value in it has been fully written, so neither side ever takes a lock.
+			Values pushed by one thread are popped in the order they were pushed; values
+			pushed by different threads are popped in the order their slots were claimed.
+
+	 \tparam T - type of the values, must be default constructible and movable
+	 \tparam Capacity - maximum number of values waiting to be popped, a power of two
+	*************************************************************************************/
+	template <typename T, std::size_t Capacity>
+	class MPSCQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPSCQueue capacity must be a power of two");
+
+	public:
+		// ----- Constructor ----- //
+		/*!***********************************************************************************
+		 \brief Construct an empty queue, every slot starts free for its first lap
+
+		*************************************************************************************/
+		MPSCQueue()
+		{
+			for (std::size_t i{ 0 }; i < Capacity; ++i)
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		MPSCQueue(MPSCQueue const&) = delete;
+		MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+		// ----- Public Methods ----- //
+		/*!***********************************************************************************
+		 \brief Pushes a value into the queue. Safe to call from any thread.
+
+		 \param[in] r_value - value to push
+		 \return bool - false if the queue was full and the value was dropped
+		*************************************************************************************/
+		bool Push(T const& r_value)
+		{
+			std::size_t position{ m_pushPosition.load(std::memory_order_relaxed) };
+			Slot* p_slot{ nullptr };
+
+			while (true)
+			{
+				p_slot = &m_slots[position & (Capacity - 1)];
+				std::size_t const sequence{ p_slot->sequence.load(std::memory_order_acquire) };
+				std::ptrdiff_t const difference{ static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position) };
+
+				if (!difference)
+				{
+					// the slot is free, claim it unless another producer got to it first
+					if (m_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+				{
+					// the slot still holds a value from the previous lap
+					m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+				{
+					position = m_pushPosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			p_slot->value = r_value;
+			p_slot->sequence.store(position + 1, std::memory_order_release);
+			m_pushCount.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/*!***********************************************************************************
+		 \brief Pops the values that were in the queue when the call started and passes each
+				to r_func, in order. Values pushed while draining, including by r_func, are
+				left for the next call. Stops early at a slot that was claimed but is still
+				being written to, so that the order is kept. Only call from the consumer thread.
+
+		 \param[in] r_func - function to call with each popped value
+		 \return std::size_t - number of values popped
+		*************************************************************************************/
+		template <typename Func>
+		std::size_t Drain(Func&& r_func)
+		{
+			std::size_t const end{ m_pushPosition.load(std::memory_order_acquire) };
+			std::size_t count{ 0 };
+
+			while (m_popPosition < end)
+			{
+				Slot& r_slot{ m_slots[m_popPosition & (Capacity - 1)] };
+				if (r_slot.sequence.load(std::memory_order_acquire) != m_popPosition + 1)
+					break;
+
+				// move the value out first so the slot can be reused while r_func runs
+				T value{ std::move(r_slot.value) };
+				r_slot.sequence.store(m_popPosition + Capacity, std::memory_order_release);
+				++m_popPosition;
+				++count;
+
+				r_func(value);
+			}
+
+			return count;
+		}
+
+		// ----- Public Getters ----- //
+		/*!***********************************************************************************
+		 \brief Get the maximum number of values that can wait in the queue
+
+		 \return std::size_t - capacity of the queue
+		*************************************************************************************/
+		static constexpr std::size_t GetCapacity() { return Capacity; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of values waiting in the queue. Only exact on the consumer
+				thread while no producer is pushing.
+
+		 \return std::size_t - number of values waiting to be popped
+		*************************************************************************************/
+		std::size_t GetSize() const { return m_pushPosition.load(std::memory_order_acquire) - m_popPosition; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of values pushed since the queue was created
+
+		 \return unsigned long long - number of values pushed
+		*************************************************************************************/
+		unsigned long long GetPushCount() const { return m_pushCount.load(std::memory_order_relaxed); }
+
+		/*!***********************************************************************************
+		 \brief Get the number of values dropped because the queue was full
+
+		 \return unsigned long long - number of values dropped
+		*************************************************************************************/
+		unsigned long long GetOverflowCount() const { return m_overflowCount.load(std::memory_order_relaxed); }
+
+	private:
+		// ----- Private Variables ----- //
+		struct Slot
+		{
+			std::atomic<std::size_t> sequence; // position + 1 once written, position + Capacity once popped
+			T value{};
+		};
+
+		std::array<Slot, Capacity> m_slots;
+		alignas(64) std::atomic<std::size_t> m_pushPosition{ 0 }; // position of the next slot to claim
+		alignas(64) std::size_t m_popPosition{ 0 }; // position of the next slot to pop, only used by the consumer
+		std::atomic<unsigned long long> m_pushCount{ 0 };
+		std::atomic<unsigned long long> m_overflowCount{ 0 };
+	};
+}
@@ -0,0 +1,144 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     ThreadPool.cpp
+ \date     20-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    Contains the definition of the ThreadPool class's member functions.
+
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+#include "prpch.h"
+#include "ThreadPool.h"
+#include "Time/Profiler.h"
+
+namespace PE
+{
+	// ----- Constructor/Destructor ----- //
+
+	ThreadPool::ThreadPool()
+	{
+		// empty by design, workers are only spawned when a system asks for them
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			m_stop = true;
+		}
+		m_wakeCondition.notify_all();
+
+		for (std::thread& r_worker : m_workers)
+		{
+			if (r_worker.joinable())
+				r_worker.join();
+		}
+		m_workers.clear();
+	}
+
+	// ----- Public Methods ----- //
+
+	void ThreadPool::ReserveThreads(unsigned threadCount)
+	{
+		// the calling thread counts as one of the threads
+		while (GetThreadCount() < threadCount)
+		{
+			m_workers.emplace_back(&ThreadPool::WorkerLoop, this, static_cast<unsigned>(m_workers.size()));
+		}
+	}
+
+	void ThreadPool::ParallelFor(unsigned taskCount, std::function<void(unsigned)> const& r_task)
+	{
+		if (!taskCount)
+			return;
+
+		// nothing to gain from waking the workers, run everything on this thread
+		if (m_workers.empty() || taskCount == 1)
+		{
+			for (unsigned i{ 0 }; i < taskCount; ++i)
+				r_task(i);
+			return;
+		}
+
+		// post the batch
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			p_task = &r_task;
+			m_taskCount = taskCount;
+			m_nextTask = 0;
+			m_tasksDone = 0;
+			++m_batchID;
+		}
+		m_wakeCondition.notify_all();
+
+		// the calling thread helps out instead of idling
+		RunTasks(r_task, taskCount);
+
+		// wait until every task is done and no worker is still holding onto this batch
+		std::unique_lock<std::mutex> lock{ m_mutex };
+		m_doneCondition.wait(lock, [&]() { return m_tasksDone.load() >= m_taskCount && !m_activeWorkers; });
+		p_task = nullptr;
+	}
+
+	unsigned ThreadPool::GetHardwareThreadCount()
+	{
+		unsigned const count{ std::thread::hardware_concurrency() };
+		return count ? count : 1U;
+	}
+
+	// ----- Private Methods ----- //
+
+	void ThreadPool::WorkerLoop(unsigned workerIndex)
+	{
+		Profiler::GetInstance().SetThreadName("Worker " + std::to_string(workerIndex));
+		unsigned long long lastBatchID{ 0 };
+
+		while (true)
+		{
+			std::function<void(unsigned)> const* p_batchTask{ nullptr };
+			unsigned batchTaskCount{ 0 };
+
+			{
+				std::unique_lock<std::mutex> lock{ m_mutex };
+				m_wakeCondition.wait(lock, [&]() { return m_stop || m_batchID != lastBatchID; });
+
+				if (m_stop)
+					return;
+
+				lastBatchID = m_batchID;
+
+				// the batch was already finished by the other threads
+				if (!p_task)
+					continue;
+
+				p_batchTask = p_task;
+				batchTaskCount = m_taskCount;
+				++m_activeWorkers;
+			}
+
+			RunTasks(*p_batchTask, batchTaskCount);
+
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				--m_activeWorkers;
+			}
+			m_doneCondition.notify_one();
+		}
+	}
+
+	void ThreadPool::RunTasks(std::function<void(unsigned)> const& r_task, unsigned taskCount)
+	{
+		PE_PROFILE_SCOPE("ThreadPool Tasks");
+		for (unsigned i{ m_nextTask.fetch_add(1) }; i < taskCount; i = m_nextTask.fetch_add(1))
+		{
+			r_task(i);
+			++m_tasksDone;
+		}
+	}
+}
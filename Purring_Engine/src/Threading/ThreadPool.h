@@ -0,0 +1,115 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     ThreadPool.h
+ \date     20-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    Contains the declaration of the ThreadPool class, a small pool of persistent
+		   worker threads that engine systems can use to split work that can be done
+		   in parallel (e.g. narrowphase collision tests) across multiple cores.
+
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include "Singleton.h"
+
+namespace PE
+{
+	class ThreadPool : public Singleton<ThreadPool>
+	{
+	public:
+		friend class Singleton<ThreadPool>;
+
+		// ----- Public Methods ----- //
+		/*!***********************************************************************************
+		 \brief Makes sure the pool can run at least threadCount tasks concurrently. The
+				calling thread always takes part in the work, so threadCount - 1 worker
+				threads are spawned. The pool never shrinks.
+
+		 \param[in] threadCount - total number of threads (including the caller) to support
+		*************************************************************************************/
+		void ReserveThreads(unsigned threadCount);
+
+		/*!***********************************************************************************
+		 \brief Runs r_task for every index in [0, taskCount) across the worker threads and
+				the calling thread, and blocks until every task has finished. Tasks are
+				claimed in any order, so each task must only write to data owned by its index.
+
+		 \param[in] taskCount - number of tasks to run
+		 \param[in] r_task 	  - function to call with the index of each task
+		*************************************************************************************/
+		void ParallelFor(unsigned taskCount, std::function<void(unsigned)> const& r_task);
+
+		// ----- Public Getters ----- //
+		/*!***********************************************************************************
+		 \brief Get the number of threads (workers + the calling thread) that the pool can use
+
+		 \return unsigned - number of threads
+		*************************************************************************************/
+		unsigned GetThreadCount() const { return static_cast<unsigned>(m_workers.size()) + 1U; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of hardware threads reported by the system, never less than 1
+
+		 \return unsigned - number of hardware threads
+		*************************************************************************************/
+		static unsigned GetHardwareThreadCount();
+
+	private:
+		// ----- Constructor/Destructor ----- //
+		/*!***********************************************************************************
+		 \brief Construct a new Thread Pool object with no workers
+
+		*************************************************************************************/
+		ThreadPool();
+
+		/*!***********************************************************************************
+		 \brief Stops and joins all worker threads
+
+		*************************************************************************************/
+		~ThreadPool();
+
+		// ----- Private Methods ----- //
+		/*!***********************************************************************************
+		 \brief Loop run by each worker thread, waits for a new batch of tasks and helps
+				run them until the pool is destroyed
+
+		 \param[in] workerIndex - index of the worker, used to name its thread in the profiler
+		*************************************************************************************/
+		void WorkerLoop(unsigned workerIndex);
+
+		/*!***********************************************************************************
+		 \brief Claims and runs tasks of the current batch until none are left
+
+		 \param[in] r_task 	  - task function of the current batch
+		 \param[in] taskCount - number of tasks in the current batch
+		*************************************************************************************/
+		void RunTasks(std::function<void(unsigned)> const& r_task, unsigned taskCount);
+
+	private:
+		// ----- Private Variables ----- //
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex; // guards the batch state below
+		std::condition_variable m_wakeCondition; // signalled when a new batch is posted
+		std::condition_variable m_doneCondition; // signalled when a batch is finished
+
+		std::function<void(unsigned)> const* p_task{ nullptr }; // task of the current batch
+		unsigned m_taskCount{ 0 }; // number of tasks in the current batch
+		std::atomic<unsigned> m_nextTask{ 0 }; // index of the next task to be claimed
+		std::atomic<unsigned> m_tasksDone{ 0 }; // number of tasks completed in the current batch
+		unsigned m_activeWorkers{ 0 }; // workers currently running tasks of the current batch
+		unsigned long long m_batchID{ 0 }; // incremented every time a batch is posted
+		bool m_stop{ false };
+	};
+}
@@ -0,0 +1,204 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     Profiler.cpp
+ \date     26-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the definitions of the Profiler class, which records nested
+		   timed scopes on every thread and exports them as Chrome trace events.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+
+/*                                                                                                          includes
+--------------------------------------------------------------------------------------------------------------------- */
+#include "prpch.h"
+#include "Profiler.h"
+#include "Logging/Logger.h"
+
+extern Logger engine_logger;
+
+namespace PE
+{
+	std::atomic<bool> Profiler::s_enabled{ false };
+	std::atomic<std::uint64_t> Profiler::s_frameIndex{ 0 };
+
+	namespace
+	{
+		// clock the timestamps are measured from, set when the profiler is created
+		std::chrono::steady_clock::time_point profilerEpoch{ std::chrono::steady_clock::now() };
+	}
+
+	Profiler::Profiler()
+	{
+		profilerEpoch = std::chrono::steady_clock::now();
+	}
+
+	void Profiler::SetEnabled(bool enabled)
+	{
+		s_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	void Profiler::BeginFrame()
+	{
+		std::uint64_t const frame{ s_frameIndex.load(std::memory_order_relaxed) + 1 };
+		m_frameStarts[frame % FrameHistory] = Now();
+		s_frameIndex.store(frame, std::memory_order_relaxed);
+
+		// Write the capture out once its last frame is done
+		if (m_capturing && frame > m_captureLast)
+		{
+			m_capturing = false;
+			SetEnabled(m_wasEnabled);
+
+			std::size_t const eventCount{ ExportChromeTrace(m_captureFilepath, m_captureFirst, m_captureLast) };
+			engine_logger.SetFlag(Logger::EnumLoggerFlags::WRITE_TO_CONSOLE | Logger::EnumLoggerFlags::DEBUG, true);
+			engine_logger.SetTime();
+			engine_logger.AddLog(false, "Profiler capture of frames " + std::to_string(m_captureFirst) + " to " + std::to_string(m_captureLast)
+				+ " wrote " + std::to_string(eventCount) + " scopes to " + m_captureFilepath, __FUNCTION__);
+		}
+	}
+
+	void Profiler::CaptureFrames(unsigned frameCount, std::string const& r_filepath)
+	{
+		if (m_capturing || !frameCount) { return; }
+
+		m_capturing = true;
+		m_wasEnabled = IsEnabled();
+		m_captureFirst = GetFrameIndex() + 1;
+		m_captureLast = m_captureFirst + frameCount - 1;
+		m_captureFilepath = r_filepath;
+		SetEnabled(true);
+	}
+
+	std::size_t Profiler::ExportChromeTrace(std::string const& r_filepath, std::uint64_t firstFrame, std::uint64_t lastFrame)
+	{
+		std::ofstream outFile{ r_filepath };
+		if (!outFile.is_open()) { return 0; }
+
+		std::vector<ProfileEvent> events;
+		std::vector<std::pair<std::uint32_t, std::string>> threadNames;
+		{
+			std::lock_guard<std::mutex> lock{ m_buffersMutex };
+			for (auto const& rp_buffer : m_buffers)
+			{
+				ReadBuffer(*rp_buffer, firstFrame, lastFrame, events);
+				threadNames.emplace_back(rp_buffer->thread, rp_buffer->name);
+			}
+		}
+
+		// Complete events with microsecond timestamps, the names are all string literals
+		outFile << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		bool first{ true };
+		for (auto const& [thread, name] : threadNames)
+		{
+			outFile << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread
+				<< ",\"args\":{\"name\":\"" << name << "\"}}";
+			first = false;
+		}
+		outFile << std::fixed << std::setprecision(3);
+		for (ProfileEvent const& r_event : events)
+		{
+			outFile << (first ? "" : ",\n") << "{\"name\":\"" << r_event.name << "\",\"cat\":\"PE\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r_event.thread
+				<< ",\"ts\":" << static_cast<double>(r_event.start) / 1000.0
+				<< ",\"dur\":" << static_cast<double>(r_event.end - r_event.start) / 1000.0
+				<< ",\"args\":{\"frame\":" << r_event.frame << ",\"allocations\":" << r_event.allocations << "}}";
+			first = false;
+		}
+		outFile << "\n]}\n";
+
+		return events.size();
+	}
+
+	void Profiler::GetFrameEvents(std::uint64_t frame, std::vector<ProfileEvent>& r_events)
+	{
+		std::lock_guard<std::mutex> lock{ m_buffersMutex };
+		for (auto const& rp_buffer : m_buffers)
+		{
+			std::size_t const threadStart{ r_events.size() };
+			ReadBuffer(*rp_buffer, frame, frame, r_events);
+			std::sort(r_events.begin() + threadStart, r_events.end(),
+				[](ProfileEvent const& r_lhs, ProfileEvent const& r_rhs) { return r_lhs.start < r_rhs.start; });
+		}
+	}
+
+	void Profiler::SetThreadName(std::string const& r_name)
+	{
+		ThreadBuffer& r_buffer{ GetThreadBuffer() };
+		std::lock_guard<std::mutex> lock{ m_buffersMutex };
+		r_buffer.name = r_name;
+	}
+
+	std::string Profiler::GetThreadName(std::uint32_t thread)
+	{
+		std::lock_guard<std::mutex> lock{ m_buffersMutex };
+		return thread < m_buffers.size() ? m_buffers[thread]->name : std::string{};
+	}
+
+	std::uint64_t Profiler::Now()
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profilerEpoch).count());
+	}
+
+	std::uint32_t Profiler::BeginScope()
+	{
+		return GetThreadBuffer().depth++;
+	}
+
+	void Profiler::EndScope(ProfileEvent const& r_event)
+	{
+		ThreadBuffer& r_buffer{ GetThreadBuffer() };
+		--r_buffer.depth;
+
+		// Only this thread writes to the buffer, readers check the index again after copying
+		std::uint64_t const index{ r_buffer.writeIndex.load(std::memory_order_relaxed) };
+		ProfileEvent& r_slot{ r_buffer.events[index % BufferCapacity] };
+		r_slot = r_event;
+		r_slot.thread = r_buffer.thread;
+		r_buffer.writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+	{
+		thread_local ThreadBuffer* p_buffer{ nullptr };
+		if (!p_buffer)
+		{
+			Profiler& r_profiler{ GetInstance() };
+			std::lock_guard<std::mutex> lock{ r_profiler.m_buffersMutex };
+			r_profiler.m_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+			p_buffer = r_profiler.m_buffers.back().get();
+			p_buffer->thread = static_cast<std::uint32_t>(r_profiler.m_buffers.size() - 1);
+			p_buffer->name = "Thread " + std::to_string(p_buffer->thread);
+		}
+		return *p_buffer;
+	}
+
+	void Profiler::ReadBuffer(ThreadBuffer const& r_buffer, std::uint64_t firstFrame, std::uint64_t lastFrame, std::vector<ProfileEvent>& r_events)
+	{
+		// The slot after the newest scope may be being written to, so it is never read
+		std::uint64_t const writeIndex{ r_buffer.writeIndex.load(std::memory_order_acquire) };
+		std::uint64_t const oldest{ writeIndex >= BufferCapacity ? writeIndex - BufferCapacity + 1 : 0 };
+
+		std::size_t const readStart{ r_events.size() };
+		for (std::uint64_t i{ oldest }; i < writeIndex; ++i)
+		{
+			ProfileEvent const& r_event{ r_buffer.events[i % BufferCapacity] };
+			if (r_event.frame >= firstFrame && r_event.frame <= lastFrame)
+			{
+				r_events.emplace_back(r_event);
+			}
+		}
+
+		// Drop the scopes the thread may have overwritten while the buffer was being copied
+		std::uint64_t const newWriteIndex{ r_buffer.writeIndex.load(std::memory_order_acquire) };
+		if (newWriteIndex + 1 > oldest + BufferCapacity)
+		{
+			std::uint64_t const overwritten{ newWriteIndex + 1 - BufferCapacity - oldest };
+			std::size_t const dropCount{ static_cast<std::size_t>(std::min<std::uint64_t>(overwritten, r_events.size() - readStart)) };
+			r_events.erase(r_events.begin() + readStart, r_events.begin() + readStart + dropCount);
+		}
+	}
+}
@@ -0,0 +1,276 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     Profiler.h
+ \date     26-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the Profiler class and the PE_PROFILE_SCOPE marker, which
+		   record nested timed scopes on every thread for the editor flame chart and for
+		   exporting to the Chrome trace event format.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+#pragma once
+
+/*                                                                                                          includes
+--------------------------------------------------------------------------------------------------------------------- */
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Singleton.h"
+#include "Memory/AllocationTracker.h"
+
+#define PE_PROFILE_CONCAT_INNER(a, b) a##b
+#define PE_PROFILE_CONCAT(a, b) PE_PROFILE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing scope when the profiler is enabled, _name must outlive the profiler (e.g. a string literal)
+#define PE_PROFILE_SCOPE(_name) PE::ProfileScope PE_PROFILE_CONCAT(profileScope, __LINE__){ _name }
+
+namespace PE
+{
+	/*!***********************************************************************************
+	 \brief A timed scope recorded by the profiler.
+	*************************************************************************************/
+	struct ProfileEvent
+	{
+		const char* name{ nullptr };	// name passed to the marker
+		std::uint64_t start{};			// nanoseconds since the profiler was created
+		std::uint64_t end{};			// nanoseconds since the profiler was created
+		std::uint64_t frame{};			// index of the frame the scope started in
+		std::uint32_t depth{};			// number of scopes the scope is nested in on its thread
+		std::uint32_t allocations{};	// heap allocations made in the scope and the scopes in it, if they were being counted
+		std::uint32_t thread{};			// index of the thread the scope ran on
+	};
+
+	/*!***********************************************************************************
+	 \brief A Singleton class that collects the scopes timed by PE_PROFILE_SCOPE. Each
+			thread writes into its own ring buffer so recording never takes a lock, the
+			oldest scopes are overwritten once a buffer is full.
+	*************************************************************************************/
+	class Profiler : public Singleton<Profiler>
+	{
+		// ----- Public Methods ----- //
+	public:
+		friend class Singleton<Profiler>;
+
+		static constexpr std::size_t BufferCapacity{ 1 << 14 };	// scopes kept per thread
+		static constexpr std::size_t FrameHistory{ 256 };		// frames whose start time is kept
+
+		/*!***********************************************************************************
+		 \brief Start or stop recording scopes. Scopes already open when recording starts
+				are not recorded.
+
+		 \param[in] enabled True to record scopes.
+		*************************************************************************************/
+		void SetEnabled(bool enabled);
+
+		/*!***********************************************************************************
+		 \brief Mark the start of a new frame. Only call from the main thread.
+		*************************************************************************************/
+		void BeginFrame();
+
+		/*!***********************************************************************************
+		 \brief Record the next frames and export them to a Chrome trace file once they
+				are done. Recording is turned back off afterwards if it was off before.
+
+		 \param[in] frameCount Number of frames to capture.
+		 \param[in] r_filepath File to write the trace to.
+		*************************************************************************************/
+		void CaptureFrames(unsigned frameCount, std::string const& r_filepath);
+
+		/*!***********************************************************************************
+		 \brief Write the scopes of a range of frames that are still in the buffers to a
+				file in the Chrome trace event format (chrome://tracing, Perfetto).
+
+		 \param[in] r_filepath File to write the trace to.
+		 \param[in] firstFrame First frame to write.
+		 \param[in] lastFrame Last frame to write.
+
+		 \return Number of scopes written, 0 if the file could not be opened.
+		*************************************************************************************/
+		std::size_t ExportChromeTrace(std::string const& r_filepath, std::uint64_t firstFrame, std::uint64_t lastFrame);
+
+		/*!***********************************************************************************
+		 \brief Copy the scopes of a frame that are still in the buffers, ordered by thread
+				and start time.
+
+		 \param[in] frame Frame to get the scopes of.
+		 \param[out] r_events Vector the scopes are appended to.
+		*************************************************************************************/
+		void GetFrameEvents(std::uint64_t frame, std::vector<ProfileEvent>& r_events);
+
+		/*!***********************************************************************************
+		 \brief Name the calling thread in the flame chart and the exported traces.
+
+		 \param[in] r_name Name of the thread.
+		*************************************************************************************/
+		void SetThreadName(std::string const& r_name);
+
+		/*!***********************************************************************************
+		 \brief Get the name of a thread that has recorded scopes.
+
+		 \param[in] thread Index of the thread.
+		 \return Name of the thread, empty if no thread has the index.
+		*************************************************************************************/
+		std::string GetThreadName(std::uint32_t thread);
+
+		// ----- Public Getters ----- //
+	public:
+		/*!***********************************************************************************
+		 \brief Check if scopes are being recorded.
+
+		 \return True if scopes are being recorded.
+		*************************************************************************************/
+		static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+		/*!***********************************************************************************
+		 \brief Check if a capture started by CaptureFrames() is still running.
+
+		 \return True if frames are being captured.
+		*************************************************************************************/
+		bool IsCapturing() const { return m_capturing; }
+
+		/*!***********************************************************************************
+		 \brief Get the index of the current frame.
+
+		 \return Number of frames begun since the profiler was created.
+		*************************************************************************************/
+		static std::uint64_t GetFrameIndex() { return s_frameIndex.load(std::memory_order_relaxed); }
+
+		/*!***********************************************************************************
+		 \brief Get the time a frame started. Only valid for the last FrameHistory frames.
+
+		 \param[in] frame Index of the frame.
+		 \return Nanoseconds since the profiler was created.
+		*************************************************************************************/
+		std::uint64_t GetFrameStart(std::uint64_t frame) const { return m_frameStarts[frame % FrameHistory]; }
+
+		/*!***********************************************************************************
+		 \brief Get the current time.
+
+		 \return Nanoseconds since the profiler was created.
+		*************************************************************************************/
+		static std::uint64_t Now();
+
+		// ----- Scope Recording ----- //
+	public:
+		/*!***********************************************************************************
+		 \brief Open a scope on the calling thread, called by ProfileScope.
+
+		 \return Depth of the scope.
+		*************************************************************************************/
+		static std::uint32_t BeginScope();
+
+		/*!***********************************************************************************
+		 \brief Close a scope on the calling thread and record it, called by ProfileScope.
+
+		 \param[in] r_event The scope, with every field but the thread filled in.
+		*************************************************************************************/
+		static void EndScope(ProfileEvent const& r_event);
+
+		// ----- Private Methods ----- //
+	private:
+		/*!***********************************************************************************
+		 \brief Constructor, starts the clock the timestamps are measured from.
+		*************************************************************************************/
+		Profiler();
+
+		/*!***********************************************************************************
+		 \brief Ring buffer of the scopes of one thread. Only its thread writes the events,
+				other threads may read them while it does.
+		*************************************************************************************/
+		struct ThreadBuffer
+		{
+			std::array<ProfileEvent, BufferCapacity> events;
+			std::atomic<std::uint64_t> writeIndex{ 0 };	// number of scopes ever written
+			std::uint32_t depth{ 0 };					// scopes currently open
+			std::uint32_t thread{ 0 };					// index of the thread
+			std::string name;							// name of the thread
+		};
+
+		/*!***********************************************************************************
+		 \brief Get the buffer of the calling thread, creating it on first use.
+
+		 \return Buffer of the calling thread.
+		*************************************************************************************/
+		static ThreadBuffer& GetThreadBuffer();
+
+		/*!***********************************************************************************
+		 \brief Copy the scopes in a buffer that were in a range of frames, skipping any
+				that were overwritten while being copied.
+
+		 \param[in] r_buffer Buffer to read from.
+		 \param[in] firstFrame First frame to copy.
+		 \param[in] lastFrame Last frame to copy.
+		 \param[out] r_events Vector the scopes are appended to.
+		*************************************************************************************/
+		static void ReadBuffer(ThreadBuffer const& r_buffer, std::uint64_t firstFrame, std::uint64_t lastFrame, std::vector<ProfileEvent>& r_events);
+
+		// ----- Private Variables ----- //
+	private:
+		static std::atomic<bool> s_enabled;
+		static std::atomic<std::uint64_t> s_frameIndex;
+
+		std::mutex m_buffersMutex;								// guards adding buffers and thread names
+		std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;	// buffers of every thread that recorded a scope, never freed
+		std::array<std::uint64_t, FrameHistory> m_frameStarts{};
+
+		bool m_capturing{ false };
+		bool m_wasEnabled{ false };			// recording state before the capture started
+		std::uint64_t m_captureFirst{ 0 };
+		std::uint64_t m_captureLast{ 0 };
+		std::string m_captureFilepath;
+	};
+
+	/*!***********************************************************************************
+	 \brief Records the time from its construction to its destruction as a scope when the
+			profiler is enabled, use through PE_PROFILE_SCOPE.
+	*************************************************************************************/
+	class ProfileScope
+	{
+	public:
+		/*!***********************************************************************************
+		 \brief Open the scope. Only reads a flag if the profiler is disabled.
+
+		 \param[in] p_name Name of the scope, must outlive the profiler.
+		*************************************************************************************/
+		explicit ProfileScope(const char* p_name)
+		{
+			if (Profiler::IsEnabled())
+			{
+				m_event.name = p_name;
+				m_event.frame = Profiler::GetFrameIndex();
+				m_event.depth = Profiler::BeginScope();
+				m_allocationsAtStart = AllocationTracker::GetThreadAllocationCount();
+				m_event.start = Profiler::Now();
+			}
+		}
+
+		/*!***********************************************************************************
+		 \brief Close the scope and record it if it was opened while the profiler was enabled.
+		*************************************************************************************/
+		~ProfileScope()
+		{
+			if (m_event.name)
+			{
+				m_event.end = Profiler::Now();
+				m_event.allocations = static_cast<std::uint32_t>(AllocationTracker::GetThreadAllocationCount() - m_allocationsAtStart);
+				Profiler::EndScope(m_event);
+			}
+		}
+
+		ProfileScope(ProfileScope const&) = delete;
+		ProfileScope& operator=(ProfileScope const&) = delete;
+
+	private:
+		ProfileEvent m_event;
+		unsigned long long m_allocationsAtStart{ 0 };
+	};
+}
@@ -33,14 +33,22 @@ namespace PE
 		m_systemStartFrame[system] = std::chrono::high_resolution_clock::now();
 	}
 	
-	void TimeManager::SystemEndFrame(SystemID system)
+	void TimeManager::SystemEndFrame(SystemID system, float frameBudget)
 	{
 		// frame time for each system
 		m_durationInSeconds = (std::chrono::high_resolution_clock::now() - m_systemStartFrame[system]);
+		++m_systemUpdateCount[system];
 
 		if (system != GRAPHICS)
 		{
 			m_systemAccumulatedFrameTime[system] += m_durationInSeconds.count();
+
+			// count each frame over budget once
+			if (frameBudget > 0.f && !m_systemOverBudget[system] && m_systemAccumulatedFrameTime[system] > frameBudget)
+			{
+				m_systemOverBudget[system] = true;
+				++m_systemBudgetOverruns[system];
+			}
 		}
 		else // Graphics not using fixed time step
 		{
@@ -48,6 +56,11 @@ namespace PE
 		}
 	}
 
+	void TimeManager::SystemDeferred(SystemID system)
+	{
+		++m_systemDeferredSteps[system];
+	}
+
 	void TimeManager::UpdateSystemFrameUsage()
 	{
 		// update system frame usage
@@ -55,8 +68,13 @@ namespace PE
 		{
 			m_systemFrameUsage[systemID] = m_systemFrameTime[systemID] / m_frameTime;
 			m_systemFrameTime[systemID] = 0.f;
+
+			// update system rate
+			m_systemUpdateRate[systemID] = (m_updateRateTime > 0.f) ? static_cast<float>(m_systemUpdateCount[systemID]) / m_updateRateTime : 0.f;
+			m_systemUpdateCount[systemID] = 0;
 		}
 		m_frameTime = 0.f;
+		m_updateRateTime = 0.f;
 	}
 
 	void TimeManager::StartFrame()
@@ -68,6 +86,7 @@ namespace PE
 		m_durationInSeconds = (m_startFrame - m_previousStartFrame);
 		m_deltaTime = m_deltaTime == 0.f ? 1.f / 60.f : m_durationInSeconds.count();
 		m_previousStartFrame = m_startFrame;
+		m_updateRateTime += m_deltaTime;
 
 		// calculate total run time
 		m_durationInSeconds = (m_startFrame - m_engineStartTime);
@@ -103,6 +122,7 @@ namespace PE
 	void TimeManager::EndAccumulator()
 	{
 		m_accumulator -= m_fixedTimeStep;
+		++m_fixedStepCount;
 
 		// if accumulator last loop iteration
 		if (!(m_accumulator >= m_fixedTimeStep))
@@ -112,6 +132,7 @@ namespace PE
 			{
 				m_systemFrameTime[systemID] += m_systemAccumulatedFrameTime[systemID];
 				m_systemAccumulatedFrameTime[systemID] = 0.f;
+				m_systemOverBudget[systemID] = false;
 			}
 		}
 	}
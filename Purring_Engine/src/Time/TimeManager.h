@@ -53,8 +53,17 @@ namespace PE
 		 \brief Conclude the frame time for a particular subsystem.
 
 		 \param[in] system The subsystem to conclude frame time for.
+		 \param[in] frameBudget Time the subsystem may use per frame, 0 if it has no budget.
 		*************************************************************************************/
-		void SystemEndFrame(SystemID system);
+		void SystemEndFrame(SystemID system, float frameBudget = 0.f);
+
+		/*!***********************************************************************************
+		 \brief Record that a fixed step of a subsystem was deferred to the next frame
+				because the subsystem had used up its frame budget.
+
+		 \param[in] system The subsystem that was deferred.
+		*************************************************************************************/
+		void SystemDeferred(SystemID system);
 
 		void UpdateSystemFrameUsage();
 
@@ -125,6 +134,15 @@ namespace PE
 		*************************************************************************************/
 		float GetFixedTimeStep() const { return m_fixedTimeStep; }
 
+		/*!***********************************************************************************
+		 \brief Get how far the current frame is between the last fixed step and the next,
+				from the time left in the accumulator. Used to draw objects between the
+				states of their last two steps.
+
+		 \return Interpolation alpha from 0 (at the last step) to 1 (at the next step)
+		*************************************************************************************/
+		float GetInterpolationAlpha() const { return (m_fixedTimeStep > 0.f) ? std::clamp(m_accumulator / m_fixedTimeStep, 0.f, 1.f) : 1.f; }
+
 		/*!***********************************************************************************
 		 \brief Get the total run time of the engine.
 
@@ -148,6 +166,52 @@ namespace PE
 		*************************************************************************************/
 		float GetSystemFrameUsage(SystemID system) const { return m_systemFrameUsage[system]; }
 
+		/*!***********************************************************************************
+		 \brief Get the time a fixed time subsystem has spent updating in the current frame.
+
+		 \param[in] system The subsystem identifier.
+
+		 \return Time spent in the current frame in seconds.
+		*************************************************************************************/
+		float GetSystemCurrentFrameTime(SystemID system) const { return m_systemAccumulatedFrameTime[system]; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of times a subsystem was updated per second, measured over
+				the last FPS update interval.
+
+		 \param[in] system The subsystem identifier.
+
+		 \return Measured update rate in updates per second.
+		*************************************************************************************/
+		float GetSystemUpdateRate(SystemID system) const { return m_systemUpdateRate[system]; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of frames in which a subsystem went over its frame budget.
+
+		 \param[in] system The subsystem identifier.
+
+		 \return Number of frames over budget since the engine started.
+		*************************************************************************************/
+		unsigned GetSystemBudgetOverruns(SystemID system) const { return m_systemBudgetOverruns[system]; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of fixed steps of a subsystem deferred to the next frame
+				because it had used up its frame budget.
+
+		 \param[in] system The subsystem identifier.
+
+		 \return Number of deferred steps since the engine started.
+		*************************************************************************************/
+		unsigned GetSystemDeferredSteps(SystemID system) const { return m_systemDeferredSteps[system]; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of fixed steps run since the engine started, so that work
+				meant to be done once per step can tell if it already ran this step.
+
+		 \return Number of fixed steps.
+		*************************************************************************************/
+		unsigned long long GetFixedStepCount() const { return m_fixedStepCount; }
+
 		FrameRateController m_frameRateController;
 		// ----- Private Methods and Members ----- //
 	private:
@@ -164,6 +228,11 @@ namespace PE
 		std::array<float, SYSTEMCOUNT> m_systemFrameTime;					// stores all system frame time
 		std::array<float, SYSTEMCOUNT> m_systemAccumulatedFrameTime;		// stores all accumulated system frame time
 		std::array<float, SYSTEMCOUNT> m_systemFrameUsage;					// stores all system frame usage
+		std::array<unsigned, SYSTEMCOUNT> m_systemUpdateCount{};			// stores the number of updates of each system since the last usage update
+		std::array<float, SYSTEMCOUNT> m_systemUpdateRate{};				// stores the measured updates per second of each system
+		std::array<bool, SYSTEMCOUNT> m_systemOverBudget{};				// stores whether each system went over its budget this frame
+		std::array<unsigned, SYSTEMCOUNT> m_systemBudgetOverruns{};		// stores the number of frames each system went over its budget
+		std::array<unsigned, SYSTEMCOUNT> m_systemDeferredSteps{};		// stores the number of steps of each system deferred by its budget
 		//std::chrono::high_resolution_clock::time_point m_systemStartFrame, m_systemEndFrame;	// system time
 
 		// global time
@@ -174,6 +243,8 @@ namespace PE
 		float m_accumulator;
 		float m_accumulatorLimit;
 		float m_fixedTimeStep;
+		float m_updateRateTime{};								// time since the update rates were last measured
+		unsigned long long m_fixedStepCount{};
 
 		// holds duration in seconds
 		std::chrono::duration<float> m_durationInSeconds;
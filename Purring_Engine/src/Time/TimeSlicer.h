@@ -0,0 +1,103 @@
+/*!***********************************************************************************
+ \project  Purring Engine
+ \module   CSD2401-A
+ \file     TimeSlicer.h
+ \date     25-03-2024
+
+ \author               agent
+ \par      email:      agent@local
+
+ \brief    This file contains the TimeSlicer class, which spreads work over a list of
+		   items across frames by handing out round-robin slices that fit in a time
+		   budget.
+
+ All content (c) 2024 DigiPen Institute of Technology Singapore. All rights reserved.
+*************************************************************************************/
+#pragma once
+
+/*                                                                                                          includes
+--------------------------------------------------------------------------------------------------------------------- */
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace PE
+{
+	/*!***********************************************************************************
+	 \brief Processes a slice of a list of items on every call, continuing from where the
+			previous slice stopped, until the time budget of the slice is used up or
+			every item has had a turn. At least one item is processed per call so the
+			whole list is always worked through eventually.
+	*************************************************************************************/
+	class TimeSlicer
+	{
+		// ----- Public Methods ----- //
+	public:
+		/*!***********************************************************************************
+		 \brief Construct a time slicer.
+
+		 \param[in] sliceBudget Time each slice may take in seconds, 0 to process every item.
+		*************************************************************************************/
+		explicit TimeSlicer(float sliceBudget = 0.f) : m_sliceBudget{ sliceBudget } {}
+
+		/*!***********************************************************************************
+		 \brief Calls r_func on the next slice of r_items.
+
+		 \param[in] r_items The items to work through, may change between calls.
+		 \param[in] r_func Function to call with each item of the slice.
+
+		 \return Number of items processed in this slice.
+		*************************************************************************************/
+		template <typename T, typename Func>
+		std::size_t Run(std::vector<T> const& r_items, Func&& r_func)
+		{
+			m_lastSliceCount = 0;
+			if (r_items.empty())
+			{
+				m_cursor = 0;
+				return 0;
+			}
+			if (m_cursor >= r_items.size()) { m_cursor = 0; }
+
+			auto const start{ std::chrono::high_resolution_clock::now() };
+			do
+			{
+				r_func(r_items[m_cursor]);
+				m_cursor = (m_cursor + 1) % r_items.size();
+				++m_lastSliceCount;
+			} while (m_lastSliceCount < r_items.size() && (m_sliceBudget <= 0.f ||
+				std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start).count() < m_sliceBudget));
+
+			return m_lastSliceCount;
+		}
+
+		/*!***********************************************************************************
+		 \brief Set the time each slice may take.
+
+		 \param[in] sliceBudget Time budget in seconds, 0 to process every item.
+		*************************************************************************************/
+		void SetSliceBudget(float sliceBudget) { m_sliceBudget = sliceBudget; }
+
+		// ----- Public Getters ----- //
+	public:
+		/*!***********************************************************************************
+		 \brief Get the time each slice may take.
+
+		 \return Time budget in seconds, 0 if every item is processed.
+		*************************************************************************************/
+		float GetSliceBudget() const { return m_sliceBudget; }
+
+		/*!***********************************************************************************
+		 \brief Get the number of items processed by the last slice.
+
+		 \return Number of items processed.
+		*************************************************************************************/
+		std::size_t GetLastSliceCount() const { return m_lastSliceCount; }
+
+		// ----- Private Variables ----- //
+	private:
+		float m_sliceBudget;					// time each slice may take in seconds
+		std::size_t m_cursor{ 0 };				// index of the item the next slice starts from
+		std::size_t m_lastSliceCount{ 0 };		// number of items processed by the last slice
+	};
+}
@@ -54,13 +54,6 @@ namespace PE
 #else
 		m_showFps = false;
 #endif // !GAMERELEASE
-		// Attempt to initialize GLFW
-		if (!glfwInit())
-		{
-			std::cerr << "Failed to initialize GLFW." << std::endl;
-			exit(-1);
-		}
-
 	}
 
 
@@ -72,6 +65,13 @@ namespace PE
 
 	GLFWwindow* WindowManager::InitWindow(int width, int height, const char* p_title)
 	{
+		// Attempt to initialize GLFW, only once there is a window to create
+		if (!glfwInit())
+		{
+			std::cerr << "Failed to initialize GLFW." << std::endl;
+			exit(-1);
+		}
+
 #ifndef GAMERELEASE
 		GLFWwindow* window = glfwCreateWindow(width, height, p_title, nullptr, nullptr);
 		p_monitor = glfwGetWindowMonitor(window);
@@ -44,7 +44,7 @@ namespace PE
         friend class Singleton<WindowManager>;
     public:
         /*!***********************************************************************************
-         \brief     Constructor for initializing GLFW library.
+         \brief     Constructor. GLFW is only initialized by InitWindow().
         *************************************************************************************/
         WindowManager();
 
@@ -54,7 +54,7 @@ namespace PE
         ~WindowManager();
 
         /*!***********************************************************************************
-         \brief     Initialize a new GLFW window.
+         \brief     Initialize the GLFW library and a new GLFW window.
          \param     width Window width.
          \param     height Window height.
          \param     title Window title.
@@ -187,11 +187,11 @@ namespace PE
 
 
     public:
-        GLFWwindow* p_currWindow;
+        GLFWwindow* p_currWindow{ nullptr };
         static bool m_fullScreen;
 
     private:
-        GLFWmonitor* p_monitor;
+        GLFWmonitor* p_monitor{ nullptr };
         static bool msepress;
         bool m_showFps;
     };
@@ -8,7 +8,7 @@
  \par      email:      krystal.y@digipen.edu
  
  \brief     This file implements a fragment shader that renders fragments based on the
-            uniform color or the texture passed in. 
+            color and the page of the texture atlas or the texture passed in. 
   
  All content (c) 2023 DigiPen Institute of Technology Singapore. All rights reserved.
 *************************************************************************************/
@@ -17,15 +17,22 @@
 
 layout (location = 0) in vec4 vColor;         // IN color
 layout (location = 1) in vec2 vTextureCoord;  // IN texture coordinate
-layout (location = 2) in flat float vIsTextured;    // IN texture boolean
-// Set to true to sample texture coordinates, false to just use the color
+layout (location = 2) in flat float vTextureLayer;  // IN atlas layer
+// Layer of the atlas to sample, -1 to just use the color, -2 to sample uTextureSampler2d
 
 layout (location = 0) out vec4 fFragColor;	// OUT RGBA color
 
-uniform sampler2D uTextureSampler2d;   // Texture sampler to access texture image
+uniform sampler2D uTextureSampler2d;   // Texture sampler to access a texture that is not in the atlas
+uniform sampler2DArray uTextureArray;  // Texture sampler to access the pages of the texture atlas
 
 void main(void) {
-	if(vIsTextured > 0.1)
+	if(vTextureLayer > -0.5)
+	{
+		// Sample the page of the atlas using the texture coordinates
+		fFragColor = texture(uTextureArray, vec3(vTextureCoord, vTextureLayer));
+		fFragColor *= vColor;
+	}
+	else if(vTextureLayer < -1.5)
 	{
 		// Sample the texture using the texture coordinates
 		fFragColor = texture(uTextureSampler2d, vTextureCoord);
@@ -7,9 +7,10 @@
  \author               Krystal YAMIN
  \par      email:      krystal.y@digipen.edu
  
- \brief     This file implements a minimal vertex shader that takes in a position, 
-            color and texture coordinates. These parameters are passed to the next 
-            hardware stage unchanged.
+ \brief     This file implements a vertex shader for instanced sprites. The model to
+            world transform of each quad is built from its position, half size and
+            rotation, and its texture coordinates are taken from its UV rect, which
+            is already mapped into the texture atlas.
   
  All content (c) 2023 DigiPen Institute of Technology Singapore. All rights reserved.
 *************************************************************************************/
@@ -17,23 +18,32 @@
 #version 450 core
 
 layout (location = 0) in vec2 aVertexPosition; // IN vertex position
-layout (location = 1) in vec2 aTextureCoord;   // IN texture coordinate
-layout (location = 2) in vec2 aTextureCoordDynamic;
+layout (location = 1) in vec2 aTextureCoord;   // IN texture coordinate, from (0, 0) at the bottom left to (1, 1) at the top right
 
-layout (location = 3) in float aIsTextured;    // IN texture boolean
-layout (location = 4) in vec4 aColor;          // IN vertex color
-layout (location = 5) in mat4 aModelToWorld;   // IN transformation matrix
+// Per instance, see Graphics/SpriteInstance.h
+layout (location = 2) in vec2 aPosition;       // IN position of the center of the quad
+layout (location = 3) in vec2 aHalfSize;       // IN half the width and height of the quad
+layout (location = 4) in float aRotation;      // IN counterclockwise rotation in radians
+layout (location = 5) in vec4 aColor;          // IN color, unpacked from 8 bits per channel
+layout (location = 6) in vec4 aUVRect;         // IN UV coordinates of the bottom left (xy) and top right (zw) corners
+layout (location = 7) in float aTextureLayer;  // IN atlas layer, -1 if not textured, -2 if the texture is not in the atlas
 
 layout (location = 0) out vec4 vColor;         // OUT color
 layout (location = 1) out vec2 vTextureCoord;  // OUT texture coordinate
-layout (location = 2) out float vIsTextured;    // OUT texture boolean
+layout (location = 2) flat out float vTextureLayer; // OUT atlas layer
 
 uniform mat4 uWorldToNdc;   // World to NDC matrix
 
 void main(void) {
-    gl_Position = uWorldToNdc * aModelToWorld * vec4(aVertexPosition, 0.0, 1.0);
+    // Scale, rotate then translate the vertex, as the model to world matrix would
+    vec2 scaled = aVertexPosition * 2.0 * aHalfSize;
+    float sinAngle = sin(aRotation);
+    float cosAngle = cos(aRotation);
+    vec2 worldPosition = vec2(scaled.x * cosAngle - scaled.y * sinAngle,
+                              scaled.x * sinAngle + scaled.y * cosAngle) + aPosition;
+
+    gl_Position = uWorldToNdc * vec4(worldPosition, 0.0, 1.0);
     vColor = aColor;
-    aTextureCoord;
-	vTextureCoord = aTextureCoordDynamic;
-    vIsTextured = aIsTextured;
+    vTextureCoord = mix(aUVRect.xy, aUVRect.zw, aTextureCoord);
+    vTextureLayer = aTextureLayer;
 }
\ No newline at end of file
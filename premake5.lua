@@ -35,6 +35,13 @@ workspace "Purring_Engine"
         "GameRelease"               -- Game release build configuration.
     }
 
+-- Command line options. Pass them when generating the project, e.g. "premake5 vs2022 --track-allocations".
+newoption
+{
+    trigger     = "track-allocations",
+    description = "Replace the global operator new and delete to count the allocations of each system (Debug and Release only)"
+}
+
 -- Global variables to define output directories for binaries and intermediates based on the configuration, system, and architecture.
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"         -- Output directory for the project.
 gameoutputdir = "Release-%{cfg.system}-%{cfg.architecture}"             -- Output directory for the game release build configuration.
@@ -282,6 +289,10 @@ project "Purring_Engine"
             "%{prj.name}/src/Editor/*.cpp"
         }
 
+    ----- Allocation Tracking -----
+    filter { "options:track-allocations", "configurations:not GameRelease" }
+        defines { "PE_TRACK_ALLOCATIONS" }                          -- Count every allocation, off by default as it slows every allocation down.
+
  
 -- Application project setup. This is the user-facing part of the engine, like a game editor or standalone game.
 project "Application"
@@ -405,3 +416,7 @@ project "Application"
         }
 
         links { "rttr_core" }
+
+    ----- Allocation Tracking -----
+    filter { "options:track-allocations", "configurations:not GameRelease" }
+        defines { "PE_TRACK_ALLOCATIONS" }                          -- Needed by the entry point to leave the debug heap flags alone.